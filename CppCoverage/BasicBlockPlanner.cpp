@@ -0,0 +1,225 @@
+// OpenCppCoverage is an open source code coverage for C++.
+// Copyright (C) 2019 OpenCppCoverage
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "stdafx.h"
+#include "BasicBlockPlanner.hpp"
+
+#include <algorithm>
+#include <unordered_set>
+
+#include <boost/optional.hpp>
+
+namespace CppCoverage
+{
+	namespace
+	{
+		// The code of the last line before a gap is decoded up to this size.
+		const size_t LastSegmentMaxSize = 256;
+
+		using Kind = InstructionDecoder::Kind;
+
+		//---------------------------------------------------------------------
+		bool IsUnconditionalTransfer(Kind kind)
+		{
+			return kind == Kind::Jump || kind == Kind::IndirectJump ||
+				kind == Kind::Return || kind == Kind::Interrupt;
+		}
+
+		//---------------------------------------------------------------------
+		bool HasTargetIn(
+			const std::vector<std::uint64_t>& sortedTargets,
+			std::uint64_t first,
+			std::uint64_t last)
+		{
+			auto it = std::upper_bound(sortedTargets.begin(), sortedTargets.end(), first);
+			return it != sortedTargets.end() && *it <= last;
+		}
+	}
+
+	//-------------------------------------------------------------------------
+	struct BasicBlockPlanner::DecodedCode
+	{
+		explicit DecodedCode(size_t lineCount)
+			: fallsThrough_(lineCount, false)
+			, hasIndirectJump_(lineCount, false)
+		{
+		}
+
+		// fallsThrough_[i] is true when the code of the line i always
+		// continues with the line i + 1.
+		std::vector<bool> fallsThrough_;
+		std::vector<bool> hasIndirectJump_;
+		std::vector<std::uint64_t> targets_;
+	};
+
+	//-------------------------------------------------------------------------
+	BasicBlockPlanner::BasicBlockPlanner(
+		InstructionDecoder::Mode mode,
+		CodeReader codeReader)
+		: decoder_{ mode }
+		, codeReader_{ std::move(codeReader) }
+	{
+	}
+
+	//-------------------------------------------------------------------------
+	std::unordered_map<std::uint64_t, std::uint64_t>
+	BasicBlockPlanner::Plan(std::vector<Line> lines) const
+	{
+		std::stable_sort(lines.begin(), lines.end(), [](const Line& line1, const Line& line2) {
+			return line1.address_ < line2.address_;
+		});
+
+		// Lines sharing an address are merged. When they come from different
+		// functions or files, they are kept in their own block.
+		std::vector<Line> uniqueLines;
+		std::vector<bool> isShared;
+		for (const auto& line : lines)
+		{
+			if (!uniqueLines.empty() && uniqueLines.back().address_ == line.address_)
+			{
+				auto& previous = uniqueLines.back();
+				if (previous.symbolIndex_ != line.symbolIndex_ || previous.fileId_ != line.fileId_)
+					isShared.back() = true;
+				previous.isMonitored_ |= line.isMonitored_;
+			}
+			else
+			{
+				uniqueLines.push_back(line);
+				isShared.push_back(false);
+			}
+		}
+
+		auto decodedCode = Decode(uniqueLines);
+		auto& targets = decodedCode.targets_;
+		std::sort(targets.begin(), targets.end());
+
+		std::unordered_set<unsigned long> symbolsWithIndirectJump;
+		for (size_t i = 0; i < uniqueLines.size(); ++i)
+		{
+			if (decodedCode.hasIndirectJump_[i])
+				symbolsWithIndirectJump.insert(uniqueLines[i].symbolIndex_);
+		}
+
+		std::unordered_map<std::uint64_t, std::uint64_t> leaders;
+		boost::optional<size_t> leaderIndex;
+		for (size_t i = 0; i < uniqueLines.size(); ++i)
+		{
+			const auto& line = uniqueLines[i];
+			if (i == 0 ||
+				!decodedCode.fallsThrough_[i - 1] ||
+				line.symbolIndex_ != uniqueLines[i - 1].symbolIndex_ ||
+				symbolsWithIndirectJump.count(line.symbolIndex_) ||
+				HasTargetIn(targets, uniqueLines[i - 1].address_, line.address_) ||
+				isShared[i])
+			{
+				leaderIndex = boost::none;
+			}
+
+			if (line.isMonitored_)
+			{
+				if (leaderIndex && uniqueLines[*leaderIndex].fileId_ == line.fileId_)
+					leaders.emplace(line.address_, uniqueLines[*leaderIndex].address_);
+				else
+				{
+					leaders.emplace(line.address_, line.address_);
+					leaderIndex = i;
+				}
+			}
+			if (isShared[i])
+				leaderIndex = boost::none;
+		}
+
+		return leaders;
+	}
+
+	//-------------------------------------------------------------------------
+	BasicBlockPlanner::DecodedCode
+	BasicBlockPlanner::Decode(const std::vector<Line>& lines) const
+	{
+		DecodedCode decodedCode{ lines.size() };
+
+		size_t first = 0;
+		while (first < lines.size())
+		{
+			auto last = first;
+			while (last + 1 < lines.size() &&
+				lines[last + 1].address_ - lines[last].address_ <= MaxLineGap)
+			{
+				++last;
+			}
+
+			auto codeAddress = lines[first].address_;
+			auto code = codeReader_(
+				codeAddress,
+				static_cast<size_t>(lines[last].address_ - codeAddress) + LastSegmentMaxSize);
+
+			for (auto i = first; i <= last; ++i)
+			{
+				auto begin = static_cast<size_t>(lines[i].address_ - codeAddress);
+				auto isLastSegment = i == last;
+				auto end = isLastSegment
+					? code.size()
+					: static_cast<size_t>(lines[i + 1].address_ - codeAddress);
+
+				DecodeSegment(code, codeAddress, begin, end, isLastSegment, i, decodedCode);
+			}
+			first = last + 1;
+		}
+
+		return decodedCode;
+	}
+
+	//-------------------------------------------------------------------------
+	void BasicBlockPlanner::DecodeSegment(
+		const std::vector<unsigned char>& code,
+		std::uint64_t codeAddress,
+		size_t begin,
+		size_t end,
+		bool isLastSegment,
+		size_t lineIndex,
+		DecodedCode& decodedCode) const
+	{
+		auto offset = begin;
+		auto fallsThrough = !isLastSegment;
+
+		while (offset < end && offset < code.size())
+		{
+			// The size is not limited to end to detect an instruction
+			// overlapping the next line.
+			auto instruction = decoder_.Decode(
+				&code[offset], code.size() - offset, codeAddress + offset);
+
+			if (instruction.kind_ == Kind::Invalid)
+			{
+				fallsThrough = false;
+				break;
+			}
+			if (instruction.target_)
+				decodedCode.targets_.push_back(*instruction.target_);
+			if (instruction.kind_ == Kind::IndirectJump)
+				decodedCode.hasIndirectJump_[lineIndex] = true;
+			if (InstructionDecoder::IsControlTransfer(instruction.kind_))
+			{
+				fallsThrough = false;
+				// After the last line, the code can be padding or data.
+				if (isLastSegment && IsUnconditionalTransfer(instruction.kind_))
+					break;
+			}
+			offset += instruction.length_;
+		}
+		decodedCode.fallsThrough_[lineIndex] = fallsThrough && offset == end;
+	}
+}
@@ -0,0 +1,79 @@
+// OpenCppCoverage is an open source code coverage for C++.
+// Copyright (C) 2019 OpenCppCoverage
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+#include "InstructionDecoder.hpp"
+#include "CppCoverageExport.hpp"
+
+namespace CppCoverage
+{
+	// Group the monitored lines of a module by basic block so only the
+	// first line of a block needs a breakpoint.
+	// A line is in the block of the previous monitored line when the code
+	// between them is decoded without any jump, call, return or interrupt
+	// and no decoded branch targets this code. Calls end a block because
+	// they can throw. The lines of a function with an indirect jump (a
+	// switch table for example) are never grouped as the targets are unknown.
+	class CPPCOVERAGE_DLL BasicBlockPlanner
+	{
+	public:
+		struct Line
+		{
+			std::uint64_t address_;
+			unsigned long symbolIndex_;
+			// Lines of different files are never grouped.
+			unsigned int fileId_;
+			// Lines that are not monitored only split the code to decode.
+			bool isMonitored_;
+		};
+
+		// Return the code at address. The result can be smaller than size
+		// at the end of a readable range.
+		using CodeReader = std::function<std::vector<unsigned char>(
+			std::uint64_t address, size_t size)>;
+
+		// Code between two lines farther than this value is never decoded.
+		static const std::uint64_t MaxLineGap = 4096;
+
+		BasicBlockPlanner(InstructionDecoder::Mode, CodeReader);
+
+		// Return the address of the first line of the block of each
+		// monitored line.
+		std::unordered_map<std::uint64_t, std::uint64_t> Plan(std::vector<Line>) const;
+
+	private:
+		struct DecodedCode;
+
+		DecodedCode Decode(const std::vector<Line>&) const;
+		void DecodeSegment(
+			const std::vector<unsigned char>& code,
+			std::uint64_t codeAddress,
+			size_t begin,
+			size_t end,
+			bool isLastSegment,
+			size_t lineIndex,
+			DecodedCode&) const;
+
+		const InstructionDecoder decoder_;
+		const CodeReader codeReader_;
+	};
+}
@@ -17,7 +17,11 @@
 #include "stdafx.h"
 #include "CodeCoverageRunner.hpp"
 
+#include <atomic>
+#include <condition_variable>
+#include <exception>
 #include <sstream>
+#include <thread>
 #include <boost/optional.hpp>
 
 #include "tools/Log.hpp"
@@ -25,32 +29,122 @@
 #include "Plugin/Exporter/CoverageData.hpp"
 #include "Debugger.hpp"
 #include "ExecutedAddressManager.hpp"
-#include "HandleInformation.hpp"
 #include "BreakPoint.hpp"
 #include "CoverageFilterManager.hpp"
+#include "CoverageDataMerger.hpp"
+#include "CoverageEventsHandler.hpp"
 #include "StartInfo.hpp"
-#include "ExceptionHandler.hpp"
 #include "CppCoverageException.hpp"
-#include "Address.hpp"
 #include "RunCoverageSettings.hpp"
-#include "MonitoredLineRegister.hpp"
+#include "DebugInformationEnumerator.hpp"
 #include "FilterAssistant.hpp"
+#include "LineTableCache.hpp"
 #include "FileSystem.hpp"
+#include "CoverageSnapshot.hpp"
+#include "CoverageJournal.hpp"
+#include "CoverageSummary.hpp"
 
+#include "Tools/ScopedAction.hpp"
 #include "Tools/WarningManager.hpp"
 #include "Tools/Tool.hpp"
 
 namespace CppCoverage
 {
+	namespace
+	{
+		// The first breakpoints of an attached process are the attach
+		// breakpoint and the loader breakpoint.
+		const size_t RootProcessIgnoredBreakPointCount = 1;
+		const size_t AttachedProcessIgnoredBreakPointCount = 2;
+
+		//---------------------------------------------------------------------
+		std::wstring GetFilterKey(const RunCoverageSettings& settings)
+		{
+			std::wostringstream ostr;
+			const auto& coverageFilterSettings = settings.GetCoverageFilterSettings();
+
+			for (const auto* patterns : { &coverageFilterSettings.GetModulePatterns(),
+				&coverageFilterSettings.GetSourcePatterns() })
+			{
+				ostr << patterns->IsRegexCaseSensitiv() << L'\n';
+				for (const auto& pattern : patterns->GetSelectedPatterns())
+					ostr << L"+" << pattern << L'\n';
+				for (const auto& pattern : patterns->GetExcludedPatterns())
+					ostr << L"-" << pattern << L'\n';
+			}
+			for (const auto& excludedLineRegex : settings.GetExcludedLineRegexes())
+				ostr << L"!" << excludedLineRegex << L'\n';
+			for (const auto& substitutePdbSourcePath : settings.GetSubstitutePdbSourcePaths())
+			{
+				ostr << L"?" << substitutePdbSourcePath.GetPdbStartPath().wstring()
+					<< L'?' << substitutePdbSourcePath.GetLocalPath().wstring() << L'\n';
+			}
+			ostr << settings.GetOptimizedBuildSupport();
+
+			return ostr.str();
+		}
+
+		//---------------------------------------------------------------------
+		// Increment tick every interval so the debug loops can check whether
+		// work is due with an atomic load instead of a lock and a clock.
+		class Ticker
+		{
+		public:
+			Ticker(std::chrono::milliseconds interval, std::atomic<uint64_t>& tick)
+				: thread_{ [this, interval, &tick]() {
+					std::unique_lock<std::mutex> lock{ mutex_ };
+					while (!condition_.wait_for(lock, interval, [this]() { return isStopped_; }))
+						++tick;
+				} }
+			{
+			}
+
+			~Ticker()
+			{
+				{
+					std::lock_guard<std::mutex> lock{ mutex_ };
+					isStopped_ = true;
+				}
+				condition_.notify_one();
+				thread_.join();
+			}
+
+		private:
+			std::mutex mutex_;
+			std::condition_variable condition_;
+			bool isStopped_ = false;
+			std::thread thread_;
+		};
+	}
+
+	//-------------------------------------------------------------------------
+	struct CodeCoverageRunner::ChildProcesses
+	{
+		std::mutex mutex_;
+		std::vector<std::thread> threads_;
+		std::vector<std::unique_ptr<CoverageEventsHandler>> eventsHandlers_;
+		std::exception_ptr error_;
+	};
+
+	//-------------------------------------------------------------------------
+	struct CodeCoverageRunner::Session
+	{
+		std::wstring name_;
+		int exitCode_;
+		// The root process is the last one.
+		std::vector<std::unique_ptr<CoverageEventsHandler>> eventsHandlers_;
+	};
+
 	//-------------------------------------------------------------------------
 	CodeCoverageRunner::CodeCoverageRunner(
 		std::shared_ptr<Tools::WarningManager> warningManager)
 		: warningManager_{ warningManager },
 		filterAssistant_{
-			std::make_shared<FilterAssistant>(std::make_shared<FileSystem>()) }
+			std::make_shared<FilterAssistant>(std::make_shared<FileSystem>()) },
+		lineTableCache_{ std::make_shared<LineTableCache>() },
+		idleTimeout_{ INFINITE },
+		tick_{ 0 }
 	{
-		executedAddressManager_ = std::make_shared<ExecutedAddressManager>();
-		exceptionHandler_ = std::make_unique<ExceptionHandler>();
 		breakpoint_ = std::make_shared<BreakPoint>();
 	}
 
@@ -63,144 +157,306 @@ namespace CppCoverage
 	Plugin::CoverageData CodeCoverageRunner::RunCoverage(
 		const RunCoverageSettings& settings)
 	{
-		Debugger debugger{ settings.GetCoverChildren(), settings.GetContinueAfterCppException(), settings.GetStopOnAssert(), settings.GetDumpOnCrash(), settings.GetDumpDirectory() };
-
-		coverageFilterManager_ = std::make_shared<CoverageFilterManager>(
-			settings.GetCoverageFilterSettings(),
-			settings.GetUnifiedDiffSettings(),
-			settings.GetExcludedLineRegexes(),
-			settings.GetOptimizedBuildSupport());
+		boost::optional<Plugin::CoverageData> coverageData;
 
-		monitoredLineRegister_ = std::make_unique<MonitoredLineRegister>(
-			breakpoint_,
-			executedAddressManager_,
-			coverageFilterManager_,
-			std::make_unique<DebugInformationEnumerator>(settings.GetSubstitutePdbSourcePaths()),
-			filterAssistant_);
-
-		const auto& startInfo = settings.GetStartInfo();
-		int exitCode = debugger.Debug(startInfo, *this);
-		const auto& path = startInfo.GetPath();
-
-		auto warningMessageLines = coverageFilterManager_->ComputeWarningMessageLines(
-			settings.GetMaxUnmatchPathsForWarning());
-		for (const auto& line : warningMessageLines)
-			LOG_WARNING << line;
-		auto filterAdviceMessage = filterAssistant_->GetAdviceMessage();
-		if (filterAdviceMessage)
-			warningManager_->AddWarning(*filterAdviceMessage);
-		return executedAddressManager_->CreateCoverageData(path.filename().wstring(), exitCode);
+		RunCoverage(settings, { settings.GetStartInfo() }, 1,
+			[&](Plugin::CoverageData&& sessionCoverageData) {
+				coverageData = std::move(sessionCoverageData);
+			});
+		return std::move(*coverageData);
 	}
 
 	//-------------------------------------------------------------------------
-	void CodeCoverageRunner::OnCreateProcess(const CREATE_PROCESS_DEBUG_INFO& processDebugInfo)
+	void CodeCoverageRunner::RunCoverage(
+		const RunCoverageSettings& settings,
+		const std::vector<StartInfo>& startInfos,
+		size_t jobCount,
+		const CoverageDataHandler& coverageDataHandler)
 	{
-		auto hProcess = processDebugInfo.hProcess;
-		auto lpBaseOfImage = processDebugInfo.lpBaseOfImage;
+		RunSessions(settings, startInfos, jobCount,
+			[](const Session& session) {
+				const auto& eventsHandlers = session.eventsHandlers_;
+				auto coverageData = eventsHandlers.back()->GetExecutedAddressManager()
+					.CreateCoverageData(session.name_, session.exitCode_);
+				if (eventsHandlers.size() == 1)
+					return coverageData;
 
-		LoadModule(hProcess, processDebugInfo.hFile, lpBaseOfImage);
-	}
+				// The root process is merged last to keep its name and its exit code.
+				std::vector<Plugin::CoverageData> coverageDatas;
+				for (auto it = eventsHandlers.begin(); it + 1 != eventsHandlers.end(); ++it)
+					coverageDatas.push_back((*it)->GetExecutedAddressManager().CreateCoverageData(session.name_, 0));
+				coverageDatas.push_back(std::move(coverageData));
 
-	//-------------------------------------------------------------------------
-	void CodeCoverageRunner::OnExitProcess(HANDLE hProcess, HANDLE, const EXIT_PROCESS_DEBUG_INFO&)
-	{
-		exceptionHandler_->OnExitProcess(hProcess);
-		executedAddressManager_->OnExitProcess(hProcess);
+				return CoverageDataMerger{}.Merge(std::move(coverageDatas));
+			},
+			coverageDataHandler);
 	}
 
 	//-------------------------------------------------------------------------
-	void CodeCoverageRunner::OnLoadDll(
-		HANDLE hProcess,
-		HANDLE hThread,
-		const LOAD_DLL_DEBUG_INFO& dllDebugInfo)
+	CoverageSummary CodeCoverageRunner::RunCoverageSummary(
+		const RunCoverageSettings& settings,
+		const std::vector<StartInfo>& startInfos,
+		size_t jobCount)
 	{
-		LoadModule(hProcess, dllDebugInfo.hFile, dllDebugInfo.lpBaseOfDll);
-	}
+		CoverageSummary coverageSummary;
 
-	//-------------------------------------------------------------------------
-	void CodeCoverageRunner::OnUnloadDll(
-		HANDLE hProcess,
-		HANDLE hThread,
-		const UNLOAD_DLL_DEBUG_INFO& unloadDllDebugInfo)
-	{
-		executedAddressManager_->OnUnloadModule(hProcess, unloadDllDebugInfo.lpBaseOfDll);
+		RunSessions(settings, startInfos, jobCount,
+			[](const Session& session) {
+				CoverageSummary sessionCoverageSummary{ session.exitCode_ };
+				for (const auto& eventsHandler : session.eventsHandlers_)
+				{
+					sessionCoverageSummary.Merge(
+						eventsHandler->GetExecutedAddressManager().CreateCoverageSummary(0));
+				}
+				return sessionCoverageSummary;
+			},
+			[&](CoverageSummary&& sessionCoverageSummary) {
+				coverageSummary.Merge(std::move(sessionCoverageSummary));
+			});
+		return coverageSummary;
 	}
 
 	//-------------------------------------------------------------------------
-	IDebugEventsHandler::ExceptionType CodeCoverageRunner::OnException(
-		HANDLE hProcess,
-		HANDLE hThread,
-		const EXCEPTION_DEBUG_INFO& exceptionDebugInfo)
+	template <typename CreateResult, typename ResultHandler>
+	void CodeCoverageRunner::RunSessions(
+		const RunCoverageSettings& settings,
+		const std::vector<StartInfo>& startInfos,
+		size_t jobCount,
+		CreateResult createResult,
+		ResultHandler resultHandler)
 	{
-		std::wostringstream ostr;
-
-		auto status = exceptionHandler_->HandleException(hProcess, exceptionDebugInfo, ostr);
-
-		switch (status)
+		// Keep the filters, their decisions and the cached lines of the
+		// selected source files when the same runner is used again with the
+		// same filters. Unified diff files may have changed.
+		auto filterKey = GetFilterKey(settings);
+		if (!coverageFilterManager_ || filterKey != filterKey_ ||
+			!settings.GetUnifiedDiffSettings().empty())
 		{
-		case CppCoverage::ExceptionHandlerStatus::BreakPoint:
+			lineTableCache_->Clear();
+			coverageFilterManager_ = std::make_shared<CoverageFilterManager>(
+				settings.GetCoverageFilterSettings(),
+				settings.GetUnifiedDiffSettings(),
+				settings.GetExcludedLineRegexes(),
+				settings.GetOptimizedBuildSupport());
+			filterKey_ = std::move(filterKey);
+		}
+
+		const auto& path = settings.GetStartInfo().GetPath();
+		const auto& snapshotSettings = settings.GetSnapshotSettings();
+		idleTimeout_ = INFINITE;
+		if (snapshotSettings)
 		{
-			if (OnBreakPoint(exceptionDebugInfo, hProcess, hThread))
-				return IDebugEventsHandler::ExceptionType::BreakPoint;
-			return IDebugEventsHandler::ExceptionType::InvalidBreakPoint;
+			coverageSnapshot_ = std::make_unique<CoverageSnapshot>(
+				path.filename().wstring(),
+				*snapshotSettings,
+				settings.GetSnapshotHandler());
+			idleTimeout_ = static_cast<DWORD>(CoverageSnapshot::PollInterval.count());
 		}
-		case CppCoverage::ExceptionHandlerStatus::FirstChanceException:
+		const auto& coverageJournalPath = settings.GetCoverageJournalPath();
+		if (coverageJournalPath)
 		{
-			return IDebugEventsHandler::ExceptionType::NotHandled;
+			coverageJournal_ = std::make_unique<CoverageJournal>(
+				*coverageJournalPath, path.filename().wstring());
+			idleTimeout_ = static_cast<DWORD>(CoverageJournal::FlushInterval.count());
 		}
-		case CppCoverage::ExceptionHandlerStatus::Error:
+
+		std::unique_ptr<Ticker> ticker;
+		if (coverageSnapshot_ || coverageJournal_)
+			ticker = std::make_unique<Ticker>(std::chrono::milliseconds{ idleTimeout_ }, tick_);
+
+		std::atomic<size_t> nextStartInfo{ 0 };
+		std::mutex resultMutex;
+		std::exception_ptr error;
+		auto runSessions = [&]() {
+			for (auto i = nextStartInfo++; i < startInfos.size(); i = nextStartInfo++)
+			{
+				try
+				{
+					auto result = createResult(RunSession(settings, startInfos[i]));
+					std::lock_guard<std::mutex> lock{ resultMutex };
+					if (error)
+						return;
+					resultHandler(std::move(result));
+				}
+				catch (...)
+				{
+					std::lock_guard<std::mutex> lock{ resultMutex };
+					if (!error)
+						error = std::current_exception();
+					return;
+				}
+			}
+		};
+
+		auto threadCount = std::min(jobCount, startInfos.size());
+		if (threadCount <= 1)
+			runSessions();
+		else
 		{
-			LOG_ERROR << ostr.str();
+			std::vector<std::thread> threads;
+			for (size_t i = 0; i < threadCount; ++i)
+				threads.emplace_back(runSessions);
+			for (auto& thread : threads)
+				thread.join();
+		}
+		ticker.reset();
+		coverageJournal_.reset();
+		coverageSnapshot_.reset();
+		if (error)
+			std::rethrow_exception(error);
+
+		auto warningMessageLines = coverageFilterManager_->ComputeWarningMessageLines(
+			settings.GetMaxUnmatchPathsForWarning());
+		for (const auto& line : warningMessageLines)
+			LOG_WARNING << line;
+		auto filterAdviceMessage = filterAssistant_->GetAdviceMessage();
+		if (filterAdviceMessage)
+			warningManager_->AddWarning(*filterAdviceMessage);
+	}
 
-			return IDebugEventsHandler::ExceptionType::Error;
+	//-------------------------------------------------------------------------
+	CodeCoverageRunner::Session CodeCoverageRunner::RunSession(
+		const RunCoverageSettings& settings,
+		const StartInfo& startInfo)
+	{
+		Debugger debugger{ settings.GetCoverChildren(), settings.GetContinueAfterCppException(), settings.GetStopOnAssert(), settings.GetDumpOnCrash(), settings.GetDumpDirectory() };
+		ChildProcesses childProcesses;
+
+		debugger.SetIdleTimeout(idleTimeout_);
+		auto eventsHandler = CreateEventsHandler(settings, RootProcessIgnoredBreakPointCount);
+		if (settings.GetCoverChildrenInParallel())
+		{
+			debugger.SetChildProcessHandler(
+				[this, &settings, &childProcesses](DWORD processId, DWORD threadId) {
+					StartChildProcessCoverage(settings, childProcesses, processId, threadId);
+				});
 		}
-		case CppCoverage::ExceptionHandlerStatus::CppError:
+
+		int exitCode = 0;
 		{
-			LOG_ERROR << ostr.str();
+			Tools::ScopedAction joinChildProcesses{ [&] { JoinChildProcessCoverages(childProcesses); } };
+			exitCode = debugger.Debug(startInfo, *eventsHandler);
+		}
+		if (childProcesses.error_)
+			std::rethrow_exception(childProcesses.error_);
 
-			return IDebugEventsHandler::ExceptionType::CppError;
+		if (coverageJournal_)
+		{
+			std::lock_guard<std::mutex> lock{ lineChangesMutex_ };
+			coverageJournal_->Append(eventsHandler->GetExecutedAddressManager().TakeLineChanges());
+			for (const auto& childProcessHandler : childProcesses.eventsHandlers_)
+				coverageJournal_->Append(childProcessHandler->GetExecutedAddressManager().TakeLineChanges());
 		}
+
+		Session session{ startInfo.GetPath().filename().wstring(), exitCode };
+		session.eventsHandlers_ = std::move(childProcesses.eventsHandlers_);
+		session.eventsHandlers_.push_back(std::move(eventsHandler));
+		return session;
+	}
+
+	//-------------------------------------------------------------------------
+	std::unique_ptr<CoverageEventsHandler> CodeCoverageRunner::CreateEventsHandler(
+		const RunCoverageSettings& settings,
+		size_t ignoredBreakPointCount)
+	{
+		CoverageEventsHandler::DebuggeeRunningHandler debuggeeRunningHandler;
+		if (coverageSnapshot_ || coverageJournal_)
+		{
+			// Each debug loop has its own handler so lastTick is not shared.
+			debuggeeRunningHandler = [this, lastTick = tick_.load()](
+				ExecutedAddressManager& executedAddressManager) mutable {
+				auto tick = tick_.load(std::memory_order_relaxed);
+				if (tick != lastTick)
+				{
+					lastTick = tick;
+					OnDebuggeeRunning(executedAddressManager);
+				}
+			};
 		}
 
-		return IDebugEventsHandler::ExceptionType::NotHandled;
+		auto eventsHandler = std::make_unique<CoverageEventsHandler>(
+			breakpoint_,
+			coverageFilterManager_,
+			filterAssistant_,
+			std::make_unique<DebugInformationEnumerator>(settings.GetSubstitutePdbSourcePaths()),
+			lineTableCache_,
+			settings.GetBasicBlockBreakPoints(),
+			ignoredBreakPointCount,
+			std::move(debuggeeRunningHandler));
+
+		auto& executedAddressManager = eventsHandler->GetExecutedAddressManager();
+		executedAddressManager.SetMemoryBudget(settings.GetCoverageMemoryBudget());
+		if (coverageSnapshot_ || coverageJournal_)
+			executedAddressManager.EnableLineChangeTracking();
+
+		return eventsHandler;
 	}
 
 	//-------------------------------------------------------------------------
-	bool CodeCoverageRunner::OnBreakPoint(
-		const EXCEPTION_DEBUG_INFO& exceptionDebugInfo,
-		HANDLE hProcess,
-		HANDLE hThread)
+	void CodeCoverageRunner::OnDebuggeeRunning(ExecutedAddressManager& executedAddressManager)
 	{
-		const auto& exceptionRecord = exceptionDebugInfo.ExceptionRecord;
-		auto addressValue = exceptionRecord.ExceptionAddress;
-		Address address{ hProcess, addressValue };
-		auto oldInstruction = executedAddressManager_->MarkAddressAsExecuted(address);
+		std::lock_guard<std::mutex> lock{ lineChangesMutex_ };
+		auto lineChanges = executedAddressManager.TakeLineChanges();
 
-		if (oldInstruction)
+		if (coverageSnapshot_)
 		{
-			breakpoint_->RemoveBreakPoint(address, *oldInstruction);
-			breakpoint_->AdjustEipAfterBreakPointRemoval(hThread);
-			return true;
+			coverageSnapshot_->AddLineChanges(lineChanges);
+			if (coverageSnapshot_->IsDue())
+				coverageSnapshot_->Take();
 		}
-
-		return false;
+		if (coverageJournal_)
+			coverageJournal_->Append(std::move(lineChanges));
 	}
 
 	//-------------------------------------------------------------------------
-	void CodeCoverageRunner::LoadModule(HANDLE hProcess,
-		HANDLE hFile,
-		void* baseOfImage)
+	void CodeCoverageRunner::StartChildProcessCoverage(
+		const RunCoverageSettings& settings,
+		ChildProcesses& childProcesses,
+		DWORD processId,
+		DWORD suspendedThreadId)
 	{
-		HandleInformation handleInformation;
+		auto eventsHandler = CreateEventsHandler(settings, AttachedProcessIgnoredBreakPointCount);
+		auto& eventsHandlerRef = *eventsHandler;
 
-		std::wstring filename = handleInformation.ComputeFilename(hFile);
+		std::lock_guard<std::mutex> lock{ childProcesses.mutex_ };
+		childProcesses.eventsHandlers_.push_back(std::move(eventsHandler));
+		childProcesses.threads_.emplace_back(
+			[this, &settings, &childProcesses, &eventsHandlerRef, processId, suspendedThreadId]() {
+			try
+			{
+				Debugger debugger{ settings.GetCoverChildren(), settings.GetContinueAfterCppException(), settings.GetStopOnAssert(), settings.GetDumpOnCrash(), settings.GetDumpDirectory() };
 
-		auto isSelected = coverageFilterManager_->IsModuleSelected(filename);
-		if (isSelected)
+				debugger.SetIdleTimeout(idleTimeout_);
+				debugger.SetChildProcessHandler(
+					[this, &settings, &childProcesses](DWORD childProcessId, DWORD childThreadId) {
+						StartChildProcessCoverage(settings, childProcesses, childProcessId, childThreadId);
+					});
+				debugger.Attach(processId, suspendedThreadId, eventsHandlerRef);
+			}
+			catch (...)
+			{
+				std::lock_guard<std::mutex> errorLock{ childProcesses.mutex_ };
+				if (!childProcesses.error_)
+					childProcesses.error_ = std::current_exception();
+			}
+		});
+	}
+
+	//-------------------------------------------------------------------------
+	void CodeCoverageRunner::JoinChildProcessCoverages(ChildProcesses& childProcesses)
+	{
+		// A child process can start other child processes while joining.
+		for (;;)
 		{
-			isSelected = monitoredLineRegister_->RegisterLineToMonitor(
-				filename, hProcess, baseOfImage);
+			std::vector<std::thread> threads;
+			{
+				std::lock_guard<std::mutex> lock{ childProcesses.mutex_ };
+				threads.swap(childProcesses.threads_);
+			}
+			if (threads.empty())
+				return;
+			for (auto& thread : threads)
+				thread.join();
 		}
-		filterAssistant_->OnNewModule(filename, isSelected);
 	}
 }
@@ -16,10 +16,16 @@
 
 #pragma once
 
+#include <atomic>
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <Windows.h>
 
 #include "Plugin/Exporter/CoverageData.hpp"
-#include "IDebugEventsHandler.hpp"
 #include "CppCoverageExport.hpp"
 
 namespace Tools
@@ -35,42 +41,84 @@ namespace CppCoverage
 	class ExecutedAddressManager;
 	class BreakPoint;
 	class CoverageFilterManager;
-	class ExceptionHandler;
 	class UnifiedDiffSettings;
-	class MonitoredLineRegister;
 	class FilterAssistant;
+	class CoverageSnapshot;
+	class CoverageJournal;
+	class CoverageEventsHandler;
+	class LineTableCache;
+	class CoverageSummary;
 
-	class CPPCOVERAGE_DLL CodeCoverageRunner : private IDebugEventsHandler
+	class CPPCOVERAGE_DLL CodeCoverageRunner
 	{
 	public:
 		explicit CodeCoverageRunner(std::shared_ptr<Tools::WarningManager>);
 		~CodeCoverageRunner();
 
+		// A runner can be used for several runs. The line tables and, when
+		// the filter settings do not change, the filter decisions are kept.
 		Plugin::CoverageData RunCoverage(const RunCoverageSettings&);
 
-	private:
-		virtual void OnCreateProcess(const CREATE_PROCESS_DEBUG_INFO&) override;
-		virtual void OnExitProcess(HANDLE hProcess, HANDLE hThread, const EXIT_PROCESS_DEBUG_INFO&) override;
-		virtual void OnLoadDll(HANDLE hProcess, HANDLE hThread, const LOAD_DLL_DEBUG_INFO&) override;
-		virtual void OnUnloadDll(HANDLE hProcess, HANDLE hThread, const UNLOAD_DLL_DEBUG_INFO&) override;
-		virtual ExceptionType OnException(HANDLE hProcess, HANDLE hThread, const EXCEPTION_DEBUG_INFO&) override;
+		// Run the coverage of each program with up to jobCount programs at
+		// the same time. Programs share the other settings, the filters and
+		// the line tables. coverageDataHandler is called, one at a time,
+		// each time a program exits.
+		using CoverageDataHandler = std::function<void(Plugin::CoverageData&&)>;
+		void RunCoverage(
+			const RunCoverageSettings&,
+			const std::vector<StartInfo>&,
+			size_t jobCount,
+			const CoverageDataHandler&);
+
+		// Same as the previous function but only the executed and unexecuted
+		// line counts are computed: Plugin::CoverageData is never created.
+		// The summary has the last exit code that is not 0.
+		CoverageSummary RunCoverageSummary(
+			const RunCoverageSettings&,
+			const std::vector<StartInfo>&,
+			size_t jobCount);
 
 	private:
 		CodeCoverageRunner(const CodeCoverageRunner&) = delete;
 		CodeCoverageRunner& operator=(const CodeCoverageRunner&) = delete;
 
-		void LoadModule(HANDLE hProcess, HANDLE hFile, void* baseOfImage);
-		bool OnBreakPoint(const EXCEPTION_DEBUG_INFO&, HANDLE hProcess, HANDLE hThread);
+		struct ChildProcesses;
+		struct Session;
+
+		template <typename CreateResult, typename ResultHandler>
+		void RunSessions(
+			const RunCoverageSettings&,
+			const std::vector<StartInfo>&,
+			size_t jobCount,
+			CreateResult,
+			ResultHandler);
+		Session RunSession(const RunCoverageSettings&, const StartInfo&);
+		std::unique_ptr<CoverageEventsHandler> CreateEventsHandler(
+			const RunCoverageSettings&,
+			size_t ignoredBreakPointCount);
+		// Called at most once per tick by each debug loop.
+		void OnDebuggeeRunning(ExecutedAddressManager&);
+
+		void StartChildProcessCoverage(
+			const RunCoverageSettings&,
+			ChildProcesses&,
+			DWORD processId,
+			DWORD suspendedThreadId);
+		void JoinChildProcessCoverages(ChildProcesses&);
 
 	private:
 		std::shared_ptr<BreakPoint> breakpoint_;
-		std::shared_ptr<ExecutedAddressManager> executedAddressManager_;
 		std::shared_ptr<CoverageFilterManager> coverageFilterManager_;
-		std::unique_ptr<MonitoredLineRegister> monitoredLineRegister_;
-		std::unique_ptr<ExceptionHandler> exceptionHandler_;
+		std::wstring filterKey_;
 		std::shared_ptr<Tools::WarningManager> warningManager_;
 		std::shared_ptr<FilterAssistant> filterAssistant_;
+		std::shared_ptr<LineTableCache> lineTableCache_;
+		DWORD idleTimeout_;
+		// Incremented every idleTimeout_ while a snapshot or a journal is used.
+		std::atomic<uint64_t> tick_;
+
+		std::mutex lineChangesMutex_;
+		std::unique_ptr<CoverageSnapshot> coverageSnapshot_;
+		std::unique_ptr<CoverageJournal> coverageJournal_;
 	};
 }
-
-
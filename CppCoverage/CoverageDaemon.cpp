@@ -0,0 +1,211 @@
+// OpenCppCoverage is an open source code coverage for C++.
+// Copyright (C) 2019 OpenCppCoverage
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "stdafx.h"
+#include "CoverageDaemon.hpp"
+
+#include <cwchar>
+#include <filesystem>
+#include <sstream>
+
+#include "Tools/BinaryStream.hpp"
+#include "Tools/Log.hpp"
+
+#include "CppCoverageException.hpp"
+#include "MessageChannel.hpp"
+
+namespace CppCoverage
+{
+	namespace
+	{
+		// Request: Magic, Version, MessageType,
+		//	{workingDirectory, environmentCount, variable*, argumentCount, argument*}
+		// Response: Magic, Version, MessageType, exitCode, output
+		const uint32_t Magic = 0x444F4343; // OCCD
+		const uint32_t Version = 3;
+
+		enum class MessageType : uint8_t
+		{
+			Run = 1,
+			Stop = 2,
+			Response = 3
+		};
+
+		//---------------------------------------------------------------------
+		template <typename T>
+		T Read(Tools::BinaryReader& reader)
+		{
+			T value;
+
+			if (!reader.Read(value))
+				THROW(L"Invalid daemon message.");
+			return value;
+		}
+
+		//---------------------------------------------------------------------
+		template <typename String>
+		String ReadString(Tools::BinaryReader& reader)
+		{
+			String str;
+
+			if (!reader.ReadString(str))
+				THROW(L"Invalid daemon message.");
+			return str;
+		}
+
+		//---------------------------------------------------------------------
+		std::ostringstream CreateMessage(MessageType messageType)
+		{
+			std::ostringstream ostr;
+			Tools::BinaryWriter writer{ ostr };
+
+			writer.Write(Magic);
+			writer.Write(Version);
+			writer.Write(messageType);
+			return ostr;
+		}
+
+		//---------------------------------------------------------------------
+		MessageType ReadMessageType(Tools::BinaryReader& reader)
+		{
+			if (Read<uint32_t>(reader) != Magic)
+				THROW(L"Invalid daemon message.");
+			auto version = Read<uint32_t>(reader);
+			if (version != Version)
+			{
+				THROW(L"Daemon protocol version " << version <<
+					L" is not supported. Expected version " << Version << L'.');
+			}
+			return Read<MessageType>(reader);
+		}
+	}
+
+	//-------------------------------------------------------------------------
+	CoverageDaemon::CoverageDaemon(RequestHandler requestHandler)
+		: requestHandler_{ std::move(requestHandler) }
+	{
+	}
+
+	//-------------------------------------------------------------------------
+	void CoverageDaemon::Serve(IMessageChannelListener& listener)
+	{
+		while (auto channel = listener.Accept())
+		{
+			try
+			{
+				if (!HandleClient(*channel))
+					return;
+			}
+			catch (const std::exception& e)
+			{
+				// A faulty client must not stop the daemon.
+				LOG_ERROR << "Daemon client error: " << e.what();
+			}
+		}
+	}
+
+	//-------------------------------------------------------------------------
+	bool CoverageDaemon::HandleClient(IMessageChannel& channel)
+	{
+		while (auto message = channel.Read())
+		{
+			std::istringstream istr{ *message };
+			Tools::BinaryReader reader{ istr };
+
+			switch (ReadMessageType(reader))
+			{
+			case MessageType::Stop:
+				return false;
+			case MessageType::Run:
+			{
+				DaemonRequest request;
+				request.workingDirectory = ReadString<std::wstring>(reader);
+				auto environmentCount = Read<uint32_t>(reader);
+				for (uint32_t i = 0; i < environmentCount; ++i)
+					request.environment.push_back(ReadString<std::wstring>(reader));
+				auto argumentCount = Read<uint32_t>(reader);
+				for (uint32_t i = 0; i < argumentCount; ++i)
+					request.arguments.push_back(ReadString<std::string>(reader));
+
+				auto response = requestHandler_(request);
+				auto ostr = CreateMessage(MessageType::Response);
+				Tools::BinaryWriter writer{ ostr };
+				writer.Write<int32_t>(response.exitCode);
+				writer.WriteString(response.output);
+				channel.Write(ostr.str());
+				break;
+			}
+			default:
+				THROW(L"Unexpected daemon message.");
+			}
+		}
+		return true;
+	}
+
+	//-------------------------------------------------------------------------
+	DaemonRequest CoverageDaemon::CreateRequest(std::vector<std::string>&& arguments)
+	{
+		DaemonRequest request;
+		auto* environmentStrings = GetEnvironmentStringsW();
+
+		if (!environmentStrings)
+			THROW_LAST_ERROR(L"Cannot get the environment: ", GetLastError());
+		for (auto* variable = environmentStrings; *variable; variable += wcslen(variable) + 1)
+			request.environment.emplace_back(variable);
+		FreeEnvironmentStringsW(environmentStrings);
+
+		request.workingDirectory = std::filesystem::current_path().wstring();
+		request.arguments = std::move(arguments);
+		return request;
+	}
+
+	//-------------------------------------------------------------------------
+	DaemonResponse CoverageDaemon::SendRequest(
+		IMessageChannel& channel,
+		const DaemonRequest& request)
+	{
+		auto ostr = CreateMessage(MessageType::Run);
+		Tools::BinaryWriter writer{ ostr };
+		writer.WriteString(request.workingDirectory);
+		writer.Write<uint32_t>(static_cast<uint32_t>(request.environment.size()));
+		for (const auto& variable : request.environment)
+			writer.WriteString(variable);
+		writer.Write<uint32_t>(static_cast<uint32_t>(request.arguments.size()));
+		for (const auto& argument : request.arguments)
+			writer.WriteString(argument);
+		channel.Write(ostr.str());
+
+		auto message = channel.Read();
+		if (!message)
+			THROW(L"The daemon closed the connection.");
+
+		std::istringstream istr{ *message };
+		Tools::BinaryReader reader{ istr };
+		if (ReadMessageType(reader) != MessageType::Response)
+			THROW(L"Unexpected daemon message.");
+
+		DaemonResponse response;
+		response.exitCode = Read<int32_t>(reader);
+		response.output = ReadString<std::string>(reader);
+		return response;
+	}
+
+	//-------------------------------------------------------------------------
+	void CoverageDaemon::SendStopRequest(IMessageChannel& channel)
+	{
+		channel.Write(CreateMessage(MessageType::Stop).str());
+	}
+}
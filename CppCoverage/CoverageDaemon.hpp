@@ -0,0 +1,76 @@
+// OpenCppCoverage is an open source code coverage for C++.
+// Copyright (C) 2019 OpenCppCoverage
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "CppCoverageExport.hpp"
+
+namespace CppCoverage
+{
+	class IMessageChannel;
+	class IMessageChannelListener;
+
+	//-------------------------------------------------------------------------
+	struct CPPCOVERAGE_DLL DaemonRequest
+	{
+		std::wstring workingDirectory;
+		std::vector<std::wstring> environment;
+		std::vector<std::string> arguments;
+	};
+
+	//-------------------------------------------------------------------------
+	struct CPPCOVERAGE_DLL DaemonResponse
+	{
+		int exitCode;
+		std::string output;
+	};
+
+	//-------------------------------------------------------------------------
+	// Resident process running the command lines sent by thin clients. The
+	// caches filled by a run (plugins, line tables, filter decisions) are
+	// still warm for the next one.
+	//-------------------------------------------------------------------------
+	class CPPCOVERAGE_DLL CoverageDaemon
+	{
+	public:
+		using RequestHandler = std::function<DaemonResponse(const DaemonRequest&)>;
+
+		explicit CoverageDaemon(RequestHandler);
+
+		// Handle the requests one at a time until a client sends a stop
+		// request or the listener has no more clients.
+		void Serve(IMessageChannelListener&);
+
+		// Request running arguments with the working directory and the
+		// environment of the current process.
+		static DaemonRequest CreateRequest(std::vector<std::string>&& arguments);
+
+		static DaemonResponse SendRequest(IMessageChannel&, const DaemonRequest&);
+		static void SendStopRequest(IMessageChannel&);
+
+	private:
+		CoverageDaemon(const CoverageDaemon&) = delete;
+		CoverageDaemon& operator=(const CoverageDaemon&) = delete;
+
+		bool HandleClient(IMessageChannel&);
+
+		const RequestHandler requestHandler_;
+	};
+}
@@ -0,0 +1,204 @@
+// OpenCppCoverage is an open source code coverage for C++.
+// Copyright (C) 2019 OpenCppCoverage
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "stdafx.h"
+#include "CoverageDataAccumulator.hpp"
+
+#include <algorithm>
+
+#include "Plugin/Exporter/ModuleCoverage.hpp"
+#include "Plugin/Exporter/FileCoverage.hpp"
+
+namespace CppCoverage
+{
+	namespace
+	{
+		//---------------------------------------------------------------------
+		// Paths that differ only by their separators are merged, like in
+		// CoverageDataMerger::Merge.
+		Tools::PathId GetPathId(const std::filesystem::path& path)
+		{
+			auto preferredPath = path;
+
+			return Tools::PathInterner::GetInstance().Intern(preferredPath.make_preferred());
+		}
+
+		//---------------------------------------------------------------------
+		template <typename Children>
+		void SortChildrenByPath(Children& children)
+		{
+			std::sort(children.begin(), children.end(), [](const auto& child1, const auto& child2)
+			{
+				return child1->GetPath() < child2->GetPath();
+			});
+		}
+	}
+
+	//-------------------------------------------------------------------------
+	struct CoverageDataAccumulator::File
+	{
+		Plugin::FileCoverage* fileCoverage = nullptr;
+		bool isMerged = false;
+	};
+
+	//-------------------------------------------------------------------------
+	struct CoverageDataAccumulator::Module
+	{
+		// Null while the modules are in coverageData_.
+		std::unique_ptr<Plugin::ModuleCoverage> moduleCoverage;
+
+		// Filled the first time another module with the same path is merged.
+		std::unordered_map<Tools::PathId, File> files;
+		bool isMerged = false;
+	};
+
+	//-------------------------------------------------------------------------
+	CoverageDataAccumulator::CoverageDataAccumulator()
+		: coverageData_{ L"", 0 }
+		, isSorted_{ true }
+	{
+	}
+
+	//-------------------------------------------------------------------------
+	CoverageDataAccumulator::~CoverageDataAccumulator() = default;
+
+	//-------------------------------------------------------------------------
+	void CoverageDataAccumulator::Add(Plugin::CoverageData&& coverageData)
+	{
+		// Take the ownership so the arena of coverageData is released at the
+		// end if none of its files is moved.
+		auto input = std::move(coverageData);
+
+		coverageData_.SetName(input.GetName());
+		if (input.GetExitCode())
+			coverageData_.SetExitCode(input.GetExitCode());
+
+		TakeModules();
+		for (auto& moduleCoverage : input.ReleaseModules())
+		{
+			auto& module = modules_[GetPathId(moduleCoverage->GetPath())];
+			if (!module)
+			{
+				module = std::make_unique<Module>();
+				module->moduleCoverage = std::move(moduleCoverage);
+			}
+			else
+				MergeModule(*module, std::move(moduleCoverage));
+		}
+	}
+
+	//-------------------------------------------------------------------------
+	const Plugin::CoverageData& CoverageDataAccumulator::GetCoverageData()
+	{
+		SortByPath();
+		return coverageData_;
+	}
+
+	//-------------------------------------------------------------------------
+	Plugin::CoverageData CoverageDataAccumulator::Release()
+	{
+		SortByPath();
+
+		auto coverageData = std::move(coverageData_);
+		coverageData_ = Plugin::CoverageData{ L"", 0 };
+		modules_.clear();
+		return coverageData;
+	}
+
+	//-------------------------------------------------------------------------
+	void CoverageDataAccumulator::MergeModule(
+		Module& module,
+		std::unique_ptr<Plugin::ModuleCoverage>&& moduleCoverage)
+	{
+		if (!module.isMerged)
+		{
+			// The module can belong to an arena: new files are added to a 
+			// module on the heap instead.
+			auto files = module.moduleCoverage->ReleaseFiles();
+
+			module.moduleCoverage = std::make_unique<Plugin::ModuleCoverage>(
+				module.moduleCoverage->GetPath());
+			module.isMerged = true;
+			for (auto& file : files)
+				AddFile(module, std::move(file));
+		}
+
+		for (auto& file : moduleCoverage->ReleaseFiles())
+			AddFile(module, std::move(file));
+	}
+
+	//-------------------------------------------------------------------------
+	void CoverageDataAccumulator::AddFile(
+		Module& module,
+		std::unique_ptr<Plugin::FileCoverage>&& fileCoverage)
+	{
+		auto& file = module.files[GetPathId(fileCoverage->GetPath())];
+
+		if (!file.fileCoverage)
+		{
+			file.fileCoverage = &module.moduleCoverage->AddFile(std::move(fileCoverage));
+			return;
+		}
+
+		if (!file.isMerged)
+		{
+			// Copy the lines once to the heap so merging does not grow the
+			// arena of the moved file.
+			Plugin::FileCoverage mergedFile{ file.fileCoverage->GetPath() };
+
+			mergedFile.MergeLines(*file.fileCoverage);
+			*file.fileCoverage = mergedFile;
+			file.isMerged = true;
+		}
+		file.fileCoverage->MergeLines(*fileCoverage);
+	}
+
+	//-------------------------------------------------------------------------
+	void CoverageDataAccumulator::TakeModules()
+	{
+		if (!isSorted_)
+			return;
+
+		for (auto& moduleCoverage : coverageData_.ReleaseModules())
+		{
+			auto& module = modules_.at(GetPathId(moduleCoverage->GetPath()));
+			module->moduleCoverage = std::move(moduleCoverage);
+		}
+		isSorted_ = false;
+	}
+
+	//-------------------------------------------------------------------------
+	void CoverageDataAccumulator::SortByPath()
+	{
+		if (isSorted_)
+			return;
+
+		Plugin::CoverageData::T_ModuleCoverageCollection modules;
+		for (auto& module : modules_)
+			modules.push_back(std::move(module.second->moduleCoverage));
+
+		SortChildrenByPath(modules);
+		for (auto& module : modules)
+		{
+			auto files = module->ReleaseFiles();
+			SortChildrenByPath(files);
+			for (auto& file : files)
+				module->AddFile(std::move(file));
+			coverageData_.AddModule(std::move(module));
+		}
+		isSorted_ = true;
+	}
+}
@@ -0,0 +1,75 @@
+// OpenCppCoverage is an open source code coverage for C++.
+// Copyright (C) 2019 OpenCppCoverage
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <memory>
+#include <unordered_map>
+
+#include "Plugin/Exporter/CoverageData.hpp"
+#include "Tools/PathInterner.hpp"
+
+#include "CppCoverageExport.hpp"
+
+namespace Plugin
+{
+	class FileCoverage;
+}
+
+namespace CppCoverage
+{
+	//-------------------------------------------------------------------------
+	// Merge coverage data one at a time into the same result, with the same
+	// result as CoverageDataMerger::Merge on all of them in order. Modules
+	// and files with a new path are moved to the result without copying
+	// their lines. The first time a path is merged, its module or file is
+	// copied to the default heap so the result can grow for a long time.
+	// A moved file keeps the arena of its coverage data alive.
+	//-------------------------------------------------------------------------
+	class CPPCOVERAGE_DLL CoverageDataAccumulator
+	{
+	public:
+		CoverageDataAccumulator();
+		~CoverageDataAccumulator();
+
+		// coverageData is released once merged.
+		void Add(Plugin::CoverageData&& coverageData);
+
+		// Modules and files are sorted by path.
+		const Plugin::CoverageData& GetCoverageData();
+
+		// Return the result and start a new one.
+		Plugin::CoverageData Release();
+
+	private:
+		CoverageDataAccumulator(const CoverageDataAccumulator&) = delete;
+		CoverageDataAccumulator& operator=(const CoverageDataAccumulator&) = delete;
+
+		struct File;
+		struct Module;
+
+		void MergeModule(Module&, std::unique_ptr<Plugin::ModuleCoverage>&&);
+		void AddFile(Module&, std::unique_ptr<Plugin::FileCoverage>&&);
+		void TakeModules();
+		void SortByPath();
+
+		Plugin::CoverageData coverageData_;
+		std::unordered_map<Tools::PathId, std::unique_ptr<Module>> modules_;
+
+		// True when the modules are in coverageData_ sorted by path.
+		bool isSorted_;
+	};
+}
@@ -17,13 +17,19 @@
 #include "stdafx.h"
 #include "CoverageDataMerger.hpp"
 
-#include <functional>
+#include <iterator>
+#include <unordered_map>
+#include <algorithm>
 
 #include "Plugin/Exporter/CoverageData.hpp"
 #include "Plugin/Exporter/ModuleCoverage.hpp"
 #include "Plugin/Exporter/FileCoverage.hpp"
 #include "Plugin/Exporter/LineCoverage.hpp"
 
+#include "Tools/PathInterner.hpp"
+
+#include "CoverageDataAccumulator.hpp"
+
 namespace fs = std::filesystem;
 
 namespace CppCoverage
@@ -44,58 +50,84 @@ namespace CppCoverage
 					lastNotZeroExitCode = exitCode;
 			}
 
+			// The result is often merged again: a monotonic arena would keep
+			// every buffer replaced by a merge.
 			return Plugin::CoverageData{ name, lastNotZeroExitCode };
 		}
 		
 		//---------------------------------------------------------------------
-		template <typename Object, typename Key, typename Child>
-		std::map<Key, std::vector<Child*>> GroupChildrenByKey(
-			const std::vector<Object>& collection,
-			const std::function<const std::vector<std::unique_ptr<Child>>& (const Object&)>& getChildren,
-			const std::function<const Key& (const Child&)>& getKey)
-		{			
-			std::map<Key, std::vector<Child*>> childrenByKey;
-
-			for (const auto& object : collection)
-			{					
-				for (const auto& child : getChildren(object))
-				{
-					const auto& key = getKey(*child);
+		template <typename ChildPtr>
+		using ChildrenByPath = std::vector<std::pair<Tools::PathId, std::vector<ChildPtr>>>;
+
+		//---------------------------------------------------------------------
+		// Group children by interned path and sort the groups by path.
+		template <typename ChildPtr>
+		ChildrenByPath<ChildPtr> GroupChildrenByPath(std::vector<ChildPtr>&& children)
+		{
+			auto& pathInterner = Tools::PathInterner::GetInstance();
+			std::unordered_map<Tools::PathId, std::vector<ChildPtr>> childrenById;
+
+			for (auto& child : children)
+				childrenById[pathInterner.Intern(child->GetPath())].push_back(std::move(child));
+
+			// The paths are looked up once instead of for each comparison.
+			std::vector<std::pair<const fs::path*, Tools::PathId>> paths;
+			paths.reserve(childrenById.size());
+			for (const auto& pair : childrenById)
+				paths.emplace_back(&pathInterner.GetPath(pair.first), pair.first);
+			std::sort(paths.begin(), paths.end(), [](const auto& pair1, const auto& pair2)
+			{
+				return *pair1.first < *pair2.first;
+			});
+
+			// Different strings can still be the same path (separators).
+			ChildrenByPath<ChildPtr> mergedChildrenByPath;
+			const fs::path* previousPath = nullptr;
+			for (const auto& pair : paths)
+			{
+				auto& children = childrenById.at(pair.second);
 
-					childrenByKey[key].push_back(child.get());
+				if (previousPath && *previousPath == *pair.first)
+				{
+					auto& mergedChildren = mergedChildrenByPath.back().second;
+					mergedChildren.insert(mergedChildren.end(), 
+						std::make_move_iterator(children.begin()), 
+						std::make_move_iterator(children.end()));
 				}
+				else
+					mergedChildrenByPath.emplace_back(pair.second, std::move(children));
+				previousPath = pair.first;
 			}
 
-			return childrenByKey;
+			return mergedChildrenByPath;
 		}
-		
+
 		//---------------------------------------------------------------------
-		void AddFileCoverageTo(
-			const Plugin::FileCoverage* sourceFile,
-			Plugin::FileCoverage* destinationFile)
+		std::vector<Plugin::ModuleCoverage*> GetModules(
+			const std::vector<Plugin::CoverageData>& coverageDataCollection)
 		{
-			if (sourceFile && destinationFile)
-			{
-				for (const auto& line : sourceFile->GetLines())
-				{
-					auto lineNumber = line.GetLineNumber();
-					auto hasBeenExecuted = line.HasBeenExecuted();
+			std::vector<Plugin::ModuleCoverage*> modules;
 
-					if (!(*destinationFile)[lineNumber])
-						destinationFile->AddLine(lineNumber, hasBeenExecuted);
-					else if (hasBeenExecuted)
-						destinationFile->UpdateLine(lineNumber, true);
-				}
+			for (const auto& coverageData : coverageDataCollection)
+			{
+				for (const auto& module : coverageData.GetModules())
+					modules.push_back(module.get());
 			}
+			return modules;
 		}
 
 		//---------------------------------------------------------------------
-		void FillFiles(
-			Plugin::FileCoverage& file,
-			const std::vector<Plugin::FileCoverage*>& files)
+		std::vector<Plugin::FileCoverage*> GetFiles(
+			const std::vector<Plugin::ModuleCoverage*>& modules)
 		{
-			for (const auto& f : files)
-				AddFileCoverageTo(f, &file);
+			std::vector<Plugin::FileCoverage*> files;
+
+			for (const auto* module : modules)
+			{
+				for (const auto& file : module->GetFiles())
+					files.push_back(file.get());
+			}
+			return files;
 		}
 
 		//---------------------------------------------------------------------
@@ -103,16 +135,14 @@ namespace CppCoverage
 			Plugin::ModuleCoverage& module,
 			const std::vector<Plugin::ModuleCoverage*>& modules)
 		{
-			std::map<fs::path, std::vector<Plugin::FileCoverage*>> filesByPath =
-				GroupChildrenByKey<Plugin::ModuleCoverage*, fs::path, Plugin::FileCoverage>(
-				modules,
-				[](const Plugin::ModuleCoverage* m) -> const Plugin::ModuleCoverage::T_FileCoverageCollection&{ return m->GetFiles(); },
-				[](const Plugin::FileCoverage& file) -> const fs::path&{ return file.GetPath(); });
+			const auto& pathInterner = Tools::PathInterner::GetInstance();
 
-			for (const auto& pair : filesByPath)
+			for (const auto& pair : GroupChildrenByPath(GetFiles(modules)))
 			{
-				auto& file = module.AddFile(pair.first);
-				FillFiles(file, pair.second);
+				auto& file = module.AddFile(pathInterner.GetPath(pair.first));
+
+				for (const auto* fileToMerge : pair.second)
+					file.MergeLines(*fileToMerge);
 			}
 		}
 
@@ -126,8 +156,9 @@ namespace CppCoverage
 
 				mutableFileCoverages.pop_back();
 				for (const auto* fileCoverage : mutableFileCoverages)
-					AddFileCoverageTo(fileCoverage, fileCoverageSum);
+					fileCoverageSum->MergeLines(*fileCoverage);
 
+				// Assignment shares the lines instead of copying them.
 				for (auto* fileCoverage : mutableFileCoverages)
 					*fileCoverage = *fileCoverageSum;
 			}
@@ -138,39 +169,40 @@ namespace CppCoverage
 	Plugin::CoverageData CoverageDataMerger::Merge(
 		const std::vector<Plugin::CoverageData>& coverageDataCollection) const
 	{
+		const auto& pathInterner = Tools::PathInterner::GetInstance();
 		auto coverageData = CreateCoverageData(coverageDataCollection);
 
-		std::map<fs::path, std::vector<Plugin::ModuleCoverage*>> modulesByPath =
-			GroupChildrenByKey<Plugin::CoverageData, fs::path, Plugin::ModuleCoverage>(
-				coverageDataCollection,
-				[](const Plugin::CoverageData& data) -> const Plugin::CoverageData::T_ModuleCoverageCollection& { return data.GetModules(); },
-				[](const Plugin::ModuleCoverage& module) -> const fs::path& { return module.GetPath(); });
-		
-		for (const auto& pair : modulesByPath)
+		for (const auto& pair : GroupChildrenByPath(GetModules(coverageDataCollection)))
 		{
-			auto& module = coverageData.AddModule(pair.first);
+			auto& module = coverageData.AddModule(pathInterner.GetPath(pair.first));
 			FillModule(module, pair.second);
 		}
 		
 		return coverageData;
 	}
 
+	//-------------------------------------------------------------------------
+	Plugin::CoverageData CoverageDataMerger::Merge(
+		std::vector<Plugin::CoverageData>&& coverageDataCollection) const
+	{
+		CoverageDataAccumulator coverageDataAccumulator;
+
+		for (auto& coverageData : coverageDataCollection)
+			coverageDataAccumulator.Add(std::move(coverageData));
+		coverageDataCollection.clear();
+
+		return coverageDataAccumulator.Release();
+	}
+
 	//-------------------------------------------------------------------------
 	void CoverageDataMerger::MergeFileCoverage(Plugin::CoverageData& coverageData) const
 	{
-		std::map<std::filesystem::path, std::vector<Plugin::FileCoverage*>> fileCoveragesByPath;
+		std::vector<Plugin::ModuleCoverage*> modules;
 
 		for (const auto& module : coverageData.GetModules())
-		{
-			for (const auto& file : module->GetFiles())
-				fileCoveragesByPath[file->GetPath()].push_back(file.get());
-		}
-
-		for (const auto& fileCoverageByPath : fileCoveragesByPath)
-		{
-			const auto& fileCoverages = fileCoverageByPath.second;
+			modules.push_back(module.get());
 
-			MergeFileCoverages(fileCoverages);
-		}
+		for (const auto& fileCoveragesByPath : GroupChildrenByPath(GetFiles(modules)))
+			MergeFileCoverages(fileCoveragesByPath.second);
 	}
 }
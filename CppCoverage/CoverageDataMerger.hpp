@@ -31,6 +31,9 @@ namespace CppCoverage
 		CoverageDataMerger() = default;
 		
 		Plugin::CoverageData Merge(const std::vector<Plugin::CoverageData>&) const;
+
+		// Release each coverage data of the collection once it is merged.
+		Plugin::CoverageData Merge(std::vector<Plugin::CoverageData>&&) const;
 		void MergeFileCoverage(Plugin::CoverageData&) const;
 
 	private:
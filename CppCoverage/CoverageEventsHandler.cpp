@@ -0,0 +1,214 @@
+// OpenCppCoverage is an open source code coverage for C++.
+// Copyright (C) 2019 OpenCppCoverage
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "stdafx.h"
+#include "CoverageEventsHandler.hpp"
+
+#include <sstream>
+
+#include "tools/Log.hpp"
+
+#include "Address.hpp"
+#include "BreakPoint.hpp"
+#include "CoverageFilterManager.hpp"
+#include "DebugInformationEnumerator.hpp"
+#include "ExceptionHandler.hpp"
+#include "ExecutedAddressManager.hpp"
+#include "FilterAssistant.hpp"
+#include "HandleInformation.hpp"
+#include "LineTableCache.hpp"
+#include "MonitoredLineRegister.hpp"
+
+namespace CppCoverage
+{
+	namespace
+	{
+		//---------------------------------------------------------------------
+		bool IsBreakPointException(const EXCEPTION_DEBUG_INFO& exceptionDebugInfo)
+		{
+			auto exceptionCode = exceptionDebugInfo.ExceptionRecord.ExceptionCode;
+
+			return exceptionDebugInfo.dwFirstChance &&
+				(exceptionCode == EXCEPTION_BREAKPOINT ||
+				 exceptionCode == static_cast<DWORD>(ExceptionHandler::ExceptionEmulationX86ErrorCode));
+		}
+	}
+
+	//-------------------------------------------------------------------------
+	CoverageEventsHandler::CoverageEventsHandler(
+		std::shared_ptr<BreakPoint> breakpoint,
+		std::shared_ptr<CoverageFilterManager> coverageFilterManager,
+		std::shared_ptr<FilterAssistant> filterAssistant,
+		std::unique_ptr<DebugInformationEnumerator> debugInformationEnumerator,
+		std::shared_ptr<LineTableCache> lineTableCache,
+		bool basicBlockBreakPoints,
+		size_t ignoredBreakPointCount,
+		DebuggeeRunningHandler debuggeeRunningHandler)
+		: breakpoint_{ breakpoint }
+		, coverageFilterManager_{ coverageFilterManager }
+		, filterAssistant_{ filterAssistant }
+		, executedAddressManager_{ std::make_shared<ExecutedAddressManager>() }
+		, monitoredLineRegister_{ std::make_unique<MonitoredLineRegister>(
+			breakpoint,
+			executedAddressManager_,
+			coverageFilterManager,
+			std::move(debugInformationEnumerator),
+			filterAssistant,
+			std::move(lineTableCache),
+			basicBlockBreakPoints) }
+		, exceptionHandler_{ std::make_unique<ExceptionHandler>(ignoredBreakPointCount) }
+		, debuggeeRunningHandler_{ std::move(debuggeeRunningHandler) }
+	{
+	}
+
+	//-------------------------------------------------------------------------
+	CoverageEventsHandler::~CoverageEventsHandler()
+	{
+	}
+
+	//-------------------------------------------------------------------------
+	ExecutedAddressManager& CoverageEventsHandler::GetExecutedAddressManager()
+	{
+		return *executedAddressManager_;
+	}
+
+	//-------------------------------------------------------------------------
+	void CoverageEventsHandler::OnCreateProcess(const CREATE_PROCESS_DEBUG_INFO& processDebugInfo)
+	{
+		auto hProcess = processDebugInfo.hProcess;
+		auto lpBaseOfImage = processDebugInfo.lpBaseOfImage;
+
+		LoadModule(hProcess, processDebugInfo.hFile, lpBaseOfImage);
+	}
+
+	//-------------------------------------------------------------------------
+	void CoverageEventsHandler::OnExitProcess(HANDLE hProcess, HANDLE, const EXIT_PROCESS_DEBUG_INFO&)
+	{
+		exceptionHandler_->OnExitProcess(hProcess);
+		executedAddressManager_->OnExitProcess(hProcess);
+	}
+
+	//-------------------------------------------------------------------------
+	void CoverageEventsHandler::OnDebuggeeRunning()
+	{
+		if (debuggeeRunningHandler_)
+			debuggeeRunningHandler_(*executedAddressManager_);
+	}
+
+	//-------------------------------------------------------------------------
+	void CoverageEventsHandler::OnLoadDll(
+		HANDLE hProcess,
+		HANDLE hThread,
+		const LOAD_DLL_DEBUG_INFO& dllDebugInfo)
+	{
+		LoadModule(hProcess, dllDebugInfo.hFile, dllDebugInfo.lpBaseOfDll);
+	}
+
+	//-------------------------------------------------------------------------
+	void CoverageEventsHandler::OnUnloadDll(
+		HANDLE hProcess,
+		HANDLE hThread,
+		const UNLOAD_DLL_DEBUG_INFO& unloadDllDebugInfo)
+	{
+		executedAddressManager_->OnUnloadModule(hProcess, unloadDllDebugInfo.lpBaseOfDll);
+	}
+
+	//-------------------------------------------------------------------------
+	IDebugEventsHandler::ExceptionType CoverageEventsHandler::OnException(
+		HANDLE hProcess,
+		HANDLE hThread,
+		const EXCEPTION_DEBUG_INFO& exceptionDebugInfo)
+	{
+		// Check the coverage breakpoints first: the breakpoints ignored by
+		// ExceptionHandler are never set by OpenCppCoverage.
+		if (IsBreakPointException(exceptionDebugInfo) &&
+			OnBreakPoint(exceptionDebugInfo, hProcess, hThread))
+		{
+			return IDebugEventsHandler::ExceptionType::BreakPoint;
+		}
+
+		std::wostringstream ostr;
+
+		auto status = exceptionHandler_->HandleException(hProcess, exceptionDebugInfo, ostr);
+
+		switch (status)
+		{
+		case CppCoverage::ExceptionHandlerStatus::BreakPoint:
+		{
+			return IDebugEventsHandler::ExceptionType::InvalidBreakPoint;
+		}
+		case CppCoverage::ExceptionHandlerStatus::FirstChanceException:
+		{
+			return IDebugEventsHandler::ExceptionType::NotHandled;
+		}
+		case CppCoverage::ExceptionHandlerStatus::Error:
+		{
+			LOG_ERROR << ostr.str();
+
+			return IDebugEventsHandler::ExceptionType::Error;
+		}
+		case CppCoverage::ExceptionHandlerStatus::CppError:
+		{
+			LOG_ERROR << ostr.str();
+
+			return IDebugEventsHandler::ExceptionType::CppError;
+		}
+		}
+
+		return IDebugEventsHandler::ExceptionType::NotHandled;
+	}
+
+	//-------------------------------------------------------------------------
+	bool CoverageEventsHandler::OnBreakPoint(
+		const EXCEPTION_DEBUG_INFO& exceptionDebugInfo,
+		HANDLE hProcess,
+		HANDLE hThread)
+	{
+		const auto& exceptionRecord = exceptionDebugInfo.ExceptionRecord;
+		auto addressValue = exceptionRecord.ExceptionAddress;
+		Address address{ hProcess, addressValue };
+		auto oldInstruction = executedAddressManager_->MarkAddressAsExecuted(address);
+
+		if (oldInstruction)
+		{
+			breakpoint_->RemoveBreakPoint(address, *oldInstruction);
+			breakpoint_->AdjustEipAfterBreakPointRemoval(hThread);
+			return true;
+		}
+
+		return false;
+	}
+
+	//-------------------------------------------------------------------------
+	void CoverageEventsHandler::LoadModule(HANDLE hProcess,
+		HANDLE hFile,
+		void* baseOfImage)
+	{
+		HandleInformation handleInformation;
+
+		std::wstring filename = handleInformation.ComputeFilename(hFile);
+
+		auto isSelected = coverageFilterManager_->IsModuleSelected(filename);
+
+		if (isSelected)
+		{
+			isSelected = monitoredLineRegister_->RegisterLineToMonitor(
+				filename, hProcess, baseOfImage);
+		}
+
+		filterAssistant_->OnNewModule(filename, isSelected);
+	}
+}
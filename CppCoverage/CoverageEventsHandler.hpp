@@ -0,0 +1,79 @@
+// OpenCppCoverage is an open source code coverage for C++.
+// Copyright (C) 2019 OpenCppCoverage
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <functional>
+#include <memory>
+
+#include "IDebugEventsHandler.hpp"
+
+namespace CppCoverage
+{
+	class BreakPoint;
+	class CoverageFilterManager;
+	class DebugInformationEnumerator;
+	class ExceptionHandler;
+	class ExecutedAddressManager;
+	class FilterAssistant;
+	class LineTableCache;
+	class MonitoredLineRegister;
+
+	// Collect the coverage of the processes debugged by one Debugger.
+	// Several instances can run on different threads: the filters shared
+	// between them are thread safe. The executed address manager and the
+	// debug information enumerator belong to one instance.
+	class CoverageEventsHandler : public IDebugEventsHandler
+	{
+	public:
+		using DebuggeeRunningHandler = std::function<void(ExecutedAddressManager&)>;
+
+		CoverageEventsHandler(
+			std::shared_ptr<BreakPoint>,
+			std::shared_ptr<CoverageFilterManager>,
+			std::shared_ptr<FilterAssistant>,
+			std::unique_ptr<DebugInformationEnumerator>,
+			std::shared_ptr<LineTableCache>,
+			bool basicBlockBreakPoints,
+			size_t ignoredBreakPointCount,
+			DebuggeeRunningHandler);
+		~CoverageEventsHandler();
+
+		ExecutedAddressManager& GetExecutedAddressManager();
+
+		void OnCreateProcess(const CREATE_PROCESS_DEBUG_INFO&) override;
+		void OnExitProcess(HANDLE hProcess, HANDLE hThread, const EXIT_PROCESS_DEBUG_INFO&) override;
+		void OnLoadDll(HANDLE hProcess, HANDLE hThread, const LOAD_DLL_DEBUG_INFO&) override;
+		void OnUnloadDll(HANDLE hProcess, HANDLE hThread, const UNLOAD_DLL_DEBUG_INFO&) override;
+		ExceptionType OnException(HANDLE hProcess, HANDLE hThread, const EXCEPTION_DEBUG_INFO&) override;
+		void OnDebuggeeRunning() override;
+
+	private:
+		CoverageEventsHandler(const CoverageEventsHandler&) = delete;
+		CoverageEventsHandler& operator=(const CoverageEventsHandler&) = delete;
+
+		void LoadModule(HANDLE hProcess, HANDLE hFile, void* baseOfImage);
+		bool OnBreakPoint(const EXCEPTION_DEBUG_INFO&, HANDLE hProcess, HANDLE hThread);
+
+		const std::shared_ptr<BreakPoint> breakpoint_;
+		const std::shared_ptr<CoverageFilterManager> coverageFilterManager_;
+		const std::shared_ptr<FilterAssistant> filterAssistant_;
+		const std::shared_ptr<ExecutedAddressManager> executedAddressManager_;
+		const std::unique_ptr<MonitoredLineRegister> monitoredLineRegister_;
+		const std::unique_ptr<ExceptionHandler> exceptionHandler_;
+		const DebuggeeRunningHandler debuggeeRunningHandler_;
+	};
+}
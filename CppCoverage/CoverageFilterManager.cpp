@@ -27,6 +27,23 @@
 
 namespace CppCoverage
 {
+	//-------------------------------------------------------------------------
+	struct CoverageFilterManager::LineFilters
+	{
+		//---------------------------------------------------------------------
+		LineFilters(
+			const std::vector<std::wstring>& excludedLineRegexes,
+			bool useReleaseCoverageFilter)
+			: lineFilter_{ excludedLineRegexes }
+			, optionalReleaseCoverageFilter_{ useReleaseCoverageFilter ?
+				std::make_unique<FileFilter::ReleaseCoverageFilter>() : nullptr }
+		{
+		}
+
+		FileFilter::LineFilter lineFilter_;
+		const std::unique_ptr<FileFilter::ReleaseCoverageFilter> optionalReleaseCoverageFilter_;
+	};
+
 	//-------------------------------------------------------------------------
 	CoverageFilterManager::CoverageFilterManager(
 		const CoverageFilterSettings& settings,
@@ -34,10 +51,10 @@ namespace CppCoverage
 		const std::vector<std::wstring>& excludedLineRegexes,
 		bool useReleaseCoverageFilter)
 		: wildcardCoverageFilter_{ settings }
+		, hasUnifiedDiff_{ !unifiedDiffSettingsCollection.empty() }
 		, unifiedDiffCoverageFilterManager_{ unifiedDiffSettingsCollection }
-		, lineFilter_{ excludedLineRegexes }
-		, optionalReleaseCoverageFilter_{ useReleaseCoverageFilter ?
-			std::make_unique<FileFilter::ReleaseCoverageFilter>() : nullptr }		
+		, excludedLineRegexes_{ excludedLineRegexes }
+		, useReleaseCoverageFilter_{ useReleaseCoverageFilter }
 	{
 	}
 
@@ -53,10 +70,25 @@ namespace CppCoverage
 	//-------------------------------------------------------------------------
 	bool CoverageFilterManager::IsSourceFileSelected(const std::wstring& filename)
 	{
-		if (!wildcardCoverageFilter_.IsSourceFileSelected(filename))
-			return false;
+		// Most source files (headers) are shared between modules.
+		auto id = Tools::PathInterner::GetInstance().Intern(filename);
+		{
+			std::shared_lock<std::shared_mutex> lock{ sourceFileMutex_ };
+			auto it = isSourceFileSelectedById_.find(id);
+
+			if (it != isSourceFileSelectedById_.end())
+				return it->second;
+		}
 
-		return unifiedDiffCoverageFilterManager_.IsSourceFileSelected(filename);
+		auto isSelected = wildcardCoverageFilter_.IsSourceFileSelected(filename);
+		if (isSelected)
+		{
+			std::lock_guard<std::mutex> lock{ unifiedDiffMutex_ };
+			isSelected = unifiedDiffCoverageFilterManager_.IsSourceFileSelected(filename);
+		}
+
+		std::lock_guard<std::shared_mutex> lock{ sourceFileMutex_ };
+		return isSourceFileSelectedById_.emplace(id, isSelected).first->second;
 	}
 
 	//-------------------------------------------------------------------------
@@ -65,21 +97,48 @@ namespace CppCoverage
 		const FileFilter::FileInfo& fileInfo,
 		const FileFilter::LineInfo& lineInfo)
 	{
-		if (optionalReleaseCoverageFilter_ &&
-			!optionalReleaseCoverageFilter_->IsLineSelected(moduleInfo, fileInfo, lineInfo))
+		auto& lineFilters = GetLineFilters();
+		const auto& optionalReleaseCoverageFilter = lineFilters.optionalReleaseCoverageFilter_;
+
+		if (optionalReleaseCoverageFilter &&
+			!optionalReleaseCoverageFilter->IsLineSelected(moduleInfo, fileInfo, lineInfo))
 		{
 			return false;
 		}
 
-		if (!lineFilter_.IsLineSelected(fileInfo, lineInfo))
+		if (!lineFilters.lineFilter_.IsLineSelected(fileInfo, lineInfo))
 			return false;
 
+		if (!hasUnifiedDiff_)
+			return true;
+
+		std::lock_guard<std::mutex> lock{ unifiedDiffMutex_ };
 		return unifiedDiffCoverageFilterManager_.IsLineSelected(fileInfo, lineInfo);
 	}
 
 	//-------------------------------------------------------------------------
 	std::vector<std::wstring> CoverageFilterManager::ComputeWarningMessageLines(size_t maxUnmatchPaths) const
 	{
+		std::lock_guard<std::mutex> lock{ unifiedDiffMutex_ };
 		return unifiedDiffCoverageFilterManager_.ComputeWarningMessageLines(maxUnmatchPaths);
 	}
+
+	//-------------------------------------------------------------------------
+	CoverageFilterManager::LineFilters& CoverageFilterManager::GetLineFilters()
+	{
+		auto threadId = std::this_thread::get_id();
+		{
+			std::shared_lock<std::shared_mutex> lock{ lineFiltersMutex_ };
+			auto it = lineFiltersByThread_.find(threadId);
+
+			if (it != lineFiltersByThread_.end())
+				return *it->second;
+		}
+
+		std::lock_guard<std::shared_mutex> lock{ lineFiltersMutex_ };
+		auto& lineFilters = lineFiltersByThread_[threadId];
+		if (!lineFilters)
+			lineFilters = std::make_unique<LineFilters>(excludedLineRegexes_, useReleaseCoverageFilter_);
+		return *lineFilters;
+	}
 }
@@ -17,12 +17,17 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <unordered_map>
 
 #include "CppCoverageExport.hpp"
 #include "WildcardCoverageFilter.hpp"
 #include "ICoverageFilterManager.hpp"
 #include "UnifiedDiffCoverageFilterManager.hpp"
 #include "FileFilter/LineFilter.hpp"
+#include "Tools/PathInterner.hpp"
 
 namespace FileFilter
 {
@@ -34,6 +39,8 @@ namespace CppCoverage
 	class CoverageFilterSettings;
 	class UnifiedDiffSettings;
 
+	// Can be used by several threads. The line filters keep the last file
+	// read so each thread has its own line filters.
 	class CPPCOVERAGE_DLL CoverageFilterManager: public ICoverageFilterManager
 	{
 	public:
@@ -58,10 +65,20 @@ namespace CppCoverage
 		CoverageFilterManager(const CoverageFilterManager&) = delete;
 		CoverageFilterManager& operator=(const CoverageFilterManager&) = delete;
 
+		struct LineFilters;
+		LineFilters& GetLineFilters();
+
 		const WildcardCoverageFilter wildcardCoverageFilter_;
+		const bool hasUnifiedDiff_;
 		UnifiedDiffCoverageFilterManager unifiedDiffCoverageFilterManager_;
-		FileFilter::LineFilter lineFilter_;
+		mutable std::mutex unifiedDiffMutex_;
+
+		const std::vector<std::wstring> excludedLineRegexes_;
+		const bool useReleaseCoverageFilter_;
+		std::unordered_map<std::thread::id, std::unique_ptr<LineFilters>> lineFiltersByThread_;
+		std::shared_mutex lineFiltersMutex_;
 
-		const std::unique_ptr<FileFilter::ReleaseCoverageFilter> optionalReleaseCoverageFilter_;
+		std::unordered_map<Tools::PathId, bool> isSourceFileSelectedById_;
+		std::shared_mutex sourceFileMutex_;
 	};
 }
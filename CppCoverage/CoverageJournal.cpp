@@ -0,0 +1,275 @@
+// OpenCppCoverage is an open source code coverage for C++.
+// Copyright (C) 2019 OpenCppCoverage
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "stdafx.h"
+#include "CoverageJournal.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "Plugin/Exporter/CoverageData.hpp"
+
+#include "Tools/BinaryStream.hpp"
+#include "Tools/Log.hpp"
+#include "Tools/PathInterner.hpp"
+#include "Tools/WorkQueue.hpp"
+
+#include "CppCoverageException.hpp"
+
+namespace CppCoverage
+{
+	namespace
+	{
+		// Layout: Magic, Version, name, {RecordType, record}*
+		// Path record: varint id, path
+		// Lines record (one per file): varint moduleId, varint fileId,
+		// varint count, {varint delta from the previous line number}*
+		const uint32_t Magic = 0x4A43434F; // OCCJ
+		const uint32_t Version = 3;
+
+		enum class RecordType : uint8_t
+		{
+			Path = 1,
+			RegisteredLines = 2,
+			ExecutedLines = 3
+		};
+
+		//---------------------------------------------------------------------
+		bool ReadPathId(
+			Tools::BinaryReader& reader,
+			const std::unordered_map<uint64_t, Tools::PathId>& pathIds,
+			Tools::PathId& pathId)
+		{
+			uint64_t id;
+
+			if (!reader.ReadVarint(id))
+				return false;
+			auto it = pathIds.find(id);
+			if (it == pathIds.end())
+				return false;
+			pathId = it->second;
+			return true;
+		}
+
+		//---------------------------------------------------------------------
+		bool ReadLines(
+			Tools::BinaryReader& reader,
+			const std::unordered_map<uint64_t, Tools::PathId>& pathIds,
+			std::vector<ExecutedAddressManager::LineChange>& lines)
+		{
+			Tools::PathId moduleId;
+			Tools::PathId fileId;
+			uint64_t count;
+
+			if (!ReadPathId(reader, pathIds, moduleId)
+				|| !ReadPathId(reader, pathIds, fileId)
+				|| !reader.ReadVarint(count))
+			{
+				return false;
+			}
+
+			// A delta takes at least one byte: count is bounded by the file size.
+			if (!reader.CanRead(count))
+				return false;
+
+			std::vector<ExecutedAddressManager::LineChange> fileLines;
+			uint64_t lineNumber = 0;
+
+			fileLines.reserve(static_cast<size_t>(count));
+			for (uint64_t i = 0; i < count; ++i)
+			{
+				uint64_t delta;
+
+				if (!reader.ReadVarint(delta))
+					return false;
+				lineNumber += delta;
+				if (lineNumber > std::numeric_limits<unsigned int>::max())
+					return false;
+				fileLines.push_back({ moduleId, fileId, static_cast<unsigned int>(lineNumber) });
+			}
+			lines.insert(lines.end(), fileLines.begin(), fileLines.end());
+			return true;
+		}
+	}
+
+	//-------------------------------------------------------------------------
+	struct CoverageJournal::Writer
+	{
+		Writer(const std::filesystem::path& path, const std::wstring& name)
+			: path_{ path }
+			, ostr_{ path, std::ios::binary | std::ios::trunc }
+			, writer_{ ostr_ }
+		{
+			if (!ostr_)
+				THROW(L"Cannot open coverage journal " << path.wstring());
+			writer_.Write(Magic);
+			writer_.Write(Version);
+			writer_.WriteString(name);
+			ostr_.flush();
+		}
+
+		void WriteBatch(const ExecutedAddressManager::LineChanges& lineChanges)
+		{
+			WritePaths(lineChanges.registeredLines);
+			WriteLines(RecordType::RegisteredLines, lineChanges.registeredLines);
+			WriteLines(RecordType::ExecutedLines, lineChanges.executedLines);
+			ostr_.flush();
+			if (!ostr_)
+				THROW(L"Cannot write coverage journal " << path_.wstring());
+		}
+
+		void WritePaths(const std::vector<ExecutedAddressManager::LineChange>& lines)
+		{
+			const auto& pathInterner = Tools::PathInterner::GetInstance();
+
+			for (const auto& line : lines)
+			{
+				for (auto id : { line.moduleId, line.fileId })
+				{
+					if (writtenPathIds_.insert(id).second)
+					{
+						writer_.Write(RecordType::Path);
+						writer_.WriteVarint(id);
+						writer_.WriteString(pathInterner.GetPath(id).wstring());
+					}
+				}
+			}
+		}
+
+		void WriteLines(
+			RecordType recordType,
+			const std::vector<ExecutedAddressManager::LineChange>& lines)
+		{
+			std::map<std::pair<Tools::PathId, Tools::PathId>, std::vector<unsigned int>> files;
+
+			for (const auto& line : lines)
+				files[{ line.moduleId, line.fileId }].push_back(line.lineNumber);
+
+			for (auto& file : files)
+			{
+				auto& lineNumbers = file.second;
+
+				std::sort(lineNumbers.begin(), lineNumbers.end());
+				lineNumbers.erase(
+					std::unique(lineNumbers.begin(), lineNumbers.end()),
+					lineNumbers.end());
+
+				writer_.Write(recordType);
+				writer_.WriteVarint(file.first.first);
+				writer_.WriteVarint(file.first.second);
+				writer_.WriteVarint(lineNumbers.size());
+
+				unsigned int previousLineNumber = 0;
+				for (auto lineNumber : lineNumbers)
+				{
+					writer_.WriteVarint(lineNumber - previousLineNumber);
+					previousLineNumber = lineNumber;
+				}
+			}
+		}
+
+		const std::filesystem::path path_;
+		std::ofstream ostr_;
+		Tools::BinaryWriter writer_;
+		std::unordered_set<Tools::PathId> writtenPathIds_;
+	};
+
+	//-------------------------------------------------------------------------
+	const std::chrono::milliseconds CoverageJournal::FlushInterval{ 500 };
+
+	//-------------------------------------------------------------------------
+	CoverageJournal::CoverageJournal(
+		const std::filesystem::path& path,
+		const std::wstring& name)
+		: writer_{ std::make_unique<Writer>(path, name) }
+		, workQueue_{ std::make_unique<Tools::WorkQueue>() }
+	{
+		LOG_INFO << L"Coverage journal: " << path.wstring();
+	}
+
+	//-------------------------------------------------------------------------
+	CoverageJournal::~CoverageJournal()
+	{
+	}
+
+	//-------------------------------------------------------------------------
+	void CoverageJournal::Append(ExecutedAddressManager::LineChanges&& lineChanges)
+	{
+		if (lineChanges.registeredLines.empty() && lineChanges.executedLines.empty())
+			return;
+
+		auto batch = std::make_shared<ExecutedAddressManager::LineChanges>(
+			std::move(lineChanges));
+		workQueue_->Push([writer = writer_.get(), batch]() {
+			writer->WriteBatch(*batch);
+		});
+	}
+
+	//-------------------------------------------------------------------------
+	Plugin::CoverageData CoverageJournal::Recover(const std::filesystem::path& path)
+	{
+		std::ifstream istr{ path, std::ios::binary };
+		Tools::BinaryReader reader{ istr };
+		uint32_t magic = 0;
+		uint32_t version = 0;
+		std::wstring name;
+
+		if (!istr || !reader.Read(magic) || magic != Magic)
+			THROW(L"Invalid coverage journal " << path.wstring());
+		if (!reader.Read(version) || version != Version)
+			THROW(L"Unsupported coverage journal version " << version);
+		if (!reader.ReadString(name))
+			THROW(L"Invalid coverage journal " << path.wstring());
+
+		auto& pathInterner = Tools::PathInterner::GetInstance();
+		std::unordered_map<uint64_t, Tools::PathId> pathIds;
+		ExecutedAddressManager::LineChanges lineChanges;
+		RecordType recordType;
+
+		while (reader.Read(recordType))
+		{
+			bool isComplete = false;
+
+			if (recordType == RecordType::Path)
+			{
+				uint64_t id;
+				std::wstring pathStr;
+
+				isComplete = reader.ReadVarint(id) && reader.ReadString(pathStr);
+				if (isComplete)
+					pathIds[id] = pathInterner.Intern(pathStr);
+			}
+			else if (recordType == RecordType::RegisteredLines)
+				isComplete = ReadLines(reader, pathIds, lineChanges.registeredLines);
+			else if (recordType == RecordType::ExecutedLines)
+				isComplete = ReadLines(reader, pathIds, lineChanges.executedLines);
+
+			if (!isComplete)
+			{
+				LOG_WARNING << L"Coverage journal " << path.wstring()
+					<< L" is truncated or corrupted. The remaining records are ignored.";
+				break;
+			}
+		}
+
+		return ExecutedAddressManager::CreateCoverageData(name, lineChanges);
+	}
+}
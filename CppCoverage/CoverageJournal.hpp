@@ -0,0 +1,63 @@
+// OpenCppCoverage is an open source code coverage for C++.
+// Copyright (C) 2019 OpenCppCoverage
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#pragma once
+
+#include <chrono>
+#include <filesystem>
+#include <memory>
+#include <string>
+
+#include "ExecutedAddressManager.hpp"
+#include "CppCoverageExport.hpp"
+
+namespace Tools
+{
+	class WorkQueue;
+}
+
+namespace CppCoverage
+{
+	// Append-only journal of the registered and executed lines. It is written
+	// in batches on a background thread and flushed after each batch so the
+	// coverage of a killed run can be recovered with Recover.
+	class CPPCOVERAGE_DLL CoverageJournal
+	{
+	public:
+		// Delay between two batches.
+		static const std::chrono::milliseconds FlushInterval;
+
+		CoverageJournal(const std::filesystem::path&, const std::wstring& name);
+
+		// Wait for the pending batches.
+		~CoverageJournal();
+
+		void Append(ExecutedAddressManager::LineChanges&&);
+
+		// Read all complete records. A truncated or corrupted tail is ignored.
+		static Plugin::CoverageData Recover(const std::filesystem::path&);
+
+	private:
+		CoverageJournal(const CoverageJournal&) = delete;
+		CoverageJournal& operator=(const CoverageJournal&) = delete;
+
+		struct Writer;
+
+		std::unique_ptr<Writer> writer_;
+		std::unique_ptr<Tools::WorkQueue> workQueue_;
+	};
+}
@@ -29,16 +29,8 @@ namespace CppCoverage
 		//---------------------------------------------------------------------
 		CoverageRate ComputeFileCoverage(const Plugin::FileCoverage& file)
 		{
-			int executedLines = 0;
-			int unexecutedLines = 0;
-
-			for (const auto& lineCoverage : file.GetLines())
-			{
-				if (lineCoverage.HasBeenExecuted())
-					++executedLines;
-				else
-					++unexecutedLines;
-			}
+			auto executedLines = static_cast<int>(file.GetExecutedLineCount());
+			auto unexecutedLines = static_cast<int>(file.GetLineCount()) - executedLines;
 
 			return CoverageRate{executedLines, unexecutedLines};
 		}
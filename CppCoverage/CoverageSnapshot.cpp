@@ -0,0 +1,111 @@
+// OpenCppCoverage is an open source code coverage for C++.
+// Copyright (C) 2019 OpenCppCoverage
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "stdafx.h"
+#include "CoverageSnapshot.hpp"
+
+#include "Plugin/Exporter/CoverageData.hpp"
+
+#include "Tools/Log.hpp"
+#include "Tools/Tool.hpp"
+#include "Tools/WorkQueue.hpp"
+
+namespace CppCoverage
+{
+	//-------------------------------------------------------------------------
+	const std::chrono::milliseconds CoverageSnapshot::PollInterval{ 500 };
+
+	//-------------------------------------------------------------------------
+	CoverageSnapshot::CoverageSnapshot(
+		const std::wstring& name,
+		const SnapshotSettings& settings,
+		SnapshotHandler handler)
+		: name_{ name }
+		, settings_{ settings }
+		, handler_{ std::move(handler) }
+		, workQueue_{ std::make_unique<Tools::WorkQueue>() }
+	{
+		auto now = std::chrono::steady_clock::now();
+
+		nextSnapshot_ = now + settings_.GetInterval().value_or(std::chrono::seconds{ 0 });
+		nextTriggerCheck_ = now;
+	}
+
+	//-------------------------------------------------------------------------
+	CoverageSnapshot::~CoverageSnapshot()
+	{
+	}
+
+	//-------------------------------------------------------------------------
+	bool CoverageSnapshot::IsDue()
+	{
+		auto now = std::chrono::steady_clock::now();
+		const auto& interval = settings_.GetInterval();
+
+		if (interval && now >= nextSnapshot_)
+		{
+			nextSnapshot_ = now + *interval;
+			return true;
+		}
+		return IsTriggered(now);
+	}
+
+	//-------------------------------------------------------------------------
+	bool CoverageSnapshot::IsTriggered(std::chrono::steady_clock::time_point now)
+	{
+		const auto& triggerFile = settings_.GetTriggerFile();
+
+		if (!triggerFile || now < nextTriggerCheck_)
+			return false;
+
+		nextTriggerCheck_ = now + PollInterval;
+		if (!Tools::FileExists(*triggerFile))
+			return false;
+
+		std::error_code error;
+		std::filesystem::remove(*triggerFile, error);
+		if (error)
+			LOG_WARNING << L"Cannot remove " << triggerFile->wstring();
+		return true;
+	}
+
+	//-------------------------------------------------------------------------
+	void CoverageSnapshot::AddLineChanges(
+		const ExecutedAddressManager::LineChanges& lineChanges)
+	{
+		auto append = [](auto& destination, const auto& source) {
+			destination.insert(destination.end(), source.begin(), source.end());
+		};
+
+		append(lineChanges_.registeredLines, lineChanges.registeredLines);
+		append(lineChanges_.executedLines, lineChanges.executedLines);
+	}
+
+	//-------------------------------------------------------------------------
+	void CoverageSnapshot::Take()
+	{
+		auto lineChanges = std::make_shared<ExecutedAddressManager::LineChanges>();
+
+		std::swap(*lineChanges, lineChanges_);
+		if (lineChanges->registeredLines.empty() && lineChanges->executedLines.empty())
+			return;
+
+		workQueue_->Push([this, lineChanges]() {
+			handler_(ExecutedAddressManager::CreateCoverageData(name_, *lineChanges));
+		});
+	}
+}
@@ -0,0 +1,76 @@
+// OpenCppCoverage is an open source code coverage for C++.
+// Copyright (C) 2019 OpenCppCoverage
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <string>
+
+#include "ExecutedAddressManager.hpp"
+#include "SnapshotSettings.hpp"
+#include "CppCoverageExport.hpp"
+
+namespace Tools
+{
+	class WorkQueue;
+}
+
+namespace CppCoverage
+{
+	// Build coverage snapshots while the debuggees are running. Each snapshot
+	// only contains the lines registered or executed since the previous one:
+	// merging all of them gives the coverage at the time of the last snapshot.
+	class CPPCOVERAGE_DLL CoverageSnapshot
+	{
+	public:
+		// Maximum delay before a due snapshot or a trigger file is noticed.
+		static const std::chrono::milliseconds PollInterval;
+
+		CoverageSnapshot(
+			const std::wstring& name,
+			const SnapshotSettings&,
+			SnapshotHandler);
+
+		// Wait for the pending snapshots.
+		~CoverageSnapshot();
+
+		// Cheap when no snapshot is due.
+		bool IsDue();
+
+		// Accumulate the changes until the next snapshot.
+		void AddLineChanges(const ExecutedAddressManager::LineChanges&);
+
+		// The coverage data is built and given to the handler on a
+		// background thread.
+		void Take();
+
+	private:
+		CoverageSnapshot(const CoverageSnapshot&) = delete;
+		CoverageSnapshot& operator=(const CoverageSnapshot&) = delete;
+
+		bool IsTriggered(std::chrono::steady_clock::time_point now);
+
+		const std::wstring name_;
+		const SnapshotSettings settings_;
+		const SnapshotHandler handler_;
+		ExecutedAddressManager::LineChanges lineChanges_;
+		std::chrono::steady_clock::time_point nextSnapshot_;
+		std::chrono::steady_clock::time_point nextTriggerCheck_;
+		std::unique_ptr<Tools::WorkQueue> workQueue_;
+	};
+}
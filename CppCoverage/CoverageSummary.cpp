@@ -0,0 +1,253 @@
+// OpenCppCoverage is an open source code coverage for C++.
+// Copyright (C) 2019 OpenCppCoverage
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "stdafx.h"
+#include "CoverageSummary.hpp"
+
+#include <algorithm>
+#include <iomanip>
+#include <ostream>
+#include <sstream>
+
+#include "Tools/Tool.hpp"
+
+namespace CppCoverage
+{
+	namespace
+	{
+		//---------------------------------------------------------------------
+		CoverageSummary::Lines MergeLines(
+			const CoverageSummary::Lines& lines1,
+			const CoverageSummary::Lines& lines2)
+		{
+			CoverageSummary::Lines lines;
+			auto it1 = lines1.begin();
+			auto it2 = lines2.begin();
+
+			lines.reserve(std::max(lines1.size(), lines2.size()));
+			while (it1 != lines1.end() || it2 != lines2.end())
+			{
+				if (it2 == lines2.end() || (it1 != lines1.end() && it1->first < it2->first))
+					lines.push_back(*it1++);
+				else if (it1 == lines1.end() || it2->first < it1->first)
+					lines.push_back(*it2++);
+				else
+				{
+					lines.emplace_back(it1->first, it1->second || it2->second);
+					++it1;
+					++it2;
+				}
+			}
+			return lines;
+		}
+
+		//---------------------------------------------------------------------
+		CoverageRate ComputeCoverageRate(const CoverageSummary::Lines& lines)
+		{
+			auto executedLineCount = std::count_if(lines.begin(), lines.end(),
+				[](const auto& line) { return line.second; });
+
+			return CoverageRate{
+				static_cast<int>(executedLineCount),
+				static_cast<int>(lines.size() - executedLineCount) };
+		}
+
+		//---------------------------------------------------------------------
+		template <typename Char>
+		void WriteRate(std::basic_ostream<Char>& ostr, const CoverageRate& coverageRate)
+		{
+			std::basic_ostringstream<Char> rate;
+
+			rate << std::fixed << std::setprecision(2) << coverageRate.GetRate() * 100;
+			ostr << rate.str();
+		}
+
+		//---------------------------------------------------------------------
+		void WriteTextRate(
+			std::wostream& ostr,
+			const std::wstring& title,
+			const CoverageRate& coverageRate)
+		{
+			ostr << title << L": " << coverageRate.GetExecutedLinesCount()
+				<< L'/' << coverageRate.GetTotalLinesCount() << L" (";
+			WriteRate(ostr, coverageRate);
+			ostr << L"%)" << std::endl;
+		}
+
+		//---------------------------------------------------------------------
+		std::string EscapeJson(const std::filesystem::path& path)
+		{
+			std::ostringstream ostr;
+
+			for (unsigned char c : Tools::ToUtf8String(path.wstring()))
+			{
+				if (c == '"' || c == '\\')
+					ostr << '\\' << c;
+				else if (c < 0x20)
+					ostr << "\\u" << std::hex << std::setw(4) << std::setfill('0') << int{ c };
+				else
+					ostr << c;
+			}
+			return ostr.str();
+		}
+
+		//---------------------------------------------------------------------
+		void WriteJsonRate(std::ostream& ostr, const CoverageRate& coverageRate)
+		{
+			ostr << "\"lineCount\":" << coverageRate.GetTotalLinesCount()
+				<< ",\"executedLineCount\":" << coverageRate.GetExecutedLinesCount()
+				<< ",\"rate\":";
+			WriteRate(ostr, coverageRate);
+		}
+	}
+
+	//-------------------------------------------------------------------------
+	CoverageSummary::CoverageSummary(int exitCode)
+		: exitCode_{ exitCode }
+	{
+	}
+
+	//-------------------------------------------------------------------------
+	void CoverageSummary::AddFile(
+		Tools::PathId moduleId,
+		Tools::PathId fileId,
+		Lines&& lines)
+	{
+		const auto& pathInterner = Tools::PathInterner::GetInstance();
+		auto& files = modules_.emplace(
+			pathInterner.GetCanonicalId(moduleId), Module{ moduleId, {} }).first->second.files;
+		auto it = files.emplace(pathInterner.GetCanonicalId(fileId), Lines{});
+		auto& fileLines = it.first->second;
+
+		if (it.second)
+			fileLines = std::move(lines);
+		else
+			fileLines = MergeLines(fileLines, lines);
+	}
+
+	//-------------------------------------------------------------------------
+	void CoverageSummary::Merge(CoverageSummary&& coverageSummary)
+	{
+		for (auto& module : coverageSummary.modules_)
+		{
+			for (auto& file : module.second.files)
+				AddFile(module.second.pathId, file.first, std::move(file.second));
+		}
+		coverageSummary.modules_.clear();
+		if (coverageSummary.exitCode_)
+			exitCode_ = coverageSummary.exitCode_;
+	}
+
+	//-------------------------------------------------------------------------
+	void CoverageSummary::MergeFileCoverage()
+	{
+		std::unordered_map<Tools::PathId, std::vector<Lines*>> linesByFile;
+
+		for (auto& module : modules_)
+		{
+			for (auto& file : module.second.files)
+				linesByFile[file.first].push_back(&file.second);
+		}
+
+		for (const auto& pair : linesByFile)
+		{
+			const auto& fileLines = pair.second;
+			if (fileLines.size() <= 1)
+				continue;
+
+			Lines mergedLines;
+			for (const auto* lines : fileLines)
+				mergedLines = MergeLines(mergedLines, *lines);
+			for (auto* lines : fileLines)
+				*lines = mergedLines;
+		}
+	}
+
+	//-------------------------------------------------------------------------
+	int CoverageSummary::GetExitCode() const
+	{
+		return exitCode_;
+	}
+
+	//-------------------------------------------------------------------------
+	CoverageRate CoverageSummary::GetCoverageRate() const
+	{
+		CoverageRate coverageRate;
+
+		for (const auto& moduleCoverageRate : GetModuleCoverageRates())
+			coverageRate += moduleCoverageRate.coverageRate;
+		return coverageRate;
+	}
+
+	//-------------------------------------------------------------------------
+	std::vector<CoverageSummary::ModuleCoverageRate>
+	CoverageSummary::GetModuleCoverageRates() const
+	{
+		const auto& pathInterner = Tools::PathInterner::GetInstance();
+		std::vector<std::pair<const std::filesystem::path*, const Files*>> modules;
+
+		for (const auto& module : modules_)
+			modules.emplace_back(&pathInterner.GetPath(module.second.pathId), &module.second.files);
+		std::sort(modules.begin(), modules.end(), [](const auto& module1, const auto& module2) {
+			return *module1.first < *module2.first;
+		});
+
+		std::vector<ModuleCoverageRate> moduleCoverageRates;
+		for (const auto& module : modules)
+		{
+			CoverageRate coverageRate;
+
+			for (const auto& file : *module.second)
+				coverageRate += ComputeCoverageRate(file.second);
+			moduleCoverageRates.push_back(ModuleCoverageRate{ *module.first, coverageRate });
+		}
+		return moduleCoverageRates;
+	}
+
+	//-------------------------------------------------------------------------
+	void CoverageSummary::WriteText(std::wostream& ostr) const
+	{
+		CoverageRate coverageRate;
+
+		for (const auto& moduleCoverageRate : GetModuleCoverageRates())
+		{
+			WriteTextRate(ostr, moduleCoverageRate.path.wstring(), moduleCoverageRate.coverageRate);
+			coverageRate += moduleCoverageRate.coverageRate;
+		}
+		WriteTextRate(ostr, L"Total", coverageRate);
+	}
+
+	//-------------------------------------------------------------------------
+	void CoverageSummary::WriteJson(std::ostream& ostr) const
+	{
+		CoverageRate coverageRate;
+		auto moduleCoverageRates = GetModuleCoverageRates();
+
+		ostr << "{\"exitCode\":" << exitCode_ << ",\"modules\":[";
+		for (size_t i = 0; i < moduleCoverageRates.size(); ++i)
+		{
+			const auto& moduleCoverageRate = moduleCoverageRates[i];
+
+			ostr << (i ? "," : "") << "{\"path\":\"" << EscapeJson(moduleCoverageRate.path) << "\",";
+			WriteJsonRate(ostr, moduleCoverageRate.coverageRate);
+			ostr << '}';
+			coverageRate += moduleCoverageRate.coverageRate;
+		}
+		ostr << "],\"total\":{";
+		WriteJsonRate(ostr, coverageRate);
+		ostr << "}}";
+	}
+}
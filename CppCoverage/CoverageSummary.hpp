@@ -0,0 +1,87 @@
+// OpenCppCoverage is an open source code coverage for C++.
+// Copyright (C) 2019 OpenCppCoverage
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <filesystem>
+#include <iosfwd>
+#include <map>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "Tools/PathInterner.hpp"
+#include "CoverageRate.hpp"
+#include "CppCoverageExport.hpp"
+
+namespace CppCoverage
+{
+	// Executed and unexecuted line counts of a run, built directly from the
+	// executed addresses without creating a Plugin::CoverageData.
+	// Only line numbers are kept so runs and processes can still be merged.
+	class CPPCOVERAGE_DLL CoverageSummary
+	{
+	public:
+		// {lineNumber, hasBeenExecuted} sorted by line number.
+		using Lines = std::vector<std::pair<unsigned int, bool>>;
+
+		struct ModuleCoverageRate
+		{
+			std::filesystem::path path;
+			CoverageRate coverageRate;
+		};
+
+		explicit CoverageSummary(int exitCode = 0);
+
+		CoverageSummary(CoverageSummary&&) = default;
+		CoverageSummary& operator=(CoverageSummary&&) = default;
+
+		// Lines of the same file in the same module are merged.
+		void AddFile(Tools::PathId moduleId, Tools::PathId fileId, Lines&&);
+
+		// The exit code of coverageSummary is kept when it is not 0.
+		void Merge(CoverageSummary&& coverageSummary);
+
+		// A line of a file is executed in all modules if it is executed in one
+		// of them, like CoverageDataMerger::MergeFileCoverage.
+		void MergeFileCoverage();
+
+		int GetExitCode() const;
+		CoverageRate GetCoverageRate() const;
+
+		// Sorted by module path.
+		std::vector<ModuleCoverageRate> GetModuleCoverageRates() const;
+
+		void WriteText(std::wostream&) const;
+		void WriteJson(std::ostream&) const;
+
+	private:
+		CoverageSummary(const CoverageSummary&) = delete;
+		CoverageSummary& operator=(const CoverageSummary&) = delete;
+
+		using Files = std::unordered_map<Tools::PathId, Lines>;
+		struct Module
+		{
+			// Path id of the first added module, used for the output.
+			Tools::PathId pathId;
+			Files files;
+		};
+
+		// Modules and files by canonical path id.
+		std::map<Tools::PathId, Module> modules_;
+		int exitCode_;
+	};
+}
@@ -169,6 +169,8 @@ namespace CppCoverage
 			{
 				LOG_DEBUG << "Try to load pdb from " << pdbPath << ": "
 				          << (resultCode == S_OK ? "Success" : "Failed");
+				if (resultCode == S_OK)
+					pdbPath_ = pdbPath;
 				return S_OK;
 			}
 
@@ -183,11 +185,14 @@ namespace CppCoverage
 			{
 				return S_OK;
 			}
+
+			std::filesystem::path pdbPath_;
 		};
 
 		//----------------------------------------------------------------------
 		CComPtr<IDiaDataSource>
-		LoadDataForExe(const std::filesystem::path& path)
+		LoadDataForExe(const std::filesystem::path& path,
+		               std::filesystem::path& pdbPath)
 		{
 			CComPtr<IDiaDataSource> sourcePtr;
 
@@ -208,6 +213,7 @@ namespace CppCoverage
 			{
 				return nullptr;
 			}
+			pdbPath = diaLoadCallback.pdbPath_;
 			return sourcePtr;
 		}
 	}
@@ -224,7 +230,8 @@ namespace CppCoverage
 	DebugInformationEnumerator::Enumerate(const std::filesystem::path& path,
 	                                      IDebugInformationHandler& handler)
 	{
-		auto sourcePtr = LoadDataForExe(path);
+		pdbPath_.clear();
+		auto sourcePtr = LoadDataForExe(path, pdbPath_);
 
 		if (!sourcePtr)
 			return false;
@@ -237,9 +244,11 @@ namespace CppCoverage
 		if (!sourceFiles)
 			THROW("DIA: cannot get SourceFiles");
 
+		symbolIndexes_.clear();
+
 		EnumerateCollection<IDiaSourceFile>(
 		    *sourceFiles, [&](IDiaSourceFile& sourceFile) {
-			    auto filename = GetSourceFileName(sourceFile);
+			    const auto& filename = GetSourceFileName(sourceFile);
 			    if (handler.IsSourceFileSelected(filename))
 			    {
 				    lines_.clear();
@@ -250,6 +259,12 @@ namespace CppCoverage
 		return true;
 	}
 
+	//----------------------------------------------------------------------
+	const std::filesystem::path& DebugInformationEnumerator::GetPdbPath() const
+	{
+		return pdbPath_;
+	}
+
 	//----------------------------------------------------------------------
 	void
 	DebugInformationEnumerator::EnumLines(IDiaSession& session,
@@ -305,18 +320,61 @@ namespace CppCoverage
 			if (symbol->get_symIndexId(&symIndex) != S_OK)
 				THROW("DIA: Cannot get symIndex");
 
+			if (symbolIndexes_.insert(symIndex).second)
+				OnNewFunction(*symbol, symIndex, handler);
 			lines_.emplace_back(linenum, virtualAddress, symIndex);
 		}
 	}
 
 	//----------------------------------------------------------------------
-	std::filesystem::path DebugInformationEnumerator::GetSourceFileName(
-	    IDiaSourceFile& sourceFile) const
+	void DebugInformationEnumerator::OnNewFunction(
+	    IDiaSymbol& symbol,
+	    unsigned long symbolIndex,
+	    IDebugInformationHandler& handler)
+	{
+		CComPtr<IDiaSymbol> function{&symbol};
+		DWORD symTag = SymTagNull;
+
+		// Lines of a nested block belong to the enclosing function.
+		while (function->get_symTag(&symTag) == S_OK && symTag == SymTagBlock)
+		{
+			CComPtr<IDiaSymbol> parent;
+			if (function->get_lexicalParent(&parent) != S_OK || !parent)
+				return;
+			function = parent;
+		}
+
+		DiaString name;
+		if (symTag == SymTagFunction && function->get_name(&name) == S_OK)
+			handler.OnFunction(symbolIndex, name);
+	}
+
+	//----------------------------------------------------------------------
+	const std::filesystem::path& DebugInformationEnumerator::GetSourceFileName(
+	    IDiaSourceFile& sourceFile)
 	{
 		DiaString fileName;
 		if (sourceFile.get_fileName(&fileName) != S_OK)
 			THROW("DIA: Cannot get filename");
-		std::wstring filenameStr = fileName;
+		std::wstring diaFileName = fileName;
+		auto& pathInterner = Tools::PathInterner::GetInstance();
+
+		// The same headers are listed by most of the modules.
+		auto it = pathIdByDiaFileName_.find(diaFileName);
+		if (it == pathIdByDiaFileName_.end())
+		{
+			auto pathId = pathInterner.Intern(SubstitutePdbSourcePaths(diaFileName));
+			it = pathIdByDiaFileName_.emplace(std::move(diaFileName), pathId).first;
+		}
+
+		return pathInterner.GetPath(it->second);
+	}
+
+	//----------------------------------------------------------------------
+	std::filesystem::path DebugInformationEnumerator::SubstitutePdbSourcePaths(
+	    const std::wstring& filename) const
+	{
+		std::wstring filenameStr = filename;
 
 		for (const auto& paths : substitutePdbSourcePaths_)
 		{
@@ -17,6 +17,10 @@
 #pragma once
 
 #include <filesystem>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "Tools/PathInterner.hpp"
 
 #include "CppCoverageExport.hpp"
 #include "SubstitutePdbSourcePath.hpp"
@@ -24,6 +28,7 @@
 struct IDiaSession;
 struct IDiaLineNumber;
 struct IDiaSourceFile;
+struct IDiaSymbol;
 
 namespace CppCoverage
 {
@@ -54,6 +59,13 @@ namespace CppCoverage
 		virtual bool IsSourceFileSelected(const std::filesystem::path&) = 0;
 		virtual void OnSourceFile(const std::filesystem::path&,
 		                          const std::vector<Line>&) = 0;
+
+		// Called once by module for the symbol index of the function
+		// containing lines, before OnSourceFile is called for these lines.
+		virtual void OnFunction(unsigned long /*symbolIndex*/,
+		                        const std::wstring& /*name*/)
+		{
+		}
 	};
 
 	//-------------------------------------------------------------------------
@@ -64,16 +76,28 @@ namespace CppCoverage
 		bool Enumerate(const std::filesystem::path&,
 		               IDebugInformationHandler&);
 
+		// Path of the pdb loaded by the last call to Enumerate. Empty when
+		// the debug information does not come from a pdb file.
+		const std::filesystem::path& GetPdbPath() const;
+
 	  private:
 		void
 		EnumLines(IDiaSession&, IDiaSourceFile&, IDebugInformationHandler&);
 		void
 		OnNewLine(IDiaSession&, IDiaLineNumber&, IDebugInformationHandler&);
+		void OnNewFunction(IDiaSymbol&,
+		                   unsigned long symbolIndex,
+		                   IDebugInformationHandler&);
 
+		const std::filesystem::path&
+		GetSourceFileName(IDiaSourceFile&);
 		std::filesystem::path
-		GetSourceFileName(IDiaSourceFile&) const;
+		SubstitutePdbSourcePaths(const std::wstring& filename) const;
 
 		std::vector<IDebugInformationHandler::Line> lines_;
+		std::unordered_set<unsigned long> symbolIndexes_;
+		std::unordered_map<std::wstring, Tools::PathId> pathIdByDiaFileName_;
 		const std::vector<SubstitutePdbSourcePath> substitutePdbSourcePaths_;
+		std::filesystem::path pdbPath_;
 	};
 }
@@ -42,6 +42,32 @@ namespace CppCoverage
 				<< "(type:" << ripInfo.dwType << ")"
 				<< GetErrorMessage(ripInfo.dwError);
 		}
+
+		//---------------------------------------------------------------------
+		// DebugActiveProcess does not debug the child processes of the
+		// attached process. Clear its "no debug inherit" flag as WinDbg does
+		// for .childdbg 1: NtSetInformationProcess is not documented.
+		bool EnableChildProcessDebugging(DWORD processId)
+		{
+			using NtSetInformationProcessFct = LONG (NTAPI*)(HANDLE, ULONG, PVOID, ULONG);
+			const ULONG ProcessDebugFlags = 0x1F;
+			ULONG debugInherit = 1;
+
+			auto ntdll = GetModuleHandle(L"ntdll.dll");
+			auto ntSetInformationProcess = ntdll ?
+				reinterpret_cast<NtSetInformationProcessFct>(
+					GetProcAddress(ntdll, "NtSetInformationProcess")) : nullptr;
+			if (!ntSetInformationProcess)
+				return false;
+
+			auto hProcess = OpenProcess(PROCESS_SET_INFORMATION, FALSE, processId);
+			if (!hProcess)
+				return false;
+			Tools::ScopedAction closeProcess{ [=] { CloseHandle(hProcess); } };
+
+			return ntSetInformationProcess(
+				hProcess, ProcessDebugFlags, &debugInherit, sizeof(debugInherit)) >= 0;
+		}
 	}
 
 	//-------------------------------------------------------------------------
@@ -73,7 +99,20 @@ namespace CppCoverage
 		, stopOnAssert_{ stopOnAssert }
 		, dumpOnCrash_{ dumpOnCrash }
 		, dumpDirectory_{ dumpDirectory }
+		, idleTimeout_{ INFINITE }
+	{
+	}
+
+	//-------------------------------------------------------------------------
+	void Debugger::SetIdleTimeout(DWORD idleTimeoutInMilliseconds)
+	{
+		idleTimeout_ = idleTimeoutInMilliseconds;
+	}
+
+	//-------------------------------------------------------------------------
+	void Debugger::SetChildProcessHandler(ChildProcessHandler childProcessHandler)
 	{
+		childProcessHandler_ = std::move(childProcessHandler);
 	}
 
 	//-------------------------------------------------------------------------
@@ -84,17 +123,61 @@ namespace CppCoverage
 		Process process(startInfo);
 		process.Start((coverChildren_) ? DEBUG_PROCESS : DEBUG_ONLY_THIS_PROCESS);
 
+		rootProcessId_ = boost::none;
+		return RunDebugLoop(debugEventsHandler);
+	}
+
+	//-------------------------------------------------------------------------
+	int Debugger::Attach(
+		DWORD processId,
+		DWORD suspendedThreadId,
+		IDebugEventsHandler& debugEventsHandler)
+	{
+		LOG_DEBUG << "Attach Process:" << processId;
+
+		if (!DebugActiveProcess(processId))
+			THROW_LAST_ERROR(L"Error DebugActiveProcess:", GetLastError());
+
+		// The main thread is still suspended: no child process was created.
+		if (coverChildren_ && !EnableChildProcessDebugging(processId))
+		{
+			LOG_WARNING << Tools::GetSeparatorLine();
+			LOG_WARNING << "Cannot debug the child processes of the process " << processId;
+			LOG_WARNING << Tools::GetSeparatorLine();
+		}
+
+		auto hThread = OpenThread(THREAD_SUSPEND_RESUME, FALSE, suspendedThreadId);
+		if (!hThread)
+			THROW_LAST_ERROR(L"Error OpenThread:", GetLastError());
+		Tools::ScopedAction closeThread{ [=] { CloseHandle(hThread); } };
+
+		if (ResumeThread(hThread) == static_cast<DWORD>(-1))
+			THROW_LAST_ERROR(L"Error ResumeThread:", GetLastError());
+
+		rootProcessId_ = processId;
+		return RunDebugLoop(debugEventsHandler);
+	}
+
+	//-------------------------------------------------------------------------
+	int Debugger::RunDebugLoop(IDebugEventsHandler& debugEventsHandler)
+	{
 		DEBUG_EVENT debugEvent;
 		boost::optional<int> exitCode;
 
 		processHandles_.clear();
 		threadHandles_.clear();
-		rootProcessId_ = boost::none;
+		childProcessesToDetach_.clear();
 
 		while (!exitCode || !processHandles_.empty())
 		{
-			if (!WaitForDebugEvent(&debugEvent, INFINITE))
-				THROW_LAST_ERROR(L"Error WaitForDebugEvent:", GetLastError());
+			if (!WaitForDebugEvent(&debugEvent, idleTimeout_))
+			{
+				auto lastError = GetLastError();
+				if (lastError != ERROR_SEM_TIMEOUT)
+					THROW_LAST_ERROR(L"Error WaitForDebugEvent:", lastError);
+				debugEventsHandler.OnDebuggeeRunning();
+				continue;
+			}
 
 			ProcessStatus processStatus = HandleDebugEvent(debugEvent, debugEventsHandler);
 
@@ -107,11 +190,27 @@ namespace CppCoverage
 
 			if (!ContinueDebugEvent(debugEvent.dwProcessId, debugEvent.dwThreadId, continueStatus))
 				THROW_LAST_ERROR("Error in ContinueDebugEvent:", GetLastError());
+			DetachChildProcesses();
+			debugEventsHandler.OnDebuggeeRunning();
 		}
 
 		return *exitCode;
 	}
 
+	//-------------------------------------------------------------------------
+	void Debugger::DetachChildProcesses()
+	{
+		for (const auto& [processId, threadId] : childProcessesToDetach_)
+		{
+			LOG_DEBUG << "Detach Process:" << processId;
+
+			if (!DebugActiveProcessStop(processId))
+				THROW_LAST_ERROR(L"Error DebugActiveProcessStop:", GetLastError());
+			childProcessHandler_(processId, threadId);
+		}
+		childProcessesToDetach_.clear();
+	}
+
 	//-------------------------------------------------------------------------
 	Debugger::ProcessStatus Debugger::HandleDebugEvent(
 		const DEBUG_EVENT& debugEvent,
@@ -301,6 +400,16 @@ namespace CppCoverage
 		if (!rootProcessId_ && processHandles_.empty())
 			rootProcessId_ = debugEvent.dwProcessId;
 
+		// The child process is debugged by another Debugger once its main
+		// thread is suspended and this one has detached from it.
+		if (childProcessHandler_ && rootProcessId_ != debugEvent.dwProcessId)
+		{
+			if (SuspendThread(processInfo.hThread) == static_cast<DWORD>(-1))
+				THROW_LAST_ERROR(L"Error SuspendThread:", GetLastError());
+			childProcessesToDetach_.emplace_back(debugEvent.dwProcessId, debugEvent.dwThreadId);
+			return;
+		}
+
 		if (!processHandles_.emplace(debugEvent.dwProcessId, processInfo.hProcess).second)
 			THROW("Process id already exist");
 
@@ -19,7 +19,9 @@
 #include <boost/optional/optional.hpp>
 
 #include <filesystem>
+#include <functional>
 #include <unordered_map>
+#include <vector>
 #include <Windows.h>
 #include "CppCoverageExport.hpp"
 
@@ -39,7 +41,24 @@ namespace CppCoverage
 			bool dumpOnCrash,
 			const std::filesystem::path& dumpDirectory);
 
+		// IDebugEventsHandler::OnDebuggeeRunning is called at least every
+		// idleTimeout. The default is INFINITE.
+		void SetIdleTimeout(DWORD idleTimeoutInMilliseconds);
+
+		// When set, each child process is detached from this debugger with
+		// its main thread suspended and given to childProcessHandler which
+		// is expected to call Attach from another thread.
+		using ChildProcessHandler = std::function<void(DWORD processId, DWORD suspendedThreadId)>;
+		void SetChildProcessHandler(ChildProcessHandler);
+
 		int Debug(const StartInfo&, IDebugEventsHandler&);
+
+		// Debug a process given by a ChildProcessHandler and resume its
+		// suspended thread. With coverChildren, its own child processes are
+		// debugged too. This relies on an undocumented flag: a warning is
+		// logged and they are not covered if it cannot be set.
+		int Attach(DWORD processId, DWORD suspendedThreadId, IDebugEventsHandler&);
+
 		size_t GetRunningProcesses() const;
 		size_t GetRunningThreads() const;
 
@@ -47,6 +66,9 @@ namespace CppCoverage
 		Debugger(const Debugger&) = delete;
 		Debugger& operator=(const Debugger&) = delete;
 
+		int RunDebugLoop(IDebugEventsHandler&);
+		void DetachChildProcesses();
+
 		void OnCreateProcess(
 			const DEBUG_EVENT& debugEvent,
 			IDebugEventsHandler& debugEventsHandler);
@@ -89,6 +111,9 @@ namespace CppCoverage
 		bool stopOnAssert_;
 		bool dumpOnCrash_;
 		std::filesystem::path dumpDirectory_;
+		DWORD idleTimeout_;
+		ChildProcessHandler childProcessHandler_;
+		std::vector<std::pair<DWORD, DWORD>> childProcessesToDetach_;
 	};
 }
 
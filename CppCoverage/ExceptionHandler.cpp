@@ -33,7 +33,8 @@ namespace CppCoverage
 	const int ExceptionHandler::CppExceptionErrorCode = 0xE06D7363;
 
 	//-------------------------------------------------------------------------
-	ExceptionHandler::ExceptionHandler()
+	ExceptionHandler::ExceptionHandler(size_t ignoredBreakPointCount)
+		: ignoredBreakPointCount_{ ignoredBreakPointCount }
 	{
 		breakPointExceptionCode_.emplace(EXCEPTION_BREAKPOINT, std::vector<HANDLE>{});
 		breakPointExceptionCode_.emplace(ExceptionEmulationX86ErrorCode, std::vector<HANDLE>{});
@@ -84,7 +85,8 @@ namespace CppCoverage
 			{
 				auto& processHandles = it->second;
 				// Breakpoint exception need to be ignore the first time by process.
-				if (std::find(processHandles.begin(), processHandles.end(), hProcess) == processHandles.end())
+				auto count = std::count(processHandles.begin(), processHandles.end(), hProcess);
+				if (static_cast<size_t>(count) < ignoredBreakPointCount_)
 					processHandles.push_back(hProcess);
 				else
 					return ExceptionHandlerStatus::BreakPoint;
@@ -113,10 +115,9 @@ namespace CppCoverage
 		for (auto& pair : breakPointExceptionCode_)
 		{
 			std::vector<HANDLE>& processes = pair.second;
-			auto it = std::find(processes.begin(), processes.end(), hProcess);
-
-			if (it != processes.end())
-				processes.erase(it);
+			processes.erase(
+				std::remove(processes.begin(), processes.end(), hProcess),
+				processes.end());
 		}
 	}
 
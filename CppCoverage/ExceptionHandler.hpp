@@ -43,7 +43,10 @@ namespace CppCoverage
 		static const int ExceptionEmulationX86ErrorCode;
 		static const int CppExceptionErrorCode;
 
-		ExceptionHandler();
+		// The first ignoredBreakPointCount breakpoints of each process are
+		// ignored: the loader breakpoint and, for an attached process, the
+		// attach breakpoint.
+		explicit ExceptionHandler(size_t ignoredBreakPointCount = 1);
 
 		ExceptionHandlerStatus HandleException(HANDLE hProcess, const EXCEPTION_DEBUG_INFO&, std::wostream&);
 		void OnExitProcess(HANDLE hProcess);
@@ -57,6 +60,7 @@ namespace CppCoverage
 
 		std::unordered_map<DWORD, std::wstring> exceptionCode_;
 		std::map<DWORD, std::vector<HANDLE>> breakPointExceptionCode_;
+		const size_t ignoredBreakPointCount_;
 	};
 }
 
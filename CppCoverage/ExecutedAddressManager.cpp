@@ -18,51 +18,167 @@
 #include "ExecutedAddressManager.hpp"
 
 #include <unordered_map>
+#include <fstream>
 #include <boost/container/small_vector.hpp>
 
+#include "tools/BinaryStream.hpp"
 #include "tools/Log.hpp"
+#include "tools/Tool.hpp"
 
 #include "CppCoverageException.hpp"
+#include "Plugin/Exporter/CoverageArena.hpp"
 #include "Plugin/Exporter/ModuleCoverage.hpp"
 #include "Plugin/Exporter/FileCoverage.hpp"
 #include "Address.hpp"
+#include "CoverageSummary.hpp"
 
 namespace CppCoverage
 {
+	namespace
+	{
+		// Rough size of a node of File::lines.
+		const size_t EstimatedLineSize =
+			sizeof(std::map<unsigned int, bool>::value_type) + 4 * sizeof(void*);
+
+		//---------------------------------------------------------------------
+		template <typename T>
+		T Read(Tools::BinaryReader& reader)
+		{
+			T value;
+
+			if (!reader.Read(value))
+				THROW("Cannot read spilled coverage.");
+			return value;
+		}
+	}
+
 	//-------------------------------------------------------------------------
 	struct ExecutedAddressManager::Line
 	{
-		explicit Line(unsigned char instructionToRestore, void* dllBaseOfImage)
+		struct FileLine
+		{
+			std::pair<const unsigned int, bool>* line_;
+			Tools::PathId fileId_;
+		};
+
+		explicit Line(
+			unsigned char instructionToRestore,
+			void* dllBaseOfImage,
+			Module& module)
 			: instructionToRestore_{ instructionToRestore }
 			, dllBaseOfImage_{ dllBaseOfImage }
+			, module_{ module }
 		{
 		}
 
 		const unsigned char instructionToRestore_;
 		void* const dllBaseOfImage_;
-		boost::container::small_vector<bool*, 1> hasBeenExecutedCollection_;
+		Module& module_;
+		boost::container::small_vector<FileLine, 1> hasBeenExecutedCollection_;
 	};
 
 	//-------------------------------------------------------------------------
 	struct ExecutedAddressManager::File
 	{		
+		struct Function
+		{
+			unsigned int firstLine;
+			unsigned int lastLine;
+		};
+
+		//---------------------------------------------------------------------
+		void AddFunctionLines(unsigned long symbolIndex, unsigned int firstLine, unsigned int lastLine)
+		{
+			auto it = functions.emplace(symbolIndex, Function{ firstLine, lastLine });
+
+			if (!it.second)
+			{
+				auto& function = it.first->second;
+				function.firstLine = std::min(function.firstLine, firstLine);
+				function.lastLine = std::max(function.lastLine, lastLine);
+			}
+		}
+
 		// Use map to have iterator always valid
 		std::map<unsigned int, bool> lines;
+
+		// Line range in this file by symbol index.
+		std::unordered_map<unsigned long, Function> functions;
 	};
 
 	//-------------------------------------------------------------------------
 	struct ExecutedAddressManager::Module
 	{
-		explicit Module(const std::wstring& name) : name_{ name }
+		explicit Module(const std::wstring& name)
+			: name_{ name }
+			, id_{ Tools::PathInterner::GetInstance().Intern(name) }
 		{
 		}
 
+		//---------------------------------------------------------------------
+		void AddFunctionName(unsigned long symbolIndex, const std::wstring& name)
+		{
+			if (functionNameOffsets_.emplace(symbolIndex, functionNames_.size()).second)
+			{
+				functionNames_ += name;
+				functionNames_.push_back(L'\0');
+			}
+		}
+
+		//---------------------------------------------------------------------
+		const wchar_t* GetFunctionName(unsigned long symbolIndex) const
+		{
+			auto it = functionNameOffsets_.find(symbolIndex);
+
+			return it == functionNameOffsets_.end() ? nullptr : functionNames_.c_str() + it->second;
+		}
+
 		const std::wstring name_;
-		std::unordered_map<std::wstring, File> files_;
+		const Tools::PathId id_;
+		std::unordered_map<Tools::PathId, File> files_;
+		size_t lineCount_ = 0;
+
+		// Names of the functions separated by a null character.
+		std::wstring functionNames_;
+		std::unordered_map<unsigned long, size_t> functionNameOffsets_;
+
+		// Number of entries of addressLineMap_ that point to this module.
+		// When it drops to zero, the module is unloaded in all processes.
+		size_t addressCount_ = 0;
 	};
-	
+
+	//-------------------------------------------------------------------------
+	// Binary layout of a spilled module:
+	// fileCount, {pathId, lineCount, {lineNumber, hasBeenExecuted}*,
+	// functionCount, {symbolIndex, firstLine, lastLine, nameSize, name}*}*
+	// Path ids are only valid in this process which is fine as the file is
+	// temporary.
+	struct ExecutedAddressManager::SpillFile
+	{
+		SpillFile()
+			: path_{ Tools::CreateTemporaryFile() }
+			, ostr_{ path_, std::ios::binary | std::ios::trunc }
+		{
+			if (!ostr_)
+				THROW(L"Cannot open " << path_.wstring());
+			LOG_INFO << L"Spill coverage data to " << path_.wstring();
+		}
+
+		~SpillFile()
+		{
+			ostr_.close();
+			std::error_code error;
+			std::filesystem::remove(path_, error);
+		}
+
+		const std::filesystem::path path_;
+		std::ofstream ostr_;
+	};
+
 	//-------------------------------------------------------------------------
 	ExecutedAddressManager::ExecutedAddressManager()
+		: lineCount_{ 0 }
+		, isLineChangeTrackingEnabled_{ false }
 	{
 		lastModule_.baseOfImage_ = nullptr;
 		lastModule_.module_ = nullptr;
@@ -73,6 +189,28 @@ namespace CppCoverage
 	{
 	}
 
+	//-------------------------------------------------------------------------
+	void ExecutedAddressManager::SetMemoryBudget(
+		boost::optional<size_t> memoryBudget)
+	{
+		memoryBudget_ = memoryBudget;
+	}
+
+	//-------------------------------------------------------------------------
+	void ExecutedAddressManager::EnableLineChangeTracking()
+	{
+		isLineChangeTrackingEnabled_ = true;
+	}
+
+	//-------------------------------------------------------------------------
+	ExecutedAddressManager::LineChanges ExecutedAddressManager::TakeLineChanges()
+	{
+		LineChanges lineChanges;
+
+		std::swap(lineChanges, lineChanges_);
+		return lineChanges;
+	}
+
 	//-------------------------------------------------------------------------
 	void ExecutedAddressManager::AddModule(
 		const std::wstring& moduleName,
@@ -92,11 +230,24 @@ namespace CppCoverage
 		const std::wstring& filename,
 		unsigned int lineNumber, 
 		unsigned char instructionValue)
+	{
+		auto filenameId = Tools::PathInterner::GetInstance().Intern(filename);
+
+		return RegisterAddress(address, filenameId, lineNumber, instructionValue);
+	}
+
+	//-------------------------------------------------------------------------
+	bool ExecutedAddressManager::RegisterAddress(
+		const Address& address,
+		Tools::PathId filenameId,
+		unsigned int lineNumber,
+		unsigned char instructionValue)
 	{
 		auto& module = GetLastAddedModule();
-		auto& file = module.files_[filename];
+		auto& file = module.files_[filenameId];
 
-		LOG_TRACE << "RegisterAddress: " << address << " for " << filename << ":" << lineNumber;
+		LOG_TRACE << "RegisterAddress: " << address << " for " 
+			<< Tools::PathInterner::GetInstance().GetPath(filenameId).wstring() << ":" << lineNumber;
 
 		// Different {filename, line} can have the same address.
 		// Same {filename, line} can have several addresses.		
@@ -106,16 +257,48 @@ namespace CppCoverage
 		if (itAddress == addressLineMap_.end())
 		{
 			itAddress = addressLineMap_.emplace(address, 
-				Line{ instructionValue, lastModule_.baseOfImage_ }).first;
+				Line{ instructionValue, lastModule_.baseOfImage_, module }).first;
+			++module.addressCount_;
 			keepBreakpoint = true;
 		}
 		
 		auto& line = itAddress->second;
-		line.hasBeenExecutedCollection_.push_back(&file.lines[lineNumber]);
+		auto itLine = file.lines.emplace(lineNumber, false);
+		if (itLine.second)
+		{
+			++module.lineCount_;
+			++lineCount_;
+			if (isLineChangeTrackingEnabled_)
+				lineChanges_.registeredLines.push_back({ module.id_, filenameId, lineNumber });
+		}
+		line.hasBeenExecutedCollection_.push_back({ &*itLine.first, filenameId });
 		
 		return keepBreakpoint;
 	}
 
+	//-------------------------------------------------------------------------
+	void ExecutedAddressManager::RegisterFunction(
+		unsigned long symbolIndex,
+		const std::wstring& name)
+	{
+		GetLastAddedModule().AddFunctionName(symbolIndex, name);
+	}
+
+	//-------------------------------------------------------------------------
+	void ExecutedAddressManager::RegisterFunctionLine(
+		Tools::PathId filenameId,
+		unsigned long symbolIndex,
+		unsigned int lineNumber)
+	{
+		auto& module = GetLastAddedModule();
+		auto itFile = module.files_.find(filenameId);
+
+		if (itFile == module.files_.end() || !module.GetFunctionName(symbolIndex))
+			return;
+
+		itFile->second.AddFunctionLines(symbolIndex, lineNumber, lineNumber);
+	}
+
 	//-------------------------------------------------------------------------
 	ExecutedAddressManager::Module& ExecutedAddressManager::GetLastAddedModule()
 	{
@@ -136,33 +319,73 @@ namespace CppCoverage
 
 		auto& line = it->second;
 
-		for (bool* hasBeenExecuted : line.hasBeenExecutedCollection_)
+		for (const auto& fileLine : line.hasBeenExecutedCollection_)
 		{
-			if (!hasBeenExecuted)
+			auto* lineData = fileLine.line_;
+			if (!lineData)
 				THROW("Invalid pointer");
-			*hasBeenExecuted = true;
+			if (!lineData->second && isLineChangeTrackingEnabled_)
+			{
+				lineChanges_.executedLines.push_back(
+					{ line.module_.id_, fileLine.fileId_, lineData->first });
+			}
+			lineData->second = true;
 		}
 		return line.instructionToRestore_;
 	}
 	
+	//-------------------------------------------------------------------------
+	template <typename ModuleHandler>
+	void ExecutedAddressManager::ForEachModule(ModuleHandler moduleHandler) const
+	{
+		std::map<std::wstring, const Module*> modules;
+
+		for (const auto& pair : modules_)
+			modules.emplace(pair.first, &pair.second);
+
+		// Spilled modules are loaded back one at a time.
+		std::unique_ptr<Module> spilledModule;
+		if (spillFile_)
+		{
+			spillFile_->ostr_.flush();
+			for (const auto& pair : spilledModules_)
+				modules.emplace(pair.first, nullptr);
+		}
+
+		for (const auto& pair : modules)
+		{
+			const auto* modulePtr = pair.second;
+			auto itSpilled = spilledModules_.find(pair.first);
+
+			if (itSpilled != spilledModules_.end())
+			{
+				spilledModule = modulePtr ? std::make_unique<Module>(*modulePtr)
+				                          : std::make_unique<Module>(pair.first);
+				LoadSpilledModules(itSpilled->second, *spilledModule);
+				modulePtr = spilledModule.get();
+			}
+
+			moduleHandler(*modulePtr);
+		}
+	}
+
 	//-------------------------------------------------------------------------
 	Plugin::CoverageData ExecutedAddressManager::CreateCoverageData(
 		const std::wstring& name,
 		int exitCode) const
 	{
-		Plugin::CoverageData coverageData{ name, exitCode };
+		const auto& pathInterner = Tools::PathInterner::GetInstance();
+		auto coverageData = Plugin::CoverageArena::CreateCoverageData(name, exitCode);
 
-		for (const auto& pair : modules_)
-		{
-			const auto& module = pair.second;
+		ForEachModule([&](const Module& module) {
 			auto& moduleCoverage = coverageData.AddModule(module.name_);
 
 			for (const auto& file : module.files_)
 			{
-				const std::wstring& name = file.first;
+				const auto& path = pathInterner.GetPath(file.first);
 				const File& fileData = file.second;
 
-				auto& fileCoverage = moduleCoverage.AddFile(name);
+				auto& fileCoverage = moduleCoverage.AddFile(path);
 
 				for (const auto& pair : fileData.lines)
 				{
@@ -171,7 +394,67 @@ namespace CppCoverage
 					
 					fileCoverage.AddLine(lineNumber, hasLineBeenExecuted);
 				}
-			}			
+
+				for (const auto& function : fileData.functions)
+				{
+					fileCoverage.AddFunction(
+						static_cast<unsigned int>(function.first),
+						module.GetFunctionName(function.first),
+						function.second.firstLine,
+						function.second.lastLine);
+				}
+			}
+		});
+
+		return coverageData;
+	}
+
+	//-------------------------------------------------------------------------
+	CoverageSummary ExecutedAddressManager::CreateCoverageSummary(int exitCode) const
+	{
+		CoverageSummary coverageSummary{ exitCode };
+
+		ForEachModule([&](const Module& module) {
+			for (const auto& file : module.files_)
+			{
+				const auto& lines = file.second.lines;
+				coverageSummary.AddFile(module.id_, file.first,
+					CoverageSummary::Lines{ lines.begin(), lines.end() });
+			}
+		});
+
+		return coverageSummary;
+	}
+
+	//-------------------------------------------------------------------------
+	Plugin::CoverageData ExecutedAddressManager::CreateCoverageData(
+		const std::wstring& name,
+		const LineChanges& lineChanges)
+	{
+		using Lines = std::map<unsigned int, bool>;
+		std::map<Tools::PathId, std::map<Tools::PathId, Lines>> modules;
+
+		for (const auto& line : lineChanges.registeredLines)
+			modules[line.moduleId][line.fileId].emplace(line.lineNumber, false);
+		for (const auto& line : lineChanges.executedLines)
+			modules[line.moduleId][line.fileId][line.lineNumber] = true;
+
+		const auto& pathInterner = Tools::PathInterner::GetInstance();
+		auto coverageData = Plugin::CoverageArena::CreateCoverageData(name, 0);
+
+		for (const auto& module : modules)
+		{
+			auto& moduleCoverage = coverageData.AddModule(
+				pathInterner.GetPath(module.first));
+
+			for (const auto& file : module.second)
+			{
+				auto& fileCoverage = moduleCoverage.AddFile(
+					pathInterner.GetPath(file.first));
+
+				for (const auto& line : file.second)
+					fileCoverage.AddLine(line.first, line.second);
+			}
 		}
 
 		return coverageData;
@@ -186,12 +469,126 @@ namespace CppCoverage
 		while (it != addressLineMap_.end())
 		{
 			if (condition(*it))
+			{
+				--it->second.module_.addressCount_;
 				it = addressLineMap_.erase(it);
+			}
 			else
 				++it;
 		}
 	}
 
+	//-------------------------------------------------------------------------
+	void ExecutedAddressManager::SpillFinishedModulesIfNeeded()
+	{
+		if (!memoryBudget_ || lineCount_ * EstimatedLineSize <= *memoryBudget_)
+			return;
+
+		auto it = modules_.begin();
+		while (it != modules_.end())
+		{
+			auto& module = it->second;
+
+			if (module.addressCount_ == 0)
+			{
+				SpillModule(module);
+				lineCount_ -= module.lineCount_;
+				if (lastModule_.module_ == &module)
+					lastModule_.module_ = nullptr;
+				it = modules_.erase(it);
+			}
+			else
+				++it;
+		}
+	}
+
+	//-------------------------------------------------------------------------
+	void ExecutedAddressManager::SpillModule(const Module& module)
+	{
+		if (!spillFile_)
+			spillFile_ = std::make_unique<SpillFile>();
+
+		auto& ostr = spillFile_->ostr_;
+		Tools::BinaryWriter writer{ ostr };
+		spilledModules_[module.name_].push_back(ostr.tellp());
+
+		writer.Write<uint32_t>(static_cast<uint32_t>(module.files_.size()));
+		for (const auto& file : module.files_)
+		{
+			const auto& lines = file.second.lines;
+
+			writer.Write<uint32_t>(file.first);
+			writer.Write<uint32_t>(static_cast<uint32_t>(lines.size()));
+			for (const auto& line : lines)
+			{
+				writer.Write<uint32_t>(line.first);
+				writer.Write<uint8_t>(line.second);
+			}
+
+			const auto& functions = file.second.functions;
+			writer.Write<uint32_t>(static_cast<uint32_t>(functions.size()));
+			for (const auto& function : functions)
+			{
+				std::wstring name = module.GetFunctionName(function.first);
+
+				writer.Write<uint32_t>(function.first);
+				writer.Write<uint32_t>(function.second.firstLine);
+				writer.Write<uint32_t>(function.second.lastLine);
+				writer.WriteString(name);
+			}
+		}
+
+		if (!ostr)
+			THROW(L"Cannot write to " << spillFile_->path_.wstring());
+		LOG_DEBUG << L"Module " << module.name_ << L" spilled to disk.";
+	}
+
+	//-------------------------------------------------------------------------
+	void ExecutedAddressManager::LoadSpilledModules(
+		const std::vector<std::streamoff>& positions,
+		Module& module) const
+	{
+		std::ifstream istr{ spillFile_->path_, std::ios::binary };
+
+		if (!istr)
+			THROW(L"Cannot open " << spillFile_->path_.wstring());
+
+		for (auto position : positions)
+		{
+			istr.seekg(position);
+			Tools::BinaryReader reader{ istr };
+			auto fileCount = Read<uint32_t>(reader);
+			for (uint32_t i = 0; i < fileCount; ++i)
+			{
+				auto& file = module.files_[Read<uint32_t>(reader)];
+				auto lineCount = Read<uint32_t>(reader);
+
+				for (uint32_t j = 0; j < lineCount; ++j)
+				{
+					auto lineNumber = Read<uint32_t>(reader);
+					bool hasBeenExecuted = Read<uint8_t>(reader) != 0;
+					auto& executed = file.lines[lineNumber];
+
+					executed = executed || hasBeenExecuted;
+				}
+
+				auto functionCount = Read<uint32_t>(reader);
+				for (uint32_t j = 0; j < functionCount; ++j)
+				{
+					auto symbolIndex = Read<uint32_t>(reader);
+					auto firstLine = Read<uint32_t>(reader);
+					auto lastLine = Read<uint32_t>(reader);
+					std::wstring name;
+
+					if (!reader.ReadString(name))
+						THROW("Cannot read spilled coverage.");
+					module.AddFunctionName(symbolIndex, name);
+					file.AddFunctionLines(symbolIndex, firstLine, lastLine);
+				}
+			}
+		}
+	}
+
 	//-------------------------------------------------------------------------
 	void ExecutedAddressManager::OnExitProcess(HANDLE hProcess)
 	{
@@ -199,6 +596,7 @@ namespace CppCoverage
 		{
 			return pair.first.GetProcessHandle() == hProcess;
 		});
+		SpillFinishedModulesIfNeeded();
 	}
 
 	//-------------------------------------------------------------------------
@@ -209,5 +607,6 @@ namespace CppCoverage
 			return pair.first.GetProcessHandle() == hProcess
 				&& pair.second.dllBaseOfImage_ == dllBaseOfImage;
 		});
+		SpillFinishedModulesIfNeeded();
 	}
 }
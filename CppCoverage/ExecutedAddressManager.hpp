@@ -21,15 +21,20 @@
 #include <Windows.h>
 #include <map>
 #include <set>
+#include <ios>
+#include <memory>
+#include <vector>
 #include <boost/optional.hpp>
 
 #include "Plugin/Exporter/CoverageData.hpp"
+#include "Tools/PathInterner.hpp"
 #include "CppCoverageExport.hpp"
 
 namespace CppCoverage
 {
 	class FileCoverage;
 	class Address;
+	class CoverageSummary;
 
 	class CPPCOVERAGE_DLL ExecutedAddressManager
 	{
@@ -37,6 +42,35 @@ namespace CppCoverage
 		ExecutedAddressManager();
 		~ExecutedAddressManager();
 
+		// When the estimated memory used by the collected lines exceeds
+		// memoryBudget (in bytes), modules that are no longer loaded in any
+		// process are written to a temporary file and released.
+		void SetMemoryBudget(boost::optional<size_t> memoryBudget);
+
+		struct LineChange
+		{
+			Tools::PathId moduleId;
+			Tools::PathId fileId;
+			unsigned int lineNumber;
+		};
+
+		// Lines registered and lines executed since the previous call.
+		struct LineChanges
+		{
+			std::vector<LineChange> registeredLines;
+			std::vector<LineChange> executedLines;
+		};
+
+		// Record the changes returned by TakeLineChanges.
+		void EnableLineChangeTracking();
+		LineChanges TakeLineChanges();
+
+		// The lines in executedLines are executed, the other ones in
+		// registeredLines are not.
+		static Plugin::CoverageData CreateCoverageData(
+			const std::wstring& name,
+			const LineChanges&);
+
 		void AddModule(const std::wstring& moduleName, void* dllBaseOfImage);
 		void OnUnloadModule(HANDLE hProcess, void* dllBaseOfImage);
 
@@ -46,16 +80,34 @@ namespace CppCoverage
 			unsigned int line,
 			unsigned char instruction);
 
+		bool RegisterAddress(
+			const Address&,
+			Tools::PathId filenameId,
+			unsigned int line,
+			unsigned char instruction);
+
+		// Functions of the last added module: the line range of a function
+		// in a file is extended with the lines registered for its symbol
+		// index. Lines must be registered first with RegisterAddress.
+		void RegisterFunction(unsigned long symbolIndex, const std::wstring& name);
+		void RegisterFunctionLine(
+			Tools::PathId filenameId,
+			unsigned long symbolIndex,
+			unsigned int line);
+
 		boost::optional<unsigned char> MarkAddressAsExecuted(const Address&);
 
 		Plugin::CoverageData CreateCoverageData(const std::wstring& name, int exitCode) const;
+
+		// Line counts only: function ranges and names are not collected.
+		CoverageSummary CreateCoverageSummary(int exitCode) const;
 		void OnExitProcess(HANDLE hProcess);
 
 	private:
 		struct Module;
 		struct File;
-		struct File;
 		struct Line;
+		struct SpillFile;
 		struct LastModule
 		{
 			Module* module_;
@@ -66,11 +118,22 @@ namespace CppCoverage
 		ExecutedAddressManager& operator=(const ExecutedAddressManager&) = delete;
 
 		Module& GetLastAddedModule();
+		template <typename ModuleHandler>
+		void ForEachModule(ModuleHandler) const;
 		template <typename F>
 		void RemoveAddressLineIf(F fct);
+		void SpillFinishedModulesIfNeeded();
+		void SpillModule(const Module&);
+		void LoadSpilledModules(const std::vector<std::streamoff>&, Module&) const;
 
 		std::map<std::wstring, Module> modules_;
 		std::map<Address, Line> addressLineMap_;
 		LastModule lastModule_;
+		boost::optional<size_t> memoryBudget_;
+		size_t lineCount_;
+		bool isLineChangeTrackingEnabled_;
+		LineChanges lineChanges_;
+		std::unique_ptr<SpillFile> spillFile_;
+		std::map<std::wstring, std::vector<std::streamoff>> spilledModules_;
 	};
 }
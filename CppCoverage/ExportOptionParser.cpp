@@ -105,7 +105,10 @@ namespace CppCoverage
 	const std::string ExportOptionParser::ExportTypeHtmlValue = "html";
 	const std::string ExportOptionParser::ExportTypeCoberturaValue =
 	    "cobertura";
+	const std::string ExportOptionParser::ExportTypeCoberturaDirectoryValue =
+	    "cobertura_directory";
 	const std::string ExportOptionParser::ExportTypeBinaryValue = "binary";
+	const std::string ExportOptionParser::ExportTypeLcovValue = "lcov";
 
 	//-------------------------------------------------------------------------
 	ExportOptionParser::ExportOptionParser(
@@ -118,9 +121,16 @@ namespace CppCoverage
 		exportTypes_.emplace(
 		    Tools::LocalToWString(ExportOptionParser::ExportTypeCoberturaValue),
 		    OptionsExportType::Cobertura);
+		exportTypes_.emplace(
+		    Tools::LocalToWString(
+		        ExportOptionParser::ExportTypeCoberturaDirectoryValue),
+		    OptionsExportType::CoberturaDirectory);
 		exportTypes_.emplace(
 		    Tools::LocalToWString(ExportOptionParser::ExportTypeBinaryValue),
 		    OptionsExportType::Binary);
+		exportTypes_.emplace(
+		    Tools::LocalToWString(ExportOptionParser::ExportTypeLcovValue),
+		    OptionsExportType::Lcov);
 	}
 
 	//----------------------------------------------------------------------------
@@ -171,7 +181,12 @@ namespace CppCoverage
 		     {Tools::LocalToWString(
 		          ExportOptionParser::ExportTypeCoberturaValue),
 		      L"output file (optional)"},
+		     {Tools::LocalToWString(
+		          ExportOptionParser::ExportTypeCoberturaDirectoryValue),
+		      L"output file with a package by source directory (optional)"},
 		     {Tools::LocalToWString(ExportOptionParser::ExportTypeBinaryValue),
+		      L"output file (optional)"},
+		     {Tools::LocalToWString(ExportOptionParser::ExportTypeLcovValue),
 		      L"output file (optional)"}};
 		for (const auto& description : exportPluginDescriptions_)
 		{
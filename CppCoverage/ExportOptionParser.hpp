@@ -32,7 +32,9 @@ namespace CppCoverage
 		static const std::string ExportTypeOption;
 		static const std::string ExportTypeHtmlValue;
 		static const std::string ExportTypeCoberturaValue;
+		static const std::string ExportTypeCoberturaDirectoryValue;
 		static const std::string ExportTypeBinaryValue;
+		static const std::string ExportTypeLcovValue;
 
 		explicit ExportOptionParser(std::vector<ExportPluginDescription>&&);
 
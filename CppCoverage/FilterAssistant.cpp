@@ -125,6 +125,7 @@ namespace CppCoverage
 	void FilterAssistant::OnNewModule(const std::filesystem::path& module,
 	                                  bool isSelected)
 	{
+		std::lock_guard<std::mutex> lock{ mutex_ };
 		suggestedModuleFilter_->OnNewFile(module, isSelected);
 	}
 
@@ -132,6 +133,7 @@ namespace CppCoverage
 	boost::optional<std::filesystem::path>
 	FilterAssistant::ComputeSuggestedModuleFilter() const
 	{
+		std::lock_guard<std::mutex> lock{ mutex_ };
 		return suggestedModuleFilter_->ComputeSuggestedFilter();
 	}
 
@@ -140,6 +142,7 @@ namespace CppCoverage
 	FilterAssistant::OnNewSourceFile(const std::filesystem::path& sourceFile,
 	                              bool isSelected)
 	{
+		std::lock_guard<std::mutex> lock{ mutex_ };
 		suggestedSourceFileFilter_->OnNewFile(sourceFile, isSelected);
 	}
 
@@ -147,13 +150,15 @@ namespace CppCoverage
 	boost::optional<std::filesystem::path>
 	FilterAssistant::ComputeSuggestedSourceFileFilter() const
 	{
+		std::lock_guard<std::mutex> lock{ mutex_ };
 		return suggestedSourceFileFilter_->ComputeSuggestedFilter();
 	}
 
 	//-------------------------------------------------------------------------
 	boost::optional<std::wstring> FilterAssistant::GetAdviceMessage() const
 	{
-		auto suggestedModule = ComputeSuggestedModuleFilter();
+		std::lock_guard<std::mutex> lock{ mutex_ };
+		auto suggestedModule = suggestedModuleFilter_->ComputeSuggestedFilter();
 		if (suggestedModule)
 		{
 			return CppCoverage::GetAdviceMessage(
@@ -169,7 +174,7 @@ namespace CppCoverage
 			    L"files."};
 		}
 
-		auto suggestedSourceFile = ComputeSuggestedSourceFileFilter();
+		auto suggestedSourceFile = suggestedSourceFileFilter_->ComputeSuggestedFilter();
 		if (suggestedSourceFile)
 		{
 			return CppCoverage::GetAdviceMessage(
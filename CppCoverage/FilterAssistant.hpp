@@ -18,6 +18,7 @@
 
 #include <boost/optional/optional_fwd.hpp>
 #include <memory>
+#include <mutex>
 #include <filesystem>
 
 #include "CppCoverageExport.hpp"
@@ -26,6 +27,7 @@ namespace CppCoverage
 {
 	class IFileSystem;
 
+	// Can be used by several threads.
 	class CPPCOVERAGE_DLL FilterAssistant
 	{
 	  public:
@@ -50,5 +52,6 @@ namespace CppCoverage
 
 		std::unique_ptr<SuggestedFilter> suggestedModuleFilter_;
 		std::unique_ptr<SuggestedFilter> suggestedSourceFileFilter_;
+		mutable std::mutex mutex_;
 	};
 }
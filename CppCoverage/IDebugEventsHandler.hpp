@@ -42,6 +42,10 @@ namespace CppCoverage
 		virtual void OnLoadDll(HANDLE hProcess, HANDLE hThread, const LOAD_DLL_DEBUG_INFO&);
 		virtual void OnUnloadDll(HANDLE hProcess, HANDLE hThread, const UNLOAD_DLL_DEBUG_INFO&);
 		virtual ExceptionType OnException(HANDLE hProcess, HANDLE hThread, const EXCEPTION_DEBUG_INFO&);
+
+		// Called after a debug event is continued and when no debug event
+		// arrives before the idle timeout of the debugger.
+		virtual void OnDebuggeeRunning();
 		
 	private:
 		IDebugEventsHandler(const IDebugEventsHandler&) = delete;
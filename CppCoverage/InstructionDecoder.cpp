@@ -0,0 +1,463 @@
+// OpenCppCoverage is an open source code coverage for C++.
+// Copyright (C) 2019 OpenCppCoverage
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "stdafx.h"
+#include "InstructionDecoder.hpp"
+
+namespace CppCoverage
+{
+	namespace
+	{
+		using Kind = InstructionDecoder::Kind;
+		using Mode = InstructionDecoder::Mode;
+		using Instruction = InstructionDecoder::Instruction;
+
+		//---------------------------------------------------------------------
+		bool IsLegacyPrefix(unsigned char value)
+		{
+			switch (value)
+			{
+			case 0xF0: case 0xF2: case 0xF3:
+			case 0x26: case 0x2E: case 0x36: case 0x3E: case 0x64: case 0x65:
+			case 0x66: case 0x67:
+				return true;
+			}
+			return false;
+		}
+
+		//---------------------------------------------------------------------
+		bool HasVexImmediate(unsigned int map, unsigned char opcode)
+		{
+			if (map == 3)
+				return true;
+			return map == 1 &&
+				((opcode >= 0x70 && opcode <= 0x73) || opcode == 0xC2 ||
+				(opcode >= 0xC4 && opcode <= 0xC6));
+		}
+
+		//---------------------------------------------------------------------
+		class Decoder
+		{
+		public:
+			//-----------------------------------------------------------------
+			Decoder(Mode mode, const unsigned char* code, size_t size, std::uint64_t address)
+				: mode_{ mode }
+				, code_{ code }
+				, size_{ size < InstructionDecoder::MaxInstructionLength ? size : InstructionDecoder::MaxInstructionLength }
+				, address_{ address }
+			{
+			}
+
+			//-----------------------------------------------------------------
+			Instruction Decode()
+			{
+				auto opcode = ReadByte();
+				while (isValid_ && IsPrefix(opcode))
+				{
+					if (IsLegacyPrefix(opcode))
+					{
+						operandSize16_ |= opcode == 0x66;
+						addressSizeOverride_ |= opcode == 0x67;
+						// A REX prefix is ignored when it is not the last prefix.
+						rexW_ = false;
+					}
+					else
+						rexW_ = (opcode & 0x08) != 0;
+					opcode = ReadByte();
+				}
+				return DecodeOneByteOpcode(opcode);
+			}
+
+		private:
+			//-----------------------------------------------------------------
+			bool IsPrefix(unsigned char value) const
+			{
+				return IsLegacyPrefix(value) ||
+					(mode_ == Mode::X64 && (value & 0xF0) == 0x40);
+			}
+
+			//-----------------------------------------------------------------
+			Instruction DecodeOneByteOpcode(unsigned char opcode)
+			{
+				if (opcode == 0x0F)
+					return DecodeTwoBytesOpcode();
+				if (opcode < 0x40)
+				{
+					switch (opcode & 0x07)
+					{
+					case 4: return WithImmediate(1);
+					case 5: return WithImmediate(GetImmediateSize());
+					case 6: case 7: return NotInX64(Kind::Other);
+					default: return WithModRm();
+					}
+				}
+				if (opcode < 0x60)
+					return Make(Kind::Other);
+				if (opcode >= 0x70 && opcode <= 0x7F)
+					return MakeRelative(Kind::ConditionalJump, 1);
+				if ((opcode >= 0x84 && opcode <= 0x8F) ||
+					(opcode >= 0xD0 && opcode <= 0xD3) ||
+					(opcode >= 0xD8 && opcode <= 0xDF) || opcode == 0x63 ||
+					opcode == 0xFE)
+					return WithModRm();
+				if ((opcode >= 0x90 && opcode <= 0x99) ||
+					(opcode >= 0x9B && opcode <= 0x9F) ||
+					(opcode >= 0xA4 && opcode <= 0xA7) ||
+					(opcode >= 0xAA && opcode <= 0xAF) ||
+					(opcode >= 0x6C && opcode <= 0x6F) ||
+					(opcode >= 0xEC && opcode <= 0xEF) ||
+					(opcode >= 0xF8 && opcode <= 0xFD) ||
+					opcode == 0xC9 || opcode == 0xD7 || opcode == 0xF5)
+					return Make(Kind::Other);
+				if (opcode >= 0xB0 && opcode <= 0xB7)
+					return WithImmediate(1);
+				if (opcode >= 0xB8 && opcode <= 0xBF)
+					return WithImmediate(rexW_ ? 8 : GetImmediateSize());
+
+				switch (opcode)
+				{
+				case 0x60: case 0x61: return NotInX64(Kind::Other);
+				case 0x62:
+					if (mode_ == Mode::X64 || IsNextByteRegisterModRm())
+						return DecodeEvex();
+					return WithModRm();
+				case 0x68: return WithImmediate(GetImmediateSize());
+				case 0x69: return WithModRm(GetImmediateSize());
+				case 0x6A: return WithImmediate(1);
+				case 0x6B: return WithModRm(1);
+				case 0x80: case 0x83: return WithModRm(1);
+				case 0x81: return WithModRm(GetImmediateSize());
+				case 0x82: return mode_ == Mode::X64 ? Invalid() : WithModRm(1);
+				case 0x9A:
+					if (mode_ == Mode::X64)
+						return Invalid();
+					Skip(GetImmediateSize() + 2);
+					return Make(Kind::Call);
+				case 0xA0: case 0xA1: case 0xA2: case 0xA3:
+					if (mode_ == Mode::X64)
+						return WithImmediate(addressSizeOverride_ ? 4 : 8);
+					return WithImmediate(addressSizeOverride_ ? 2 : 4);
+				case 0xA8: return WithImmediate(1);
+				case 0xA9: return WithImmediate(GetImmediateSize());
+				case 0xC0: case 0xC1: case 0xC6: return WithModRm(1);
+				case 0xC2: case 0xCA:
+					Skip(2);
+					return Make(Kind::Return);
+				case 0xC3: case 0xCB: case 0xCF: return Make(Kind::Return);
+				case 0xC4: case 0xC5:
+					if (mode_ == Mode::X64 || IsNextByteRegisterModRm())
+						return DecodeVex(opcode);
+					return WithModRm();
+				case 0xC7:
+					// XBEGIN jumps to its fallback address on abort.
+					if (position_ < size_ && code_[position_] == 0xF8)
+					{
+						Skip(1);
+						return MakeRelative(Kind::ConditionalJump, GetRelativeSize());
+					}
+					return WithModRm(GetImmediateSize());
+				case 0xC8: return WithImmediate(3);
+				case 0xCC: case 0xF1: case 0xF4: return Make(Kind::Interrupt);
+				case 0xCD:
+					Skip(1);
+					return Make(Kind::Interrupt);
+				case 0xCE: return NotInX64(Kind::Interrupt);
+				case 0xD4: case 0xD5:
+					return mode_ == Mode::X64 ? Invalid() : WithImmediate(1);
+				case 0xD6: return NotInX64(Kind::Other);
+				case 0xE0: case 0xE1: case 0xE2: case 0xE3:
+					return MakeRelative(Kind::ConditionalJump, 1);
+				case 0xE4: case 0xE5: case 0xE6: case 0xE7:
+					return WithImmediate(1);
+				case 0xE8: return MakeRelative(Kind::Call, GetRelativeSize());
+				case 0xE9: return MakeRelative(Kind::Jump, GetRelativeSize());
+				case 0xEA:
+					if (mode_ == Mode::X64)
+						return Invalid();
+					Skip(GetImmediateSize() + 2);
+					return Make(Kind::Jump);
+				case 0xEB: return MakeRelative(Kind::Jump, 1);
+				case 0xF6: case 0xF7: return DecodeGroup3(opcode);
+				case 0xFF: return DecodeGroup5();
+				}
+				return Invalid();
+			}
+
+			//-----------------------------------------------------------------
+			Instruction DecodeGroup3(unsigned char opcode)
+			{
+				SkipModRm();
+				// Only TEST has an immediate operand.
+				if (reg_ <= 1)
+					Skip(opcode == 0xF6 ? 1 : GetImmediateSize());
+				return Make(Kind::Other);
+			}
+
+			//-----------------------------------------------------------------
+			Instruction DecodeGroup5()
+			{
+				SkipModRm();
+				switch (reg_)
+				{
+				case 2: case 3: return Make(Kind::Call);
+				case 4: case 5: return Make(Kind::IndirectJump);
+				case 7: return Invalid();
+				}
+				return Make(Kind::Other);
+			}
+
+			//-----------------------------------------------------------------
+			Instruction DecodeTwoBytesOpcode()
+			{
+				auto opcode = ReadByte();
+
+				if (opcode >= 0x80 && opcode <= 0x8F)
+					return MakeRelative(Kind::ConditionalJump, GetRelativeSize());
+				if ((opcode >= 0x10 && opcode <= 0x1F) ||
+					(opcode >= 0x28 && opcode <= 0x2F) ||
+					(opcode >= 0x40 && opcode <= 0x6F) ||
+					(opcode >= 0x74 && opcode <= 0x76) ||
+					(opcode >= 0x78 && opcode <= 0x7F) ||
+					(opcode >= 0x90 && opcode <= 0x9F) ||
+					(opcode >= 0xB0 && opcode <= 0xB8) ||
+					(opcode >= 0xBB && opcode <= 0xBF) ||
+					(opcode >= 0xD0 && opcode <= 0xFE) ||
+					(opcode <= 0x03) || opcode == 0x0D || opcode == 0xA3 ||
+					opcode == 0xA5 || opcode == 0xAB || opcode == 0xAD ||
+					opcode == 0xAE || opcode == 0xAF || opcode == 0xC0 ||
+					opcode == 0xC1 || opcode == 0xC3 || opcode == 0xC7)
+					return WithModRm();
+				if ((opcode >= 0x70 && opcode <= 0x73) ||
+					(opcode >= 0xC4 && opcode <= 0xC6) || opcode == 0xA4 ||
+					opcode == 0xAC || opcode == 0xBA || opcode == 0xC2 ||
+					opcode == 0x0F)
+					return WithModRm(1);
+				if ((opcode >= 0x05 && opcode <= 0x09) ||
+					(opcode >= 0x30 && opcode <= 0x35) ||
+					(opcode >= 0xC8 && opcode <= 0xCF) ||
+					(opcode >= 0xA0 && opcode <= 0xA2) ||
+					(opcode >= 0xA8 && opcode <= 0xAA) || opcode == 0x0E ||
+					opcode == 0x37 || opcode == 0x77)
+					return Make(Kind::Other);
+
+				switch (opcode)
+				{
+				case 0x0B: return Make(Kind::Interrupt);
+				case 0xB9: case 0xFF:
+					SkipModRm();
+					return Make(Kind::Interrupt);
+				case 0x20: case 0x21: case 0x22: case 0x23:
+					// The mod field of MOV CR/DR is ignored.
+					Skip(1);
+					return Make(Kind::Other);
+				case 0x38:
+					Skip(1);
+					return WithModRm();
+				case 0x3A:
+					Skip(1);
+					return WithModRm(1);
+				}
+				return Invalid();
+			}
+
+			//-----------------------------------------------------------------
+			Instruction DecodeVex(unsigned char opcode)
+			{
+				unsigned int map = 1;
+				if (opcode == 0xC4)
+				{
+					map = ReadByte() & 0x1F;
+					Skip(1);
+				}
+				else
+					Skip(1);
+				if (map < 1 || map > 3)
+					return Invalid();
+				auto vexOpcode = ReadByte();
+				// VZEROUPPER and VZEROALL have no ModR/M byte.
+				if (map == 1 && vexOpcode == 0x77)
+					return Make(Kind::Other);
+				return WithModRm(HasVexImmediate(map, vexOpcode) ? 1 : 0);
+			}
+
+			//-----------------------------------------------------------------
+			Instruction DecodeEvex()
+			{
+				auto map = ReadByte() & 0x07u;
+				Skip(2);
+				if (map == 0 || map == 4 || map == 7)
+					return Invalid();
+				auto evexOpcode = ReadByte();
+				return WithModRm(HasVexImmediate(map, evexOpcode) ? 1 : 0);
+			}
+
+			//-----------------------------------------------------------------
+			void SkipModRm()
+			{
+				auto modRm = ReadByte();
+				auto mod = modRm >> 6;
+				auto rm = modRm & 0x07;
+
+				reg_ = (modRm >> 3) & 0x07;
+				if (mod == 3)
+					return;
+				if (mode_ == Mode::X86 && addressSizeOverride_)
+				{
+					if (mod == 0 && rm == 6)
+						Skip(2);
+					else
+						Skip(mod == 1 ? 1 : mod == 2 ? 2 : 0);
+					return;
+				}
+				if (rm == 4)
+				{
+					auto sib = ReadByte();
+					if (mod == 0 && (sib & 0x07) == 5)
+						Skip(4);
+				}
+				if (mod == 0 && rm == 5)
+					Skip(4);
+				else
+					Skip(mod == 1 ? 1 : mod == 2 ? 4 : 0);
+			}
+
+			//-----------------------------------------------------------------
+			Instruction WithModRm(size_t immediateSize = 0)
+			{
+				SkipModRm();
+				return WithImmediate(immediateSize);
+			}
+
+			//-----------------------------------------------------------------
+			Instruction WithImmediate(size_t immediateSize)
+			{
+				Skip(immediateSize);
+				return Make(Kind::Other);
+			}
+
+			//-----------------------------------------------------------------
+			Instruction MakeRelative(Kind kind, size_t offsetSize)
+			{
+				std::uint64_t offset = 0;
+				for (size_t i = 0; i < offsetSize; ++i)
+					offset |= static_cast<std::uint64_t>(ReadByte()) << (8 * i);
+				// Sign extension
+				auto signBit = std::uint64_t{ 1 } << (8 * offsetSize - 1);
+				offset = (offset ^ signBit) - signBit;
+
+				std::uint64_t target = address_ + position_ + offset;
+				if (offsetSize == 2)
+					target &= 0xFFFF;
+				else if (mode_ == Mode::X86)
+					target &= 0xFFFFFFFF;
+				return Make(kind, target);
+			}
+
+			//-----------------------------------------------------------------
+			Instruction NotInX64(Kind kind)
+			{
+				return mode_ == Mode::X64 ? Invalid() : Make(kind);
+			}
+
+			//-----------------------------------------------------------------
+			Instruction Make(Kind kind, boost::optional<std::uint64_t> target = boost::none)
+			{
+				if (!isValid_)
+					return Invalid();
+				return { position_, kind, target };
+			}
+
+			//-----------------------------------------------------------------
+			Instruction Invalid() const
+			{
+				return { 0, Kind::Invalid, boost::none };
+			}
+
+			//-----------------------------------------------------------------
+			size_t GetImmediateSize() const
+			{
+				return operandSize16_ ? 2 : 4;
+			}
+
+			//-----------------------------------------------------------------
+			size_t GetRelativeSize() const
+			{
+				return mode_ == Mode::X86 && operandSize16_ ? 2 : 4;
+			}
+
+			//-----------------------------------------------------------------
+			bool IsNextByteRegisterModRm() const
+			{
+				return position_ < size_ && (code_[position_] & 0xC0) == 0xC0;
+			}
+
+			//-----------------------------------------------------------------
+			unsigned char ReadByte()
+			{
+				if (position_ >= size_)
+				{
+					isValid_ = false;
+					return 0;
+				}
+				return code_[position_++];
+			}
+
+			//-----------------------------------------------------------------
+			void Skip(size_t count)
+			{
+				if (size_ - position_ < count)
+				{
+					isValid_ = false;
+					position_ = size_;
+				}
+				else
+					position_ += count;
+			}
+
+			const Mode mode_;
+			const unsigned char* const code_;
+			const size_t size_;
+			const std::uint64_t address_;
+			size_t position_ = 0;
+			bool isValid_ = true;
+			bool operandSize16_ = false;
+			bool addressSizeOverride_ = false;
+			bool rexW_ = false;
+			unsigned int reg_ = 0;
+		};
+	}
+
+	//-------------------------------------------------------------------------
+	InstructionDecoder::InstructionDecoder(Mode mode)
+		: mode_{ mode }
+	{
+	}
+
+	//-------------------------------------------------------------------------
+	InstructionDecoder::Instruction InstructionDecoder::Decode(
+		const unsigned char* code,
+		size_t size,
+		std::uint64_t address) const
+	{
+		return Decoder{ mode_, code, size, address }.Decode();
+	}
+
+	//-------------------------------------------------------------------------
+	bool InstructionDecoder::IsControlTransfer(Kind kind)
+	{
+		return kind != Kind::Other;
+	}
+}
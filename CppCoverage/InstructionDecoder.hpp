@@ -0,0 +1,75 @@
+// OpenCppCoverage is an open source code coverage for C++.
+// Copyright (C) 2019 OpenCppCoverage
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <boost/optional.hpp>
+
+#include "CppCoverageExport.hpp"
+
+namespace CppCoverage
+{
+	// Decode the length of x86 and x64 instructions and the way they
+	// transfer control. Operands other than branch targets are skipped.
+	class CPPCOVERAGE_DLL InstructionDecoder
+	{
+	public:
+		enum class Mode
+		{
+			X86,
+			X64
+		};
+
+		enum class Kind
+		{
+			Other,
+			Jump,
+			ConditionalJump,
+			IndirectJump,
+			Call,
+			Return,
+			Interrupt,
+			Invalid
+		};
+
+		struct Instruction
+		{
+			size_t length_;
+			Kind kind_;
+			// Set only for the relative jumps and calls.
+			boost::optional<std::uint64_t> target_;
+		};
+
+		static const size_t MaxInstructionLength = 15;
+
+		explicit InstructionDecoder(Mode);
+
+		// Decode the instruction at the beginning of code. address is the
+		// address of code in the debuggee. Return an instruction of kind
+		// Invalid when the bytes are not a valid instruction or are
+		// truncated.
+		Instruction Decode(const unsigned char* code, size_t size, std::uint64_t address) const;
+
+		// Return true if the execution does not always continue with the
+		// next instruction.
+		static bool IsControlTransfer(Kind);
+
+	private:
+		const Mode mode_;
+	};
+}
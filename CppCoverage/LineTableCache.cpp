@@ -0,0 +1,159 @@
+// OpenCppCoverage is an open source code coverage for C++.
+// Copyright (C) 2019 OpenCppCoverage
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "stdafx.h"
+#include "LineTableCache.hpp"
+
+#include "Tools/Log.hpp"
+#include "Tools/PathInterner.hpp"
+
+namespace CppCoverage
+{
+	//-------------------------------------------------------------------------
+	struct LineTableCache::LineTable
+	{
+		struct SourceFile
+		{
+			std::filesystem::path path_;
+			std::vector<IDebugInformationHandler::Line> lines_;
+		};
+
+		//---------------------------------------------------------------------
+		bool IsPdbUnchanged() const
+		{
+			if (pdbPath_.empty())
+				return true;
+
+			std::error_code error;
+			auto pdbLastWriteTime = std::filesystem::last_write_time(pdbPath_, error);
+			return !error && pdbLastWriteTime == pdbLastWriteTime_;
+		}
+
+		std::filesystem::file_time_type lastWriteTime_;
+		std::filesystem::path pdbPath_;
+		std::filesystem::file_time_type pdbLastWriteTime_;
+		std::vector<std::pair<unsigned long, std::wstring>> functions_;
+		std::vector<SourceFile> sourceFiles_;
+	};
+
+	//-------------------------------------------------------------------------
+	// Forward the debug information and record the selected source files.
+	class LineTableCache::Recorder : public IDebugInformationHandler
+	{
+	public:
+		//---------------------------------------------------------------------
+		Recorder(IDebugInformationHandler& handler, LineTable& lineTable)
+			: handler_{ handler }
+			, lineTable_{ lineTable }
+		{
+		}
+
+		//---------------------------------------------------------------------
+		bool IsSourceFileSelected(const std::filesystem::path& path) override
+		{
+			return handler_.IsSourceFileSelected(path);
+		}
+
+		//---------------------------------------------------------------------
+		void OnSourceFile(const std::filesystem::path& path,
+		                  const std::vector<Line>& lines) override
+		{
+			lineTable_.sourceFiles_.push_back(LineTable::SourceFile{ path, lines });
+			handler_.OnSourceFile(path, lines);
+		}
+
+		//---------------------------------------------------------------------
+		void OnFunction(unsigned long symbolIndex, const std::wstring& name) override
+		{
+			lineTable_.functions_.emplace_back(symbolIndex, name);
+			handler_.OnFunction(symbolIndex, name);
+		}
+
+	private:
+		IDebugInformationHandler& handler_;
+		LineTable& lineTable_;
+	};
+
+	//-------------------------------------------------------------------------
+	LineTableCache::~LineTableCache() = default;
+
+	//-------------------------------------------------------------------------
+	bool LineTableCache::Enumerate(
+		const std::filesystem::path& modulePath,
+		DebugInformationEnumerator& debugInformationEnumerator,
+		IDebugInformationHandler& handler)
+	{
+		auto& pathInterner = Tools::PathInterner::GetInstance();
+		const auto& key = pathInterner.GetNormalizedPath(pathInterner.Intern(modulePath));
+
+		std::error_code error;
+		auto lastWriteTime = std::filesystem::last_write_time(modulePath, error);
+		if (error)
+			return debugInformationEnumerator.Enumerate(modulePath, handler);
+
+		auto cachedLineTable = Find(key, lastWriteTime);
+		if (cachedLineTable && cachedLineTable->IsPdbUnchanged())
+		{
+			LOG_DEBUG << L"Use cached lines of " << modulePath.wstring();
+			for (const auto& function : cachedLineTable->functions_)
+				handler.OnFunction(function.first, function.second);
+			for (const auto& sourceFile : cachedLineTable->sourceFiles_)
+				handler.OnSourceFile(sourceFile.path_, sourceFile.lines_);
+			return true;
+		}
+
+		auto lineTable = std::make_shared<LineTable>();
+		lineTable->lastWriteTime_ = lastWriteTime;
+
+		Recorder recorder{ handler, *lineTable };
+		// A module without debug information is not cached as its pdb
+		// can be added later.
+		if (!debugInformationEnumerator.Enumerate(modulePath, recorder))
+			return false;
+
+		lineTable->pdbPath_ = debugInformationEnumerator.GetPdbPath();
+		if (!lineTable->pdbPath_.empty())
+		{
+			lineTable->pdbLastWriteTime_ = std::filesystem::last_write_time(lineTable->pdbPath_, error);
+			if (error)
+				return true;
+		}
+
+		std::lock_guard<std::mutex> lock{ mutex_ };
+		lineTables_[key] = lineTable;
+		return true;
+	}
+
+	//-------------------------------------------------------------------------
+	void LineTableCache::Clear()
+	{
+		std::lock_guard<std::mutex> lock{ mutex_ };
+		lineTables_.clear();
+	}
+
+	//-------------------------------------------------------------------------
+	std::shared_ptr<const LineTableCache::LineTable> LineTableCache::Find(
+		const std::wstring& key,
+		std::filesystem::file_time_type lastWriteTime) const
+	{
+		std::lock_guard<std::mutex> lock{ mutex_ };
+		auto it = lineTables_.find(key);
+
+		if (it == lineTables_.end() || it->second->lastWriteTime_ != lastWriteTime)
+			return nullptr;
+		return it->second;
+	}
+}
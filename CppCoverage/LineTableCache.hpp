@@ -0,0 +1,62 @@
+// OpenCppCoverage is an open source code coverage for C++.
+// Copyright (C) 2019 OpenCppCoverage
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "DebugInformationEnumerator.hpp"
+#include "CppCoverageExport.hpp"
+
+namespace CppCoverage
+{
+	// Keep the lines of the selected source files of each module so the
+	// debug information of a module is read once even if the module is
+	// loaded by several processes. The source file selection must be the
+	// same for all the handlers given to Enumerate: call Clear when it
+	// changes. A module is read again when it or its pdb is rebuilt.
+	class CPPCOVERAGE_DLL LineTableCache
+	{
+	public:
+		LineTableCache() = default;
+		~LineTableCache();
+
+		bool Enumerate(
+			const std::filesystem::path& modulePath,
+			DebugInformationEnumerator&,
+			IDebugInformationHandler&);
+
+		void Clear();
+
+	private:
+		LineTableCache(const LineTableCache&) = delete;
+		LineTableCache& operator=(const LineTableCache&) = delete;
+
+		struct LineTable;
+		class Recorder;
+
+		std::shared_ptr<const LineTable> Find(
+			const std::wstring& key,
+			std::filesystem::file_time_type lastWriteTime) const;
+
+		mutable std::mutex mutex_;
+		std::unordered_map<std::wstring, std::shared_ptr<const LineTable>> lineTables_;
+	};
+}
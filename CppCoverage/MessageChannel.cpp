@@ -0,0 +1,215 @@
+// OpenCppCoverage is an open source code coverage for C++.
+// Copyright (C) 2019 OpenCppCoverage
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "stdafx.h"
+#include "MessageChannel.hpp"
+
+#include <chrono>
+#include <thread>
+
+#include "CppCoverageException.hpp"
+
+namespace CppCoverage
+{
+	namespace
+	{
+		const DWORD PipeBufferSize = 64 * 1024;
+		const std::chrono::milliseconds ConnectTimeout{ 5000 };
+		const std::chrono::milliseconds ConnectRetryDelay{ 10 };
+
+		//---------------------------------------------------------------------
+		std::wstring GetPipePath(const std::wstring& pipeName)
+		{
+			return L"\\\\.\\pipe\\" + pipeName;
+		}
+	}
+
+	const uint32_t NamedPipeChannel::MaxMessageSize = 256 * 1024 * 1024;
+
+	//-------------------------------------------------------------------------
+	std::unique_ptr<NamedPipeChannel> NamedPipeChannel::Connect(const std::wstring& pipeName)
+	{
+		auto pipePath = GetPipePath(pipeName);
+		auto deadline = std::chrono::steady_clock::now() + ConnectTimeout;
+
+		for (;;)
+		{
+			auto pipe = CreateFileW(pipePath.c_str(), GENERIC_READ | GENERIC_WRITE,
+				0, nullptr, OPEN_EXISTING, 0, nullptr);
+
+			if (pipe != INVALID_HANDLE_VALUE)
+				return std::make_unique<NamedPipeChannel>(pipe, false);
+
+			// The pipe does not exist when the server is starting and all its
+			// instances are busy when it is accepting another client.
+			auto lastError = GetLastError();
+			if (lastError != ERROR_PIPE_BUSY && lastError != ERROR_FILE_NOT_FOUND)
+				THROW_LAST_ERROR(L"Cannot connect to " << pipePath << L": ", lastError);
+			if (std::chrono::steady_clock::now() >= deadline)
+				THROW_LAST_ERROR(L"Timeout while connecting to " << pipePath << L": ", lastError);
+			if (lastError == ERROR_PIPE_BUSY)
+				WaitNamedPipeW(pipePath.c_str(), static_cast<DWORD>(ConnectRetryDelay.count()));
+			else
+				std::this_thread::sleep_for(ConnectRetryDelay);
+		}
+	}
+
+	//-------------------------------------------------------------------------
+	NamedPipeChannel::NamedPipeChannel(HANDLE pipe, bool isServerSide)
+		: pipe_{ pipe }
+		, isServerSide_{ isServerSide }
+	{
+	}
+
+	//-------------------------------------------------------------------------
+	NamedPipeChannel::~NamedPipeChannel()
+	{
+		if (isServerSide_)
+		{
+			// Let the client read the last message before disconnecting.
+			FlushFileBuffers(pipe_);
+			DisconnectNamedPipe(pipe_);
+		}
+		CloseHandle(pipe_);
+	}
+
+	//-------------------------------------------------------------------------
+	void NamedPipeChannel::Write(const std::string& message)
+	{
+		if (message.size() > MaxMessageSize)
+			THROW(L"Message of " << message.size() << L" bytes is too large for the named pipe.");
+
+		auto size = static_cast<uint32_t>(message.size());
+		std::string buffer{ reinterpret_cast<const char*>(&size), sizeof(size) };
+		buffer += message;
+
+		size_t offset = 0;
+		while (offset < buffer.size())
+		{
+			DWORD written = 0;
+			auto toWrite = static_cast<DWORD>(
+				std::min<size_t>(buffer.size() - offset, PipeBufferSize));
+
+			if (!WriteFile(pipe_, buffer.data() + offset, toWrite, &written, nullptr))
+				THROW_LAST_ERROR(L"Cannot write to named pipe: ", GetLastError());
+			offset += written;
+		}
+	}
+
+	//-------------------------------------------------------------------------
+	boost::optional<std::string> NamedPipeChannel::Read()
+	{
+		uint32_t size = 0;
+
+		if (!ReadBuffer(reinterpret_cast<char*>(&size), sizeof(size)))
+			return boost::none;
+		if (size > MaxMessageSize)
+			THROW(L"Invalid named pipe message size: " << size);
+
+		std::string message(size, '\0');
+		if (size && !ReadBuffer(&message[0], size))
+			THROW(L"Named pipe closed in the middle of a message.");
+		return message;
+	}
+
+	//-------------------------------------------------------------------------
+	bool NamedPipeChannel::ReadBuffer(char* buffer, size_t size)
+	{
+		size_t offset = 0;
+
+		while (offset < size)
+		{
+			DWORD read = 0;
+			auto toRead = static_cast<DWORD>(std::min<size_t>(size - offset, PipeBufferSize));
+
+			if (!ReadFile(pipe_, buffer + offset, toRead, &read, nullptr))
+			{
+				auto lastError = GetLastError();
+				if (lastError == ERROR_BROKEN_PIPE && offset == 0)
+					return false;
+				THROW_LAST_ERROR(L"Cannot read from named pipe: ", lastError);
+			}
+			if (read == 0)
+				return false;
+			offset += read;
+		}
+		return true;
+	}
+
+	//-------------------------------------------------------------------------
+	NamedPipeListener::NamedPipeListener(const std::wstring& pipeName)
+		: pipePath_{ GetPipePath(pipeName) }
+		, pendingPipe_{ CreatePipeInstance() }
+		, isClosed_{ false }
+	{
+	}
+
+	//-------------------------------------------------------------------------
+	NamedPipeListener::~NamedPipeListener()
+	{
+		CloseHandle(pendingPipe_);
+	}
+
+	//-------------------------------------------------------------------------
+	std::unique_ptr<IMessageChannel> NamedPipeListener::Accept()
+	{
+		if (isClosed_)
+			return nullptr;
+
+		DWORD lastError = ERROR_SUCCESS;
+		if (!ConnectNamedPipe(pendingPipe_, nullptr))
+			lastError = GetLastError();
+		if (isClosed_)
+			return nullptr;
+		if (lastError != ERROR_SUCCESS && lastError != ERROR_PIPE_CONNECTED)
+			THROW_LAST_ERROR(L"Cannot connect named pipe " << pipePath_ << L": ", lastError);
+
+		// Replace the connected instance before handling its client.
+		auto pipe = pendingPipe_;
+		pendingPipe_ = CreatePipeInstance();
+		return std::make_unique<NamedPipeChannel>(pipe, true);
+	}
+
+	//-------------------------------------------------------------------------
+	void NamedPipeListener::Close()
+	{
+		isClosed_ = true;
+
+		// Wake up a pending Accept.
+		auto pipe = CreateFileW(pipePath_.c_str(), GENERIC_READ | GENERIC_WRITE,
+			0, nullptr, OPEN_EXISTING, 0, nullptr);
+		if (pipe != INVALID_HANDLE_VALUE)
+			CloseHandle(pipe);
+	}
+
+	//-------------------------------------------------------------------------
+	HANDLE NamedPipeListener::CreatePipeInstance() const
+	{
+		auto pipe = CreateNamedPipeW(
+			pipePath_.c_str(),
+			PIPE_ACCESS_DUPLEX,
+			PIPE_TYPE_BYTE | PIPE_READMODE_BYTE | PIPE_WAIT | PIPE_REJECT_REMOTE_CLIENTS,
+			PIPE_UNLIMITED_INSTANCES,
+			PipeBufferSize,
+			PipeBufferSize,
+			0,
+			nullptr);
+
+		if (pipe == INVALID_HANDLE_VALUE)
+			THROW_LAST_ERROR(L"Cannot create named pipe " << pipePath_ << L": ", GetLastError());
+		return pipe;
+	}
+}
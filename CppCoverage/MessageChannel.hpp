@@ -0,0 +1,110 @@
+// OpenCppCoverage is an open source code coverage for C++.
+// Copyright (C) 2019 OpenCppCoverage
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <boost/optional.hpp>
+
+#include <Windows.h>
+
+#include "CppCoverageExport.hpp"
+
+namespace CppCoverage
+{
+	//-------------------------------------------------------------------------
+	// Connection exchanging whole messages in both directions.
+	//-------------------------------------------------------------------------
+	class CPPCOVERAGE_DLL IMessageChannel
+	{
+	public:
+		virtual ~IMessageChannel() = default;
+
+		virtual void Write(const std::string& message) = 0;
+
+		// Return boost::none when the other side closed the connection.
+		virtual boost::optional<std::string> Read() = 0;
+	};
+
+	//-------------------------------------------------------------------------
+	class CPPCOVERAGE_DLL IMessageChannelListener
+	{
+	public:
+		virtual ~IMessageChannelListener() = default;
+
+		// Wait for the next client. Return nullptr when there are no more
+		// clients.
+		virtual std::unique_ptr<IMessageChannel> Accept() = 0;
+
+		// Can be called from another thread. Accept returns nullptr after
+		// Close, possibly once the pending connections are accepted.
+		virtual void Close() = 0;
+	};
+
+	//-------------------------------------------------------------------------
+	// Messages are sent on the local named pipe \\.\pipe\<name> prefixed by
+	// their size.
+	//-------------------------------------------------------------------------
+	class CPPCOVERAGE_DLL NamedPipeChannel : public IMessageChannel
+	{
+	public:
+		// Larger messages are rejected on both sides.
+		static const uint32_t MaxMessageSize;
+
+		static std::unique_ptr<NamedPipeChannel> Connect(const std::wstring& pipeName);
+
+		NamedPipeChannel(HANDLE pipe, bool isServerSide);
+		~NamedPipeChannel();
+
+		void Write(const std::string& message) override;
+		boost::optional<std::string> Read() override;
+
+	private:
+		NamedPipeChannel(const NamedPipeChannel&) = delete;
+		NamedPipeChannel& operator=(const NamedPipeChannel&) = delete;
+
+		bool ReadBuffer(char* buffer, size_t size);
+
+		HANDLE pipe_;
+		const bool isServerSide_;
+	};
+
+	//-------------------------------------------------------------------------
+	// A pipe instance is always waiting for the next client, including while
+	// the previous clients are handled.
+	//-------------------------------------------------------------------------
+	class CPPCOVERAGE_DLL NamedPipeListener : public IMessageChannelListener
+	{
+	public:
+		explicit NamedPipeListener(const std::wstring& pipeName);
+		~NamedPipeListener();
+
+		std::unique_ptr<IMessageChannel> Accept() override;
+		void Close() override;
+
+	private:
+		NamedPipeListener(const NamedPipeListener&) = delete;
+		NamedPipeListener& operator=(const NamedPipeListener&) = delete;
+
+		HANDLE CreatePipeInstance() const;
+
+		const std::wstring pipePath_;
+		HANDLE pendingPipe_;
+		std::atomic<bool> isClosed_;
+	};
+}
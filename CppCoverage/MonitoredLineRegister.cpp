@@ -24,12 +24,16 @@
 #include "ExecutedAddressManager.hpp"
 #include "CppCoverageException.hpp"
 #include "FilterAssistant.hpp"
+#include "LineTableCache.hpp"
 
 #include "FileFilter/ModuleInfo.hpp"
 #include "FileFilter/FileInfo.hpp"
 #include "FileFilter/LineInfo.hpp"
 
 #include "Tools/PEFileHeader.hpp"
+#include "Tools/ProcessMemory.hpp"
+#include "Tools/ScopedAction.hpp"
+#include "Tools/PathInterner.hpp"
 #include "Tools/Log.hpp"
 
 namespace CppCoverage
@@ -47,6 +51,18 @@ namespace CppCoverage
 				return isNativeModule_;
 			}
 
+			//----------------------------------------------------------------------------
+			InstructionDecoder::Mode GetInstructionMode() const
+			{
+				return instructionMode_;
+			}
+
+			//----------------------------------------------------------------------------
+			size_t GetSizeOfImage() const
+			{
+				return sizeOfImage_;
+			}
+
 		  private:
 			//-----------------------------------------------------------------
 			template <typename T_IMAGE_NT_HEADERS>
@@ -58,6 +74,7 @@ namespace CppCoverage
 				        .DataDirectory[IMAGE_DIRECTORY_ENTRY_COM_DESCRIPTOR];
 				isNativeModule_ = dataDirectory.VirtualAddress == 0 &&
 				                  dataDirectory.Size == 0;
+				sizeOfImage_ = optionalHeader.SizeOfImage;
 			}
 
 			//-----------------------------------------------------------------
@@ -66,6 +83,7 @@ namespace CppCoverage
 			                  const IMAGE_NT_HEADERS32& ntHeader) override
 			{
 				OnNtHeader(ntHeader);
+				instructionMode_ = InstructionDecoder::Mode::X86;
 			}
 
 			//-----------------------------------------------------------------
@@ -74,9 +92,12 @@ namespace CppCoverage
 			                  const IMAGE_NT_HEADERS64& ntHeader) override
 			{
 				OnNtHeader(ntHeader);
+				instructionMode_ = InstructionDecoder::Mode::X64;
 			}
 
 			bool isNativeModule_ = true;
+			InstructionDecoder::Mode instructionMode_ = InstructionDecoder::Mode::X64;
+			size_t sizeOfImage_ = 0;
 		};
 	}
 
@@ -86,12 +107,16 @@ namespace CppCoverage
 	    std::shared_ptr<ExecutedAddressManager> executedAddressManager,
 	    std::shared_ptr<ICoverageFilterManager> coverageFilterManager,
 	    std::unique_ptr<DebugInformationEnumerator> debugInformationEnumerator,
-	    std::shared_ptr<FilterAssistant> filterAssistant)
+	    std::shared_ptr<FilterAssistant> filterAssistant,
+	    std::shared_ptr<LineTableCache> lineTableCache,
+	    bool basicBlockBreakPoints)
 	    : breakPoint_{breakPoint},
 	      executedAddressManager_{executedAddressManager},
 	      coverageFilterManager_{coverageFilterManager},
 	      debugInformationEnumerator_{std::move(debugInformationEnumerator)},
-	      filterAssistant_{std::move(filterAssistant)}
+	      filterAssistant_{std::move(filterAssistant)},
+	      lineTableCache_{std::move(lineTableCache)},
+	      basicBlockBreakPoints_{basicBlockBreakPoints}
 	{
 	}
 
@@ -104,7 +129,8 @@ namespace CppCoverage
 	    HANDLE hProcess,
 	    void* baseOfImage)
 	{
-		if (!ModuleKind{}.IsNativeModule(
+		ModuleKind moduleKind;
+		if (!moduleKind.IsNativeModule(
 		        hProcess, reinterpret_cast<DWORD64>(baseOfImage)))
 		{
 			LOG_INFO << modulePath.wstring()
@@ -117,7 +143,24 @@ namespace CppCoverage
 		moduleInfo_ = std::make_unique<FileFilter::ModuleInfo>(
 		    hProcess, modulePath, baseOfImage);
 
-		return debugInformationEnumerator_->Enumerate(modulePath, *this);
+		Tools::ScopedAction releaseScratchArena{[&]() {
+			basicBlockLines_.clear();
+			pendingSourceFiles_.clear();
+			scratchArena_.release();
+		}};
+
+		auto isEnumerated =
+		    lineTableCache_
+		        ? lineTableCache_->Enumerate(
+		              modulePath, *debugInformationEnumerator_, *this)
+		        : debugInformationEnumerator_->Enumerate(modulePath, *this);
+
+		if (basicBlockBreakPoints_)
+		{
+			SetPendingBreakPoints(moduleKind.GetInstructionMode(),
+			                      moduleKind.GetSizeOfImage());
+		}
+		return isEnumerated;
 	}
 
 	//--------------------------------------------------------------------------
@@ -134,8 +177,9 @@ namespace CppCoverage
 	MonitoredLineRegister::OnSourceFile(const std::filesystem::path& path,
 	                                    const std::vector<Line>& lines)
 	{
-		std::vector<FileFilter::LineInfo> lineInfos;
+		std::pmr::vector<FileFilter::LineInfo> lineInfos{&scratchArena_};
 
+		lineInfos.reserve(lines.size());
 		for (const auto& line : lines)
 		{
 			lineInfos.emplace_back(
@@ -144,33 +188,127 @@ namespace CppCoverage
 
 		FileFilter::FileInfo fileInfo{path, std::move(lineInfos)};
 		const auto& moduleInfo = GetModuleInfo();
+		auto pathId = Tools::PathInterner::GetInstance().Intern(path);
+		std::pmr::vector<MonitoredLine> monitoredLines{&scratchArena_};
 
-		std::vector<DWORD64> addresses;
-		LineNumberByAddress lineNumberByAddress;
-
+		monitoredLines.reserve(fileInfo.lineInfoColllection_.size());
 		for (const auto& lineInfo : fileInfo.lineInfoColllection_)
 		{
-			auto lineNumber = lineInfo.lineNumber_;
-			if (coverageFilterManager_->IsLineSelected(
-			        moduleInfo, fileInfo, lineInfo))
+			auto addressValue =
+			    lineInfo.virtualAddress_ +
+			    reinterpret_cast<DWORD64>(moduleInfo.baseOfImage_);
+			auto isSelected = coverageFilterManager_->IsLineSelected(
+			    moduleInfo, fileInfo, lineInfo);
+
+			if (isSelected)
 			{
-				auto addressValue =
-				    lineInfo.virtualAddress_ +
-				    reinterpret_cast<DWORD64>(moduleInfo.baseOfImage_);
+				monitoredLines.push_back(
+				    {addressValue, lineInfo.lineNumber_, lineInfo.symbolIndex_});
+			}
+			// Lines not selected still split the code into basic blocks.
+			if (basicBlockBreakPoints_)
+			{
+				basicBlockLines_.push_back(
+				    {addressValue, lineInfo.symbolIndex_, pathId, isSelected});
+			}
+		}
+
+		if (basicBlockBreakPoints_)
+			pendingSourceFiles_.push_back({pathId, std::move(monitoredLines)});
+		else
+			SetBreakPoints(pathId, monitoredLines, nullptr);
+	}
+
+	//--------------------------------------------------------------------------
+	void MonitoredLineRegister::OnFunction(unsigned long symbolIndex,
+	                                       const std::wstring& name)
+	{
+		executedAddressManager_->RegisterFunction(symbolIndex, name);
+	}
+
+	//--------------------------------------------------------------------------
+	void MonitoredLineRegister::SetBreakPoints(
+	    Tools::PathId pathId,
+	    const std::pmr::vector<MonitoredLine>& monitoredLines,
+	    const BasicBlockLeaders* basicBlockLeaders)
+	{
+		// addresses is moved to BreakPoint so it stays on the default heap.
+		std::vector<DWORD64> addresses;
+		LineNumberByAddress lineNumberByAddress{&scratchArena_};
 
-				lineNumberByAddress[addressValue].push_back(lineNumber);
-				addresses.push_back(addressValue);
+		addresses.reserve(monitoredLines.size());
+		for (const auto& monitoredLine : monitoredLines)
+		{
+			auto address = monitoredLine.address_;
+			if (basicBlockLeaders)
+			{
+				auto it = basicBlockLeaders->find(address);
+				if (it != basicBlockLeaders->end())
+					address = it->second;
 			}
+
+			// A line in the block of another line is credited with the
+			// breakpoint of the first line of the block.
+			lineNumberByAddress[address].push_back(monitoredLine.lineNumber_);
+			if (address == monitoredLine.address_)
+				addresses.push_back(address);
 		}
-		SetBreakPoint(path,
-		              moduleInfo.hProcess_,
+
+		SetBreakPoint(pathId,
+		              GetModuleInfo().hProcess_,
 		              std::move(addresses),
 		              lineNumberByAddress);
+
+		for (const auto& monitoredLine : monitoredLines)
+		{
+			executedAddressManager_->RegisterFunctionLine(
+			    pathId, monitoredLine.symbolIndex_, monitoredLine.lineNumber_);
+		}
+	}
+
+	//--------------------------------------------------------------------------
+	void MonitoredLineRegister::SetPendingBreakPoints(
+	    InstructionDecoder::Mode instructionMode,
+	    size_t sizeOfImage)
+	{
+		const auto& moduleInfo = GetModuleInfo();
+		auto hProcess = moduleInfo.hProcess_;
+		auto endOfImage =
+		    reinterpret_cast<DWORD64>(moduleInfo.baseOfImage_) + sizeOfImage;
+
+		BasicBlockPlanner basicBlockPlanner{
+		    instructionMode, [&](std::uint64_t address, size_t size) {
+			    auto readableSize =
+			        address < endOfImage
+			            ? static_cast<size_t>(std::min<std::uint64_t>(
+			                  size, endOfImage - address))
+			            : 0;
+			    if (readableSize == 0)
+				    return std::vector<unsigned char>{};
+			    return Tools::ReadProcessMemory(
+			        hProcess, reinterpret_cast<void*>(address), readableSize);
+		    }};
+
+		auto basicBlockLeaders =
+		    basicBlockPlanner.Plan(std::move(basicBlockLines_));
+		for (const auto& pendingSourceFile : pendingSourceFiles_)
+		{
+			SetBreakPoints(pendingSourceFile.pathId_,
+			               pendingSourceFile.lines_,
+			               &basicBlockLeaders);
+		}
+
+		auto blockCount = std::count_if(
+		    basicBlockLeaders.begin(),
+		    basicBlockLeaders.end(),
+		    [](const auto& leader) { return leader.first == leader.second; });
+		LOG_DEBUG << basicBlockLeaders.size() << L" line addresses in "
+		          << blockCount << L" basic blocks.";
 	}
 
 	//--------------------------------------------------------------------------
 	void MonitoredLineRegister::SetBreakPoint(
-	    const std::filesystem::path& path,
+	    Tools::PathId pathId,
 	    HANDLE hProcess,
 	    std::vector<DWORD64>&& addressCollection,
 	    const LineNumberByAddress& lineNumberByAddress)
@@ -188,17 +326,16 @@ namespace CppCoverage
 				Address address{hProcess,
 				                reinterpret_cast<void*>(addressValue)};
 				const auto& lineNumbers = it->second;
+				// The breakpoint is kept when the address is new: the other
+				// lines of the same address are credited with it.
+				bool keepBreakPoint = false;
 				for (auto lineNumber : lineNumbers)
 				{
-					if (!executedAddressManager_->RegisterAddress(
-					        address,
-					        path.wstring(),
-					        lineNumber,
-					        oldInstruction))
-					{
-						breakPoint_->RemoveBreakPoint(address, oldInstruction);
-					}
+					keepBreakPoint |= executedAddressManager_->RegisterAddress(
+					    address, pathId, lineNumber, oldInstruction);
 				}
+				if (!keepBreakPoint)
+					breakPoint_->RemoveBreakPoint(address, oldInstruction);
 			}
 		}
 	}
@@ -17,10 +17,14 @@
 #pragma once
 
 #include "DebugInformationEnumerator.hpp"
+#include "BasicBlockPlanner.hpp"
 #include <memory>
+#include <memory_resource>
 #include <unordered_map>
 #include <filesystem>
 
+#include "Tools/PathInterner.hpp"
+
 namespace FileFilter
 {
 	class LineInfo;
@@ -33,6 +37,7 @@ namespace CppCoverage
 	class BreakPoint;
 	class ExecutedAddressManager;
 	class FilterAssistant;
+	class LineTableCache;
 
 	class MonitoredLineRegister : private IDebugInformationHandler
 	{
@@ -41,7 +46,9 @@ namespace CppCoverage
 		                      std::shared_ptr<ExecutedAddressManager>,
 		                      std::shared_ptr<ICoverageFilterManager>,
 		                      std::unique_ptr<DebugInformationEnumerator>,
-		                      std::shared_ptr<FilterAssistant>);
+		                      std::shared_ptr<FilterAssistant>,
+		                      std::shared_ptr<LineTableCache> = nullptr,
+		                      bool basicBlockBreakPoints = false);
 		~MonitoredLineRegister();
 
 		bool RegisterLineToMonitor(const std::filesystem::path& modulePath,
@@ -52,10 +59,34 @@ namespace CppCoverage
 		bool IsSourceFileSelected(const std::filesystem::path&) override;
 		void OnSourceFile(const std::filesystem::path&,
 		                  const std::vector<Line>&) override;
+		void OnFunction(unsigned long symbolIndex,
+		                const std::wstring& name) override;
+
+		struct MonitoredLine
+		{
+			DWORD64 address_;
+			int lineNumber_;
+			unsigned long symbolIndex_;
+		};
+
+		struct PendingSourceFile
+		{
+			Tools::PathId pathId_;
+			std::pmr::vector<MonitoredLine> lines_;
+		};
+
+		// Address of the first line of the basic block by line address.
+		using BasicBlockLeaders = std::unordered_map<std::uint64_t, std::uint64_t>;
+
+		void SetBreakPoints(Tools::PathId,
+		                    const std::pmr::vector<MonitoredLine>&,
+		                    const BasicBlockLeaders*);
+		void SetPendingBreakPoints(InstructionDecoder::Mode,
+		                           size_t sizeOfImage);
 
 		using LineNumberByAddress =
-		    std::unordered_map<DWORD64, std::vector<int>>;
-		void SetBreakPoint(const std::filesystem::path&,
+		    std::pmr::unordered_map<DWORD64, std::pmr::vector<int>>;
+		void SetBreakPoint(Tools::PathId,
 		                   HANDLE hProcess,
 		                   std::vector<DWORD64>&&,
 		                   const LineNumberByAddress&);
@@ -69,5 +100,16 @@ namespace CppCoverage
 		const std::unique_ptr<DebugInformationEnumerator>
 		    debugInformationEnumerator_;
 		const std::shared_ptr<FilterAssistant> filterAssistant_;
+		const std::shared_ptr<LineTableCache> lineTableCache_;
+		const bool basicBlockBreakPoints_;
+
+		// With basic block breakpoints, the breakpoints are set once all
+		// the lines of the module are known.
+		std::vector<BasicBlockPlanner::Line> basicBlockLines_;
+		std::vector<PendingSourceFile> pendingSourceFiles_;
+
+		// Scratch memory for the per source file structures, released
+		// after each module.
+		std::pmr::monotonic_buffer_resource scratchArena_;
 	};
 }
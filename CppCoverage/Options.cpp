@@ -55,11 +55,16 @@ namespace CppCoverage
 		, logLevel_{ LogLevel::Normal }
 		, isPluginModeEnabled_{ false }
 		, isCoverChildrenModeEnabled_{ false }
+		, isCoverChildrenInParallelModeEnabled_{ false }
 		, isAggregateByFileModeEnabled_{ true }
 		, isContinueAfterCppExceptionModeEnabled_{ false }
 		, isStopOnAssertModeEnabled_{ false }
 		, isDumpOnCrashEnabled_{ false }
 		, isOptimizedBuildSupportEnabled_{ false }
+		, isBasicBlockBreakPointsEnabled_{ false }
+		, isExportPluginOutOfProcessEnabled_{ false }
+		, isExportModuleByModuleEnabled_{ false }
+		, isSummaryOnlyEnabled_{ false }
 	{
 		if (startInfo)
 			optionalStartInfo_ = *startInfo;
@@ -122,6 +127,18 @@ namespace CppCoverage
 		return isCoverChildrenModeEnabled_;
 	}
 
+	//-------------------------------------------------------------------------
+	void Options::EnableCoverChildrenInParallelMode()
+	{
+		isCoverChildrenInParallelModeEnabled_ = true;
+	}
+
+	//-------------------------------------------------------------------------
+	bool Options::IsCoverChildrenInParallelModeEnabled() const
+	{
+		return isCoverChildrenInParallelModeEnabled_;
+	}
+
 	//-------------------------------------------------------------------------
 	void Options::DisableAggregateByFileMode()
 	{
@@ -231,6 +248,155 @@ namespace CppCoverage
 		return isOptimizedBuildSupportEnabled_;
 	}
 
+	//-------------------------------------------------------------------------
+	void Options::EnableBasicBlockBreakPoints()
+	{
+		isBasicBlockBreakPointsEnabled_ = true;
+	}
+
+	//-------------------------------------------------------------------------
+	bool Options::IsBasicBlockBreakPointsEnabled() const
+	{
+		return isBasicBlockBreakPointsEnabled_;
+	}
+
+	//-------------------------------------------------------------------------
+	void Options::EnableExportPluginOutOfProcess()
+	{
+		isExportPluginOutOfProcessEnabled_ = true;
+	}
+
+	//-------------------------------------------------------------------------
+	bool Options::IsExportPluginOutOfProcessEnabled() const
+	{
+		return isExportPluginOutOfProcessEnabled_;
+	}
+
+	//-------------------------------------------------------------------------
+	void Options::EnableExportModuleByModule()
+	{
+		isExportModuleByModuleEnabled_ = true;
+	}
+
+	//-------------------------------------------------------------------------
+	bool Options::IsExportModuleByModuleEnabled() const
+	{
+		return isExportModuleByModuleEnabled_;
+	}
+
+	//-------------------------------------------------------------------------
+	void Options::SetExportPluginTimeout(size_t seconds)
+	{
+		exportPluginTimeout_ = seconds;
+	}
+
+	//-------------------------------------------------------------------------
+	boost::optional<size_t> Options::GetExportPluginTimeout() const
+	{
+		return exportPluginTimeout_;
+	}
+
+	//-------------------------------------------------------------------------
+	void Options::SetCoverageMemoryBudget(size_t megaBytes)
+	{
+		coverageMemoryBudget_ = megaBytes;
+	}
+
+	//-------------------------------------------------------------------------
+	boost::optional<size_t> Options::GetCoverageMemoryBudget() const
+	{
+		return coverageMemoryBudget_;
+	}
+
+	//-------------------------------------------------------------------------
+	void Options::SetSnapshotSettings(const SnapshotSettings& snapshotSettings)
+	{
+		snapshotSettings_ = snapshotSettings;
+	}
+
+	//-------------------------------------------------------------------------
+	const boost::optional<SnapshotSettings>& Options::GetSnapshotSettings() const
+	{
+		return snapshotSettings_;
+	}
+
+	//-------------------------------------------------------------------------
+	void Options::SetCoverageJournalPath(const std::filesystem::path& coverageJournalPath)
+	{
+		coverageJournalPath_ = coverageJournalPath;
+	}
+
+	//-------------------------------------------------------------------------
+	const boost::optional<std::filesystem::path>& Options::GetCoverageJournalPath() const
+	{
+		return coverageJournalPath_;
+	}
+
+	//-------------------------------------------------------------------------
+	void Options::AddInputCoverageJournalPath(const std::filesystem::path& path)
+	{
+		inputCoverageJournalPaths_.push_back(path);
+	}
+
+	//-------------------------------------------------------------------------
+	const std::vector<std::filesystem::path>& Options::GetInputCoverageJournalPaths() const
+	{
+		return inputCoverageJournalPaths_;
+	}
+
+	//-------------------------------------------------------------------------
+	void Options::AddBatchStartInfo(const StartInfo& startInfo)
+	{
+		batchStartInfos_.push_back(startInfo);
+	}
+
+	//-------------------------------------------------------------------------
+	const std::vector<StartInfo>& Options::GetBatchStartInfos() const
+	{
+		return batchStartInfos_;
+	}
+
+	//-------------------------------------------------------------------------
+	void Options::SetDefaultWorkingDirectory(const std::filesystem::path& workingDirectory)
+	{
+		for (auto* startInfo : GetMutableStartInfos())
+		{
+			if (!startInfo->GetWorkingDirectory())
+				startInfo->SetWorkingDirectory(workingDirectory);
+		}
+	}
+
+	//-------------------------------------------------------------------------
+	void Options::SetEnvironment(const std::vector<std::wstring>& environment)
+	{
+		for (auto* startInfo : GetMutableStartInfos())
+			startInfo->SetEnvironment(std::vector<std::wstring>{ environment });
+	}
+
+	//-------------------------------------------------------------------------
+	std::vector<StartInfo*> Options::GetMutableStartInfos()
+	{
+		std::vector<StartInfo*> startInfos;
+
+		if (optionalStartInfo_)
+			startInfos.push_back(optionalStartInfo_.get_ptr());
+		for (auto& startInfo : batchStartInfos_)
+			startInfos.push_back(&startInfo);
+		return startInfos;
+	}
+
+	//-------------------------------------------------------------------------
+	void Options::SetBatchJobCount(size_t batchJobCount)
+	{
+		batchJobCount_ = batchJobCount;
+	}
+
+	//-------------------------------------------------------------------------
+	boost::optional<size_t> Options::GetBatchJobCount() const
+	{
+		return batchJobCount_;
+	}
+
 	//-------------------------------------------------------------------------
 	void Options::AddExcludedLineRegex(const std::wstring& excludedRegex)
 	{
@@ -255,6 +421,66 @@ namespace CppCoverage
 		return substitutePdbSourcePaths_;
 	}
 
+	//-------------------------------------------------------------------------
+	void Options::EnableSummaryOnly()
+	{
+		isSummaryOnlyEnabled_ = true;
+	}
+
+	//-------------------------------------------------------------------------
+	bool Options::IsSummaryOnlyEnabled() const
+	{
+		return isSummaryOnlyEnabled_;
+	}
+
+	//-------------------------------------------------------------------------
+	void Options::SetSummaryOutputPath(const std::filesystem::path& summaryOutputPath)
+	{
+		summaryOutputPath_ = summaryOutputPath;
+	}
+
+	//-------------------------------------------------------------------------
+	const boost::optional<std::filesystem::path>& Options::GetSummaryOutputPath() const
+	{
+		return summaryOutputPath_;
+	}
+
+	//-------------------------------------------------------------------------
+	void Options::SetSummaryThreshold(size_t percent)
+	{
+		summaryThreshold_ = percent;
+	}
+
+	//-------------------------------------------------------------------------
+	boost::optional<size_t> Options::GetSummaryThreshold() const
+	{
+		return summaryThreshold_;
+	}
+
+	//-------------------------------------------------------------------------
+	void Options::SetDaemonClientPipeName(const std::wstring& pipeName)
+	{
+		daemonClientPipeName_ = pipeName;
+	}
+
+	//-------------------------------------------------------------------------
+	const boost::optional<std::wstring>& Options::GetDaemonClientPipeName() const
+	{
+		return daemonClientPipeName_;
+	}
+
+	//-------------------------------------------------------------------------
+	void Options::SetSubcommand(Subcommand&& subcommand)
+	{
+		subcommand_ = std::move(subcommand);
+	}
+
+	//-------------------------------------------------------------------------
+	const boost::optional<Subcommand>& Options::GetSubcommand() const
+	{
+		return subcommand_;
+	}
+
 	//-------------------------------------------------------------------------
 	std::wostream& operator<<(std::wostream& ostr, const Options& options)
 	{
@@ -264,11 +490,40 @@ namespace CppCoverage
 		ostr << L"Sources: " << options.sources_ << std::endl;
 		ostr << L"Log Level: " << GetLogLevelStr(options.GetLogLevel()) << std::endl;
 		ostr << L"Cover Children: " << options.isCoverChildrenModeEnabled_ << std::endl;
+		ostr << L"Cover Children in parallel: " << options.isCoverChildrenInParallelModeEnabled_ << std::endl;
 		ostr << L"Aggregate by file: " << options.isAggregateByFileModeEnabled_ << std::endl;
 		ostr << L"Continue after C++ exception: " << options.isContinueAfterCppExceptionModeEnabled_ << std::endl;
 		ostr << L"Create minidump on crash: " << options.isDumpOnCrashEnabled_ << std::endl;
 		ostr << L"The directory of minidump: " << options.dumpDirectory_ << std::endl;
 		ostr << L"Optimized build support: " << options.isOptimizedBuildSupportEnabled_ << std::endl;
+		ostr << L"Basic block breakpoints: " << options.isBasicBlockBreakPointsEnabled_ << std::endl;
+		ostr << L"Export plugin out of process: " << options.isExportPluginOutOfProcessEnabled_ << std::endl;
+		if (options.exportPluginTimeout_)
+			ostr << L"Export plugin timeout (s): " << *options.exportPluginTimeout_ << std::endl;
+		ostr << L"Export module by module: " << options.isExportModuleByModuleEnabled_ << std::endl;
+		if (options.coverageMemoryBudget_)
+			ostr << L"Coverage memory budget (MB): " << *options.coverageMemoryBudget_ << std::endl;
+		if (const auto& snapshotSettings = options.snapshotSettings_)
+		{
+			if (const auto& interval = snapshotSettings->GetInterval())
+				ostr << L"Snapshot interval (s): " << interval->count() << std::endl;
+			if (const auto& triggerFile = snapshotSettings->GetTriggerFile())
+				ostr << L"Snapshot trigger file: " << triggerFile->wstring() << std::endl;
+			ostr << L"Snapshot directory: " << snapshotSettings->GetDirectory().wstring() << std::endl;
+		}
+		if (options.coverageJournalPath_)
+			ostr << L"Coverage journal: " << options.coverageJournalPath_->wstring() << std::endl;
+		for (const auto& startInfo : options.batchStartInfos_)
+			ostr << L"Batch command: " << startInfo << std::endl;
+		if (options.batchJobCount_)
+			ostr << L"Batch jobs: " << *options.batchJobCount_ << std::endl;
+		ostr << L"Summary only: " << options.isSummaryOnlyEnabled_ << std::endl;
+		if (options.summaryOutputPath_)
+			ostr << L"Summary output: " << options.summaryOutputPath_->wstring() << std::endl;
+		if (options.summaryThreshold_)
+			ostr << L"Summary threshold (%): " << *options.summaryThreshold_ << std::endl;
+		if (options.daemonClientPipeName_)
+			ostr << L"Daemon client pipe: " << *options.daemonClientPipeName_ << std::endl;
 
 		ostr << L"Export: ";
 		for (const auto& optionExport : options.exports_)
@@ -25,6 +25,8 @@
 #include "UnifiedDiffSettings.hpp"
 #include "SubstitutePdbSourcePath.hpp"
 #include "OptionsExport.hpp"
+#include "SnapshotSettings.hpp"
+#include "Subcommand.hpp"
 
 namespace CppCoverage
 {
@@ -61,6 +63,9 @@ namespace CppCoverage
 		void EnableCoverChildrenMode();
 		bool IsCoverChildrenModeEnabled() const;
 
+		void EnableCoverChildrenInParallelMode();
+		bool IsCoverChildrenInParallelModeEnabled() const;
+
 		void EnableStopOnAssertMode();
 		bool IsStopOnAssertModeEnabled() const;
 
@@ -88,18 +93,71 @@ namespace CppCoverage
 		void EnableOptimizedBuildSupport();
 		bool IsOptimizedBuildSupportEnabled() const;
 
+		void EnableBasicBlockBreakPoints();
+		bool IsBasicBlockBreakPointsEnabled() const;
+
+		void EnableExportPluginOutOfProcess();
+		bool IsExportPluginOutOfProcessEnabled() const;
+
+		void SetExportPluginTimeout(size_t seconds);
+		boost::optional<size_t> GetExportPluginTimeout() const;
+
+		void EnableExportModuleByModule();
+		bool IsExportModuleByModuleEnabled() const;
+
+		void SetCoverageMemoryBudget(size_t megaBytes);
+		boost::optional<size_t> GetCoverageMemoryBudget() const;
+
+		void SetSnapshotSettings(const SnapshotSettings&);
+		const boost::optional<SnapshotSettings>& GetSnapshotSettings() const;
+
+		void SetCoverageJournalPath(const std::filesystem::path&);
+		const boost::optional<std::filesystem::path>& GetCoverageJournalPath() const;
+
+		void AddInputCoverageJournalPath(const std::filesystem::path&);
+		const std::vector<std::filesystem::path>& GetInputCoverageJournalPaths() const;
+
+		void AddBatchStartInfo(const StartInfo&);
+		const std::vector<StartInfo>& GetBatchStartInfos() const;
+
+		// Apply to the start info and to the batch start infos. The default
+		// working directory is used when a start info has none.
+		void SetDefaultWorkingDirectory(const std::filesystem::path&);
+		void SetEnvironment(const std::vector<std::wstring>&);
+
+		void SetBatchJobCount(size_t);
+		boost::optional<size_t> GetBatchJobCount() const;
+
 		void AddExcludedLineRegex(const std::wstring&);
 		const std::vector<std::wstring>& GetExcludedLineRegexes() const;
 
 		void AddSubstitutePdbSourcePath(SubstitutePdbSourcePath&&);
 		const std::vector<SubstitutePdbSourcePath>& GetSubstitutePdbSourcePaths() const;
 
+		void EnableSummaryOnly();
+		bool IsSummaryOnlyEnabled() const;
+
+		void SetSummaryOutputPath(const std::filesystem::path&);
+		const boost::optional<std::filesystem::path>& GetSummaryOutputPath() const;
+
+		void SetSummaryThreshold(size_t percent);
+		boost::optional<size_t> GetSummaryThreshold() const;
+
+		void SetDaemonClientPipeName(const std::wstring&);
+		const boost::optional<std::wstring>& GetDaemonClientPipeName() const;
+
+		// When set, the other options are not used.
+		void SetSubcommand(Subcommand&&);
+		const boost::optional<Subcommand>& GetSubcommand() const;
+
 		friend CPPCOVERAGE_DLL std::wostream& operator<<(std::wostream&, const Options&);
 
 	private:
 		Options(const Options&) = delete;
 		Options& operator=(Options&&) = delete;
 
+		std::vector<StartInfo*> GetMutableStartInfos();
+
 	private:
 		Patterns modules_;
 		Patterns sources_;
@@ -108,16 +166,32 @@ namespace CppCoverage
 		LogLevel logLevel_;
 		bool isPluginModeEnabled_;
 		bool isCoverChildrenModeEnabled_;
+		bool isCoverChildrenInParallelModeEnabled_;
 		bool isAggregateByFileModeEnabled_;
 		bool isContinueAfterCppExceptionModeEnabled_;
 		bool isStopOnAssertModeEnabled_;
 		bool isDumpOnCrashEnabled_;
 		std::filesystem::path dumpDirectory_;
 		bool isOptimizedBuildSupportEnabled_;
+		bool isBasicBlockBreakPointsEnabled_;
+		bool isExportPluginOutOfProcessEnabled_;
+		boost::optional<size_t> exportPluginTimeout_;
+		bool isExportModuleByModuleEnabled_;
+		boost::optional<size_t> coverageMemoryBudget_;
+		boost::optional<SnapshotSettings> snapshotSettings_;
+		boost::optional<std::filesystem::path> coverageJournalPath_;
+		std::vector<std::filesystem::path> inputCoverageJournalPaths_;
+		std::vector<StartInfo> batchStartInfos_;
+		boost::optional<size_t> batchJobCount_;
 		std::vector<OptionsExport> exports_;
 		std::vector<std::filesystem::path> inputCoveragePaths_;
 		std::vector<UnifiedDiffSettings> unifiedDiffSettingsCollection_;
 		std::vector<std::wstring> excludedLineRegexes_;
 		std::vector<SubstitutePdbSourcePath> substitutePdbSourcePaths_;
+		bool isSummaryOnlyEnabled_;
+		boost::optional<std::filesystem::path> summaryOutputPath_;
+		boost::optional<size_t> summaryThreshold_;
+		boost::optional<std::wstring> daemonClientPipeName_;
+		boost::optional<Subcommand> subcommand_;
 	};
 }
\ No newline at end of file
@@ -26,7 +26,9 @@ namespace CppCoverage
 	{
 		Html,
 		Cobertura,
+		CoberturaDirectory,
 		Binary,
+		Lcov,
 		Plugin
 	};
 
@@ -17,6 +17,8 @@
 #include "stdafx.h"
 #include "OptionsParser.hpp"
 
+#include <algorithm>
+#include <chrono>
 #include <string>
 #include <vector>
 #include <sstream>
@@ -25,6 +27,7 @@
 
 #include <boost/algorithm/string/split.hpp>
 #include <boost/algorithm/string/classification.hpp>
+#include <boost/program_options/parsers.hpp>
 
 #include "Tools/Tool.hpp"
 #include "CppCoverage/Patterns.hpp"
@@ -182,6 +185,77 @@ namespace CppCoverage
 			}
 		}
 
+		//---------------------------------------------------------------------
+		void AddBatchCommands(const ProgramOptionsVariablesMap& variablesMap,
+			Options& options)
+		{
+			const auto* commands = variablesMap.GetOptionalValue<std::vector<std::string>>(
+				ProgramOptions::BatchCommandOption);
+			const auto* jobCount = variablesMap.GetOptionalValue<size_t>(
+				ProgramOptions::BatchJobsOption);
+
+			if (!commands)
+			{
+				if (jobCount)
+					throw Plugin::OptionsParserException("--" +
+						ProgramOptions::BatchJobsOption + " requires --" +
+						ProgramOptions::BatchCommandOption + '.');
+				return;
+			}
+			if (jobCount && *jobCount == 0)
+				throw Plugin::OptionsParserException("--" +
+					ProgramOptions::BatchJobsOption + " must be greater than 0.");
+
+			const auto* workingDirectory = variablesMap.GetOptionalValue<std::string>(
+				ProgramOptions::WorkingDirectoryOption);
+			for (const auto& command : *commands)
+			{
+				auto arguments = po::split_winmain(Tools::LocalToWString(command));
+				if (arguments.empty())
+					throw Plugin::OptionsParserException("--" +
+						ProgramOptions::BatchCommandOption + " cannot be empty.");
+
+				cov::StartInfo startInfo{ arguments.front() };
+				for (auto it = arguments.begin() + 1; it != arguments.end(); ++it)
+					startInfo.AddArgument(*it);
+				if (workingDirectory)
+					startInfo.SetWorkingDirectory(*workingDirectory);
+				options.AddBatchStartInfo(startInfo);
+			}
+			if (jobCount)
+				options.SetBatchJobCount(*jobCount);
+		}
+
+		//---------------------------------------------------------------------
+		void AddCoverageJournals(const ProgramOptionsVariablesMap& variablesMap,
+			Options& options)
+		{
+			const auto* coverageJournal = variablesMap.GetOptionalValue<std::string>(
+				ProgramOptions::CoverageJournalOption);
+			if (coverageJournal)
+				options.SetCoverageJournalPath(*coverageJournal);
+
+			auto inputJournalPaths =
+				variablesMap.GetOptionalValue<std::vector<std::string>>(
+					ProgramOptions::InputCoverageJournalOption);
+
+			if (inputJournalPaths)
+			{
+				for (const auto& path : *inputJournalPaths)
+				{
+					if (!Tools::FileExists(path))
+					{
+						throw Plugin::OptionsParserException(
+							"Argument of " +
+							ProgramOptions::InputCoverageJournalOption + " <" + path +
+							"> does not exist.");
+					}
+
+					options.AddInputCoverageJournalPath(path);
+				}
+			}
+		}
+
 		//----------------------------------------------------------------------------
 		std::pair<fs::path, boost::optional<fs::path>>
 			ExtractUnifiedDiffOption(const std::string& option)
@@ -298,6 +372,235 @@ namespace CppCoverage
 				}
 			}
 		}
+		//---------------------------------------------------------------------
+		void AddSnapshotSettings(
+			const ProgramOptionsVariablesMap& variablesMap, Options& options)
+		{
+			const auto* interval = variablesMap.GetOptionalValue<size_t>(
+				ProgramOptions::SnapshotIntervalOption);
+			const auto* triggerFile = variablesMap.GetOptionalValue<std::string>(
+				ProgramOptions::SnapshotTriggerFileOption);
+			const auto* directory = variablesMap.GetOptionalValue<std::string>(
+				ProgramOptions::SnapshotDirectoryOption);
+
+			if (!interval && !triggerFile)
+			{
+				if (directory)
+					throw Plugin::OptionsParserException("--" +
+						ProgramOptions::SnapshotDirectoryOption + " requires --" +
+						ProgramOptions::SnapshotIntervalOption + " or --" +
+						ProgramOptions::SnapshotTriggerFileOption + '.');
+				return;
+			}
+			if (interval && *interval == 0)
+				throw Plugin::OptionsParserException("--" +
+					ProgramOptions::SnapshotIntervalOption + " must be greater than 0.");
+
+			boost::optional<std::chrono::seconds> optionalInterval;
+			if (interval)
+				optionalInterval = std::chrono::seconds{ *interval };
+			boost::optional<fs::path> optionalTriggerFile;
+			if (triggerFile)
+				optionalTriggerFile = fs::path{ *triggerFile };
+
+			options.SetSnapshotSettings(SnapshotSettings{
+				optionalInterval,
+				optionalTriggerFile,
+				directory ? *directory : ProgramOptions::SnapshotDirectoryDefaultValue });
+		}
+
+		//---------------------------------------------------------------------
+		void AddSummarySettings(
+			const ProgramOptionsVariablesMap& variablesMap, Options& options)
+		{
+			const auto* output = variablesMap.GetOptionalValue<std::string>(
+				ProgramOptions::SummaryOutputOption);
+			const auto* threshold = variablesMap.GetOptionalValue<size_t>(
+				ProgramOptions::SummaryThresholdOption);
+
+			if (!variablesMap.IsOptionSelected(ProgramOptions::SummaryOnlyOption))
+			{
+				for (const auto* option : { &ProgramOptions::SummaryOutputOption,
+					&ProgramOptions::SummaryThresholdOption })
+				{
+					if (variablesMap.IsOptionSelected(*option))
+						throw Plugin::OptionsParserException("--" + *option +
+							" requires --" + ProgramOptions::SummaryOnlyOption + '.');
+				}
+				return;
+			}
+
+			// The summary is computed while running: there is no coverage
+			// data to merge or to export.
+			for (const auto* option : { &ProgramOptions::InputCoverageValue,
+				&ProgramOptions::InputCoverageJournalOption,
+				&ProgramOptions::ExportModuleByModuleOption })
+			{
+				if (variablesMap.IsOptionSelected(*option))
+					throw Plugin::OptionsParserException("--" + *option +
+						" cannot be used with --" + ProgramOptions::SummaryOnlyOption + '.');
+			}
+			if (threshold && *threshold > 100)
+				throw Plugin::OptionsParserException("--" +
+					ProgramOptions::SummaryThresholdOption + " must be between 0 and 100.");
+
+			options.EnableSummaryOnly();
+			if (output)
+				options.SetSummaryOutputPath(*output);
+			if (threshold)
+				options.SetSummaryThreshold(*threshold);
+		}
+
+		//---------------------------------------------------------------------
+		const std::vector<std::pair<const std::string*, SubcommandType>>& GetSubcommandOptions()
+		{
+			static const std::vector<std::pair<const std::string*, SubcommandType>> subcommandOptions = {
+				{ &ProgramOptions::DaemonOption, SubcommandType::Daemon },
+				{ &ProgramOptions::DaemonStopOption, SubcommandType::DaemonStop },
+				{ &ProgramOptions::AggregationServerOption, SubcommandType::AggregationServer },
+				{ &ProgramOptions::AggregationClientOption, SubcommandType::AggregationClient },
+				{ &ProgramOptions::HistoryOption, SubcommandType::History },
+				{ &ProgramOptions::DiffOption, SubcommandType::Diff },
+				{ &ProgramOptions::QueryOption, SubcommandType::Query },
+				{ &ProgramOptions::ExportPluginHostOption, SubcommandType::ExportPluginHost } };
+
+			return subcommandOptions;
+		}
+
+		//---------------------------------------------------------------------
+		bool AreAggregationClientArgumentsValid(
+			const std::wstring& command,
+			size_t pathCount)
+		{
+			if (command == L"upload")
+				return pathCount >= 1;
+			if (command == L"download")
+				return pathCount == 1;
+			return (command == L"summary" || command == L"stop") && pathCount == 0;
+		}
+
+		//---------------------------------------------------------------------
+		bool AreHistoryArgumentsValid(
+			const std::wstring& command,
+			size_t argumentCount)
+		{
+			if (command == L"add")
+				return argumentCount >= 2;
+			if (command == L"get")
+				return argumentCount == 2;
+			if (command == L"list")
+				return argumentCount == 0;
+			return command == L"trend" && argumentCount <= 1;
+		}
+
+		//---------------------------------------------------------------------
+		bool AreQueryArgumentsValid(
+			const std::wstring& command,
+			const std::vector<std::wstring>& arguments)
+		{
+			if (command == L"line")
+			{
+				if (arguments.size() != 2 || arguments[1].empty())
+					return false;
+				const auto& line = arguments[1];
+				return std::all_of(line.begin(), line.end(), [](wchar_t c) {
+					return c >= L'0' && c <= L'9';
+				});
+			}
+			if (command == L"prefix")
+				return arguments.size() <= 1;
+			return command == L"directory" && arguments.size() == 1;
+		}
+
+		//---------------------------------------------------------------------
+		bool AreSubcommandArgumentsValid(
+			SubcommandType subcommandType,
+			const std::vector<std::wstring>& arguments)
+		{
+			switch (subcommandType)
+			{
+			case SubcommandType::AggregationClient:
+				// The pipe name, the command and its files.
+				return arguments.size() >= 2 &&
+					AreAggregationClientArgumentsValid(arguments[1], arguments.size() - 2);
+			case SubcommandType::History:
+				// The folder, the command and its arguments.
+				return arguments.size() >= 2 &&
+					AreHistoryArgumentsValid(arguments[1], arguments.size() - 2);
+			case SubcommandType::Diff:
+			{
+				// The two coverage files, then the optional format and output.
+				if (arguments.size() < 2 || arguments.size() > 4)
+					return false;
+				if (arguments.size() == 2)
+					return true;
+				const auto& format = arguments[2];
+				return format == L"text" || format == L"json" || format == L"html";
+			}
+			case SubcommandType::Query:
+				// The coverage file, the command and its arguments.
+				return arguments.size() >= 2 && AreQueryArgumentsValid(
+					arguments[1], { arguments.begin() + 2, arguments.end() });
+			default:
+				// The pipe name or the shared memory name.
+				return arguments.size() == 1;
+			}
+		}
+
+		//---------------------------------------------------------------------
+		// Only the log level can be set with a subcommand.
+		void CheckSubcommandOptions(
+			const ProgramOptionsVariablesMap& variablesMap,
+			const std::string& subcommandOption)
+		{
+			for (const auto& variable : variablesMap.GetVariablesMap())
+			{
+				const auto& option = variable.first;
+
+				if (variable.second.defaulted() || option == subcommandOption ||
+					option == ProgramOptions::VerboseOption || option == ProgramOptions::QuietOption)
+					continue;
+				if (option == ProgramOptions::ProgramToRunOption ||
+					option == ProgramOptions::ProgramToRunArgOption)
+					throw Plugin::OptionsParserException(
+						"A program to run cannot be used with --" + subcommandOption + '.');
+				throw Plugin::OptionsParserException("--" + option +
+					" cannot be used with --" + subcommandOption + '.');
+			}
+		}
+
+		//---------------------------------------------------------------------
+		boost::optional<Subcommand> GetSubcommand(const ProgramOptionsVariablesMap& variablesMap)
+		{
+			boost::optional<Subcommand> subcommand;
+			const std::string* subcommandOption = nullptr;
+
+			for (const auto& subcommandOptionType : GetSubcommandOptions())
+			{
+				const auto& option = *subcommandOptionType.first;
+				const auto* values = variablesMap.GetOptionalValue<std::vector<std::string>>(option);
+
+				if (!values)
+					continue;
+				if (subcommandOption)
+					throw Plugin::OptionsParserException("--" + *subcommandOption + 
+						" and --" + option + " cannot be used at the same time.");
+
+				std::vector<std::wstring> arguments;
+				for (const auto& value : *values)
+					arguments.push_back(Tools::LocalToWString(value));
+				if (!AreSubcommandArgumentsValid(subcommandOptionType.second, arguments))
+					throw Plugin::OptionsParserException("Invalid arguments for --" + option + '.');
+
+				subcommand = Subcommand{ subcommandOptionType.second, std::move(arguments) };
+				subcommandOption = &option;
+			}
+
+			if (subcommandOption)
+				CheckSubcommandOptions(variablesMap, *subcommandOption);
+			return subcommand;
+		}
+
 		//---------------------------------------------------------------------------
 		void CheckArgumentsSize(int argc,
 			const char** argv,
@@ -321,6 +624,21 @@ namespace CppCoverage
 				warningManager.AddWarning(tooLongCmd);
 			}
 		}
+
+		//---------------------------------------------------------------------------
+		void CheckExportModuleByModule(const Options& options)
+		{
+			if (!options.IsExportModuleByModuleEnabled())
+				return;
+
+			for (const auto& optionExport : options.GetExports())
+			{
+				if (optionExport.GetType() == OptionsExportType::Plugin)
+					throw Plugin::OptionsParserException("--" + 
+						ProgramOptions::ExportModuleByModuleOption + 
+						" cannot be used with an export plugin.");
+			}
+		}
 	}
 
 	//-------------------------------------------------------------------------
@@ -433,8 +751,22 @@ namespace CppCoverage
 		if (isQuiet)
 			options.SetLogLevel(LogLevel::Quiet);
 
+		if (auto subcommand = GetSubcommand(variablesMap))
+		{
+			options.SetSubcommand(std::move(*subcommand));
+			return options;
+		}
+
 		if (variablesMap.IsOptionSelected(ProgramOptions::CoverChildrenOption))
 			options.EnableCoverChildrenMode();
+		if (variablesMap.IsOptionSelected(ProgramOptions::CoverChildrenInParallelOption))
+		{
+			if (!options.IsCoverChildrenModeEnabled())
+				throw Plugin::OptionsParserException("--" +
+					ProgramOptions::CoverChildrenInParallelOption + " requires --" +
+					ProgramOptions::CoverChildrenOption + ".");
+			options.EnableCoverChildrenInParallelMode();
+		}
 		if (variablesMap.IsOptionSelected(ProgramOptions::PluginOption))
 			options.EnablePlugingMode();
 		if (variablesMap.IsOptionSelected(
@@ -445,6 +777,32 @@ namespace CppCoverage
 			options.EnableContinueAfterCppExceptionMode();
 		if (variablesMap.IsOptionSelected(ProgramOptions::OptimizedBuildOption))
 			options.EnableOptimizedBuildSupport();
+		if (variablesMap.IsOptionSelected(ProgramOptions::BasicBlockBreakPointsOption))
+			options.EnableBasicBlockBreakPoints();
+		if (variablesMap.IsOptionSelected(ProgramOptions::ExportPluginOutOfProcessOption))
+			options.EnableExportPluginOutOfProcess();
+		const auto* exportPluginTimeout = variablesMap.GetOptionalValue<size_t>(
+			ProgramOptions::ExportPluginTimeoutOption);
+		if (exportPluginTimeout)
+		{
+			if (!options.IsExportPluginOutOfProcessEnabled())
+				throw Plugin::OptionsParserException("--" + ProgramOptions::ExportPluginTimeoutOption +
+					" requires --" + ProgramOptions::ExportPluginOutOfProcessOption + '.');
+			if (*exportPluginTimeout == 0)
+				throw Plugin::OptionsParserException("--" + ProgramOptions::ExportPluginTimeoutOption +
+					" must be greater than 0.");
+			options.SetExportPluginTimeout(*exportPluginTimeout);
+		}
+		if (variablesMap.IsOptionSelected(ProgramOptions::ExportModuleByModuleOption))
+			options.EnableExportModuleByModule();
+		const auto* daemonClientPipeName = variablesMap.GetOptionalValue<std::string>(
+			ProgramOptions::DaemonClientOption);
+		if (daemonClientPipeName)
+			options.SetDaemonClientPipeName(Tools::LocalToWString(*daemonClientPipeName));
+		const auto* coverageMemoryBudget = variablesMap.GetOptionalValue<size_t>(
+			ProgramOptions::CoverageMemoryBudgetOption);
+		if (coverageMemoryBudget)
+			options.SetCoverageMemoryBudget(*coverageMemoryBudget);
 		if (variablesMap.IsOptionSelected(ProgramOptions::StopOnAssertOption))
 			options.EnableStopOnAssertMode();
 		if (variablesMap.IsOptionSelected(ProgramOptions::DumpOnCrashOption)) {
@@ -457,17 +815,26 @@ namespace CppCoverage
 		}
 
 		AddInputCoverages(variablesMap, options);
+		AddCoverageJournals(variablesMap, options);
+		AddBatchCommands(variablesMap, options);
 		AddUnifiedDiff(variablesMap, options);
 		AddExcludedLineRegexes(variablesMap, options);
 		AddSubstitutePdbSourcePaths(variablesMap, options);
+		AddSnapshotSettings(variablesMap, options);
+		AddSummarySettings(variablesMap, options);
 
-		if (!options.GetStartInfo() && options.GetInputCoveragePaths().empty())
+		if (!options.GetStartInfo() && options.GetInputCoveragePaths().empty()
+			&& options.GetInputCoverageJournalPaths().empty()
+			&& options.GetBatchStartInfos().empty())
 			throw Plugin::OptionsParserException(
 				"You must specify a program to execute or use --" +
-				ProgramOptions::InputCoverageValue);
+				ProgramOptions::InputCoverageValue + ", --" +
+				ProgramOptions::InputCoverageJournalOption + " or --" +
+				ProgramOptions::BatchCommandOption);
 
 		for (const auto& optionParser : optionParsers_)
 			optionParser->ParseOption(variablesMap, options);
+		CheckExportModuleByModule(options);
 		return options;
 	}
 
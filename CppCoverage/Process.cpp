@@ -53,6 +53,22 @@ namespace CppCoverage
 
 			return commandLine;
 		}		
+
+		//---------------------------------------------------------------------
+		std::vector<wchar_t> CreateEnvironmentBlock(const std::vector<std::wstring>& environment)
+		{
+			std::vector<wchar_t> block;
+
+			for (const auto& variable : environment)
+			{
+				block.insert(block.end(), variable.begin(), variable.end());
+				block.push_back(L'\0');
+			}
+			if (block.empty())
+				block.push_back(L'\0');
+			block.push_back(L'\0');
+			return block;
+		}
 	}
 
 	const std::wstring Process::CannotFindPathMessage = L"Cannot find path: ";
@@ -92,6 +108,14 @@ namespace CppCoverage
 		const auto* workindDirectory = startInfo_.GetWorkingDirectory();
 		auto optionalCommandLine = CreateCommandLine(startInfo_.GetArguments());
 		auto commandLine = (optionalCommandLine) ? &(*optionalCommandLine)[0] : nullptr;
+		const auto* environment = startInfo_.GetEnvironment();
+		std::vector<wchar_t> environmentBlock;
+
+		if (environment)
+		{
+			environmentBlock = CreateEnvironmentBlock(*environment);
+			creationFlags |= CREATE_UNICODE_ENVIRONMENT;
+		}
 
 		processInformation_ = PROCESS_INFORMATION{};
 		if (!CreateProcess(
@@ -101,7 +125,7 @@ namespace CppCoverage
 			nullptr,
 			FALSE,
 			creationFlags,
-			nullptr,
+			(environment) ? environmentBlock.data() : nullptr,
 			(workindDirectory) ? workindDirectory->c_str() : nullptr,
 			&lpStartupInfo,
 			&processInformation_.get()
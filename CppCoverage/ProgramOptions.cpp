@@ -38,7 +38,44 @@ namespace CppCoverage
 				((ProgramOptions::VerboseOption + "," + ProgramOptions::VerboseShortOption).c_str(), "Verbose mode.")
 				((ProgramOptions::QuietOption + "," + ProgramOptions::QuietShortOption).c_str(), "Quiet mode.")
 				((ProgramOptions::HelpOption + "," + ProgramOptions::HelpShortOption).c_str(), "Show help message.")
-				(ProgramOptions::ConfigFileOption.c_str(), po::value<std::string>(), "Filename of a configuration file.");
+				(ProgramOptions::ConfigFileOption.c_str(), po::value<std::string>(), "Filename of a configuration file.")
+				(ProgramOptions::DaemonClientOption.c_str(), po::value<std::string>()->value_name("pipe"),
+					("Run the coverage with the other options in the daemon started by --" +
+					ProgramOptions::DaemonOption + " on this named pipe.").c_str());
+		}
+
+		//---------------------------------------------------------------------
+		void FillSubcommandOptions(po::options_description& options)
+		{
+			options.add_options()
+				(ProgramOptions::DaemonOption.c_str(), po::value<T_Strings>()->multitoken()->value_name("pipe"),
+					"Run a daemon listening on this named pipe. Plugins, line tables and filter decisions "
+					"stay loaded for the next runs.")
+				(ProgramOptions::DaemonStopOption.c_str(), po::value<T_Strings>()->multitoken()->value_name("pipe"),
+					"Stop the daemon listening on this named pipe.")
+				(ProgramOptions::AggregationServerOption.c_str(), po::value<T_Strings>()->multitoken()->value_name("pipe"),
+					"Run a server merging the coverage files uploaded on this named pipe.")
+				(ProgramOptions::AggregationClientOption.c_str(),
+					po::value<T_Strings>()->multitoken()->value_name("pipe command"),
+					("Send a command to the server started by --" + ProgramOptions::AggregationServerOption +
+					" on this named pipe. Commands: upload <file.cov>..., download <file.cov>, summary, stop.").c_str())
+				(ProgramOptions::HistoryOption.c_str(), po::value<T_Strings>()->multitoken()->value_name("folder command"),
+					"Store the coverage of each revision in this folder. Commands: add <revision> <file.cov>..., "
+					"get <revision> <output.cov>, list, trend [pathPrefix].")
+				(ProgramOptions::DiffOption.c_str(),
+					po::value<T_Strings>()->multitoken()->value_name("before.cov after.cov [format] [output]"),
+					"Compare two binary coverage files. Format: text (default), json or html. "
+					"The result is written to the standard output when there is no output.")
+				(ProgramOptions::QueryOption.c_str(), po::value<T_Strings>()->multitoken()->value_name("file.cov command"),
+					"Query a binary coverage file without loading it. Commands: line <path> <line>, "
+					"prefix [pathPrefix], directory <directory>.");
+		}
+
+		//---------------------------------------------------------------------
+		void FillHiddenSubcommandOptions(po::options_description& options)
+		{
+			options.add_options()
+				(ProgramOptions::ExportPluginHostOption.c_str(), po::value<T_Strings>()->multitoken());
 		}
 
 		//---------------------------------------------------------------------
@@ -78,6 +115,8 @@ namespace CppCoverage
 						". This coverage data will be merged with the current one. Can have multiple occurrences.").c_str())
 				(ProgramOptions::WorkingDirectoryOption.c_str(), po::value<std::string>(), "The program working directory.")
 				(ProgramOptions::CoverChildrenOption.c_str(), "Enable code coverage for children processes.")
+				(ProgramOptions::CoverChildrenInParallelOption.c_str(),
+					("Debug each child process on its own thread. Requires --" + ProgramOptions::CoverChildrenOption + ".").c_str())
 				(ProgramOptions::NoAggregateByFileOption.c_str(), "Do not aggregate coverage for same file path.")
 				(ProgramOptions::StopOnAssertOption.c_str(), "Do not continue after DebugBreak() or assert().")
 				(ProgramOptions::DumpOnCrashOption.c_str(), "Create a minidump on crash.")
@@ -87,11 +126,54 @@ namespace CppCoverage
 				(ProgramOptions::ContinueAfterCppExceptionOption.c_str(), "Try to continue after throwing a C++ exception.")
 				(ProgramOptions::OptimizedBuildOption.c_str(),
 					"Enable heuristics to support optimized build. See documentation for restrictions.")
+				(ProgramOptions::BasicBlockBreakPointsOption.c_str(),
+					"Set one breakpoint by basic block: lines of the same block are executed together. "
+					"A line can be reported as executed when a hardware exception occurs before it.")
+				(ProgramOptions::ExportPluginOutOfProcessOption.c_str(),
+					"Run export plugins in a separate process, at the same time as the other exports.")
+				(ProgramOptions::ExportPluginTimeoutOption.c_str(), po::value<size_t>(),
+					("Stop an export plugin that runs longer than N seconds and report an error. Requires --" +
+					ProgramOptions::ExportPluginOutOfProcessOption + ".").c_str())
+				(ProgramOptions::ExportModuleByModuleOption.c_str(),
+					"Merge and export the coverage one module at a time to reduce memory usage during the export. "
+					"The coverage of the run is still collected in full and written to a temporary file first. "
+					"Export plugins are not supported.")
+				(ProgramOptions::CoverageMemoryBudgetOption.c_str(), po::value<size_t>(),
+					"Memory in MB used to store the coverage while running. When exceeded, "
+					"modules unloaded in all processes are moved to a temporary file.")
+				(ProgramOptions::SnapshotIntervalOption.c_str(), po::value<size_t>(),
+					"Write a coverage snapshot every N seconds while the program is running.")
+				(ProgramOptions::SnapshotTriggerFileOption.c_str(), po::value<std::string>(),
+					"Write a coverage snapshot when this file is created. The file is then deleted.")
+				(ProgramOptions::SnapshotDirectoryOption.c_str(), po::value<std::string>(),
+					("The directory of the snapshots (default: " + ProgramOptions::SnapshotDirectoryDefaultValue +
+					"). Each snapshot is a binary coverage file with the lines changed since the previous one, "
+					"named Snapshot-<start time>-<process id>-<index>.cov. "
+					"Use --" + ProgramOptions::InputCoverageValue + " with all of them to get the full coverage.").c_str())
+				(ProgramOptions::CoverageJournalOption.c_str(), po::value<std::string>(),
+					("Write the coverage to this journal while the program is running. If the run is killed, use --" +
+					ProgramOptions::InputCoverageJournalOption + " to recover it.").c_str())
+				(ProgramOptions::InputCoverageJournalOption.c_str(), po::value<T_Strings>()->composing(),
+					("A journal written by --" + ProgramOptions::CoverageJournalOption +
+					". This coverage data will be merged with the current one. Can have multiple occurrences.").c_str())
+				(ProgramOptions::BatchCommandOption.c_str(), po::value<T_Strings>()->composing(),
+					"A command line to run with the coverage, usually set in the config file. "
+					"The coverage of all commands is merged. Can have multiple occurrences.")
+				(ProgramOptions::BatchJobsOption.c_str(), po::value<size_t>(),
+					("The maximum number of --" + ProgramOptions::BatchCommandOption +
+					" running at the same time (default: the number of processors).").c_str())
 				(ProgramOptions::ExcludedLineRegexOption.c_str(), po::value<T_Strings>()->composing(),
 					"Exclude all lines match the regular expression. Regular expression must match the whole line.")
 				(ProgramOptions::SubstitutePdbSourcePathOption.c_str(), po::value<T_Strings>()->composing(),
 					"Substitute the starting path defined in the pdb by a local path.\nFormat: <pdbStartPath>?<localPath>. "
-					"Can have multiple occurrences.");
+					"Can have multiple occurrences.")
+				(ProgramOptions::SummaryOnlyOption.c_str(),
+					"Only display the executed line counts of each module. No coverage report is exported.")
+				(ProgramOptions::SummaryOutputOption.c_str(), po::value<std::string>(),
+					("Write the summary to this JSON file. Requires --" + ProgramOptions::SummaryOnlyOption + ".").c_str())
+				(ProgramOptions::SummaryThresholdOption.c_str(), po::value<size_t>(),
+					("Minimum total coverage in percent. When the coverage is lower and the program succeeds, "
+					"a specific error code is returned. Requires --" + ProgramOptions::SummaryOnlyOption + ".").c_str());
 			for (const auto& optionParser : optionParsers)
 				optionParser->AddOption(options);
 		}
@@ -121,6 +203,7 @@ namespace CppCoverage
 	const std::string ProgramOptions::ConfigFileOption = "config_file";
 	const std::string ProgramOptions::WorkingDirectoryOption = "working_dir";
 	const std::string ProgramOptions::CoverChildrenOption = "cover_children";
+	const std::string ProgramOptions::CoverChildrenInParallelOption = "cover_children_in_parallel";
 	const std::string ProgramOptions::NoAggregateByFileOption = "no_aggregate_by_file";
 	const std::string ProgramOptions::ProgramToRunOption = "programToRun";
 	const std::string ProgramOptions::ProgramToRunArgOption = "programToRunArg";
@@ -128,8 +211,33 @@ namespace CppCoverage
 	const std::string ProgramOptions::UnifiedDiffOption = "unified_diff";
 	const std::string ProgramOptions::ContinueAfterCppExceptionOption = "continue_after_cpp_exception";
 	const std::string ProgramOptions::OptimizedBuildOption = "optimized_build";
+	const std::string ProgramOptions::BasicBlockBreakPointsOption = "basic_block_breakpoints";
+	const std::string ProgramOptions::ExportPluginOutOfProcessOption = "export_plugin_out_of_process";
+	const std::string ProgramOptions::ExportPluginTimeoutOption = "export_plugin_timeout";
+	const std::string ProgramOptions::ExportModuleByModuleOption = "export_module_by_module";
+	const std::string ProgramOptions::CoverageMemoryBudgetOption = "coverage_memory_budget";
+	const std::string ProgramOptions::SnapshotIntervalOption = "snapshot_interval";
+	const std::string ProgramOptions::SnapshotTriggerFileOption = "snapshot_trigger_file";
+	const std::string ProgramOptions::SnapshotDirectoryOption = "snapshot_directory";
+	const std::string ProgramOptions::SnapshotDirectoryDefaultValue = "CoverageSnapshots";
+	const std::string ProgramOptions::CoverageJournalOption = "coverage_journal";
+	const std::string ProgramOptions::InputCoverageJournalOption = "input_coverage_journal";
+	const std::string ProgramOptions::BatchCommandOption = "batch_command";
+	const std::string ProgramOptions::BatchJobsOption = "batch_jobs";
 	const std::string ProgramOptions::ExcludedLineRegexOption = "excluded_line_regex";
 	const std::string ProgramOptions::SubstitutePdbSourcePathOption = "substitute_pdb_source_path";
+	const std::string ProgramOptions::SummaryOnlyOption = "summary_only";
+	const std::string ProgramOptions::SummaryOutputOption = "summary_output";
+	const std::string ProgramOptions::SummaryThresholdOption = "summary_threshold";
+	const std::string ProgramOptions::DaemonClientOption = "daemon_client";
+	const std::string ProgramOptions::DaemonOption = "daemon";
+	const std::string ProgramOptions::DaemonStopOption = "daemon_stop";
+	const std::string ProgramOptions::AggregationServerOption = "aggregation_server";
+	const std::string ProgramOptions::AggregationClientOption = "aggregation_client";
+	const std::string ProgramOptions::HistoryOption = "history";
+	const std::string ProgramOptions::DiffOption = "diff";
+	const std::string ProgramOptions::QueryOption = "query";
+	const std::string ProgramOptions::ExportPluginHostOption = "export_plugin_host";
 	const std::string ProgramOptions::StopOnAssertOption = "stop_on_assert";
 	const std::string ProgramOptions::DumpOnCrashOption = "dump_on_crash";
 	const std::string ProgramOptions::DumpDirectoryOption = "dump_directory";
@@ -141,17 +249,22 @@ namespace CppCoverage
 		, configurationOptions_{ "Command line and configuration file" }
 		, hiddenOptions_{ "Hidden" }
 		, genericOptions_{ "Command line only" }
+		, subcommandOptions_{ "Subcommands (instead of running a program)" }
+		, hiddenSubcommandOptions_{ "Hidden subcommands" }
 	{
 		FillGenericOptions(genericOptions_);
 		FillConfigurationOptions(configurationOptions_, optionParsers);
 		FillHiddenOptions(hiddenOptions_);
+		FillSubcommandOptions(subcommandOptions_);
+		FillHiddenSubcommandOptions(hiddenSubcommandOptions_);
 
 		positionalOptions_.add(ProgramToRunOption.c_str(), 1);
 		positionalOptions_.add(ProgramToRunArgOption.c_str(), -1);
 
-		commandLineOptions_.add(genericOptions_).add(configurationOptions_).add(hiddenOptions_);
+		commandLineOptions_.add(genericOptions_).add(configurationOptions_).add(hiddenOptions_)
+			.add(subcommandOptions_).add(hiddenSubcommandOptions_);
 		configFileOptions_.add(configurationOptions_).add(hiddenOptions_);
-		visibleOptions_.add(genericOptions_).add(configurationOptions_);
+		visibleOptions_.add(genericOptions_).add(configurationOptions_).add(subcommandOptions_);
 	}
 
 	//-------------------------------------------------------------------------
@@ -41,6 +41,7 @@ namespace CppCoverage
 		static const std::string ConfigFileOption;
 		static const std::string WorkingDirectoryOption;
 		static const std::string CoverChildrenOption;
+		static const std::string CoverChildrenInParallelOption;
 		static const std::string NoAggregateByFileOption;
 		static const std::string StopOnAssertOption;
 		static const std::string DumpOnCrashOption;
@@ -51,8 +52,35 @@ namespace CppCoverage
 		static const std::string UnifiedDiffOption;
 		static const std::string ContinueAfterCppExceptionOption;
 		static const std::string OptimizedBuildOption;
+		static const std::string BasicBlockBreakPointsOption;
+		static const std::string ExportPluginOutOfProcessOption;
+		static const std::string ExportPluginTimeoutOption;
+		static const std::string ExportModuleByModuleOption;
+		static const std::string CoverageMemoryBudgetOption;
+		static const std::string SnapshotIntervalOption;
+		static const std::string SnapshotTriggerFileOption;
+		static const std::string SnapshotDirectoryOption;
+		static const std::string SnapshotDirectoryDefaultValue;
+		static const std::string CoverageJournalOption;
+		static const std::string InputCoverageJournalOption;
+		static const std::string BatchCommandOption;
+		static const std::string BatchJobsOption;
 		static const std::string ExcludedLineRegexOption;
 		static const std::string SubstitutePdbSourcePathOption;
+		static const std::string SummaryOnlyOption;
+		static const std::string SummaryOutputOption;
+		static const std::string SummaryThresholdOption;
+		static const std::string DaemonClientOption;
+
+		// Subcommands run a tool instead of the coverage.
+		static const std::string DaemonOption;
+		static const std::string DaemonStopOption;
+		static const std::string AggregationServerOption;
+		static const std::string AggregationClientOption;
+		static const std::string HistoryOption;
+		static const std::string DiffOption;
+		static const std::string QueryOption;
+		static const std::string ExportPluginHostOption;
 
 		explicit ProgramOptions(const std::vector<std::unique_ptr<IOptionParser>>&);
 
@@ -72,6 +100,8 @@ namespace CppCoverage
 		boost::program_options::options_description genericOptions_;
 		boost::program_options::options_description configurationOptions_;
 		boost::program_options::options_description hiddenOptions_;
+		boost::program_options::options_description subcommandOptions_;
+		boost::program_options::options_description hiddenSubcommandOptions_;
 
 		boost::program_options::options_description commandLineOptions_;
 		boost::program_options::options_description visibleOptions_;
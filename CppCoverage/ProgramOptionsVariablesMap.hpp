@@ -68,6 +68,12 @@ namespace CppCoverage
 			return variables_map_;
 		}
 
+		//---------------------------------------------------------------------
+		const VariableMap& GetVariablesMap() const
+		{
+			return variables_map_;
+		}
+
 	  private:
 		ProgramOptionsVariablesMap(const ProgramOptionsVariablesMap&) = delete;
 		ProgramOptionsVariablesMap&
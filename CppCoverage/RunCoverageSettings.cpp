@@ -30,12 +30,14 @@ namespace CppCoverage
 		coverageFilterSettings_{ settings },
 		unifiedDiffSettings_{ unifiedDiffSettings },
 		coverChildren_{ false },
+		coverChildrenInParallel_{ false },
 		continueAfterCppException_{ false },
 		stopOnAssert_{ false },
 		dumpOnCrash_{ false },
 		dumpDirectory_{ L"" },
 		maxUnmatchPathsForWarning_{ 0 },
 		optimizedBuildSupport_{ false },
+		basicBlockBreakPoints_{ false },
 		excludedLineRegexes_{ excludedLineRegexes },
 		substitutePdbSourcePath_{ substitutePdbSourcePath }
 	{
@@ -47,6 +49,12 @@ namespace CppCoverage
 		coverChildren_ = coverChildren;
 	}
 
+	//-------------------------------------------------------------------------
+	void RunCoverageSettings::SetCoverChildrenInParallel(bool coverChildrenInParallel)
+	{
+		coverChildrenInParallel_ = coverChildrenInParallel;
+	}
+
 	//-------------------------------------------------------------------------
 	void RunCoverageSettings::SetContinueAfterCppException(bool continueAfterCppException)
 	{
@@ -83,6 +91,35 @@ namespace CppCoverage
 		optimizedBuildSupport_ = optimizedBuildSupport;
 	}
 
+	//-------------------------------------------------------------------------
+	void RunCoverageSettings::SetBasicBlockBreakPoints(bool basicBlockBreakPoints)
+	{
+		basicBlockBreakPoints_ = basicBlockBreakPoints;
+	}
+
+	//-------------------------------------------------------------------------
+	void RunCoverageSettings::SetCoverageMemoryBudget(
+		boost::optional<size_t> coverageMemoryBudget)
+	{
+		coverageMemoryBudget_ = coverageMemoryBudget;
+	}
+
+	//-------------------------------------------------------------------------
+	void RunCoverageSettings::SetSnapshotSettings(
+		const SnapshotSettings& snapshotSettings,
+		SnapshotHandler snapshotHandler)
+	{
+		snapshotSettings_ = snapshotSettings;
+		snapshotHandler_ = std::move(snapshotHandler);
+	}
+
+	//-------------------------------------------------------------------------
+	void RunCoverageSettings::SetCoverageJournalPath(
+		const boost::optional<std::filesystem::path>& coverageJournalPath)
+	{
+		coverageJournalPath_ = coverageJournalPath;
+	}
+
 	//-------------------------------------------------------------------------
 	const StartInfo& RunCoverageSettings::GetStartInfo() const
 	{
@@ -107,6 +144,12 @@ namespace CppCoverage
 		return coverChildren_;
 	}
 
+	//-------------------------------------------------------------------------
+	bool RunCoverageSettings::GetCoverChildrenInParallel() const
+	{
+		return coverChildrenInParallel_;
+	}
+
 	//-------------------------------------------------------------------------
 	bool RunCoverageSettings::GetContinueAfterCppException() const
 	{
@@ -143,6 +186,36 @@ namespace CppCoverage
 		return optimizedBuildSupport_;
 	}
 
+	//-------------------------------------------------------------------------
+	bool RunCoverageSettings::GetBasicBlockBreakPoints() const
+	{
+		return basicBlockBreakPoints_;
+	}
+
+	//-------------------------------------------------------------------------
+	boost::optional<size_t> RunCoverageSettings::GetCoverageMemoryBudget() const
+	{
+		return coverageMemoryBudget_;
+	}
+
+	//-------------------------------------------------------------------------
+	const boost::optional<SnapshotSettings>& RunCoverageSettings::GetSnapshotSettings() const
+	{
+		return snapshotSettings_;
+	}
+
+	//-------------------------------------------------------------------------
+	const SnapshotHandler& RunCoverageSettings::GetSnapshotHandler() const
+	{
+		return snapshotHandler_;
+	}
+
+	//-------------------------------------------------------------------------
+	const boost::optional<std::filesystem::path>& RunCoverageSettings::GetCoverageJournalPath() const
+	{
+		return coverageJournalPath_;
+	}
+
 	//-------------------------------------------------------------------------
 	const std::vector<std::wstring>& RunCoverageSettings::GetExcludedLineRegexes() const
 	{
@@ -17,12 +17,15 @@
 #pragma once
 
 #include <vector>
+#include <boost/optional.hpp>
+
 #include "StartInfo.hpp"
 #include "UnifiedDiffSettings.hpp"
 #include "CoverageFilterSettings.hpp"
 
 #include "CppCoverageExport.hpp"
 #include "SubstitutePdbSourcePath.hpp"
+#include "SnapshotSettings.hpp"
 
 namespace CppCoverage
 {
@@ -40,23 +43,34 @@ namespace CppCoverage
 		RunCoverageSettings& operator=(const RunCoverageSettings&) = delete;
 
 		void SetCoverChildren(bool);
+		void SetCoverChildrenInParallel(bool);
 		void SetContinueAfterCppException(bool);
 		void SetStopOnAssert(bool);
 		void SetDumpOnCrash(bool);
 		void SetDumpDirectory(const std::filesystem::path&);
 		void SetMaxUnmatchPathsForWarning(size_t);
 		void SetOptimizedBuildSupport(bool);
+		void SetBasicBlockBreakPoints(bool);
+		void SetCoverageMemoryBudget(boost::optional<size_t>);
+		void SetSnapshotSettings(const SnapshotSettings&, SnapshotHandler);
+		void SetCoverageJournalPath(const boost::optional<std::filesystem::path>&);
 
 		const StartInfo& GetStartInfo() const;
 		const CoverageFilterSettings& GetCoverageFilterSettings() const;
 		const std::vector<UnifiedDiffSettings>& GetUnifiedDiffSettings() const;
 		bool GetCoverChildren() const;
+		bool GetCoverChildrenInParallel() const;
 		bool GetContinueAfterCppException() const;
 		bool GetStopOnAssert() const;
 		bool GetDumpOnCrash() const;
 		const std::filesystem::path& GetDumpDirectory() const;
 		size_t GetMaxUnmatchPathsForWarning() const;
 		bool GetOptimizedBuildSupport() const;
+		bool GetBasicBlockBreakPoints() const;
+		boost::optional<size_t> GetCoverageMemoryBudget() const;
+		const boost::optional<SnapshotSettings>& GetSnapshotSettings() const;
+		const SnapshotHandler& GetSnapshotHandler() const;
+		const boost::optional<std::filesystem::path>& GetCoverageJournalPath() const;
 		const std::vector<std::wstring>& GetExcludedLineRegexes() const;
 		const std::vector<SubstitutePdbSourcePath>& GetSubstitutePdbSourcePaths() const;
 
@@ -65,12 +79,18 @@ namespace CppCoverage
 		CoverageFilterSettings coverageFilterSettings_;
 		std::vector<UnifiedDiffSettings> unifiedDiffSettings_;
 		bool coverChildren_;
+		bool coverChildrenInParallel_;
 		bool continueAfterCppException_;
 		bool stopOnAssert_;
 		bool dumpOnCrash_;
 		std::filesystem::path dumpDirectory_;
 		size_t maxUnmatchPathsForWarning_;
 		bool optimizedBuildSupport_;
+		bool basicBlockBreakPoints_;
+		boost::optional<size_t> coverageMemoryBudget_;
+		boost::optional<SnapshotSettings> snapshotSettings_;
+		SnapshotHandler snapshotHandler_;
+		boost::optional<std::filesystem::path> coverageJournalPath_;
 		std::vector<std::wstring> excludedLineRegexes_;
 		std::vector<SubstitutePdbSourcePath> substitutePdbSourcePath_;
 	};
@@ -0,0 +1,58 @@
+// OpenCppCoverage is an open source code coverage for C++.
+// Copyright (C) 2019 OpenCppCoverage
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#pragma once
+
+#include <chrono>
+#include <filesystem>
+#include <functional>
+#include <boost/optional/optional.hpp>
+
+#include "CppCoverageExport.hpp"
+
+namespace Plugin
+{
+	class CoverageData;
+}
+
+namespace CppCoverage
+{
+	// Receive the lines that changed since the previous snapshot.
+	using SnapshotHandler = std::function<void(Plugin::CoverageData&&)>;
+
+	class CPPCOVERAGE_DLL SnapshotSettings
+	{
+	public:
+		SnapshotSettings(
+			const boost::optional<std::chrono::seconds>& interval,
+			const boost::optional<std::filesystem::path>& triggerFile,
+			const std::filesystem::path& directory);
+		SnapshotSettings(const SnapshotSettings&) = default;
+		SnapshotSettings(SnapshotSettings&&) = default;
+
+		const boost::optional<std::chrono::seconds>& GetInterval() const;
+		const boost::optional<std::filesystem::path>& GetTriggerFile() const;
+		const std::filesystem::path& GetDirectory() const;
+
+		SnapshotSettings& operator=(const SnapshotSettings&) = default;
+
+	private:
+		boost::optional<std::chrono::seconds> interval_;
+		boost::optional<std::filesystem::path> triggerFile_;
+		std::filesystem::path directory_;
+	};
+}
@@ -48,6 +48,7 @@ namespace CppCoverage
 		: path_{ std::move(startInfo.path_) }
 		, arguments_(std::move(startInfo.arguments_))
 		, workingDirectory_{ std::move(startInfo.workingDirectory_) }
+		, environment_{ std::move(startInfo.environment_) }
 	{
 	}
 
@@ -64,6 +65,12 @@ namespace CppCoverage
 		arguments_.push_back(argument);
 	}
 
+	//-------------------------------------------------------------------------
+	void StartInfo::SetEnvironment(std::vector<std::wstring>&& environment)
+	{
+		environment_ = std::move(environment);
+	}
+
 	//-------------------------------------------------------------------------
 	const std::filesystem::path& StartInfo::GetPath() const
 	{
@@ -84,6 +91,12 @@ namespace CppCoverage
 		return nullptr;
 	}
 
+	//-------------------------------------------------------------------------
+	const std::vector<std::wstring>* StartInfo::GetEnvironment() const
+	{
+		return environment_.get_ptr();
+	}
+
 	//-------------------------------------------------------------------------
 	std::wostream& operator<<(std::wostream& ostr, const StartInfo& startInfo)
 	{
@@ -39,9 +39,14 @@ namespace CppCoverage
 		void SetWorkingDirectory(const std::filesystem::path&);
 		void AddArgument(const std::wstring&);
 
+		// Variables as "name=value". The process inherits the current
+		// environment when it is not set.
+		void SetEnvironment(std::vector<std::wstring>&&);
+
 		const std::filesystem::path& GetPath() const;
 		const std::vector<std::wstring>& GetArguments() const;
 		const std::filesystem::path* GetWorkingDirectory() const;
+		const std::vector<std::wstring>* GetEnvironment() const;
 
 		friend CPPCOVERAGE_DLL std::wostream& operator<<(std::wostream& ostr, const StartInfo&);
 
@@ -49,6 +54,7 @@ namespace CppCoverage
 		std::filesystem::path path_;
 		std::vector<std::wstring> arguments_;
 		boost::optional<std::filesystem::path> workingDirectory_;
+		boost::optional<std::vector<std::wstring>> environment_;
 	};
 }
 
@@ -0,0 +1,56 @@
+// OpenCppCoverage is an open source code coverage for C++.
+// Copyright (C) 2019 OpenCppCoverage
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "CppCoverageExport.hpp"
+
+namespace CppCoverage
+{
+	enum class SubcommandType
+	{
+		Daemon,
+		DaemonStop,
+		AggregationServer,
+		AggregationClient,
+		History,
+		Diff,
+		Query,
+		ExportPluginHost
+	};
+
+	// Command line running a tool of OpenCppCoverage instead of the coverage,
+	// such as --daemon. Arguments are the values of the option.
+	class CPPCOVERAGE_DLL Subcommand
+	{
+	public:
+		Subcommand(SubcommandType, std::vector<std::wstring>&& arguments);
+		Subcommand(const Subcommand&) = default;
+		Subcommand(Subcommand&&) = default;
+
+		SubcommandType GetType() const;
+		const std::vector<std::wstring>& GetArguments() const;
+
+		Subcommand& operator=(const Subcommand&) = default;
+
+	private:
+		SubcommandType type_;
+		std::vector<std::wstring> arguments_;
+	};
+}
@@ -0,0 +1,203 @@
+// OpenCppCoverage is an open source code coverage for C++.
+// Copyright (C) 2019 OpenCppCoverage
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "stdafx.h"
+
+#include "CppCoverage/BasicBlockPlanner.hpp"
+
+namespace cov = CppCoverage;
+
+namespace CppCoverageTest
+{
+	namespace
+	{
+		using Line = cov::BasicBlockPlanner::Line;
+		using Leaders = std::unordered_map<std::uint64_t, std::uint64_t>;
+
+		const std::uint64_t CodeAddress = 0x1000;
+		const unsigned long SymbolIndex = 1;
+		const unsigned int FileId = 1;
+
+		//---------------------------------------------------------------------
+		cov::BasicBlockPlanner CreatePlanner(
+			const std::vector<unsigned char>& code,
+			std::vector<std::pair<std::uint64_t, size_t>>* reads = nullptr)
+		{
+			return cov::BasicBlockPlanner{
+				cov::InstructionDecoder::Mode::X64,
+				[=](std::uint64_t address, size_t size) {
+					if (reads)
+						reads->emplace_back(address, size);
+					auto begin = std::min(static_cast<size_t>(address - CodeAddress), code.size());
+					auto end = std::min(begin + size, code.size());
+					return std::vector<unsigned char>(code.begin() + begin, code.begin() + end);
+				} };
+		}
+
+		//---------------------------------------------------------------------
+		Line MakeLine(std::uint64_t offset)
+		{
+			return Line{ CodeAddress + offset, SymbolIndex, FileId, true };
+		}
+
+		//---------------------------------------------------------------------
+		Leaders MakeLeaders(const std::vector<std::pair<std::uint64_t, std::uint64_t>>& offsets)
+		{
+			Leaders leaders;
+			for (const auto& offset : offsets)
+				leaders.emplace(CodeAddress + offset.first, CodeAddress + offset.second);
+			return leaders;
+		}
+	}
+
+	//-------------------------------------------------------------------------
+	TEST(BasicBlockPlannerTest, StraightLineCode)
+	{
+		auto planner = CreatePlanner({
+			0x48, 0x83, 0xEC, 0x20, // 0: sub rsp, 20h
+			0x8B, 0xC1,             // 4: mov eax, ecx
+			0x03, 0xC2,             // 6: add eax, edx
+			0xC3 });                // 8: ret
+
+		auto leaders = planner.Plan({ MakeLine(6), MakeLine(0), MakeLine(4), MakeLine(8) });
+		ASSERT_EQ(MakeLeaders({ { 0, 0 }, { 4, 0 }, { 6, 0 }, { 8, 0 } }), leaders);
+	}
+
+	//-------------------------------------------------------------------------
+	TEST(BasicBlockPlannerTest, CallEndsBlock)
+	{
+		auto planner = CreatePlanner({
+			0xE8, 0x00, 0x00, 0x00, 0x00, // 0: call
+			0x8B, 0xC1,                   // 5: mov eax, ecx
+			0xC3 });                      // 7: ret
+
+		auto leaders = planner.Plan({ MakeLine(0), MakeLine(5), MakeLine(7) });
+		ASSERT_EQ(MakeLeaders({ { 0, 0 }, { 5, 5 }, { 7, 5 } }), leaders);
+	}
+
+	//-------------------------------------------------------------------------
+	TEST(BasicBlockPlannerTest, BranchTargetStartsBlock)
+	{
+		auto planner = CreatePlanner({
+			0x85, 0xC9, // 0: test ecx, ecx
+			0xFF, 0xC9, // 2: dec ecx
+			0x90,       // 4: nop
+			0x75, 0xFB, // 5: jne 2
+			0xC3 });    // 7: ret
+
+		auto leaders = planner.Plan({ MakeLine(0), MakeLine(2), MakeLine(4), MakeLine(5), MakeLine(7) });
+		ASSERT_EQ(MakeLeaders({ { 0, 0 }, { 2, 2 }, { 4, 2 }, { 5, 2 }, { 7, 7 } }), leaders);
+	}
+
+	//-------------------------------------------------------------------------
+	TEST(BasicBlockPlannerTest, BranchTargetInsideLine)
+	{
+		auto planner = CreatePlanner({
+			0x8B, 0xC1, // 0: mov eax, ecx
+			0xFF, 0xC8, // 2: dec eax
+			0x90,       // 4: nop
+			0x75, 0xFB, // 5: jne 2
+			0xC3 });    // 7: ret
+
+		auto leaders = planner.Plan({ MakeLine(0), MakeLine(4), MakeLine(7) });
+		ASSERT_EQ(MakeLeaders({ { 0, 0 }, { 4, 4 }, { 7, 7 } }), leaders);
+	}
+
+	//-------------------------------------------------------------------------
+	TEST(BasicBlockPlannerTest, IndirectJump)
+	{
+		auto planner = CreatePlanner({
+			0x8B, 0xC1, // 0: mov eax, ecx
+			0x90,       // 2: nop
+			0xFF, 0xE0, // 3: jmp rax
+			0x90,       // 5: nop
+			0x90,       // 6: nop
+			0xC3 });    // 7: ret
+
+		auto otherSymbol = SymbolIndex + 1;
+		auto leaders = planner.Plan({
+			MakeLine(0), MakeLine(2), MakeLine(3),
+			Line{ CodeAddress + 5, otherSymbol, FileId, true },
+			Line{ CodeAddress + 6, otherSymbol, FileId, true } });
+		ASSERT_EQ(MakeLeaders({ { 0, 0 }, { 2, 2 }, { 3, 3 }, { 5, 5 }, { 6, 5 } }), leaders);
+	}
+
+	//-------------------------------------------------------------------------
+	TEST(BasicBlockPlannerTest, LinesNotMonitored)
+	{
+		auto planner = CreatePlanner({ 0x90, 0x90, 0x90, 0x90, 0xC3 });
+
+		auto leaders = planner.Plan({
+			Line{ CodeAddress, SymbolIndex, FileId, false },
+			MakeLine(1),
+			Line{ CodeAddress + 2, SymbolIndex, FileId, false },
+			MakeLine(3) });
+		ASSERT_EQ(MakeLeaders({ { 1, 1 }, { 3, 1 } }), leaders);
+	}
+
+	//-------------------------------------------------------------------------
+	TEST(BasicBlockPlannerTest, DifferentFilesAndSymbols)
+	{
+		auto planner = CreatePlanner({ 0x90, 0x90, 0x90, 0x90, 0xC3 });
+
+		auto leaders = planner.Plan({
+			MakeLine(0),
+			Line{ CodeAddress + 1, SymbolIndex, FileId + 1, true },
+			Line{ CodeAddress + 2, SymbolIndex, FileId + 1, true },
+			Line{ CodeAddress + 3, SymbolIndex + 1, FileId + 1, true } });
+		ASSERT_EQ(MakeLeaders({ { 0, 0 }, { 1, 1 }, { 2, 1 }, { 3, 3 } }), leaders);
+	}
+
+	//-------------------------------------------------------------------------
+	TEST(BasicBlockPlannerTest, SharedAddress)
+	{
+		auto planner = CreatePlanner({ 0x90, 0x90, 0x90, 0xC3 });
+
+		auto leaders = planner.Plan({
+			MakeLine(0),
+			MakeLine(1),
+			Line{ CodeAddress + 1, SymbolIndex, FileId + 1, true },
+			MakeLine(2) });
+		ASSERT_EQ(MakeLeaders({ { 0, 0 }, { 1, 1 }, { 2, 2 } }), leaders);
+	}
+
+	//-------------------------------------------------------------------------
+	TEST(BasicBlockPlannerTest, InstructionOverlappingNextLine)
+	{
+		auto planner = CreatePlanner({
+			0xB8, 0x90, 0x90, 0x90, 0x90, // 0: mov eax, 90909090h
+			0xC3 });                      // 5: ret
+
+		auto leaders = planner.Plan({ MakeLine(0), MakeLine(2), MakeLine(5) });
+		ASSERT_EQ(MakeLeaders({ { 0, 0 }, { 2, 2 }, { 5, 2 } }), leaders);
+	}
+
+	//-------------------------------------------------------------------------
+	TEST(BasicBlockPlannerTest, DistantLines)
+	{
+		std::vector<unsigned char> code(2 * cov::BasicBlockPlanner::MaxLineGap, 0x90);
+		std::vector<std::pair<std::uint64_t, size_t>> reads;
+		auto planner = CreatePlanner(code, &reads);
+
+		auto distantOffset = cov::BasicBlockPlanner::MaxLineGap + 2;
+		auto leaders = planner.Plan({ MakeLine(0), MakeLine(1), MakeLine(distantOffset) });
+
+		ASSERT_EQ(MakeLeaders({ { 0, 0 }, { 1, 0 }, { distantOffset, distantOffset } }), leaders);
+		ASSERT_EQ(2u, reads.size());
+		ASSERT_EQ(CodeAddress, reads[0].first);
+		ASSERT_EQ(CodeAddress + distantOffset, reads[1].first);
+	}
+}
@@ -34,9 +34,12 @@
 #include "CppCoverage/CoverageDataMerger.hpp"
 #include "CppCoverage/UnifiedDiffSettings.hpp"
 #include "CppCoverage/RunCoverageSettings.hpp"
+#include "CppCoverage/CoverageSummary.hpp"
+#include "CppCoverage/CoverageRateComputer.hpp"
 
 #include "Tools/Log.hpp"
 #include "Tools/Tool.hpp"
+#include "Tools/WarningManager.hpp"
 
 #include "TestHelper/CoverageDataComparer.hpp"
 #include "TestHelper/Tools.hpp"
@@ -295,6 +298,54 @@ namespace CppCoverageTest
 			rootOnlyModules, rootAndChildModules));
 	}
 
+	//-------------------------------------------------------------------------
+	TEST_F(CodeCoverageRunnerTest, ChildProcessInParallel)
+	{
+		std::vector<std::wstring> arguments = {
+			TestCoverageConsole::TestChildProcess,
+			TestCoverageConsole::TestChildProcess,
+			TestCoverageConsole::TestThrowHandledException };
+		const auto modulePattern = TestCoverageConsole::GetOutputBinaryPath().wstring();
+		const auto sourcePattern = TestCoverageConsole::GetMainCppFilename().wstring();
+
+		CoverageArgs args{ arguments, modulePattern, sourcePattern };
+
+		auto sequential = ComputeCoverageDataPatterns(args);
+
+		args.coverChildrenInParallel_ = true;
+		auto parallel = ComputeCoverageDataPatterns(args);
+
+		ASSERT_EQ(sequential.GetName(), parallel.GetName());
+		ASSERT_EQ(sequential.GetExitCode(), parallel.GetExitCode());
+		ASSERT_TRUE(TestHelper::CoverageDataComparer().IsFirstCollectionContainsSecond(
+			parallel.GetModules(), sequential.GetModules()));
+		ASSERT_TRUE(TestHelper::CoverageDataComparer().IsFirstCollectionContainsSecond(
+			sequential.GetModules(), parallel.GetModules()));
+	}
+
+	//-------------------------------------------------------------------------
+	TEST_F(CodeCoverageRunnerTest, GrandChildProcessInParallel)
+	{
+		std::vector<std::wstring> arguments = {
+			TestCoverageConsole::TestChildProcess,
+			TestCoverageConsole::TestGrandChildProcess,
+			TestCoverageConsole::TestThrowHandledException };
+		const auto modulePattern = TestCoverageConsole::GetOutputBinaryPath().wstring();
+		const auto sourcePattern = TestCoverageConsole::GetMainCppFilename().wstring();
+
+		CoverageArgs args{ arguments, modulePattern, sourcePattern };
+
+		args.coverChildrenInParallel_ = true;
+		std::vector<Plugin::CoverageData> coverageDataCollection;
+		coverageDataCollection.push_back(ComputeCoverageDataPatterns(args));
+		auto mergedCoverageData = cov::CoverageDataMerger().Merge(coverageDataCollection);
+
+		// Only the grandchild process throws the handled exception.
+		auto& file = GetFirstFileCoverage(mergedCoverageData);
+		int mainLine = TestCoverageConsole::GetTestCoverageConsoleCppMainStartLine();
+		TestLine(file, mainLine + 15, true); // TestThrowHandledException
+	}
+
 	//-------------------------------------------------------------------------
 	TEST_F(CodeCoverageRunnerTest, SeveralChildProcess)
 	{
@@ -319,6 +370,34 @@ namespace CppCoverageTest
 		TestLine(file, mainLine + 23, true); // TestChildProcess
 	}
 
+	//-------------------------------------------------------------------------
+	TEST_F(CodeCoverageRunnerTest, BatchCoverage)
+	{
+		const std::vector<std::vector<std::wstring>> argumentsCollection = {
+			{ TestCoverageConsole::TestThrowHandledException },
+			{ TestCoverageConsole::TestThrowUnHandledCppException },
+			{ TestCoverageConsole::TestThrowUnHandledSEHException } };
+		CoverageArgs args{ {}, TestCoverageConsole::GetOutputBinaryPath().wstring(),
+			TestCoverageConsole::GetMainCppFilename().wstring() };
+
+		auto coverageDatas = TestTools::ComputeBatchCoverageData(args, argumentsCollection, 2);
+		ASSERT_EQ(argumentsCollection.size(), coverageDatas.size());
+
+		for (const auto& arguments : argumentsCollection)
+		{
+			args.arguments_ = arguments;
+			auto expectedCoverageData = ComputeCoverageDataPatterns(args);
+			auto it = std::find_if(coverageDatas.begin(), coverageDatas.end(),
+				[&](const auto& coverageData) {
+					return TestHelper::CoverageDataComparer().IsFirstCollectionContainsSecond(
+						coverageData.GetModules(), expectedCoverageData.GetModules()) &&
+						TestHelper::CoverageDataComparer().IsFirstCollectionContainsSecond(
+						expectedCoverageData.GetModules(), coverageData.GetModules());
+				});
+			ASSERT_NE(coverageDatas.end(), it);
+		}
+	}
+
 	//-------------------------------------------------------------------------
 	TEST_F(CodeCoverageRunnerTest, TestFileInSeveralModules)
 	{
@@ -446,6 +525,51 @@ namespace CppCoverageTest
 		ASSERT_GT(optimizedBuildCount, count);
 	}
 
+	//-------------------------------------------------------------------------
+	TEST_F(CodeCoverageRunnerTest, BasicBlockBreakPoints)
+	{
+		CoverageArgs args{
+			{ TestCoverageConsole::TestBasic },
+			TestCoverageConsole::GetOutputBinaryPath().wstring(),
+			TestCoverageConsole::GetTestBasicFilename().wstring()
+		};
+
+		auto coverageData = ComputeCoverageDataPatterns(args);
+		args.basicBlockBreakPoints_ = true;
+		auto coverageDataBasicBlock = ComputeCoverageDataPatterns(args);
+
+		auto lines = GetFirstFileCoverage(coverageData).GetLines();
+		auto linesBasicBlock = GetFirstFileCoverage(coverageDataBasicBlock).GetLines();
+		ASSERT_EQ(lines.size(), linesBasicBlock.size());
+		for (size_t i = 0; i < lines.size(); ++i)
+		{
+			ASSERT_EQ(lines[i].GetLineNumber(), linesBasicBlock[i].GetLineNumber());
+			ASSERT_EQ(lines[i].HasBeenExecuted(), linesBasicBlock[i].HasBeenExecuted());
+		}
+	}
+
+	//-------------------------------------------------------------------------
+	TEST_F(CodeCoverageRunnerTest, CoverageSummary)
+	{
+		CoverageArgs args{
+			{ TestCoverageConsole::TestBasic },
+			TestCoverageConsole::GetOutputBinaryPath().wstring(),
+			TestCoverageConsole::GetTestBasicFilename().wstring()
+		};
+
+		auto coverageData = ComputeCoverageDataPatterns(args);
+		auto coverageSummary = TestTools::ComputeCoverageSummary(args);
+
+		cov::CoverageRateComputer coverageRateComputer{ coverageData };
+		const auto& coverageRate = coverageRateComputer.GetCoverageRate();
+		auto summaryCoverageRate = coverageSummary.GetCoverageRate();
+		ASSERT_NE(0, coverageRate.GetTotalLinesCount());
+		ASSERT_EQ(coverageRate.GetExecutedLinesCount(), summaryCoverageRate.GetExecutedLinesCount());
+		ASSERT_EQ(coverageRate.GetUnExecutedLinesCount(), summaryCoverageRate.GetUnExecutedLinesCount());
+		ASSERT_EQ(coverageData.GetExitCode(), coverageSummary.GetExitCode());
+		ASSERT_EQ(coverageData.GetModules().size(), coverageSummary.GetModuleCoverageRates().size());
+	}
+
 	//-------------------------------------------------------------------------
 	TEST_F(CodeCoverageRunnerTest, ExcludedLine)
 	{
@@ -495,4 +619,26 @@ namespace CppCoverageTest
 		const auto& file = GetFirstFileCoverage(coverageData);
 		ASSERT_EQ(expectedPath, file.GetPath());
 	}
-}
\ No newline at end of file
+
+	//-------------------------------------------------------------------------
+	TEST_F(CodeCoverageRunnerTest, SameRunnerWithOtherSources)
+	{
+		// The daemon runs all its requests with the same runner.
+		cov::CodeCoverageRunner codeCoverageRunner{ std::make_shared<Tools::WarningManager>() };
+		const auto testBasicFilename = TestCoverageConsole::GetTestBasicFilename();
+		const auto mainFilename = TestCoverageConsole::GetMainCppFilename();
+		CoverageArgs args{ { TestCoverageConsole::TestBasic },
+			TestCoverageConsole::GetOutputBinaryPath().wstring(), testBasicFilename.wstring() };
+
+		for (const auto& filename : { testBasicFilename, mainFilename, testBasicFilename })
+		{
+			args.sourcePatternCollection_ = { filename.wstring() };
+			auto coverageData = codeCoverageRunner.RunCoverage(*TestTools::CreateRunCoverageSettings(args));
+			const auto& files = coverageData.GetModules().at(0)->GetFiles();
+
+			ASSERT_EQ(1, files.size());
+			ASSERT_TRUE(boost::algorithm::iequals(
+				filename.wstring(), files.at(0)->GetPath().filename().wstring()));
+		}
+	}
+}
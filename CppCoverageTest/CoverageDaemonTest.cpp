@@ -0,0 +1,98 @@
+// OpenCppCoverage is an open source code coverage for C++.
+// Copyright (C) 2019 OpenCppCoverage
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "stdafx.h"
+
+#include <thread>
+#include <boost/algorithm/string/join.hpp>
+
+#include "CppCoverage/CoverageDaemon.hpp"
+
+#include "TestHelper/MemoryMessageChannel.hpp"
+
+namespace cov = CppCoverage;
+
+namespace CppCoverageTest
+{
+	namespace
+	{
+		//---------------------------------------------------------------------
+		struct DaemonRunner
+		{
+			DaemonRunner()
+				: daemon_{ [this](const cov::DaemonRequest& request) {
+					++requestCount_;
+					lastRequest_ = request;
+					return cov::DaemonResponse{
+						static_cast<int>(request.arguments.size()),
+						boost::algorithm::join(request.arguments, " ") };
+				} }
+				, thread_{ [this]() { daemon_.Serve(listener_); } }
+			{
+			}
+
+			~DaemonRunner()
+			{
+				listener_.Close();
+				if (thread_.joinable())
+					thread_.join();
+			}
+
+			TestHelper::MemoryMessageChannelListener listener_;
+			int requestCount_ = 0;
+			cov::DaemonRequest lastRequest_;
+			cov::CoverageDaemon daemon_;
+			std::thread thread_;
+		};
+	}
+
+	//-------------------------------------------------------------------------
+	TEST(CoverageDaemonTest, SendRequest)
+	{
+		DaemonRunner daemonRunner;
+
+		for (int i = 0; i < 2; ++i)
+		{
+			auto channel = daemonRunner.listener_.Connect();
+			cov::DaemonRequest request{
+				L"WorkingDirectory", { L"NAME=Value" }, { "--sources", "Test", "Program.exe" } };
+
+			auto response = cov::CoverageDaemon::SendRequest(*channel, request);
+			ASSERT_EQ(3, response.exitCode);
+			ASSERT_EQ("--sources Test Program.exe", response.output);
+			ASSERT_EQ(L"WorkingDirectory", daemonRunner.lastRequest_.workingDirectory);
+			ASSERT_EQ(request.environment, daemonRunner.lastRequest_.environment);
+		}
+
+		auto channel = daemonRunner.listener_.Connect();
+		cov::CoverageDaemon::SendStopRequest(*channel);
+		daemonRunner.thread_.join();
+		ASSERT_EQ(2, daemonRunner.requestCount_);
+	}
+
+	//-------------------------------------------------------------------------
+	TEST(CoverageDaemonTest, InvalidMessage)
+	{
+		DaemonRunner daemonRunner;
+
+		daemonRunner.listener_.Connect()->Write("Invalid");
+
+		auto channel = daemonRunner.listener_.Connect();
+		auto response = cov::CoverageDaemon::SendRequest(*channel, { L"", {}, { "Program.exe" } });
+		ASSERT_EQ(1, response.exitCode);
+		ASSERT_EQ(1, daemonRunner.requestCount_);
+	}
+}
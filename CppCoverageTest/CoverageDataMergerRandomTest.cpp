@@ -126,6 +126,31 @@ namespace CppCoverageTest
 			
 			return coverageDatas;
 		}
+
+		//---------------------------------------------------------------------
+		void CheckMergedCoverageData(
+			const Plugin::CoverageData& coverageDataMerged,
+			const LineInfoHasBeenExecuted& mergedLineInfo)
+		{
+			size_t totalLine = 0;
+
+			for (const auto& module : coverageDataMerged.GetModules())
+			{
+				for (const auto& file : module->GetFiles())
+				{
+					for (const auto& lineCoverage : file->GetLines())
+					{
+						const auto& executedCount = mergedLineInfo.at(
+							{ module->GetPath(), file->GetPath(), lineCoverage.GetLineNumber() });
+						auto hasBeenExecuted = executedCount > 0;
+						ASSERT_EQ(hasBeenExecuted, lineCoverage.HasBeenExecuted());
+						++totalLine;
+					}
+				}
+			}
+
+			ASSERT_EQ(mergedLineInfo.size(), totalLine);
+		}
 	}
 
 	//-------------------------------------------------------------------------
@@ -135,23 +160,18 @@ namespace CppCoverageTest
 		
 		auto coverageDatas = AddRandomCoverageDataCollection(6, mergedLineInfo);
 		auto coverageDataMerged = cov::CoverageDataMerger{}.Merge(coverageDatas);
-		size_t totalLine = 0;
 
-		for (const auto& module : coverageDataMerged.GetModules())
-		{
-			for (const auto& file : module->GetFiles())
-			{
-				for (const auto& lineCoverage : file->GetLines())
-				{
-					const auto& executedCount = mergedLineInfo.at(
-						{ module->GetPath(), file->GetPath(), lineCoverage.GetLineNumber() });
-					auto hasBeenExecuted = executedCount > 0;
-					ASSERT_EQ(hasBeenExecuted, lineCoverage.HasBeenExecuted());
-					++totalLine;
-				}
-			}
-		}
+		CheckMergedCoverageData(coverageDataMerged, mergedLineInfo);
+	}
+
+	//-------------------------------------------------------------------------
+	TEST(CoverageDataMergerRandomTest, RandomTestMove)
+	{
+		LineInfoHasBeenExecuted mergedLineInfo;
+
+		auto coverageDatas = AddRandomCoverageDataCollection(6, mergedLineInfo);
+		auto coverageDataMerged = cov::CoverageDataMerger{}.Merge(std::move(coverageDatas));
 
-		ASSERT_EQ(mergedLineInfo.size(), totalLine);
+		CheckMergedCoverageData(coverageDataMerged, mergedLineInfo);
 	}
 }
\ No newline at end of file
@@ -18,8 +18,11 @@
 
 #include <random>
 #include <filesystem>
+#include <memory_resource>
 
 #include "CppCoverage/CoverageDataMerger.hpp"
+#include "CppCoverage/CoverageDataAccumulator.hpp"
+#include "Plugin/Exporter/CoverageArena.hpp"
 #include "Plugin/Exporter/CoverageData.hpp" 
 #include "Plugin/Exporter/ModuleCoverage.hpp" 
 #include "Plugin/Exporter/FileCoverage.hpp" 
@@ -92,6 +95,54 @@ namespace CppCoverageTest
 			ASSERT_NE(nullptr, line);
 			ASSERT_EQ(exectedValue, line->HasBeenExecuted());
 		}
+
+		//-------------------------------------------------------------------------
+		class CountingMemoryResource : public std::pmr::memory_resource
+		{
+		public:
+			size_t allocatedBytes = 0;
+			size_t usedBytes = 0;
+
+		private:
+			void* do_allocate(size_t bytes, size_t alignment) override
+			{
+				allocatedBytes += bytes;
+				usedBytes += bytes;
+				return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+			}
+
+			void do_deallocate(void* p, size_t bytes, size_t alignment) override
+			{
+				usedBytes -= bytes;
+				std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+			}
+
+			bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+			{
+				return this == &other;
+			}
+		};
+
+		//---------------------------------------------------------------------
+		class ScopedDefaultMemoryResource
+		{
+		public:
+			explicit ScopedDefaultMemoryResource(std::pmr::memory_resource& memoryResource)
+				: previousMemoryResource_{ std::pmr::set_default_resource(&memoryResource) }
+			{
+			}
+
+			~ScopedDefaultMemoryResource()
+			{
+				std::pmr::set_default_resource(previousMemoryResource_);
+			}
+
+		private:
+			ScopedDefaultMemoryResource(const ScopedDefaultMemoryResource&) = delete;
+			ScopedDefaultMemoryResource& operator=(const ScopedDefaultMemoryResource&) = delete;
+
+			std::pmr::memory_resource* const previousMemoryResource_;
+		};
 	}
 
 	//-------------------------------------------------------------------------
@@ -161,6 +212,29 @@ namespace CppCoverageTest
 		CheckLineHasBeenExecuted(mergedFile, 3, true);
 	}
 
+	//-------------------------------------------------------------------------
+	TEST(CoverageDataMergerTest, MoveLine)
+	{
+		auto coverageDatas = CreateCoverageDataCollection(3);
+
+		AddLine(coverageDatas[0], modulePath, filePath, { { 0, false }, { 1, false }, { 2, true } });
+		AddLine(coverageDatas[1], modulePath, filePath, { { 1, true }, { 2, false }, { 3, true } });
+		AddLine(coverageDatas[2], L"otherModule", filePath, { { 4, true } });
+
+		auto coverageDataMerged = cov::CoverageDataMerger{}.Merge(std::move(coverageDatas));
+		const auto& modules = coverageDataMerged.GetModules();
+		ASSERT_EQ(2, modules.size());
+		ASSERT_EQ(modulePath, modules.at(0)->GetPath());
+
+		const auto& mergedFile = modules.at(0)->GetFiles().at(0);
+		ASSERT_EQ(4, mergedFile->GetLines().size());
+		CheckLineHasBeenExecuted(mergedFile, 0, false);
+		CheckLineHasBeenExecuted(mergedFile, 1, true);
+		CheckLineHasBeenExecuted(mergedFile, 2, true);
+		CheckLineHasBeenExecuted(mergedFile, 3, true);
+		ASSERT_EQ(1, modules.at(1)->GetFiles().at(0)->GetLines().size());
+	}
+
 	//-------------------------------------------------------------------------
 	TEST(CoverageDataMergerTest, MergeFileCoverageEmpty)
 	{
@@ -200,4 +274,75 @@ namespace CppCoverageTest
 			CheckLineHasBeenExecuted(mergedFile, 3, true);
 		}
 	}
+
+	//-------------------------------------------------------------------------
+	TEST(CoverageDataMergerTest, MergeReleasesArenas)
+	{
+		const unsigned int lineCount = 1000;
+		CountingMemoryResource memoryResource;
+		ScopedDefaultMemoryResource scopedDefaultMemoryResource{ memoryResource };
+		std::vector<Plugin::CoverageData> coverageDatas;
+
+		for (int i = 0; i < 10; ++i)
+		{
+			coverageDatas.push_back(Plugin::CoverageArena::CreateCoverageData(L"", 0));
+			auto& file = coverageDatas.back().AddModule(modulePath).AddFile(filePath);
+			for (unsigned int line = 0; line < lineCount; ++line)
+				file.AddLine(line, line == static_cast<unsigned int>(i));
+		}
+
+		auto allocatedBytes = memoryResource.allocatedBytes;
+		auto coverageDataMerged = cov::CoverageDataMerger{}.Merge(std::move(coverageDatas));
+		const auto maxLineBytes = 2 * lineCount * sizeof(Plugin::LineCoverage);
+
+		ASSERT_LE(memoryResource.allocatedBytes - allocatedBytes, 2 * maxLineBytes);
+		ASSERT_LE(memoryResource.usedBytes, maxLineBytes);
+		const auto& mergedFile = coverageDataMerged.GetModules().at(0)->GetFiles().at(0);
+		ASSERT_EQ(10, mergedFile->GetExecutedLineCount());
+	}
+
+	//-------------------------------------------------------------------------
+	TEST(CoverageDataMergerTest, Accumulator)
+	{
+		cov::CoverageDataAccumulator coverageDataAccumulator;
+		auto coverageDatas = CreateCoverageDataCollection(3);
+
+		AddLine(coverageDatas[0], modulePath, "f2", { { 0, false }, { 1, true } });
+		AddLine(coverageDatas[1], modulePath, "f1", { { 2, true } });
+		AddLine(coverageDatas[2], modulePath, "f2", { { 0, true } });
+
+		for (auto& coverageData : coverageDatas)
+			coverageDataAccumulator.Add(std::move(coverageData));
+
+		const auto& files = coverageDataAccumulator.GetCoverageData().GetModules().at(0)->GetFiles();
+		ASSERT_EQ(2, files.size());
+		ASSERT_EQ(L"f1", files.at(0)->GetPath());
+		CheckLineHasBeenExecuted(files.at(1), 0, true);
+		CheckLineHasBeenExecuted(files.at(1), 1, true);
+	}
+
+	//-------------------------------------------------------------------------
+	TEST(CoverageDataMergerTest, AccumulatorMovesNewPaths)
+	{
+		cov::CoverageDataAccumulator coverageDataAccumulator;
+		auto coverageDatas = CreateCoverageDataCollection(3);
+
+		AddLine(coverageDatas[0], modulePath, "f1", { { 0, true } });
+		AddLine(coverageDatas[1], modulePath, "f2", { { 1, true } });
+		AddLine(coverageDatas[2], "otherModule", "f3", { { 2, true } });
+		const auto* module = coverageDatas[0].GetModules().at(0).get();
+		const auto* file2 = coverageDatas[1].GetModules().at(0)->GetFiles().at(0).get();
+		const auto* file3 = coverageDatas[2].GetModules().at(0)->GetFiles().at(0).get();
+
+		coverageDataAccumulator.Add(std::move(coverageDatas[0]));
+		ASSERT_EQ(module, coverageDataAccumulator.GetCoverageData().GetModules().at(0).get());
+		coverageDataAccumulator.Add(std::move(coverageDatas[1]));
+		coverageDataAccumulator.Add(std::move(coverageDatas[2]));
+
+		const auto& modules = coverageDataAccumulator.GetCoverageData().GetModules();
+		ASSERT_EQ(2u, modules.size());
+		ASSERT_EQ(file2, modules.at(0)->GetFiles().at(1).get());
+		ASSERT_EQ(file3, modules.at(1)->GetFiles().at(0).get());
+		ASSERT_EQ(2u, modules.at(0)->GetExecutedLineCount());
+	}
 }
\ No newline at end of file
@@ -0,0 +1,122 @@
+// OpenCppCoverage is an open source code coverage for C++.
+// Copyright (C) 2019 OpenCppCoverage
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "stdafx.h"
+
+#include <fstream>
+
+#include "CppCoverage/CoverageJournal.hpp"
+#include "CppCoverage/CppCoverageException.hpp"
+#include "CppCoverage/ExecutedAddressManager.hpp"
+#include "CppCoverage/Address.hpp"
+#include "Plugin/Exporter/CoverageData.hpp"
+#include "Plugin/Exporter/ModuleCoverage.hpp"
+#include "Plugin/Exporter/FileCoverage.hpp"
+#include "Plugin/Exporter/LineCoverage.hpp"
+
+#include "TestHelper/TemporaryPath.hpp"
+
+namespace cov = CppCoverage;
+
+namespace CppCoverageTest
+{
+	namespace
+	{
+		//---------------------------------------------------------------------
+		cov::Address CreateAddress(uintptr_t addressValue)
+		{
+			return cov::Address{ nullptr, reinterpret_cast<void*>(addressValue) };
+		}
+
+		//---------------------------------------------------------------------
+		void WriteJournal(const std::filesystem::path& path)
+		{
+			cov::ExecutedAddressManager manager;
+			cov::CoverageJournal coverageJournal{ path, L"Journal" };
+
+			manager.EnableLineChangeTracking();
+			manager.AddModule(L"Module", nullptr);
+			manager.RegisterAddress(CreateAddress(1), L"File", 1, 0);
+			manager.RegisterAddress(CreateAddress(2), L"File", 2, 0);
+			coverageJournal.Append(manager.TakeLineChanges());
+			manager.MarkAddressAsExecuted(CreateAddress(2));
+			coverageJournal.Append(manager.TakeLineChanges());
+		}
+	}
+
+	//-------------------------------------------------------------------------
+	TEST(CoverageJournalTest, Recover)
+	{
+		TestHelper::TemporaryPath path;
+		WriteJournal(path);
+
+		auto coverageData = cov::CoverageJournal::Recover(path);
+		ASSERT_EQ(L"Journal", coverageData.GetName());
+
+		const auto& modules = coverageData.GetModules();
+		ASSERT_EQ(1, modules.size());
+		ASSERT_EQ(L"Module", modules[0]->GetPath());
+
+		const auto& files = modules[0]->GetFiles();
+		ASSERT_EQ(1, files.size());
+		ASSERT_EQ(L"File", files[0]->GetPath());
+		ASSERT_FALSE((*files[0])[1]->HasBeenExecuted());
+		ASSERT_TRUE((*files[0])[2]->HasBeenExecuted());
+	}
+
+	//-------------------------------------------------------------------------
+	TEST(CoverageJournalTest, RecoverTruncated)
+	{
+		TestHelper::TemporaryPath path;
+		WriteJournal(path);
+
+		auto size = std::filesystem::file_size(path.GetPath());
+		std::filesystem::resize_file(path.GetPath(), size - 1);
+
+		auto coverageData = cov::CoverageJournal::Recover(path);
+		const auto& file = *coverageData.GetModules().at(0)->GetFiles().at(0);
+		ASSERT_FALSE(file[1]->HasBeenExecuted());
+		ASSERT_FALSE(file[2]->HasBeenExecuted());
+	}
+
+	//-------------------------------------------------------------------------
+	TEST(CoverageJournalTest, RecoverInvalidLineCount)
+	{
+		TestHelper::TemporaryPath path;
+		WriteJournal(path);
+
+		{
+			// Executed lines record with a line count larger than the file.
+			const unsigned char record[] = { 3, 0, 0, 0xFF, 0xFF, 0xFF, 0xFF, 0x0F };
+			std::ofstream ostr{ path.GetPath(), std::ios::binary | std::ios::app };
+			ostr.write(reinterpret_cast<const char*>(record), sizeof(record));
+		}
+
+		auto coverageData = cov::CoverageJournal::Recover(path);
+		const auto& file = *coverageData.GetModules().at(0)->GetFiles().at(0);
+		ASSERT_FALSE(file[1]->HasBeenExecuted());
+		ASSERT_TRUE(file[2]->HasBeenExecuted());
+	}
+
+	//-------------------------------------------------------------------------
+	TEST(CoverageJournalTest, InvalidJournal)
+	{
+		TestHelper::TemporaryPath path{ TestHelper::TemporaryPathOption::CreateAsFile };
+
+		ASSERT_THROW(cov::CoverageJournal::Recover(path), cov::CppCoverageException);
+	}
+}
@@ -0,0 +1,96 @@
+// OpenCppCoverage is an open source code coverage for C++.
+// Copyright (C) 2019 OpenCppCoverage
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "stdafx.h"
+
+#include "CppCoverage/CoverageSnapshot.hpp"
+#include "CppCoverage/ExecutedAddressManager.hpp"
+#include "CppCoverage/Address.hpp"
+#include "Plugin/Exporter/CoverageData.hpp"
+#include "Plugin/Exporter/ModuleCoverage.hpp"
+#include "Plugin/Exporter/FileCoverage.hpp"
+#include "Plugin/Exporter/LineCoverage.hpp"
+
+namespace cov = CppCoverage;
+
+namespace CppCoverageTest
+{
+	namespace
+	{
+		//---------------------------------------------------------------------
+		cov::Address CreateAddress(uintptr_t addressValue)
+		{
+			return cov::Address{ nullptr, reinterpret_cast<void*>(addressValue) };
+		}
+
+		//---------------------------------------------------------------------
+		std::vector<std::pair<unsigned int, bool>> GetLines(
+			const Plugin::CoverageData& coverageData)
+		{
+			std::vector<std::pair<unsigned int, bool>> lines;
+
+			for (const auto& module : coverageData.GetModules())
+			{
+				for (const auto& file : module->GetFiles())
+				{
+					for (const auto& line : file->GetLines())
+						lines.emplace_back(line.GetLineNumber(), line.HasBeenExecuted());
+				}
+			}
+			return lines;
+		}
+	}
+
+	//-------------------------------------------------------------------------
+	TEST(CoverageSnapshotTest, Take)
+	{
+		cov::ExecutedAddressManager manager;
+		std::vector<Plugin::CoverageData> snapshots;
+		{
+			cov::CoverageSnapshot coverageSnapshot{
+				L"Snapshot",
+				cov::SnapshotSettings{ boost::none, boost::none, L"" },
+				[&](Plugin::CoverageData&& coverageData) {
+					snapshots.push_back(std::move(coverageData));
+				} };
+
+			manager.EnableLineChangeTracking();
+			manager.AddModule(L"Module", nullptr);
+			manager.RegisterAddress(CreateAddress(1), L"File", 1, 0);
+			manager.RegisterAddress(CreateAddress(2), L"File", 2, 0);
+			coverageSnapshot.AddLineChanges(manager.TakeLineChanges());
+			manager.MarkAddressAsExecuted(CreateAddress(1));
+			coverageSnapshot.AddLineChanges(manager.TakeLineChanges());
+			coverageSnapshot.Take();
+
+			manager.MarkAddressAsExecuted(CreateAddress(2));
+			manager.MarkAddressAsExecuted(CreateAddress(1));
+			coverageSnapshot.AddLineChanges(manager.TakeLineChanges());
+			coverageSnapshot.Take();
+
+			// No change since the last snapshot.
+			coverageSnapshot.Take();
+		}
+
+		ASSERT_EQ(2, snapshots.size());
+		ASSERT_EQ(L"Snapshot", snapshots[0].GetName());
+		ASSERT_EQ((std::vector<std::pair<unsigned int, bool>>{ { 1, true }, { 2, false } }),
+			GetLines(snapshots[0]));
+		ASSERT_EQ((std::vector<std::pair<unsigned int, bool>>{ { 2, true } }),
+			GetLines(snapshots[1]));
+	}
+}
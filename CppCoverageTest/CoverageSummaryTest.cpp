@@ -0,0 +1,127 @@
+// OpenCppCoverage is an open source code coverage for C++.
+// Copyright (C) 2019 OpenCppCoverage
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "stdafx.h"
+
+#include <sstream>
+
+#include "CppCoverage/CoverageSummary.hpp"
+
+namespace cov = CppCoverage;
+
+namespace CppCoverageTest
+{
+	namespace
+	{
+		//---------------------------------------------------------------------
+		Tools::PathId Intern(const std::filesystem::path& path)
+		{
+			return Tools::PathInterner::GetInstance().Intern(path);
+		}
+
+		//---------------------------------------------------------------------
+		void CheckCoverageRate(
+			const cov::CoverageRate& coverageRate,
+			int executedLinesCount,
+			int unexecutedLinesCount)
+		{
+			ASSERT_EQ(executedLinesCount, coverageRate.GetExecutedLinesCount());
+			ASSERT_EQ(unexecutedLinesCount, coverageRate.GetUnExecutedLinesCount());
+		}
+	}
+
+	//-------------------------------------------------------------------------
+	TEST(CoverageSummaryTest, Merge)
+	{
+		auto module = Intern(L"Module.exe");
+		auto file = Intern(L"File.cpp");
+
+		cov::CoverageSummary coverageSummary{ 0 };
+		coverageSummary.AddFile(module, file, { { 1, true }, { 2, false }, { 3, false } });
+
+		cov::CoverageSummary otherCoverageSummary{ 42 };
+		otherCoverageSummary.AddFile(module, file, { { 2, true }, { 3, false }, { 4, false } });
+		coverageSummary.Merge(std::move(otherCoverageSummary));
+
+		CheckCoverageRate(coverageSummary.GetCoverageRate(), 2, 2);
+		ASSERT_EQ(42, coverageSummary.GetExitCode());
+
+		coverageSummary.Merge(cov::CoverageSummary{ 0 });
+		ASSERT_EQ(42, coverageSummary.GetExitCode());
+	}
+
+	//-------------------------------------------------------------------------
+	TEST(CoverageSummaryTest, SamePathWithDifferentCase)
+	{
+		cov::CoverageSummary coverageSummary;
+		coverageSummary.AddFile(Intern(L"Module.exe"), Intern(L"Dir/File.cpp"), { { 1, false } });
+		coverageSummary.AddFile(Intern(L"MODULE.exe"), Intern(L"dir\\file.cpp"), { { 1, true } });
+
+		auto moduleCoverageRates = coverageSummary.GetModuleCoverageRates();
+		ASSERT_EQ(1u, moduleCoverageRates.size());
+		CheckCoverageRate(moduleCoverageRates[0].coverageRate, 1, 0);
+	}
+
+	//-------------------------------------------------------------------------
+	TEST(CoverageSummaryTest, MergeFileCoverage)
+	{
+		auto module1 = Intern(L"Module1.exe");
+		auto module2 = Intern(L"Module2.exe");
+		auto header = Intern(L"Header.h");
+
+		cov::CoverageSummary coverageSummary;
+		coverageSummary.AddFile(module1, header, { { 1, true }, { 2, false } });
+		coverageSummary.AddFile(module1, Intern(L"File1.cpp"), { { 1, false } });
+		coverageSummary.AddFile(module2, header, { { 2, true } });
+
+		CheckCoverageRate(coverageSummary.GetCoverageRate(), 2, 2);
+		coverageSummary.MergeFileCoverage();
+
+		auto moduleCoverageRates = coverageSummary.GetModuleCoverageRates();
+		ASSERT_EQ(2u, moduleCoverageRates.size());
+		ASSERT_EQ(L"Module1.exe", moduleCoverageRates[0].path.wstring());
+		CheckCoverageRate(moduleCoverageRates[0].coverageRate, 2, 1);
+		ASSERT_EQ(L"Module2.exe", moduleCoverageRates[1].path.wstring());
+		CheckCoverageRate(moduleCoverageRates[1].coverageRate, 2, 0);
+	}
+
+	//-------------------------------------------------------------------------
+	TEST(CoverageSummaryTest, Write)
+	{
+		cov::CoverageSummary coverageSummary{ 1 };
+		coverageSummary.AddFile(Intern(L"C:\\Module.exe"), Intern(L"File.cpp"),
+			{ { 1, true }, { 2, false }, { 3, false } });
+
+		std::wostringstream text;
+		coverageSummary.WriteText(text);
+		ASSERT_EQ(L"C:\\Module.exe: 1/3 (33.33%)\nTotal: 1/3 (33.33%)\n", text.str());
+
+		std::ostringstream json;
+		coverageSummary.WriteJson(json);
+		ASSERT_EQ("{\"exitCode\":1,\"modules\":[{\"path\":\"C:\\\\Module.exe\","
+			"\"lineCount\":3,\"executedLineCount\":1,\"rate\":33.33}],"
+			"\"total\":{\"lineCount\":3,\"executedLineCount\":1,\"rate\":33.33}}", json.str());
+	}
+
+	//-------------------------------------------------------------------------
+	TEST(CoverageSummaryTest, Empty)
+	{
+		cov::CoverageSummary coverageSummary;
+
+		CheckCoverageRate(coverageSummary.GetCoverageRate(), 0, 0);
+		ASSERT_TRUE(coverageSummary.GetModuleCoverageRates().empty());
+	}
+}
@@ -52,9 +52,16 @@ namespace CppCoverageTest
 					lines_.push_back(line.lineNumber_);
 			}
 
+			//--------------------------------------------------------------------------
+			void OnFunction(unsigned long, const std::wstring& name) override
+			{
+				functionNames_.push_back(name);
+			}
+
 			const std::filesystem::path selectedFilename_;
 			std::filesystem::path selectedFullPath_;
 			std::vector<int> lines_;
+			std::vector<std::wstring> functionNames_;
 		};
 
 		//---------------------------------------------------------------------------
@@ -94,5 +101,8 @@ namespace CppCoverageTest
 		    debugInformationHandler.selectedFullPath_, L"@DebugInfoExpected");
 
 		ASSERT_EQ(debugInformationHandler.lines_, lineWithDebugInfo);
+		ASSERT_EQ(std::vector<std::wstring>{
+		              L"TestCoverageConsole::TestDebugInformationEnumerator"},
+		          debugInformationHandler.functionNames_);
 	}
 }
\ No newline at end of file
@@ -148,4 +148,22 @@ namespace CppCoverageTest
 		ASSERT_EQ(cov::ExceptionHandlerStatus::FirstChanceException,
 			handler_.HandleException(handle, exceptionDebugInfo, ostr_));
 	}
+
+	//-----------------------------------------------------------------------------
+	TEST_F(ExceptionHandlerTest, AttachedProcess)
+	{
+		cov::ExceptionHandler handler{ 2 };
+		auto exceptionDebugInfo = CreateExceptionDebugInfo();
+
+		ASSERT_EQ(cov::ExceptionHandlerStatus::FirstChanceException,
+			handler.HandleException(nullptr, exceptionDebugInfo, ostr_));
+		ASSERT_EQ(cov::ExceptionHandlerStatus::FirstChanceException,
+			handler.HandleException(nullptr, exceptionDebugInfo, ostr_));
+		ASSERT_EQ(cov::ExceptionHandlerStatus::BreakPoint,
+			handler.HandleException(nullptr, exceptionDebugInfo, ostr_));
+
+		handler.OnExitProcess(nullptr);
+		ASSERT_EQ(cov::ExceptionHandlerStatus::FirstChanceException,
+			handler.HandleException(nullptr, exceptionDebugInfo, ostr_));
+	}
 }
\ No newline at end of file
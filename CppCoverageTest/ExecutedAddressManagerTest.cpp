@@ -127,4 +127,80 @@ namespace CppCoverageTest
 		ASSERT_EQ(moduleName1, modules.at(0)->GetPath().wstring());
 		ASSERT_EQ(moduleName2, modules.at(1)->GetPath().wstring());
 	}
-}
\ No newline at end of file
+
+	//-------------------------------------------------------------------------
+	TEST(ExecutedAddressManagerTest, SpillFinishedModules)
+	{
+		cov::ExecutedAddressManager manager;
+		const std::wstring moduleName = L"module";
+		const std::wstring filename = L"filename";
+		auto address1 = CreateAddress(1);
+		auto address2 = CreateAddress(2);
+
+		manager.SetMemoryBudget(0);
+		manager.AddModule(moduleName, nullptr);
+		manager.RegisterAddress(address1, filename, 42, 0);
+		manager.RegisterAddress(address2, filename, 43, 0);
+		manager.MarkAddressAsExecuted(address1);
+		manager.OnUnloadModule(nullptr, nullptr);
+
+		// Load the module again: the coverage is merged with the spilled one.
+		manager.AddModule(moduleName, nullptr);
+		manager.RegisterAddress(address1, filename, 42, 0);
+		manager.RegisterAddress(address2, filename, 43, 0);
+		manager.MarkAddressAsExecuted(address2);
+
+		auto coverageData = manager.CreateCoverageData(L"", 0);
+		const auto& modules = coverageData.GetModules();
+		ASSERT_EQ(1, modules.size());
+		ASSERT_EQ(moduleName, modules.front()->GetPath());
+
+		const auto& files = modules.front()->GetFiles();
+		ASSERT_EQ(1, files.size());
+
+		const auto& file = *files.front();
+		ASSERT_EQ(filename, file.GetPath());
+		ASSERT_TRUE(file[42]->HasBeenExecuted());
+		ASSERT_TRUE(file[43]->HasBeenExecuted());
+	}
+
+	//-------------------------------------------------------------------------
+	TEST(ExecutedAddressManagerTest, Functions)
+	{
+		cov::ExecutedAddressManager manager;
+		const std::wstring filename = L"filename";
+		auto filenameId = Tools::PathInterner::GetInstance().Intern(filename);
+
+		manager.SetMemoryBudget(0);
+		manager.AddModule(L"module", nullptr);
+		manager.RegisterFunction(1, L"Function1");
+		manager.RegisterAddress(CreateAddress(1), filenameId, 10, 0);
+		manager.RegisterAddress(CreateAddress(2), filenameId, 12, 0);
+		manager.RegisterFunctionLine(filenameId, 1, 12);
+		manager.RegisterFunctionLine(filenameId, 1, 10);
+		manager.RegisterFunctionLine(filenameId, 2, 12);
+		manager.MarkAddressAsExecuted(CreateAddress(1));
+		manager.OnUnloadModule(nullptr, nullptr);
+
+		// The functions of the spilled module are merged.
+		manager.AddModule(L"module", nullptr);
+		manager.RegisterFunction(1, L"Function1");
+		manager.RegisterFunction(2, L"Function2");
+		manager.RegisterAddress(CreateAddress(3), filenameId, 20, 0);
+		manager.RegisterFunctionLine(filenameId, 2, 20);
+
+		auto coverageData = manager.CreateCoverageData(L"", 0);
+		const auto& file = *coverageData.GetModules().at(0)->GetFiles().at(0);
+		const auto functions = file.GetFunctions();
+
+		ASSERT_EQ(2, functions.size());
+		ASSERT_EQ(L"Function1", functions[0].GetName());
+		ASSERT_EQ(10, functions[0].GetFirstLineNumber());
+		ASSERT_EQ(12, functions[0].GetLastLineNumber());
+		ASSERT_EQ(2, functions[0].GetLineCount());
+		ASSERT_EQ(1, functions[0].GetExecutedLineCount());
+		ASSERT_EQ(L"Function2", functions[1].GetName());
+		ASSERT_EQ(20, functions[1].GetFirstLineNumber());
+		ASSERT_EQ(20, functions[1].GetLastLineNumber());
+	}
+}
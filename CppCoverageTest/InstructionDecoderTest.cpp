@@ -0,0 +1,197 @@
+// OpenCppCoverage is an open source code coverage for C++.
+// Copyright (C) 2019 OpenCppCoverage
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "stdafx.h"
+
+#include "CppCoverage/InstructionDecoder.hpp"
+
+namespace cov = CppCoverage;
+
+namespace CppCoverageTest
+{
+	namespace
+	{
+		using Kind = cov::InstructionDecoder::Kind;
+		using Mode = cov::InstructionDecoder::Mode;
+
+		const std::uint64_t Address = 0x1000;
+
+		//---------------------------------------------------------------------
+		cov::InstructionDecoder::Instruction Decode(
+			Mode mode,
+			const std::vector<unsigned char>& code)
+		{
+			return cov::InstructionDecoder{ mode }.Decode(code.data(), code.size(), Address);
+		}
+
+		//---------------------------------------------------------------------
+		void CheckLength(Mode mode, const std::vector<unsigned char>& code)
+		{
+			// A trailing NOP checks the decoder does not read too far.
+			auto codeWithNop = code;
+			codeWithNop.push_back(0x90);
+
+			auto instruction = Decode(mode, codeWithNop);
+			ASSERT_EQ(code.size(), instruction.length_);
+			ASSERT_EQ(Kind::Other, instruction.kind_);
+			ASSERT_FALSE(instruction.target_);
+		}
+	}
+
+	//-------------------------------------------------------------------------
+	TEST(InstructionDecoderTest, X64Length)
+	{
+		for (const auto& code : std::vector<std::vector<unsigned char>>{
+			{ 0x55 },                                                        // push rbp
+			{ 0x48, 0x89, 0x5C, 0x24, 0x08 },                                // mov [rsp+8], rbx
+			{ 0x48, 0x83, 0xEC, 0x20 },                                      // sub rsp, 20h
+			{ 0x48, 0x81, 0xEC, 0x00, 0x01, 0x00, 0x00 },                    // sub rsp, 100h
+			{ 0x48, 0x8B, 0x05, 0x11, 0x22, 0x33, 0x44 },                    // mov rax, [rip+disp32]
+			{ 0x48, 0xB8, 1, 2, 3, 4, 5, 6, 7, 8 },                          // mov rax, imm64
+			{ 0x48, 0xC7, 0xC0, 0x01, 0x00, 0x00, 0x00 },                    // mov rax, 1
+			{ 0x66, 0xB8, 0x34, 0x12 },                                      // mov ax, 1234h
+			{ 0x48, 0xA1, 1, 2, 3, 4, 5, 6, 7, 8 },                          // mov rax, [moffs64]
+			{ 0xC7, 0x44, 0x24, 0x10, 0x01, 0x00, 0x00, 0x00 },              // mov dword ptr [rsp+10h], 1
+			{ 0x8B, 0x84, 0x24, 0x00, 0x01, 0x00, 0x00 },                    // mov eax, [rsp+100h]
+			{ 0x66, 0x0F, 0x1F, 0x44, 0x00, 0x00 },                          // nop word ptr [rax+rax]
+			{ 0x0F, 0x1F, 0x80, 0x00, 0x00, 0x00, 0x00 },                    // nop dword ptr [rax]
+			{ 0xF6, 0xC1, 0x01 },                                            // test cl, 1
+			{ 0xF7, 0xC1, 0x01, 0x00, 0x00, 0x00 },                          // test ecx, 1
+			{ 0xF7, 0xD1 },                                                  // not ecx
+			{ 0x0F, 0xB6, 0xC1 },                                            // movzx eax, cl
+			{ 0x0F, 0x94, 0xC0 },                                            // sete al
+			{ 0xF3, 0x0F, 0x10, 0x05, 0x00, 0x00, 0x00, 0x00 },              // movss xmm0, [rip]
+			{ 0x66, 0x0F, 0x38, 0x00, 0xC1 },                                // pshufb xmm0, xmm1
+			{ 0x66, 0x0F, 0x3A, 0x0F, 0xC1, 0x08 },                          // palignr xmm0, xmm1, 8
+			{ 0x66, 0x0F, 0x70, 0xC1, 0x1B },                                // pshufd xmm0, xmm1, 1Bh
+			{ 0xF0, 0x0F, 0xB1, 0x0A },                                      // lock cmpxchg [rdx], ecx
+			{ 0xC5, 0xF8, 0x77 },                                            // vzeroupper
+			{ 0xC5, 0xFC, 0x10, 0x01 },                                      // vmovups ymm0, [rcx]
+			{ 0xC4, 0xE3, 0x79, 0x0F, 0xC1, 0x08 },                          // vpalignr xmm0, xmm0, xmm1, 8
+			{ 0x62, 0xF1, 0x7C, 0x48, 0x10, 0x44, 0x24, 0x01 },              // vmovups zmm0, [rsp+40h]
+			{ 0x62, 0xF3, 0x7D, 0x48, 0x0F, 0xC1, 0x08 } })                  // valignd zmm0, zmm0, zmm1, 8
+		{
+			CheckLength(Mode::X64, code);
+		}
+	}
+
+	//-------------------------------------------------------------------------
+	TEST(InstructionDecoderTest, X86Length)
+	{
+		for (const auto& code : std::vector<std::vector<unsigned char>>{
+			{ 0x40 },                                                        // inc eax
+			{ 0x8B, 0x45, 0x08 },                                            // mov eax, [ebp+8]
+			{ 0xA1, 0x00, 0x10, 0x00, 0x00 },                                // mov eax, [moffs32]
+			{ 0x67, 0x8B, 0x46, 0x02 },                                      // mov eax, [bp+2]
+			{ 0x67, 0x8B, 0x06, 0x34, 0x12 },                                // mov eax, [1234h]
+			{ 0xC4, 0x06 },                                                  // les eax, [esi]
+			{ 0xC5, 0xF8, 0x77 },                                            // vzeroupper
+			{ 0x62, 0x06 },                                                  // bound eax, [esi]
+			{ 0x60 } })                                                      // pushad
+		{
+			CheckLength(Mode::X86, code);
+		}
+	}
+
+	//-------------------------------------------------------------------------
+	TEST(InstructionDecoderTest, RelativeBranches)
+	{
+		struct Expected
+		{
+			std::vector<unsigned char> code;
+			Kind kind;
+			std::uint64_t target;
+		};
+
+		for (const auto& expected : std::vector<Expected>{
+			{ { 0xE8, 0x10, 0x00, 0x00, 0x00 }, Kind::Call, Address + 0x15 },
+			{ { 0xE9, 0x00, 0xFF, 0xFF, 0xFF }, Kind::Jump, Address + 5 - 0x100 },
+			{ { 0xEB, 0xFE }, Kind::Jump, Address },
+			{ { 0x74, 0xF0 }, Kind::ConditionalJump, Address + 2 - 0x10 },
+			{ { 0xE3, 0x02 }, Kind::ConditionalJump, Address + 4 },
+			{ { 0x0F, 0x84, 0x00, 0x01, 0x00, 0x00 }, Kind::ConditionalJump, Address + 0x106 },
+			{ { 0xC7, 0xF8, 0x10, 0x00, 0x00, 0x00 }, Kind::ConditionalJump, Address + 0x16 } })
+		{
+			for (auto mode : { Mode::X86, Mode::X64 })
+			{
+				auto instruction = Decode(mode, expected.code);
+				ASSERT_EQ(expected.code.size(), instruction.length_);
+				ASSERT_EQ(expected.kind, instruction.kind_);
+				ASSERT_TRUE(instruction.target_);
+				ASSERT_EQ(expected.target, *instruction.target_);
+			}
+		}
+	}
+
+	//-------------------------------------------------------------------------
+	TEST(InstructionDecoderTest, X86TargetWrapAround)
+	{
+		std::vector<unsigned char> code = { 0xE9, 0x00, 0x00, 0x00, 0x80 };
+
+		auto x86Instruction = Decode(Mode::X86, code);
+		ASSERT_EQ(std::uint64_t{ 0x80001005 }, x86Instruction.target_.get());
+
+		auto x64Instruction = Decode(Mode::X64, code);
+		ASSERT_EQ(std::uint64_t{ 0xFFFFFFFF80001005 }, x64Instruction.target_.get());
+	}
+
+	//-------------------------------------------------------------------------
+	TEST(InstructionDecoderTest, OtherControlTransfers)
+	{
+		struct Expected
+		{
+			std::vector<unsigned char> code;
+			Kind kind;
+		};
+
+		for (const auto& expected : std::vector<Expected>{
+			{ { 0xC3 }, Kind::Return },
+			{ { 0xC2, 0x08, 0x00 }, Kind::Return },
+			{ { 0xFF, 0xE0 }, Kind::IndirectJump },                                 // jmp rax
+			{ { 0xFF, 0x24, 0xC5, 0x00, 0x00, 0x00, 0x00 }, Kind::IndirectJump },   // jmp [rax*8+disp32]
+			{ { 0xFF, 0x15, 0x00, 0x00, 0x00, 0x00 }, Kind::Call },                 // call [rip]
+			{ { 0xFF, 0xD0 }, Kind::Call },                                         // call rax
+			{ { 0xCC }, Kind::Interrupt },
+			{ { 0xCD, 0x29 }, Kind::Interrupt },
+			{ { 0x0F, 0x0B }, Kind::Interrupt } })
+		{
+			auto instruction = Decode(Mode::X64, expected.code);
+			ASSERT_EQ(expected.code.size(), instruction.length_);
+			ASSERT_EQ(expected.kind, instruction.kind_);
+			ASSERT_FALSE(instruction.target_);
+			ASSERT_TRUE(cov::InstructionDecoder::IsControlTransfer(instruction.kind_));
+		}
+	}
+
+	//-------------------------------------------------------------------------
+	TEST(InstructionDecoderTest, Invalid)
+	{
+		std::vector<unsigned char> tooManyPrefixes(15, 0x66);
+		tooManyPrefixes.push_back(0x90);
+
+		for (const auto& code : std::vector<std::vector<unsigned char>>{
+			{},
+			{ 0x48 },
+			{ 0x06 },
+			{ 0xE8, 0x00 },
+			{ 0x8B, 0x84, 0x24 },
+			{ 0x0F, 0x04 },
+			tooManyPrefixes })
+		{
+			ASSERT_EQ(Kind::Invalid, Decode(Mode::X64, code).kind_);
+		}
+	}
+}
@@ -0,0 +1,97 @@
+// OpenCppCoverage is an open source code coverage for C++.
+// Copyright (C) 2019 OpenCppCoverage
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "stdafx.h"
+
+#include "CppCoverage/DebugInformationEnumerator.hpp"
+#include "CppCoverage/LineTableCache.hpp"
+#include "TestCoverageConsole/TestCoverageConsole.hpp"
+
+namespace CppCoverageTest
+{
+	namespace
+	{
+		struct DebugInformationHandlerMock
+		    : CppCoverage::IDebugInformationHandler
+		{
+			//--------------------------------------------------------------------------
+			bool IsSourceFileSelected(const std::filesystem::path& path) override
+			{
+				++selectionCount_;
+				return path.filename() == TestCoverageConsole::GetMainCppFilename();
+			}
+
+			//--------------------------------------------------------------------------
+			void OnSourceFile(const std::filesystem::path& path,
+			                  const std::vector<Line>& lines) override
+			{
+				paths_.push_back(path);
+				for (const auto& line : lines)
+					lines_.push_back(line.lineNumber_);
+			}
+
+			//--------------------------------------------------------------------------
+			void OnFunction(unsigned long, const std::wstring& name) override
+			{
+				functionNames_.push_back(name);
+			}
+
+			int selectionCount_ = 0;
+			std::vector<std::wstring> functionNames_;
+			std::vector<std::filesystem::path> paths_;
+			std::vector<unsigned long> lines_;
+		};
+	}
+
+	//-------------------------------------------------------------------------
+	TEST(LineTableCacheTest, Enumerate)
+	{
+		CppCoverage::LineTableCache lineTableCache;
+		CppCoverage::DebugInformationEnumerator debugInformationEnumerator{ {} };
+		auto binary = TestCoverageConsole::GetOutputBinaryPath();
+
+		DebugInformationHandlerMock handler;
+		ASSERT_TRUE(lineTableCache.Enumerate(binary, debugInformationEnumerator, handler));
+		ASSERT_LT(0, handler.selectionCount_);
+		ASSERT_EQ(1, handler.paths_.size());
+
+		DebugInformationHandlerMock cachedHandler;
+		ASSERT_TRUE(lineTableCache.Enumerate(binary, debugInformationEnumerator, cachedHandler));
+		ASSERT_EQ(0, cachedHandler.selectionCount_);
+		ASSERT_EQ(handler.paths_, cachedHandler.paths_);
+		ASSERT_EQ(handler.lines_, cachedHandler.lines_);
+		ASSERT_FALSE(handler.functionNames_.empty());
+		ASSERT_EQ(handler.functionNames_, cachedHandler.functionNames_);
+	}
+
+	//-------------------------------------------------------------------------
+	TEST(LineTableCacheTest, Clear)
+	{
+		CppCoverage::LineTableCache lineTableCache;
+		CppCoverage::DebugInformationEnumerator debugInformationEnumerator{ {} };
+		auto binary = TestCoverageConsole::GetOutputBinaryPath();
+
+		DebugInformationHandlerMock handler;
+		ASSERT_TRUE(lineTableCache.Enumerate(binary, debugInformationEnumerator, handler));
+		ASSERT_FALSE(debugInformationEnumerator.GetPdbPath().empty());
+
+		lineTableCache.Clear();
+		DebugInformationHandlerMock handlerAfterClear;
+		ASSERT_TRUE(lineTableCache.Enumerate(binary, debugInformationEnumerator, handlerAfterClear));
+		ASSERT_EQ(handler.selectionCount_, handlerAfterClear.selectionCount_);
+		ASSERT_EQ(handler.paths_, handlerAfterClear.paths_);
+	}
+}
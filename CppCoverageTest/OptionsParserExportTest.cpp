@@ -19,6 +19,7 @@
 #include "CppCoverage/OptionsParser.hpp"
 #include "CppCoverage/ExportOptionParser.hpp"
 #include "CppCoverage/OptionsExport.hpp"
+#include "CppCoverage/ProgramOptions.hpp"
 
 #include "CppCoverageTest/TestTools.hpp"
 
@@ -115,6 +116,22 @@ namespace CppCoverageTest
 		     MakeOptionExport(cov::OptionsExportType::Cobertura));
 	}
 
+	//-------------------------------------------------------------------------
+	TEST(OptionsParserExportTest, ExportTypesCoberturaDirectoryValue)
+	{
+		TestExportTypes(
+		    {cov::ExportOptionParser::ExportTypeCoberturaDirectoryValue},
+		     MakeOptionExport(cov::OptionsExportType::CoberturaDirectory));
+	}
+
+	//-------------------------------------------------------------------------
+	TEST(OptionsParserExportTest, ExportTypesLcovValue)
+	{
+		TestExportTypes(
+		    {cov::ExportOptionParser::ExportTypeLcovValue},
+		     MakeOptionExport(cov::OptionsExportType::Lcov));
+	}
+
 	//-------------------------------------------------------------------------
 	TEST(OptionsParserExportTest, ExportTypesBoth)
 	{
@@ -211,4 +228,18 @@ namespace CppCoverageTest
 		});
 		ASSERT_EQ(pluginArg, argument);
 	}
-}
\ No newline at end of file
+
+	//-------------------------------------------------------------------------
+	TEST(OptionsParserExportTest, ExportPluginModuleByModule)
+	{
+		std::vector<cov::ExportPluginDescription> exportPluginDescription;
+		exportPluginDescription.push_back(cov::ExportPluginDescription{
+			L"pluginName", L"", [](const auto&) {} });
+		auto parser = CreateOptionParser(std::move(exportPluginDescription));
+
+		ASSERT_FALSE(TestTools::Parse(*parser,
+			{ TestTools::GetOptionPrefix() + cov::ProgramOptions::ExportModuleByModuleOption,
+			  TestTools::GetOptionPrefix() + cov::ExportOptionParser::ExportTypeOption,
+			  "pluginName" }));
+	}
+}
@@ -0,0 +1,240 @@
+// OpenCppCoverage is an open source code coverage for C++.
+// Copyright (C) 2019 OpenCppCoverage
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "stdafx.h"
+
+#include "CppCoverage/OptionsParser.hpp"
+#include "CppCoverage/ProgramOptions.hpp"
+#include "CppCoverage/Subcommand.hpp"
+
+#include "CppCoverageTest/TestTools.hpp"
+
+#include "Tools/Tool.hpp"
+
+namespace cov = CppCoverage;
+
+namespace CppCoverageTest
+{
+	namespace
+	{
+		//---------------------------------------------------------------------
+		boost::optional<cov::Options> Parse(const std::vector<std::string>& arguments)
+		{
+			cov::OptionsParser parser;
+			std::wostringstream ostr;
+			auto options = TestTools::Parse(parser, arguments, false, &ostr);
+
+			if (!options && ostr.str().empty())
+				throw std::runtime_error("Expect error message.");
+			return options;
+		}
+
+		//---------------------------------------------------------------------
+		std::string GetOption(const std::string& option)
+		{
+			return TestTools::GetOptionPrefix() + option;
+		}
+
+		//---------------------------------------------------------------------
+		void CheckSubcommand(
+			const std::vector<std::string>& arguments,
+			cov::SubcommandType expectedType,
+			const std::vector<std::wstring>& expectedArguments)
+		{
+			auto options = Parse(arguments);
+
+			ASSERT_TRUE(static_cast<bool>(options));
+			const auto& subcommand = options->GetSubcommand();
+			ASSERT_TRUE(static_cast<bool>(subcommand));
+			ASSERT_EQ(expectedType, subcommand->GetType());
+			ASSERT_EQ(expectedArguments, subcommand->GetArguments());
+		}
+	}
+
+	//-------------------------------------------------------------------------
+	TEST(OptionsParserSubcommandTest, NoSubcommand)
+	{
+		cov::OptionsParser parser;
+		auto options = TestTools::Parse(parser, {});
+
+		ASSERT_TRUE(static_cast<bool>(options));
+		ASSERT_FALSE(options->GetSubcommand());
+		ASSERT_FALSE(options->GetDaemonClientPipeName());
+	}
+
+	//-------------------------------------------------------------------------
+	TEST(OptionsParserSubcommandTest, Help)
+	{
+		cov::OptionsParser parser;
+		std::wostringstream ostr;
+
+		ASSERT_FALSE(TestTools::Parse(parser, { GetOption(cov::ProgramOptions::HelpOption) }, false, &ostr));
+		for (const auto* option : { &cov::ProgramOptions::DaemonOption,
+			&cov::ProgramOptions::DaemonStopOption,
+			&cov::ProgramOptions::DaemonClientOption,
+			&cov::ProgramOptions::AggregationServerOption,
+			&cov::ProgramOptions::AggregationClientOption,
+			&cov::ProgramOptions::HistoryOption,
+			&cov::ProgramOptions::DiffOption,
+			&cov::ProgramOptions::QueryOption })
+		{
+			ASSERT_NE(std::wstring::npos, ostr.str().find(Tools::LocalToWString(GetOption(*option))));
+		}
+		ASSERT_EQ(std::wstring::npos, ostr.str().find(
+			Tools::LocalToWString(GetOption(cov::ProgramOptions::ExportPluginHostOption))));
+	}
+
+	//-------------------------------------------------------------------------
+	TEST(OptionsParserSubcommandTest, Daemon)
+	{
+		CheckSubcommand({ GetOption(cov::ProgramOptions::DaemonOption), "pipe" },
+			cov::SubcommandType::Daemon, { L"pipe" });
+		CheckSubcommand({ GetOption(cov::ProgramOptions::DaemonStopOption), "pipe" },
+			cov::SubcommandType::DaemonStop, { L"pipe" });
+		ASSERT_FALSE(Parse({ GetOption(cov::ProgramOptions::DaemonOption), "pipe1", "pipe2" }));
+	}
+
+	//-------------------------------------------------------------------------
+	TEST(OptionsParserSubcommandTest, AggregationServer)
+	{
+		CheckSubcommand({ GetOption(cov::ProgramOptions::AggregationServerOption), "pipe" },
+			cov::SubcommandType::AggregationServer, { L"pipe" });
+	}
+
+	//-------------------------------------------------------------------------
+	TEST(OptionsParserSubcommandTest, AggregationClient)
+	{
+		const auto clientOption = GetOption(cov::ProgramOptions::AggregationClientOption);
+		const auto type = cov::SubcommandType::AggregationClient;
+
+		CheckSubcommand({ clientOption, "pipe", "upload", "1.cov", "2.cov" }, type,
+			{ L"pipe", L"upload", L"1.cov", L"2.cov" });
+		CheckSubcommand({ clientOption, "pipe", "download", "1.cov" }, type, { L"pipe", L"download", L"1.cov" });
+		CheckSubcommand({ clientOption, "pipe", "summary" }, type, { L"pipe", L"summary" });
+		CheckSubcommand({ clientOption, "pipe", "stop" }, type, { L"pipe", L"stop" });
+
+		ASSERT_FALSE(Parse({ clientOption, "pipe" }));
+		ASSERT_FALSE(Parse({ clientOption, "pipe", "upload" }));
+		ASSERT_FALSE(Parse({ clientOption, "pipe", "download", "1.cov", "2.cov" }));
+		ASSERT_FALSE(Parse({ clientOption, "pipe", "summary", "1.cov" }));
+		ASSERT_FALSE(Parse({ clientOption, "pipe", "unknown" }));
+	}
+
+	//-------------------------------------------------------------------------
+	TEST(OptionsParserSubcommandTest, History)
+	{
+		const auto historyOption = GetOption(cov::ProgramOptions::HistoryOption);
+		const auto type = cov::SubcommandType::History;
+
+		CheckSubcommand({ historyOption, "folder", "add", "rev", "1.cov", "2.cov" }, type,
+			{ L"folder", L"add", L"rev", L"1.cov", L"2.cov" });
+		CheckSubcommand({ historyOption, "folder", "get", "rev", "1.cov" }, type,
+			{ L"folder", L"get", L"rev", L"1.cov" });
+		CheckSubcommand({ historyOption, "folder", "list" }, type, { L"folder", L"list" });
+		CheckSubcommand({ historyOption, "folder", "trend" }, type, { L"folder", L"trend" });
+		CheckSubcommand({ historyOption, "folder", "trend", "prefix" }, type,
+			{ L"folder", L"trend", L"prefix" });
+
+		ASSERT_FALSE(Parse({ historyOption, "folder" }));
+		ASSERT_FALSE(Parse({ historyOption, "folder", "add", "rev" }));
+		ASSERT_FALSE(Parse({ historyOption, "folder", "get", "rev" }));
+		ASSERT_FALSE(Parse({ historyOption, "folder", "list", "rev" }));
+		ASSERT_FALSE(Parse({ historyOption, "folder", "trend", "prefix1", "prefix2" }));
+		ASSERT_FALSE(Parse({ historyOption, "folder", "unknown" }));
+	}
+
+	//-------------------------------------------------------------------------
+	TEST(OptionsParserSubcommandTest, Diff)
+	{
+		const auto diffOption = GetOption(cov::ProgramOptions::DiffOption);
+		const auto type = cov::SubcommandType::Diff;
+
+		CheckSubcommand({ diffOption, "1.cov", "2.cov" }, type, { L"1.cov", L"2.cov" });
+		CheckSubcommand({ diffOption, "1.cov", "2.cov", "json" }, type, { L"1.cov", L"2.cov", L"json" });
+		CheckSubcommand({ diffOption, "1.cov", "2.cov", "html", "diff.html" }, type,
+			{ L"1.cov", L"2.cov", L"html", L"diff.html" });
+
+		ASSERT_FALSE(Parse({ diffOption, "1.cov" }));
+		ASSERT_FALSE(Parse({ diffOption, "1.cov", "2.cov", "xml" }));
+		ASSERT_FALSE(Parse({ diffOption, "1.cov", "2.cov", "text", "diff.txt", "other" }));
+	}
+
+	//-------------------------------------------------------------------------
+	TEST(OptionsParserSubcommandTest, Query)
+	{
+		const auto queryOption = GetOption(cov::ProgramOptions::QueryOption);
+		const auto type = cov::SubcommandType::Query;
+
+		CheckSubcommand({ queryOption, "1.cov", "line", "file.cpp", "42" }, type,
+			{ L"1.cov", L"line", L"file.cpp", L"42" });
+		CheckSubcommand({ queryOption, "1.cov", "prefix" }, type, { L"1.cov", L"prefix" });
+		CheckSubcommand({ queryOption, "1.cov", "prefix", "src" }, type, { L"1.cov", L"prefix", L"src" });
+		CheckSubcommand({ queryOption, "1.cov", "directory", "src" }, type,
+			{ L"1.cov", L"directory", L"src" });
+
+		ASSERT_FALSE(Parse({ queryOption, "1.cov" }));
+		ASSERT_FALSE(Parse({ queryOption, "1.cov", "line", "file.cpp" }));
+		ASSERT_FALSE(Parse({ queryOption, "1.cov", "line", "file.cpp", "line" }));
+		ASSERT_FALSE(Parse({ queryOption, "1.cov", "prefix", "src1", "src2" }));
+		ASSERT_FALSE(Parse({ queryOption, "1.cov", "directory" }));
+		ASSERT_FALSE(Parse({ queryOption, "1.cov", "unknown" }));
+	}
+
+	//-------------------------------------------------------------------------
+	TEST(OptionsParserSubcommandTest, ExportPluginHost)
+	{
+		CheckSubcommand({ GetOption(cov::ProgramOptions::ExportPluginHostOption), "sharedMemory" },
+			cov::SubcommandType::ExportPluginHost, { L"sharedMemory" });
+		ASSERT_FALSE(Parse({ GetOption(cov::ProgramOptions::ExportPluginHostOption), "sharedMemory1", "sharedMemory2" }));
+	}
+
+	//-------------------------------------------------------------------------
+	TEST(OptionsParserSubcommandTest, DaemonClient)
+	{
+		cov::OptionsParser parser;
+		auto options = TestTools::Parse(parser, 
+			{ GetOption(cov::ProgramOptions::DaemonClientOption), "pipe" });
+
+		ASSERT_TRUE(static_cast<bool>(options));
+		ASSERT_FALSE(options->GetSubcommand());
+		ASSERT_TRUE(static_cast<bool>(options->GetDaemonClientPipeName()));
+		ASSERT_EQ(L"pipe", *options->GetDaemonClientPipeName());
+
+		// The other options are checked before being sent to the daemon.
+		ASSERT_FALSE(Parse({ GetOption(cov::ProgramOptions::DaemonClientOption), "pipe" }));
+	}
+
+	//-------------------------------------------------------------------------
+	TEST(OptionsParserSubcommandTest, LogLevel)
+	{
+		auto options = Parse({ GetOption(cov::ProgramOptions::VerboseOption),
+			GetOption(cov::ProgramOptions::DaemonOption), "pipe" });
+
+		ASSERT_TRUE(static_cast<bool>(options));
+		ASSERT_EQ(cov::LogLevel::Verbose, options->GetLogLevel());
+		ASSERT_TRUE(static_cast<bool>(options->GetSubcommand()));
+	}
+
+	//-------------------------------------------------------------------------
+	TEST(OptionsParserSubcommandTest, OtherOptions)
+	{
+		const auto daemonOption = GetOption(cov::ProgramOptions::DaemonOption);
+
+		ASSERT_FALSE(Parse({ GetOption(cov::ProgramOptions::CoverChildrenOption), daemonOption, "pipe" }));
+		ASSERT_FALSE(Parse({ daemonOption, "pipe", "--", TestTools::GetProgramToRun() }));
+		ASSERT_FALSE(Parse({ daemonOption, "pipe", GetOption(cov::ProgramOptions::DaemonStopOption), "pipe" }));
+	}
+}
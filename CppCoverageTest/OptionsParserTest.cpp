@@ -45,11 +45,24 @@ namespace CppCoverageTest
 		ASSERT_EQ(cov::LogLevel::Normal, options->GetLogLevel());
 		ASSERT_FALSE(options->IsPlugingModeEnabled());
 		ASSERT_FALSE(options->IsCoverChildrenModeEnabled());
+		ASSERT_FALSE(options->IsCoverChildrenInParallelModeEnabled());
 		ASSERT_TRUE(options->IsAggregateByFileModeEnabled());
 		ASSERT_FALSE(options->IsContinueAfterCppExceptionModeEnabled());
 		ASSERT_FALSE(options->IsOptimizedBuildSupportEnabled());
+		ASSERT_FALSE(options->IsBasicBlockBreakPointsEnabled());
+		ASSERT_FALSE(options->IsExportPluginOutOfProcessEnabled());
+		ASSERT_FALSE(options->IsExportModuleByModuleEnabled());
+		ASSERT_FALSE(options->GetCoverageMemoryBudget());
+		ASSERT_FALSE(options->GetSnapshotSettings());
+		ASSERT_FALSE(options->GetCoverageJournalPath());
+		ASSERT_TRUE(options->GetInputCoverageJournalPaths().empty());
+		ASSERT_TRUE(options->GetBatchStartInfos().empty());
+		ASSERT_FALSE(options->GetBatchJobCount());
 		ASSERT_TRUE(options->GetExcludedLineRegexes().empty());
 		ASSERT_TRUE(options->GetSubstitutePdbSourcePaths().empty());
+		ASSERT_FALSE(options->IsSummaryOnlyEnabled());
+		ASSERT_FALSE(options->GetSummaryOutputPath());
+		ASSERT_FALSE(options->GetSummaryThreshold());
 	}
 
 	//-------------------------------------------------------------------------
@@ -106,6 +119,19 @@ namespace CppCoverageTest
 			{ TestTools::GetOptionPrefix() + cov::ProgramOptions::CoverChildrenOption })->IsCoverChildrenModeEnabled());
 	}
 
+	//-------------------------------------------------------------------------
+	TEST(OptionsParserTest, CoverChildrenInParallel)
+	{
+		cov::OptionsParser parser;
+		const auto prefix = TestTools::GetOptionPrefix();
+
+		ASSERT_TRUE(TestTools::Parse(parser,
+			{ prefix + cov::ProgramOptions::CoverChildrenOption,
+			  prefix + cov::ProgramOptions::CoverChildrenInParallelOption })->IsCoverChildrenInParallelModeEnabled());
+		ASSERT_FALSE(TestTools::Parse(parser,
+			{ prefix + cov::ProgramOptions::CoverChildrenInParallelOption }));
+	}
+
 	//-------------------------------------------------------------------------
 	TEST(OptionsParserTest, FileAggregate)
 	{
@@ -135,6 +161,74 @@ namespace CppCoverageTest
 			->IsStopOnAssertModeEnabled());
 	}
 
+	//-------------------------------------------------------------------------
+	TEST(OptionsParserTest, ExportPluginOutOfProcess)
+	{
+		cov::OptionsParser parser;
+
+		ASSERT_TRUE(TestTools::Parse(parser,
+			{ TestTools::GetOptionPrefix() + cov::ProgramOptions::ExportPluginOutOfProcessOption })
+			->IsExportPluginOutOfProcessEnabled());
+	}
+
+	//-------------------------------------------------------------------------
+	TEST(OptionsParserTest, ExportPluginTimeout)
+	{
+		cov::OptionsParser parser;
+		const auto outOfProcessOption = TestTools::GetOptionPrefix() + cov::ProgramOptions::ExportPluginOutOfProcessOption;
+		const auto timeoutOption = TestTools::GetOptionPrefix() + cov::ProgramOptions::ExportPluginTimeoutOption;
+
+		ASSERT_FALSE(TestTools::Parse(parser, {})->GetExportPluginTimeout());
+		ASSERT_EQ(60u, *TestTools::Parse(parser, { outOfProcessOption, timeoutOption, "60" })
+			->GetExportPluginTimeout());
+		ASSERT_FALSE(TestTools::Parse(parser, { timeoutOption, "60" }));
+		ASSERT_FALSE(TestTools::Parse(parser, { outOfProcessOption, timeoutOption, "0" }));
+	}
+
+	//-------------------------------------------------------------------------
+	TEST(OptionsParserTest, ExportModuleByModule)
+	{
+		cov::OptionsParser parser;
+
+		ASSERT_TRUE(TestTools::Parse(parser,
+			{ TestTools::GetOptionPrefix() + cov::ProgramOptions::ExportModuleByModuleOption })
+			->IsExportModuleByModuleEnabled());
+	}
+
+	//-------------------------------------------------------------------------
+	TEST(OptionsParserTest, CoverageMemoryBudget)
+	{
+		cov::OptionsParser parser;
+
+		auto options = TestTools::Parse(parser,
+			{ TestTools::GetOptionPrefix() + cov::ProgramOptions::CoverageMemoryBudgetOption, "512" });
+		auto coverageMemoryBudget = options->GetCoverageMemoryBudget();
+		ASSERT_TRUE(coverageMemoryBudget);
+		ASSERT_EQ(512u, *coverageMemoryBudget);
+	}
+
+	//-------------------------------------------------------------------------
+	TEST(OptionsParserTest, Snapshot)
+	{
+		cov::OptionsParser parser;
+		const auto prefix = TestTools::GetOptionPrefix();
+
+		auto options = TestTools::Parse(parser,
+			{ prefix + cov::ProgramOptions::SnapshotIntervalOption, "60",
+			  prefix + cov::ProgramOptions::SnapshotTriggerFileOption, "Trigger" });
+		const auto& snapshotSettings = options->GetSnapshotSettings();
+		ASSERT_TRUE(snapshotSettings);
+		ASSERT_EQ(std::chrono::seconds{ 60 }, *snapshotSettings->GetInterval());
+		ASSERT_EQ(std::filesystem::path{ "Trigger" }, *snapshotSettings->GetTriggerFile());
+		ASSERT_EQ(std::filesystem::path{ cov::ProgramOptions::SnapshotDirectoryDefaultValue },
+			snapshotSettings->GetDirectory());
+
+		ASSERT_FALSE(TestTools::Parse(parser,
+			{ prefix + cov::ProgramOptions::SnapshotIntervalOption, "0" }));
+		ASSERT_FALSE(TestTools::Parse(parser,
+			{ prefix + cov::ProgramOptions::SnapshotDirectoryOption, "Snapshots" }));
+	}
+
 	//-------------------------------------------------------------------------
 	TEST(OptionsParserTest, DumpOnCrash)
 	{
@@ -231,6 +325,52 @@ namespace CppCoverageTest
 		ASSERT_EQ(pathStr, options->GetInputCoveragePaths().at(0).string());
 	}
 
+	//-------------------------------------------------------------------------
+	TEST(OptionsParserTest, CoverageJournal)
+	{
+		cov::OptionsParser parser;
+		const auto prefix = TestTools::GetOptionPrefix();
+		TestHelper::TemporaryPath temporaryPath{ TestHelper::TemporaryPathOption::CreateAsFile };
+		auto pathStr = temporaryPath.GetPath().string();
+
+		auto options = TestTools::Parse(parser,
+			{ prefix + cov::ProgramOptions::CoverageJournalOption, "Journal" });
+		ASSERT_EQ(std::filesystem::path{ "Journal" }, *options->GetCoverageJournalPath());
+
+		auto recoverOptions = TestTools::Parse(parser,
+			{ prefix + cov::ProgramOptions::InputCoverageJournalOption, pathStr }, false);
+		ASSERT_TRUE(static_cast<bool>(recoverOptions));
+		ASSERT_EQ(pathStr, recoverOptions->GetInputCoverageJournalPaths().at(0).string());
+	}
+
+	//-------------------------------------------------------------------------
+	TEST(OptionsParserTest, BatchCommand)
+	{
+		cov::OptionsParser parser;
+		const auto prefix = TestTools::GetOptionPrefix();
+
+		auto options = TestTools::Parse(parser,
+			{ prefix + cov::ProgramOptions::BatchCommandOption, "Test1.exe",
+			  prefix + cov::ProgramOptions::BatchCommandOption, "\"Test 2.exe\" arg1 \"arg 2\"",
+			  prefix + cov::ProgramOptions::BatchJobsOption, "4" }, false);
+		ASSERT_TRUE(static_cast<bool>(options));
+
+		const auto& startInfos = options->GetBatchStartInfos();
+		ASSERT_EQ(2, startInfos.size());
+		ASSERT_EQ(std::filesystem::path{ "Test1.exe" }, startInfos[0].GetPath());
+		ASSERT_EQ((std::vector<std::wstring>{ L"Test1.exe" }), startInfos[0].GetArguments());
+		ASSERT_EQ(std::filesystem::path{ "Test 2.exe" }, startInfos[1].GetPath());
+		ASSERT_EQ((std::vector<std::wstring>{ L"Test 2.exe", L"arg1", L"arg 2" }),
+			startInfos[1].GetArguments());
+		ASSERT_EQ(4, *options->GetBatchJobCount());
+
+		ASSERT_FALSE(TestTools::Parse(parser,
+			{ prefix + cov::ProgramOptions::BatchJobsOption, "4" }));
+		ASSERT_FALSE(TestTools::Parse(parser,
+			{ prefix + cov::ProgramOptions::BatchCommandOption, "Test1.exe",
+			  prefix + cov::ProgramOptions::BatchJobsOption, "0" }, false));
+	}
+
 	//-------------------------------------------------------------------------
 	TEST(OptionsParserTest, InvalidInputCoverage)
 	{
@@ -251,6 +391,43 @@ namespace CppCoverageTest
 			->IsOptimizedBuildSupportEnabled());
 	}
 
+	//-------------------------------------------------------------------------
+	TEST(OptionsParserTest, BasicBlockBreakPoints)
+	{
+		cov::OptionsParser parser;
+
+		ASSERT_TRUE(TestTools::Parse(parser,
+			{ TestTools::GetOptionPrefix() + cov::ProgramOptions::BasicBlockBreakPointsOption })
+			->IsBasicBlockBreakPointsEnabled());
+	}
+
+	//-------------------------------------------------------------------------
+	TEST(OptionsParserTest, SummaryOnly)
+	{
+		cov::OptionsParser parser;
+		const auto prefix = TestTools::GetOptionPrefix();
+
+		auto options = TestTools::Parse(parser,
+			{ prefix + cov::ProgramOptions::SummaryOnlyOption,
+			  prefix + cov::ProgramOptions::SummaryOutputOption, "Summary.json",
+			  prefix + cov::ProgramOptions::SummaryThresholdOption, "80" });
+		ASSERT_TRUE(static_cast<bool>(options));
+		ASSERT_TRUE(options->IsSummaryOnlyEnabled());
+		ASSERT_EQ(std::filesystem::path{ "Summary.json" }, *options->GetSummaryOutputPath());
+		ASSERT_EQ(80, *options->GetSummaryThreshold());
+
+		ASSERT_FALSE(TestTools::Parse(parser,
+			{ prefix + cov::ProgramOptions::SummaryThresholdOption, "80" }));
+		ASSERT_FALSE(TestTools::Parse(parser,
+			{ prefix + cov::ProgramOptions::SummaryOutputOption, "Summary.json" }));
+		ASSERT_FALSE(TestTools::Parse(parser,
+			{ prefix + cov::ProgramOptions::SummaryOnlyOption,
+			  prefix + cov::ProgramOptions::SummaryThresholdOption, "101" }));
+		ASSERT_FALSE(TestTools::Parse(parser,
+			{ prefix + cov::ProgramOptions::SummaryOnlyOption,
+			  prefix + cov::ProgramOptions::ExportModuleByModuleOption }));
+	}
+
 	//-------------------------------------------------------------------------
 	TEST(OptionsParserTest, ExcludedLineRegex)
 	{
@@ -24,6 +24,7 @@
 #include "CppCoverage/Debugger.hpp"
 #include "CppCoverage/IDebugEventsHandler.hpp"
 #include "CppCoverage/CodeCoverageRunner.hpp"
+#include "CppCoverage/CoverageSummary.hpp"
 #include "CppCoverage/CoverageFilterSettings.hpp"
 #include "CppCoverage/RunCoverageSettings.hpp"
 
@@ -113,11 +114,9 @@ namespace CppCoverageTest
 		}
 
 		//---------------------------------------------------------------------
-		Plugin::CoverageData ComputeCoverageDataPatterns(
+		std::unique_ptr<cov::RunCoverageSettings> CreateRunCoverageSettings(
 			const CoverageArgs& args)
 		{
-			cov::CodeCoverageRunner codeCoverageRunner{
-				std::make_shared<Tools::WarningManager>() };
 			cov::Patterns modulePatterns{ false };
 			cov::Patterns sourcePatterns{ false };
 
@@ -139,20 +138,71 @@ namespace CppCoverageTest
 			for (const auto& argument : args.arguments_)
 				startInfo.AddArgument(argument);
 
-			cov::RunCoverageSettings settings(
+			auto settings = std::make_unique<cov::RunCoverageSettings>(
 				startInfo,
 				coverageFilterSettings,
 				args.unifiedDiffSettingsCollection_,
 				args.excludedLineRegexes_,
 				args.substitutePdbSourcePath_);
-			settings.SetCoverChildren(args.coverChildren_);
-			settings.SetContinueAfterCppException(args.continueAfterCppException_);
-			settings.SetOptimizedBuildSupport(args.optimizedBuildSupport_);
+			settings->SetCoverChildren(args.coverChildren_);
+			settings->SetCoverChildrenInParallel(args.coverChildrenInParallel_);
+			settings->SetContinueAfterCppException(args.continueAfterCppException_);
+			settings->SetOptimizedBuildSupport(args.optimizedBuildSupport_);
+			settings->SetBasicBlockBreakPoints(args.basicBlockBreakPoints_);
+
+			return settings;
+		}
+
+		//---------------------------------------------------------------------
+		Plugin::CoverageData ComputeCoverageDataPatterns(
+			const CoverageArgs& args)
+		{
+			cov::CodeCoverageRunner codeCoverageRunner{
+				std::make_shared<Tools::WarningManager>() };
+			auto settings = CreateRunCoverageSettings(args);
 
-			auto coverageData = codeCoverageRunner.RunCoverage(settings);
+			auto coverageData = codeCoverageRunner.RunCoverage(*settings);
 
 			return coverageData;
 		}
+
+		//---------------------------------------------------------------------
+		cov::CoverageSummary ComputeCoverageSummary(const CoverageArgs& args)
+		{
+			cov::CodeCoverageRunner codeCoverageRunner{
+				std::make_shared<Tools::WarningManager>() };
+			auto settings = CreateRunCoverageSettings(args);
+
+			return codeCoverageRunner.RunCoverageSummary(
+				*settings, { settings->GetStartInfo() }, 1);
+		}
+
+		//---------------------------------------------------------------------
+		std::vector<Plugin::CoverageData> ComputeBatchCoverageData(
+			const CoverageArgs& args,
+			const std::vector<std::vector<std::wstring>>& argumentsCollection,
+			size_t jobCount)
+		{
+			cov::CodeCoverageRunner codeCoverageRunner{
+				std::make_shared<Tools::WarningManager>() };
+			auto settings = CreateRunCoverageSettings(args);
+			std::vector<cov::StartInfo> startInfos;
+
+			for (const auto& arguments : argumentsCollection)
+			{
+				cov::StartInfo startInfo{ args.programToRun_ };
+				for (const auto& argument : arguments)
+					startInfo.AddArgument(argument);
+				startInfos.push_back(startInfo);
+			}
+
+			std::vector<Plugin::CoverageData> coverageDatas;
+			codeCoverageRunner.RunCoverage(*settings, startInfos, jobCount,
+				[&](Plugin::CoverageData&& coverageData) {
+					coverageDatas.push_back(std::move(coverageData));
+				});
+
+			return coverageDatas;
+		}
 	}
 }
-
@@ -31,6 +31,12 @@ namespace Plugin
 	class CoverageData;
 }
 
+namespace CppCoverage
+{
+	class CoverageSummary;
+	class RunCoverageSettings;
+}
+
 namespace CppCoverageTest
 {
 	namespace TestTools
@@ -62,8 +68,10 @@ namespace CppCoverageTest
 			std::vector<std::wstring> sourcePatternCollection_;
 			std::vector<CppCoverage::UnifiedDiffSettings> unifiedDiffSettingsCollection_;
 			bool coverChildren_ = true;
+			bool coverChildrenInParallel_ = false;
 			bool continueAfterCppException_ = false;
 			bool optimizedBuildSupport_ = false;
+			bool basicBlockBreakPoints_ = false;
 			std::vector<std::wstring> excludedLineRegexes_;
 			std::vector<CppCoverage::SubstitutePdbSourcePath> substitutePdbSourcePath_;
 		};
@@ -74,8 +82,21 @@ namespace CppCoverageTest
 			const std::wstring& modulePattern,
 			const std::wstring& sourcePattern);
 
+		//---------------------------------------------------------------------
+		std::unique_ptr<CppCoverage::RunCoverageSettings> CreateRunCoverageSettings(
+			const CoverageArgs& args);
+
 		//---------------------------------------------------------------------
 		Plugin::CoverageData ComputeCoverageDataPatterns(const CoverageArgs& args);
+
+		//---------------------------------------------------------------------
+		CppCoverage::CoverageSummary ComputeCoverageSummary(const CoverageArgs& args);
+
+		//---------------------------------------------------------------------
+		std::vector<Plugin::CoverageData> ComputeBatchCoverageData(
+			const CoverageArgs& args,
+			const std::vector<std::vector<std::wstring>>& argumentsCollection,
+			size_t jobCount);
 	}
 }
 
@@ -23,10 +23,20 @@
 
 #include "CoverageDataSerializer.hpp"
 
+#include "Plugin/Exporter/CoverageData.hpp"
+#include "Plugin/Exporter/ModuleCoverage.hpp"
+
+#include "../ExporterException.hpp"
 #include "Tools/Tool.hpp"
 
 namespace Exporter
 {
+	//-------------------------------------------------------------------------
+	BinaryExporter::BinaryExporter() = default;
+
+	//-------------------------------------------------------------------------
+	BinaryExporter::~BinaryExporter() = default;
+
 	//-------------------------------------------------------------------------
 	std::filesystem::path BinaryExporter::GetDefaultPath(const std::wstring& prefix) const
 	{
@@ -47,4 +57,34 @@ namespace Exporter
 		coverageDataSerializer.Serialize(coverageData, output);
 		Tools::ShowOutputMessage(L"Coverage binary generated in file: ", output);
 	}
+
+	//-------------------------------------------------------------------------
+	void BinaryExporter::BeginExport(
+		const Plugin::CoverageData& coverageData,
+		size_t moduleCount,
+		const std::filesystem::path& output)
+	{
+		moduleSerializer_ = std::make_unique<CoverageDataModuleSerializer>(
+			coverageData, moduleCount, output);
+		moduleExportOutput_ = output;
+	}
+
+	//-------------------------------------------------------------------------
+	void BinaryExporter::ExportModule(const Plugin::CoverageData& coverageData)
+	{
+		if (!moduleSerializer_)
+			THROW(L"BeginExport was not called.");
+		for (const auto& module : coverageData.GetModules())
+			moduleSerializer_->Serialize(*module);
+	}
+
+	//-------------------------------------------------------------------------
+	void BinaryExporter::EndExport()
+	{
+		if (!moduleSerializer_)
+			THROW(L"BeginExport was not called.");
+		auto moduleSerializer = std::move(moduleSerializer_);
+		moduleSerializer->Close();
+		Tools::ShowOutputMessage(L"Coverage binary generated in file: ", moduleExportOutput_);
+	}
 }
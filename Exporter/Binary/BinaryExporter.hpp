@@ -16,22 +16,38 @@
 
 #pragma once
 
+#include <memory>
+
 #include "../ExporterExport.hpp"
 #include "../IExporter.hpp"
+#include "../IModuleExporter.hpp"
 
 namespace Exporter
 {
-	class EXPORTER_DLL BinaryExporter : public IExporter
+	class CoverageDataModuleSerializer;
+
+	class EXPORTER_DLL BinaryExporter : public IExporter, public IModuleExporter
 	{
 	public:
-		BinaryExporter() = default;
+		BinaryExporter();
+		~BinaryExporter();
 
 		std::filesystem::path GetDefaultPath(const std::wstring& prefix) const override;
 		void Export(const Plugin::CoverageData&, const std::filesystem::path& output) override;
 
+		void BeginExport(
+			const Plugin::CoverageData&,
+			size_t moduleCount,
+			const std::filesystem::path& output) override;
+		void ExportModule(const Plugin::CoverageData&) override;
+		void EndExport() override;
+
 	private:
 		BinaryExporter(const BinaryExporter&) = delete;
 		BinaryExporter& operator=(const BinaryExporter&) = delete;
+
+		std::unique_ptr<CoverageDataModuleSerializer> moduleSerializer_;
+		std::filesystem::path moduleExportOutput_;
 	};
 }
 
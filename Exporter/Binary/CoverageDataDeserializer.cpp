@@ -20,7 +20,9 @@
 #include <fstream>
 
 #include "CoverageData.pb.hpp"
+#include <google/protobuf/wire_format_lite.h>
 
+#include "Plugin/Exporter/CoverageArena.hpp"
 #include "Plugin/Exporter/CoverageData.hpp"
 #include "Plugin/Exporter/ModuleCoverage.hpp"
 #include "Plugin/Exporter/FileCoverage.hpp"
@@ -55,6 +57,33 @@ namespace Exporter
 			input.PopLimit(limit);
 		}
 
+		//---------------------------------------------------------------------
+		void InitModuleFrom(
+			const pb::ModuleCoverage& moduleProtoBuff,
+			Plugin::ModuleCoverage& module)
+		{
+			for (const auto& fileProtoBuff : moduleProtoBuff.files())
+			{
+				auto& file = module.AddFile(Tools::Utf8ToWString(fileProtoBuff.path()));
+
+				for (const auto& line : fileProtoBuff.lines())
+					file.AddLine(line.linenumber(), line.hasbeenexecuted());
+
+				const auto& functionNames = fileProtoBuff.functionnames();
+				for (const auto& function : fileProtoBuff.functions())
+				{
+					auto nameOffset = function.nameoffset();
+					if (nameOffset >= functionNames.size())
+						THROW(L"Invalid function name offset for " << file.GetPath().wstring());
+					file.AddFunction(
+						function.symbolid(),
+						Tools::Utf8ToWString(functionNames.c_str() + nameOffset),
+						function.firstlinenumber(),
+						function.lastlinenumber());
+				}
+			}
+		}
+
 		//---------------------------------------------------------------------
 		void InitCoverageDataFrom(
 			google::protobuf::io::CodedInputStream&  input,
@@ -69,41 +98,108 @@ namespace Exporter
 
 				ReadMessage(input, moduleProtoBuff);				
 				auto& module = coverageData.AddModule(Tools::Utf8ToWString(moduleProtoBuff.path()));
+				InitModuleFrom(moduleProtoBuff, module);
+			}
+		}		
 
-				for (const auto& fileProtoBuff : moduleProtoBuff.files())
-				{
-					auto& file = module.AddFile(Tools::Utf8ToWString(fileProtoBuff.path()));
+		//---------------------------------------------------------------------
+		std::unique_ptr<Plugin::ModuleCoverage> ReadModule(
+			google::protobuf::io::CodedInputStream& input)
+		{
+			pb::ModuleCoverage moduleProtoBuff;
+
+			ReadMessage(input, moduleProtoBuff);
+			auto module = std::make_unique<Plugin::ModuleCoverage>(
+				Tools::Utf8ToWString(moduleProtoBuff.path()));
+			InitModuleFrom(moduleProtoBuff, *module);
+
+			return module;
+		}
+
+		//---------------------------------------------------------------------
+		std::filesystem::path ReadModulePath(
+			google::protobuf::io::CodedInputStream& input)
+		{
+			using WireFormat = google::protobuf::internal::WireFormatLite;
+			const int pathFieldNumber = pb::ModuleCoverage::kPathFieldNumber;
+			unsigned int size = 0;
+			std::string path;
+
+			if (!input.ReadVarint32(&size))
+				THROW(L"Cannot read message size.");
+			auto limit = input.PushLimit(size);
 
-					for (const auto& line : fileProtoBuff.lines())
-						file.AddLine(line.linenumber(), line.hasbeenexecuted());
+			while (auto tag = input.ReadTag())
+			{
+				if (WireFormat::GetTagFieldNumber(tag) == pathFieldNumber)
+				{
+					if (!WireFormat::ReadString(&input, &path))
+						THROW(L"Cannot parse module path.");
 				}
+				else if (!WireFormat::SkipField(&input, tag))
+					THROW(L"Cannot parse message.");
 			}
-		}		
+			if (!input.ConsumedEntireMessage())
+				THROW(L"Cannot parse message.");
+			input.PopLimit(limit);
+
+			return Tools::Utf8ToWString(path);
+		}
 
 		//-------------------------------------------------------------------------
-		Plugin::CoverageData DeserializeFromStream(
-			std::istream& istr,
-			const std::string& errorIfNotCorrectFormat)
+		Plugin::CoverageData ReadCoverageDataHeader(
+			google::protobuf::io::CodedInputStream& codedInputStream,
+			const std::string& errorIfNotCorrectFormat,
+			pb::CoverageData& coverageDataProtoBuff)
 		{
-			google::protobuf::io::IstreamInputStream outputStream(&istr);
-			google::protobuf::io::CodedInputStream  codedInputStream(&outputStream);
-
 			unsigned int fileTypeId;
 			if (!codedInputStream.ReadVarint32(&fileTypeId) || fileTypeId != CoverageDataSerializer::FileTypeId)
 				throw std::runtime_error(errorIfNotCorrectFormat);
 
-			pb::CoverageData coverageDataProtoBuff;
-
 			ReadMessage(codedInputStream, coverageDataProtoBuff);
 
-			Plugin::CoverageData coverageData{
+			return Plugin::CoverageArena::CreateCoverageData(
 				Tools::Utf8ToWString(coverageDataProtoBuff.name()),
-				coverageDataProtoBuff.exitcode() };
+				coverageDataProtoBuff.exitcode());
+		}
 
-			InitCoverageDataFrom(codedInputStream, coverageDataProtoBuff, coverageData);
+		//-------------------------------------------------------------------------
+		Plugin::CoverageData DeserializeFromStream(
+			std::istream& istr,
+			const std::string& errorIfNotCorrectFormat,
+			const CoverageDataDeserializer::ModuleHandler* moduleHandler)
+		{
+			google::protobuf::io::IstreamInputStream outputStream(&istr);
+			google::protobuf::io::CodedInputStream  codedInputStream(&outputStream);
+			pb::CoverageData coverageDataProtoBuff;
+
+			auto coverageData = ReadCoverageDataHeader(
+				codedInputStream, errorIfNotCorrectFormat, coverageDataProtoBuff);
+
+			if (!moduleHandler)
+				InitCoverageDataFrom(codedInputStream, coverageDataProtoBuff, coverageData);
+			else
+			{
+				for (size_t i = 0; i < coverageDataProtoBuff.modulecount(); ++i)
+				{
+					// The stream is read from its beginning.
+					std::streamoff position = codedInputStream.CurrentPosition();
+					(*moduleHandler)(ReadModule(codedInputStream), position);
+				}
+			}
 
 			return coverageData;
 		}
+
+		//-------------------------------------------------------------------------
+		std::ifstream OpenFile(const std::filesystem::path& path)
+		{
+			std::ifstream ifs(path.string(), std::ios::binary);
+
+			if (!ifs)
+				THROW(L"Cannot open file " + path.wstring());
+			return ifs;
+		}
 	}
 		
 	//-------------------------------------------------------------------------
@@ -111,10 +207,80 @@ namespace Exporter
 		const std::filesystem::path& path, 
 		const std::string& errorIfNotCorrectFormat) const
 	{
-		std::ifstream ifs(path.string(), std::ios::binary);
+		auto ifs = OpenFile(path);
+		return DeserializeFromStream(ifs, errorIfNotCorrectFormat, nullptr);
+	}
+
+	//-------------------------------------------------------------------------
+	Plugin::CoverageData CoverageDataDeserializer::Deserialize(
+		std::istream& istr,
+		const std::string& errorIfNotCorrectFormat) const
+	{
+		return DeserializeFromStream(istr, errorIfNotCorrectFormat, nullptr);
+	}
+
+	//-------------------------------------------------------------------------
+	Plugin::CoverageData CoverageDataDeserializer::Deserialize(
+		const std::filesystem::path& path,
+		const std::string& errorIfNotCorrectFormat,
+		const ModuleHandler& moduleHandler) const
+	{
+		auto ifs = OpenFile(path);
+		return DeserializeFromStream(ifs, errorIfNotCorrectFormat, &moduleHandler);
+	}
+
+	//-------------------------------------------------------------------------
+	Plugin::CoverageData CoverageDataDeserializer::ReadModulePaths(
+		const std::filesystem::path& path,
+		const std::string& errorIfNotCorrectFormat,
+		const ModulePathHandler& modulePathHandler) const
+	{
+		auto ifs = OpenFile(path);
+		google::protobuf::io::IstreamInputStream inputStream(&ifs);
+		google::protobuf::io::CodedInputStream codedInputStream(&inputStream);
+		pb::CoverageData coverageDataProtoBuff;
+
+		auto coverageData = ReadCoverageDataHeader(
+			codedInputStream, errorIfNotCorrectFormat, coverageDataProtoBuff);
+
+		for (size_t i = 0; i < coverageDataProtoBuff.modulecount(); ++i)
+		{
+			std::streamoff position = codedInputStream.CurrentPosition();
+			modulePathHandler(ReadModulePath(codedInputStream), position);
+		}
+
+		return coverageData;
+	}
+
+	//-------------------------------------------------------------------------
+	std::unique_ptr<Plugin::ModuleCoverage> CoverageDataDeserializer::DeserializeModule(
+		const std::filesystem::path& path,
+		std::streamoff position) const
+	{
+		auto ifs = OpenFile(path);
+
+		if (!ifs.seekg(position))
+			THROW(L"Cannot read module in " + path.wstring());
+
+		google::protobuf::io::IstreamInputStream inputStream(&ifs);
+		google::protobuf::io::CodedInputStream codedInputStream(&inputStream);
+
+		return ReadModule(codedInputStream);
+	}
+
+	//-------------------------------------------------------------------------
+	std::unique_ptr<Plugin::ModuleCoverage> CoverageDataDeserializer::DeserializeModule(
+		std::istream& istr,
+		std::streamoff position) const
+	{
+		// The previous read can stop at the end of the stream.
+		istr.clear();
+		if (!istr.seekg(position))
+			THROW(L"Cannot read module at position " << position);
+
+		google::protobuf::io::IstreamInputStream inputStream(&istr);
+		google::protobuf::io::CodedInputStream codedInputStream(&inputStream);
 
-		if (!ifs)
-			THROW(L"Cannot open file " + path.wstring());
-		return DeserializeFromStream(ifs, errorIfNotCorrectFormat);
+		return ReadModule(codedInputStream);
 	}
 }
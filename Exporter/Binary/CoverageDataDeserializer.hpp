@@ -17,12 +17,16 @@
 #pragma once
 
 #include <filesystem>
+#include <functional>
+#include <iosfwd>
+#include <memory>
 
 #include "../ExporterExport.hpp"
 
 namespace Plugin
 {
 	class CoverageData;
+	class ModuleCoverage;
 }
 
 namespace Exporter
@@ -32,7 +36,35 @@ namespace Exporter
 	public:		
 		CoverageDataDeserializer() = default;
 
+		using ModuleHandler = std::function<void(std::unique_ptr<Plugin::ModuleCoverage>, std::streamoff position)>;
+		using ModulePathHandler = std::function<void(const std::filesystem::path&, std::streamoff position)>;
+
 		Plugin::CoverageData Deserialize(const std::filesystem::path&, const std::string& errorIfNotCorrectFormat) const;
+		Plugin::CoverageData Deserialize(std::istream&, const std::string& errorIfNotCorrectFormat) const;
+
+		// Give the modules one at a time to moduleHandler with their position 
+		// for DeserializeModule. The returned coverage data has no module.
+		Plugin::CoverageData Deserialize(
+			const std::filesystem::path&, 
+			const std::string& errorIfNotCorrectFormat,
+			const ModuleHandler& moduleHandler) const;
+
+		// Give the module paths one at a time to modulePathHandler with their
+		// position for DeserializeModule. The files of the modules are skipped
+		// without being parsed.
+		Plugin::CoverageData ReadModulePaths(
+			const std::filesystem::path&,
+			const std::string& errorIfNotCorrectFormat,
+			const ModulePathHandler& modulePathHandler) const;
+
+		std::unique_ptr<Plugin::ModuleCoverage> DeserializeModule(
+			const std::filesystem::path&, 
+			std::streamoff position) const;
+
+		// Same as above but istr stays open to read other modules of the same file.
+		std::unique_ptr<Plugin::ModuleCoverage> DeserializeModule(
+			std::istream& istr,
+			std::streamoff position) const;
 		
 	private:
 		CoverageDataDeserializer(const CoverageDataDeserializer&) = delete;
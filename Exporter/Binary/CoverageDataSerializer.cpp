@@ -45,13 +45,28 @@ namespace Exporter
 		{
 			fileProtoBuff.set_path(Tools::ToUtf8String(file.GetPath().wstring()));
 
-			for (const auto& line : file.GetLines())
+			for (const auto& line : file.GetLineRange())
 			{
 				auto lineProtoBuff = fileProtoBuff.add_lines();
 				
 				lineProtoBuff->set_linenumber(line.GetLineNumber());
 				lineProtoBuff->set_hasbeenexecuted(line.HasBeenExecuted());
 			}
+
+			std::string functionNames;
+			for (const auto& function : file.GetFunctions())
+			{
+				auto functionProtoBuff = fileProtoBuff.add_functions();
+
+				functionProtoBuff->set_symbolid(function.GetSymbolId());
+				functionProtoBuff->set_nameoffset(static_cast<unsigned int>(functionNames.size()));
+				functionProtoBuff->set_firstlinenumber(function.GetFirstLineNumber());
+				functionProtoBuff->set_lastlinenumber(function.GetLastLineNumber());
+				functionNames += Tools::ToUtf8String(function.GetName());
+				functionNames.push_back('\0');
+			}
+			if (!functionNames.empty())
+				fileProtoBuff.set_functionnames(std::move(functionNames));
 		}
 
 		//---------------------------------------------------------------------
@@ -71,11 +86,12 @@ namespace Exporter
 		//---------------------------------------------------------------------
 		void FillCoverageDataProtoBuffFrom(
 			const Plugin::CoverageData& coverageData,
+			size_t moduleCount,
 			pb::CoverageData& coverageDataProtoBuff)
 		{
 			coverageDataProtoBuff.set_name(Tools::ToUtf8String(coverageData.GetName()));
 			coverageDataProtoBuff.set_exitcode(coverageData.GetExitCode());
-			coverageDataProtoBuff.set_modulecount(coverageData.GetModules().size());			
+			coverageDataProtoBuff.set_modulecount(moduleCount);
 		}
 
 		//---------------------------------------------------------------------
@@ -96,30 +112,110 @@ namespace Exporter
 	void CoverageDataSerializer::Serialize(
 		const Plugin::CoverageData& coverageData,
 		const std::filesystem::path& output) const
-	{		
-		pb::CoverageData coverageDataProtoBuff;
+	{
+		const auto& modules = coverageData.GetModules();
+		CoverageDataModuleSerializer moduleSerializer{ coverageData, modules.size(), output };
+
+		for (const auto& module : modules)
+			moduleSerializer.Serialize(*module);
+		moduleSerializer.Close();
+	}
+
+	//-------------------------------------------------------------------------
+	void CoverageDataSerializer::Serialize(
+		const Plugin::CoverageData& coverageData,
+		std::ostream& ostr) const
+	{
+		const auto& modules = coverageData.GetModules();
+		CoverageDataModuleSerializer moduleSerializer{ coverageData, modules.size(), ostr };
+
+		for (const auto& module : modules)
+			moduleSerializer.Serialize(*module);
+		moduleSerializer.Close();
+	}
+
+	//-------------------------------------------------------------------------
+	struct CoverageDataModuleSerializer::Streams
+	{
+		// ofs is null when writing to a stream owned by the caller.
+		Streams(std::unique_ptr<std::ofstream> ofs, std::ostream& ostr)
+			: ofs{ std::move(ofs) }
+			, outputStream{ &ostr }
+			, codedOutputStream{ &outputStream }
+		{
+		}
+
+		std::unique_ptr<std::ofstream> ofs;
+		google::protobuf::io::OstreamOutputStream outputStream;
+		google::protobuf::io::CodedOutputStream codedOutputStream;
+	};
+
+	//-------------------------------------------------------------------------
+	CoverageDataModuleSerializer::CoverageDataModuleSerializer(
+		const Plugin::CoverageData& coverageData,
+		size_t moduleCount,
+		const std::filesystem::path& output)
+		: remainingModuleCount_{ moduleCount }
+	{
 		Tools::CreateParentFolderIfNeeded(output);
 
-		std::ofstream ofs(output.string(), std::ios::binary);
-		if (!ofs)
+		auto ofs = std::make_unique<std::ofstream>(output.string(), std::ios::binary);
+		if (!*ofs)
 			throw InvalidOutputFileException(output, "binary");
 
-		google::protobuf::io::OstreamOutputStream outputStream(&ofs);
-		google::protobuf::io::CodedOutputStream codedOutputStream(&outputStream);
+		auto& ostr = *ofs;
+		streams_ = std::make_unique<Streams>(std::move(ofs), ostr);
+		WriteHeader(coverageData);
+	}
+
+	//-------------------------------------------------------------------------
+	CoverageDataModuleSerializer::CoverageDataModuleSerializer(
+		const Plugin::CoverageData& coverageData,
+		size_t moduleCount,
+		std::ostream& ostr)
+		: streams_{ std::make_unique<Streams>(nullptr, ostr) }
+		, remainingModuleCount_{ moduleCount }
+	{
+		WriteHeader(coverageData);
+	}
 
+	//-------------------------------------------------------------------------
+	void CoverageDataModuleSerializer::WriteHeader(const Plugin::CoverageData& coverageData)
+	{
+		pb::CoverageData coverageDataProtoBuff;
+		auto moduleCount = remainingModuleCount_;
+		auto& codedOutputStream = streams_->codedOutputStream;
 		codedOutputStream.WriteVarint32(CoverageDataSerializer::FileTypeId);
 
-		FillCoverageDataProtoBuffFrom(coverageData, coverageDataProtoBuff);
+		FillCoverageDataProtoBuffFrom(coverageData, moduleCount, coverageDataProtoBuff);
 		WriteMessage(coverageDataProtoBuff, codedOutputStream);
-				 			
+	}
+
+	//-------------------------------------------------------------------------
+	CoverageDataModuleSerializer::~CoverageDataModuleSerializer() = default;
+
+	//-------------------------------------------------------------------------
+	void CoverageDataModuleSerializer::Serialize(const Plugin::ModuleCoverage& module)
+	{
+		if (!streams_)
+			THROW(L"Serializer is closed.");
+		if (!remainingModuleCount_)
+			THROW(L"Too many modules to serialize.");
+
 		// Here we serialize manually modules because protobuff's limit.
 		// See https://developers.google.com/protocol-buffers/docs/techniques#large-data
-		for (const auto& module : coverageData.GetModules())
-		{
-			pb::ModuleCoverage moduleProtoBuff;
-			InitializeModuleProtoBuffFrom(*module, moduleProtoBuff);
+		pb::ModuleCoverage moduleProtoBuff;
+		InitializeModuleProtoBuffFrom(module, moduleProtoBuff);
 
-			WriteMessage(moduleProtoBuff, codedOutputStream);
-		}
+		WriteMessage(moduleProtoBuff, streams_->codedOutputStream);
+		--remainingModuleCount_;
+	}
+
+	//-------------------------------------------------------------------------
+	void CoverageDataModuleSerializer::Close()
+	{
+		streams_.reset();
+		if (remainingModuleCount_)
+			THROW(L"Missing modules: " << remainingModuleCount_);
 	}
 }
@@ -17,11 +17,14 @@
 #pragma once
 
 #include <filesystem>
+#include <iosfwd>
+#include <memory>
 #include "../ExporterExport.hpp"
 
 namespace Plugin
 {
 	class CoverageData;
+	class ModuleCoverage;
 }
 
 namespace Exporter
@@ -34,10 +37,42 @@ namespace Exporter
 		CoverageDataSerializer() = default;
 
 		void Serialize(const Plugin::CoverageData&, const std::filesystem::path&) const;
+		void Serialize(const Plugin::CoverageData&, std::ostream&) const;
 
 	private:
 		CoverageDataSerializer(const CoverageDataSerializer&) = delete;
 		CoverageDataSerializer& operator=(const CoverageDataSerializer&) = delete;
 	};
+
+	// Write the same file as CoverageDataSerializer one module at a time.
+	class EXPORTER_DLL CoverageDataModuleSerializer
+	{
+	public:
+		// The modules of coverageData are not serialized.
+		CoverageDataModuleSerializer(
+			const Plugin::CoverageData& coverageData,
+			size_t moduleCount,
+			const std::filesystem::path&);
+		CoverageDataModuleSerializer(
+			const Plugin::CoverageData& coverageData,
+			size_t moduleCount,
+			std::ostream&);
+		~CoverageDataModuleSerializer();
+
+		void Serialize(const Plugin::ModuleCoverage&);
+
+		// Throw if the number of serialized modules is not moduleCount.
+		void Close();
+
+	private:
+		CoverageDataModuleSerializer(const CoverageDataModuleSerializer&) = delete;
+		CoverageDataModuleSerializer& operator=(const CoverageDataModuleSerializer&) = delete;
+
+		void WriteHeader(const Plugin::CoverageData&);
+
+		struct Streams;
+		std::unique_ptr<Streams> streams_;
+		size_t remainingModuleCount_;
+	};
 }
 
@@ -17,6 +17,8 @@
 #include "stdafx.h"
 
 #include <unordered_set>
+#include <fstream>
+#include <sstream>
 #include <boost/property_tree/ptree.hpp>
 #include <boost/property_tree/xml_parser.hpp>
 #include <filesystem>
@@ -26,8 +28,12 @@
 #include "Plugin/Exporter/ModuleCoverage.hpp"
 #include "Plugin/Exporter/FileCoverage.hpp"
 #include "Plugin/Exporter/LineCoverage.hpp"
+#include "Plugin/Exporter/FunctionCoverage.hpp"
+#include "Plugin/Exporter/CoverageRollup.hpp"
 #include "CppCoverage/CoverageRateComputer.hpp"
+#include "CppCoverage/CoverageRate.hpp"
 #include "InvalidOutputFileException.hpp"
+#include "ExporterException.hpp"
 
 #include "Tools/Tool.hpp"
 
@@ -45,13 +51,19 @@ namespace Exporter
 		}
 
 		//-------------------------------------------------------------------------
-		std::wstring ToUft8WString(const fs::path& path)
+		std::wstring ToUft8WString(const std::wstring& value)
 		{
-			auto str = Tools::ToUtf8String(path.wstring());
+			auto str = Tools::ToUtf8String(value);
 			auto utf8Str = Tools::LocalToWString(str);
 			return utf8Str;
 		}
 
+		//-------------------------------------------------------------------------
+		std::wstring ToUft8WString(const fs::path& path)
+		{
+			return ToUft8WString(path.wstring());
+		}
+
 		//-------------------------------------------------------------------------
 		void SetCoverage(
 			property_tree::wptree& node,
@@ -62,6 +74,39 @@ namespace Exporter
 			node.put(L"<xmlattr>.complexity", 0);
 		}
 
+		//-------------------------------------------------------------------------
+		void AddLineTree(property_tree::wptree& linesTree, const Plugin::LineCoverage& line)
+		{
+			property_tree::wptree& lineTree = AddChild(linesTree, L"line");
+
+			lineTree.put(L"<xmlattr>.number", std::to_wstring(line.GetLineNumber()));
+			lineTree.put(L"<xmlattr>.hits", line.HasBeenExecuted() ? L"1" : L"0");
+		}
+
+		//-------------------------------------------------------------------------
+		void FillMethodTree(
+			property_tree::wptree& methodTree,
+			const Plugin::FunctionCoverage& function,
+			const Plugin::LineRange& lines)
+		{
+			auto executedLineCount = static_cast<int>(function.GetExecutedLineCount());
+			auto lineCount = static_cast<int>(function.GetLineCount());
+
+			methodTree.put(L"<xmlattr>.name", ToUft8WString(function.GetName()));
+			methodTree.put(L"<xmlattr>.signature", L"");
+			SetCoverage(methodTree, CppCoverage::CoverageRate{ executedLineCount, lineCount - executedLineCount });
+
+			property_tree::wptree& linesTree = AddChild(methodTree, L"lines");
+			auto it = std::lower_bound(lines.begin(), lines.end(), function.GetFirstLineNumber(),
+				[](const Plugin::LineCoverage& line, unsigned int lineNumber)
+			{
+				return line.GetLineNumber() < lineNumber;
+			});
+
+			for (; it != lines.end() && it->GetLineNumber() <= function.GetLastLineNumber(); ++it)
+				AddLineTree(linesTree, *it);
+		}
+
 		//-------------------------------------------------------------------------
 		void FillFileTree(
 			const CppCoverage::CoverageRateComputer& coverageRateComputer,
@@ -71,39 +116,39 @@ namespace Exporter
 			const auto& path = file.GetPath();
 			auto res = path.relative_path();
 			const auto& coverageRate = coverageRateComputer.GetCoverageRate(file);
+			auto lines = file.GetLineRange();
 
 			fileTree.put(L"<xmlattr>.name", ToUft8WString(path.filename()));
 			fileTree.put(L"<xmlattr>.filename", ToUft8WString(path.relative_path()));
 			SetCoverage(fileTree, coverageRate);
-			AddChild(fileTree, L"methods");
+
+			property_tree::wptree& methodsTree = AddChild(fileTree, L"methods");
+			for (const auto& function : file.GetFunctions())
+				FillMethodTree(AddChild(methodsTree, L"method"), function, lines);
 
 			property_tree::wptree& linesTree = AddChild(fileTree, L"lines");
 
-			for (const auto& line : file.GetLines())
-			{
-				property_tree::wptree& lineTree = AddChild(linesTree, L"line");
+			for (const auto& line : lines)
+				AddLineTree(linesTree, line);
+		}
 
-				lineTree.put(L"<xmlattr>.number", std::to_wstring(line.GetLineNumber()));
-				lineTree.put(L"<xmlattr>.hits", line.HasBeenExecuted() ? L"1" : L"0");
+		//-------------------------------------------------------------------------
+		void AddSourceRoots(
+			const Plugin::ModuleCoverage& module,
+			std::unordered_set<std::wstring>& rootPaths)
+		{
+			for (const auto& file : module.GetFiles())
+			{
+				const auto& path = file->GetPath();
+				rootPaths.insert(path.root_name().wstring());
 			}
 		}
 
 		//-------------------------------------------------------------------------
 		void WriteSourceRoots(
-			const Plugin::CoverageData& coverageData,
+			const std::unordered_set<std::wstring>& rootPaths,
 			property_tree::wptree& coverageTree)
 		{
-			std::unordered_set<std::wstring> rootPaths;
-
-			for (const auto& module : coverageData.GetModules())
-			{
-				for (const auto& file : module->GetFiles())
-				{
-					const auto& path = file->GetPath();
-					rootPaths.insert(path.root_name().wstring());
-				}
-			}
-
 			auto& sourcesTree = AddChild(coverageTree, L"sources");
 
 			for (const auto& rootPath : rootPaths)
@@ -128,44 +173,164 @@ namespace Exporter
 		}
 
 		//-------------------------------------------------------------------------
-		void FillCoverageTree(
+		property_tree::wptree& AddCoverageTree(
 			property_tree::wptree& root,
-			const Plugin::CoverageData& coverageData)
+			const CppCoverage::CoverageRate& coverageRate,
+			const std::unordered_set<std::wstring>& rootPaths)
 		{
-			CppCoverage::CoverageRateComputer coverageRateComputer(coverageData);
 			auto& coverageTree = AddChild(root, L"coverage");
-			const auto& coverageRate = coverageRateComputer.GetCoverageRate();
 			SetCoverage(coverageTree, coverageRate);
 			SetCoverageAttributes(coverageTree, coverageRate);
 
-			WriteSourceRoots(coverageData, coverageTree);
+			WriteSourceRoots(rootPaths, coverageTree);
+
+			return AddChild(coverageTree, L"packages");
+		}
+
+		//-------------------------------------------------------------------------
+		template <typename FileCollection>
+		property_tree::wptree CreatePackageTree(
+			const CppCoverage::CoverageRateComputer& coverageRateComputer,
+			const fs::path& name,
+			const CppCoverage::CoverageRate& coverageRate,
+			const FileCollection& files)
+		{
+			property_tree::wptree packageTree;
+			property_tree::wptree& classesTree = AddChild(packageTree, L"classes");
+
+			packageTree.put(L"<xmlattr>.name", ToUft8WString(name));
+			SetCoverage(packageTree, coverageRate);
+
+			for (const auto& file : files)
+			{
+				property_tree::wptree& fileTree = AddChild(classesTree, L"class");
+				FillFileTree(coverageRateComputer, fileTree, *file);
+			}
+			return packageTree;
+		}
+
+		//-------------------------------------------------------------------------
+		void AddDirectoryPackageTrees(
+			const CppCoverage::CoverageRateComputer& coverageRateComputer,
+			const Plugin::CoverageRollupNode& directory,
+			std::vector<property_tree::wptree>& packageTrees)
+		{
+			const auto& files = directory.GetFiles();
+
+			if (!files.empty())
+			{
+				CppCoverage::CoverageRate coverageRate;
+				for (const auto* file : files)
+					coverageRate += coverageRateComputer.GetCoverageRate(*file);
+				packageTrees.push_back(CreatePackageTree(
+					coverageRateComputer, directory.GetPath(), coverageRate, files));
+			}
+			for (const auto& subDirectory : directory.GetChildren())
+				AddDirectoryPackageTrees(coverageRateComputer, *subDirectory, packageTrees);
+		}
+
+		//-------------------------------------------------------------------------
+		std::vector<property_tree::wptree> CreatePackageTrees(
+			const CppCoverage::CoverageRateComputer& coverageRateComputer,
+			const Plugin::ModuleCoverage& module,
+			CoberturaExporter::PackageType packageType)
+		{
+			std::vector<property_tree::wptree> packageTrees;
+
+			// Do not create package if no files exists -> Coverage will not be visible by module
+			if (module.GetFiles().empty())
+				return packageTrees;
+
+			if (packageType == CoberturaExporter::PackageType::Module)
+			{
+				packageTrees.push_back(CreatePackageTree(coverageRateComputer,
+					module.GetPath(), coverageRateComputer.GetCoverageRate(module), module.GetFiles()));
+			}
+			else
+			{
+				Plugin::CoverageRollup coverageRollup{ module };
+				AddDirectoryPackageTrees(coverageRateComputer, coverageRollup.GetRoot(), packageTrees);
+			}
+			return packageTrees;
+		}
+
+		//-------------------------------------------------------------------------
+		void FillCoverageTree(
+			property_tree::wptree& root,
+			const Plugin::CoverageData& coverageData,
+			CoberturaExporter::PackageType packageType)
+		{
+			CppCoverage::CoverageRateComputer coverageRateComputer(coverageData);
+			std::unordered_set<std::wstring> rootPaths;
+
+			for (const auto& module : coverageData.GetModules())
+				AddSourceRoots(*module, rootPaths);
 
-			property_tree::wptree& packagesTree = AddChild(coverageTree, L"packages");
+			property_tree::wptree& packagesTree = AddCoverageTree(
+				root, coverageRateComputer.GetCoverageRate(), rootPaths);
 
 			for (const auto& module : coverageData.GetModules())
 			{
-				// Do not create package if no files exists -> Coverage will not be visible by module
-				if (!module->GetFiles().empty())
-				{
-					property_tree::wptree& packageTree = AddChild(packagesTree, L"package");
-					property_tree::wptree& classesTree = AddChild(packageTree, L"classes");
-					const auto& coverageRate = coverageRateComputer.GetCoverageRate(*module);
-
-					packageTree.put(L"<xmlattr>.name", ToUft8WString(module->GetPath()));
-					SetCoverage(packageTree, coverageRate);
-
-					for (const auto& file : module->GetFiles())
-					{
-						property_tree::wptree& fileTree = AddChild(classesTree, L"class");
-						FillFileTree(coverageRateComputer, fileTree, *file);
-					}
-				}
+				for (auto& packageTree : CreatePackageTrees(coverageRateComputer, *module, packageType))
+					packagesTree.add_child(L"package", std::move(packageTree));
 			}
 		}
+
+		//-------------------------------------------------------------------------
+		property_tree::xml_writer_settings<std::wstring> GetXmlWriterSettings()
+		{
+			return property_tree::xml_writer_settings<std::wstring>(' ', 2);
+		}
+
+		// Depth of package elements: coverage is 0 and packages is 1.
+		const int PackageIndent = 2;
+
+		// Replaced by the content of the packages file.
+		const std::wstring PackagesPlaceholder = L"OpenCppCoveragePackages";
 	}
 
 	//-------------------------------------------------------------------------
-	CoberturaExporter::CoberturaExporter() = default;
+	struct CoberturaExporter::ModuleExport
+	{
+		explicit ModuleExport(const std::filesystem::path& outputPath)
+			: outputPath{ outputPath }
+			, packagesPath{ Tools::CreateTemporaryFile() }
+		{
+			Tools::CreateParentFolderIfNeeded(outputPath);
+			output.open(outputPath.string().c_str());
+			if (!output)
+				throw InvalidOutputFileException(outputPath, "cobertura");
+			packages.open(packagesPath.string().c_str());
+		}
+
+		~ModuleExport()
+		{
+			packages.close();
+			std::error_code ignoredErrorCode;
+			fs::remove(packagesPath, ignoredErrorCode);
+		}
+
+		std::filesystem::path outputPath;
+		std::wofstream output;
+
+		// Packages are written as soon as a module is exported and copied 
+		// to output at the end when the total coverage rate is known.
+		std::filesystem::path packagesPath;
+		std::wofstream packages;
+		bool hasPackage = false;
+
+		std::unordered_set<std::wstring> rootPaths;
+		CppCoverage::CoverageRate coverageRate;
+	};
+
+	//-------------------------------------------------------------------------
+	CoberturaExporter::CoberturaExporter(PackageType packageType)
+		: packageType_{ packageType }
+	{
+	}
+
+	//-------------------------------------------------------------------------
+	CoberturaExporter::~CoberturaExporter() = default;
 
 	//-------------------------------------------------------------------------
 	std::filesystem::path CoberturaExporter::GetDefaultPath(const std::wstring& prefix) const
@@ -199,9 +364,81 @@ namespace Exporter
 		using Ptree = property_tree::wptree;
 		Ptree root;
 		
-		FillCoverageTree(root, coverageData);
+		FillCoverageTree(root, coverageData, packageType_);
+		property_tree::xml_parser::write_xml(ostream, root, GetXmlWriterSettings());
+	}
+
+	//-------------------------------------------------------------------------
+	void CoberturaExporter::BeginExport(
+		const Plugin::CoverageData&,
+		size_t,
+		const std::filesystem::path& output)
+	{
+		moduleExport_ = std::make_unique<ModuleExport>(output);
+	}
+
+	//-------------------------------------------------------------------------
+	void CoberturaExporter::ExportModule(const Plugin::CoverageData& coverageData)
+	{
+		if (!moduleExport_)
+			THROW(L"BeginExport was not called.");
+
+		CppCoverage::CoverageRateComputer coverageRateComputer(coverageData);
+		moduleExport_->coverageRate += coverageRateComputer.GetCoverageRate();
+
+		for (const auto& module : coverageData.GetModules())
+		{
+			AddSourceRoots(*module, moduleExport_->rootPaths);
+			for (const auto& packageTree : CreatePackageTrees(coverageRateComputer, *module, packageType_))
+			{
+				property_tree::xml_parser::write_xml_element(
+					moduleExport_->packages,
+					std::wstring{ L"package" },
+					packageTree,
+					PackageIndent,
+					GetXmlWriterSettings());
+				moduleExport_->hasPackage = true;
+			}
+		}
+	}
+
+	//-------------------------------------------------------------------------
+	void CoberturaExporter::EndExport()
+	{
+		if (!moduleExport_)
+			THROW(L"BeginExport was not called.");
+		auto moduleExport = std::move(moduleExport_);
+
+		property_tree::wptree root;
+		auto& packagesTree = AddCoverageTree(
+			root, moduleExport->coverageRate, moduleExport->rootPaths);
+		if (moduleExport->hasPackage)
+			AddChild(packagesTree, PackagesPlaceholder);
+
+		std::wostringstream ostr;
+		property_tree::xml_parser::write_xml(ostr, root, GetXmlWriterSettings());
+		auto document = ostr.str();
+		auto& output = moduleExport->output;
+
+		if (moduleExport->hasPackage)
+		{
+			auto placeholderPos = document.find(L'<' + PackagesPlaceholder);
+			auto lineBegin = document.rfind(L'\n', placeholderPos) + 1;
+			auto lineEnd = document.find(L'\n', placeholderPos) + 1;
+
+			moduleExport->packages.close();
+			std::wifstream packages{ moduleExport->packagesPath.string().c_str() };
+
+			output << document.substr(0, lineBegin);
+			output << packages.rdbuf();
+			output << document.substr(lineEnd);
+		}
+		else
+			output << document;
 
-		property_tree::xml_writer_settings<Ptree::key_type> settings(' ', 2);
-		property_tree::xml_parser::write_xml(ostream, root, settings);
+		output.close();
+		if (!output)
+			throw InvalidOutputFileException(moduleExport->outputPath, "cobertura");
+		Tools::ShowOutputMessage(L"Cobertura report generated: ", moduleExport->outputPath);
 	}
 }
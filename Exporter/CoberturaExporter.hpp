@@ -17,10 +17,12 @@
 #pragma once
 
 #include <iosfwd>
+#include <memory>
 #include <filesystem>
 
 #include "ExporterExport.hpp"
 #include "IExporter.hpp"
+#include "IModuleExporter.hpp"
 
 namespace Plugin
 {
@@ -29,18 +31,38 @@ namespace Plugin
 
 namespace Exporter
 {
-	class EXPORTER_DLL CoberturaExporter: public IExporter
+	class EXPORTER_DLL CoberturaExporter: public IExporter, public IModuleExporter
 	{
 	public:
-		CoberturaExporter() ;
+		// A package is created for each module or for each source directory.
+		enum class PackageType
+		{
+			Module,
+			Directory
+		};
+
+		explicit CoberturaExporter(PackageType = PackageType::Module);
+		~CoberturaExporter();
 
 		std::filesystem::path GetDefaultPath(const std::wstring& runningCommandFilename) const override;
 		void Export(const Plugin::CoverageData&, const std::filesystem::path& output) override;
 		void Export(const Plugin::CoverageData&, std::wostream&) const;
 
+		void BeginExport(
+			const Plugin::CoverageData&,
+			size_t moduleCount,
+			const std::filesystem::path& output) override;
+		void ExportModule(const Plugin::CoverageData&) override;
+		void EndExport() override;
+
 	private:
 		CoberturaExporter(const CoberturaExporter&) = delete;
 		CoberturaExporter& operator=(const CoberturaExporter&) = delete;
+
+		const PackageType packageType_;
+
+		struct ModuleExport;
+		std::unique_ptr<ModuleExport> moduleExport_;
 	};
 }
 
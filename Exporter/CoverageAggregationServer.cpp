@@ -0,0 +1,307 @@
+// OpenCppCoverage is an open source code coverage for C++.
+// Copyright (C) 2019 OpenCppCoverage
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "stdafx.h"
+#include "CoverageAggregationServer.hpp"
+
+#include <condition_variable>
+#include <cstring>
+#include <sstream>
+#include <thread>
+
+#include "Plugin/Exporter/CoverageData.hpp"
+#include "Plugin/Exporter/ModuleCoverage.hpp"
+#include "Plugin/Exporter/FileCoverage.hpp"
+
+#include "CppCoverage/CoverageDataAccumulator.hpp"
+#include "CppCoverage/MessageChannel.hpp"
+
+#include "Tools/BinaryStream.hpp"
+#include "Tools/Log.hpp"
+#include "Tools/WorkQueue.hpp"
+
+#include "Binary/CoverageDataDeserializer.hpp"
+#include "Binary/CoverageDataSerializer.hpp"
+#include "ExporterException.hpp"
+
+namespace Exporter
+{
+	namespace
+	{
+		// Message: Magic, Version, MessageType, content
+		// Upload content: binary coverage file
+		// Response content: error message or result
+		const uint32_t Magic = 0x414F4343; // OCCA
+		const uint32_t Version = 1;
+		const std::string InvalidCoverageData = "Invalid binary coverage data.";
+
+		enum class MessageType : uint8_t
+		{
+			Upload = 1,
+			DownloadMergedCoverageData = 2,
+			GetSummary = 3,
+			Stop = 4,
+			Response = 5,
+			Error = 6
+		};
+
+		//---------------------------------------------------------------------
+		template <typename T>
+		T Read(Tools::BinaryReader& reader)
+		{
+			T value;
+
+			if (!reader.Read(value))
+				THROW(L"Invalid aggregation server message.");
+			return value;
+		}
+
+		//---------------------------------------------------------------------
+		std::string CreateMessage(MessageType messageType, const std::string& content)
+		{
+			std::ostringstream ostr;
+			Tools::BinaryWriter writer{ ostr };
+
+			writer.Write(Magic);
+			writer.Write(Version);
+			writer.Write(messageType);
+			ostr << content;
+			return ostr.str();
+		}
+
+		//---------------------------------------------------------------------
+		MessageType ReadMessage(const std::string& message, std::string& content)
+		{
+			std::istringstream istr{ message };
+			Tools::BinaryReader reader{ istr };
+
+			if (Read<uint32_t>(reader) != Magic)
+				THROW(L"Invalid aggregation server message.");
+			auto version = Read<uint32_t>(reader);
+			if (version != Version)
+			{
+				THROW(L"Aggregation server protocol version " << version <<
+					L" is not supported. Expected version " << Version << L'.');
+			}
+			auto messageType = Read<MessageType>(reader);
+			content = message.substr(static_cast<size_t>(message.size() - reader.GetRemainingSize()));
+
+			return messageType;
+		}
+
+		//---------------------------------------------------------------------
+		std::string SendRequest(
+			CppCoverage::IMessageChannel& channel,
+			MessageType messageType,
+			const std::string& content)
+		{
+			channel.Write(CreateMessage(messageType, content));
+
+			auto message = channel.Read();
+			if (!message)
+				THROW(L"The aggregation server closed the connection.");
+
+			std::string response;
+			switch (ReadMessage(*message, response))
+			{
+			case MessageType::Response: return response;
+			case MessageType::Error: THROW(L"Aggregation server error: " << response.c_str());
+			}
+			THROW(L"Unexpected aggregation server message.");
+		}
+	}
+
+	//-------------------------------------------------------------------------
+	CoverageAggregator::CoverageAggregator()
+		: coverageDataAccumulator_{ std::make_unique<CppCoverage::CoverageDataAccumulator>() }
+		, uploadCount_{ 0 }
+		, workQueue_{ std::make_unique<Tools::WorkQueue>() }
+	{
+	}
+
+	//-------------------------------------------------------------------------
+	CoverageAggregator::~CoverageAggregator() = default;
+
+	//-------------------------------------------------------------------------
+	void CoverageAggregator::Add(const std::string& binaryCoverageData)
+	{
+		std::istringstream istr{ binaryCoverageData };
+		auto coverageData = std::make_shared<Plugin::CoverageData>(
+			CoverageDataDeserializer{}.Deserialize(istr, InvalidCoverageData));
+
+		workQueue_->Push([this, coverageData]() { Merge(std::move(*coverageData)); });
+	}
+
+	//-------------------------------------------------------------------------
+	void CoverageAggregator::Merge(Plugin::CoverageData&& coverageData)
+	{
+		std::lock_guard<std::mutex> lock{ mutex_ };
+
+		++uploadCount_;
+		coverageDataAccumulator_->Add(std::move(coverageData));
+	}
+
+	//-------------------------------------------------------------------------
+	std::string CoverageAggregator::GetMergedCoverageData()
+	{
+		workQueue_->Flush();
+
+		std::lock_guard<std::mutex> lock{ mutex_ };
+		std::ostringstream ostr;
+		CoverageDataSerializer{}.Serialize(coverageDataAccumulator_->GetCoverageData(), ostr);
+
+		return ostr.str();
+	}
+
+	//-------------------------------------------------------------------------
+	CoverageAggregationSummary CoverageAggregator::GetSummary()
+	{
+		workQueue_->Flush();
+
+		std::lock_guard<std::mutex> lock{ mutex_ };
+		CoverageAggregationSummary summary{ uploadCount_, 0, 0, 0, 0 };
+
+		for (const auto& module : coverageDataAccumulator_->GetCoverageData().GetModules())
+		{
+			++summary.moduleCount;
+			for (const auto& file : module->GetFiles())
+			{
+				++summary.fileCount;
+				summary.lineCount += file->GetLineCount();
+				summary.executedLineCount += file->GetExecutedLineCount();
+			}
+		}
+		return summary;
+	}
+
+	//-------------------------------------------------------------------------
+	CoverageAggregationServer::CoverageAggregationServer(CoverageAggregator& coverageAggregator)
+		: coverageAggregator_{ coverageAggregator }
+	{
+	}
+
+	//-------------------------------------------------------------------------
+	void CoverageAggregationServer::Serve(CppCoverage::IMessageChannelListener& listener)
+	{
+		std::mutex mutex;
+		std::condition_variable condition;
+		size_t clientCount = 0;
+
+		while (std::shared_ptr<CppCoverage::IMessageChannel> channel = listener.Accept())
+		{
+			{
+				std::lock_guard<std::mutex> lock{ mutex };
+				++clientCount;
+			}
+
+			// The uploads are deserialized on the client threads so a large
+			// shard does not delay the next connections.
+			std::thread{ [&, channel]() {
+				try
+				{
+					if (!HandleClient(*channel))
+						listener.Close();
+				}
+				catch (const std::exception& e)
+				{
+					// A faulty client must not stop the server.
+					LOG_ERROR << "Aggregation server client error: " << e.what();
+				}
+
+				std::lock_guard<std::mutex> lock{ mutex };
+				--clientCount;
+				condition.notify_all();
+			} }.detach();
+		}
+
+		std::unique_lock<std::mutex> lock{ mutex };
+		condition.wait(lock, [&]() { return clientCount == 0; });
+	}
+
+	//-------------------------------------------------------------------------
+	bool CoverageAggregationServer::HandleClient(CppCoverage::IMessageChannel& channel)
+	{
+		while (auto message = channel.Read())
+		{
+			std::string content;
+			auto messageType = ReadMessage(*message, content);
+
+			if (messageType == MessageType::Stop)
+				return false;
+			try
+			{
+				std::string response;
+				switch (messageType)
+				{
+				case MessageType::Upload:
+					coverageAggregator_.Add(content);
+					break;
+				case MessageType::DownloadMergedCoverageData:
+					response = coverageAggregator_.GetMergedCoverageData();
+					break;
+				case MessageType::GetSummary:
+				{
+					auto summary = coverageAggregator_.GetSummary();
+					response.assign(reinterpret_cast<const char*>(&summary), sizeof(summary));
+					break;
+				}
+				default:
+					THROW(L"Unexpected aggregation server message.");
+				}
+				channel.Write(CreateMessage(MessageType::Response, response));
+			}
+			catch (const std::exception& e)
+			{
+				channel.Write(CreateMessage(MessageType::Error, e.what()));
+			}
+		}
+		return true;
+	}
+
+	//-------------------------------------------------------------------------
+	void CoverageAggregationServer::Upload(
+		CppCoverage::IMessageChannel& channel,
+		const std::string& binaryCoverageData)
+	{
+		SendRequest(channel, MessageType::Upload, binaryCoverageData);
+	}
+
+	//-------------------------------------------------------------------------
+	std::string CoverageAggregationServer::DownloadMergedCoverageData(
+		CppCoverage::IMessageChannel& channel)
+	{
+		return SendRequest(channel, MessageType::DownloadMergedCoverageData, "");
+	}
+
+	//-------------------------------------------------------------------------
+	CoverageAggregationSummary CoverageAggregationServer::GetSummary(
+		CppCoverage::IMessageChannel& channel)
+	{
+		auto response = SendRequest(channel, MessageType::GetSummary, "");
+		CoverageAggregationSummary summary;
+
+		if (response.size() != sizeof(summary))
+			THROW(L"Invalid aggregation server summary.");
+		std::memcpy(&summary, response.data(), sizeof(summary));
+		return summary;
+	}
+
+	//-------------------------------------------------------------------------
+	void CoverageAggregationServer::SendStopRequest(CppCoverage::IMessageChannel& channel)
+	{
+		channel.Write(CreateMessage(MessageType::Stop, ""));
+	}
+}
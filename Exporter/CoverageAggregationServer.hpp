@@ -0,0 +1,112 @@
+// OpenCppCoverage is an open source code coverage for C++.
+// Copyright (C) 2019 OpenCppCoverage
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "ExporterExport.hpp"
+
+namespace Plugin
+{
+	class CoverageData;
+}
+
+namespace Tools
+{
+	class WorkQueue;
+}
+
+namespace CppCoverage
+{
+	class CoverageDataAccumulator;
+	class IMessageChannel;
+	class IMessageChannelListener;
+}
+
+namespace Exporter
+{
+	//-------------------------------------------------------------------------
+	struct EXPORTER_DLL CoverageAggregationSummary
+	{
+		uint64_t uploadCount;
+		uint64_t moduleCount;
+		uint64_t fileCount;
+		uint64_t lineCount;
+		uint64_t executedLineCount;
+	};
+
+	//-------------------------------------------------------------------------
+	// Merge binary coverage files as they arrive with the same result as
+	// CoverageDataMerger::Merge on all of them in arrival order.
+	//-------------------------------------------------------------------------
+	class EXPORTER_DLL CoverageAggregator
+	{
+	public:
+		CoverageAggregator();
+		~CoverageAggregator();
+
+		// Throw if binaryCoverageData is not a binary coverage file. Can be
+		// called from several threads. The merge runs on a background thread.
+		void Add(const std::string& binaryCoverageData);
+
+		// Wait for the pending merges.
+		std::string GetMergedCoverageData();
+		CoverageAggregationSummary GetSummary();
+
+	private:
+		CoverageAggregator(const CoverageAggregator&) = delete;
+		CoverageAggregator& operator=(const CoverageAggregator&) = delete;
+
+		void Merge(Plugin::CoverageData&&);
+
+		std::mutex mutex_;
+		std::unique_ptr<CppCoverage::CoverageDataAccumulator> coverageDataAccumulator_;
+		uint64_t uploadCount_;
+		std::unique_ptr<Tools::WorkQueue> workQueue_;
+	};
+
+	//-------------------------------------------------------------------------
+	// Serve a CoverageAggregator to the test shards: they upload their
+	// coverage files when they finish and the merged result or its summary
+	// can be requested at any time.
+	//-------------------------------------------------------------------------
+	class EXPORTER_DLL CoverageAggregationServer
+	{
+	public:
+		explicit CoverageAggregationServer(CoverageAggregator&);
+
+		// Handle each client on its own thread until a client sends a stop
+		// request or the listener has no more clients. Return once all
+		// the connected clients have disconnected.
+		void Serve(CppCoverage::IMessageChannelListener&);
+
+		static void Upload(CppCoverage::IMessageChannel&, const std::string& binaryCoverageData);
+		static std::string DownloadMergedCoverageData(CppCoverage::IMessageChannel&);
+		static CoverageAggregationSummary GetSummary(CppCoverage::IMessageChannel&);
+		static void SendStopRequest(CppCoverage::IMessageChannel&);
+
+	private:
+		CoverageAggregationServer(const CoverageAggregationServer&) = delete;
+		CoverageAggregationServer& operator=(const CoverageAggregationServer&) = delete;
+
+		bool HandleClient(CppCoverage::IMessageChannel&);
+
+		CoverageAggregator& coverageAggregator_;
+	};
+}
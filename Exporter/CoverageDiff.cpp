@@ -0,0 +1,478 @@
+// OpenCppCoverage is an open source code coverage for C++.
+// Copyright (C) 2019 OpenCppCoverage
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "stdafx.h"
+#include "CoverageDiff.hpp"
+
+#include <algorithm>
+#include <iomanip>
+#include <memory>
+#include <sstream>
+
+#include "Plugin/Exporter/CoverageData.hpp"
+#include "Plugin/Exporter/ModuleCoverage.hpp"
+#include "Plugin/Exporter/FileCoverage.hpp"
+#include "Plugin/Exporter/LineCoverage.hpp"
+
+#include "Tools/Tool.hpp"
+
+#include "Binary/CoverageDataDeserializer.hpp"
+
+namespace Exporter
+{
+	namespace
+	{
+		//---------------------------------------------------------------------
+		template <typename T, typename GetPath>
+		void SortByPath(std::vector<T>& values, GetPath getPath)
+		{
+			std::sort(values.begin(), values.end(), [&](const T& value1, const T& value2)
+			{
+				return getPath(value1) < getPath(value2);
+			});
+		}
+
+		//---------------------------------------------------------------------
+		// before and after must be sorted by path. onJoin is called in path
+		// order with nullptr for the side where the path is missing.
+		template <typename T, typename GetPath, typename OnJoin>
+		void MergeJoin(
+			const std::vector<T>& before,
+			const std::vector<T>& after,
+			GetPath getPath,
+			OnJoin onJoin)
+		{
+			auto beforeIt = before.begin();
+			auto afterIt = after.begin();
+
+			while (beforeIt != before.end() || afterIt != after.end())
+			{
+				if (afterIt == after.end() ||
+					(beforeIt != before.end() && getPath(*beforeIt) < getPath(*afterIt)))
+				{
+					onJoin(&*beforeIt++, nullptr);
+				}
+				else if (beforeIt == before.end() || getPath(*afterIt) < getPath(*beforeIt))
+					onJoin(nullptr, &*afterIt++);
+				else
+					onJoin(&*beforeIt++, &*afterIt++);
+			}
+		}
+
+		//---------------------------------------------------------------------
+		void AddCount(CoverageDiffCount& total, const CoverageDiffCount& count)
+		{
+			total.lineCount += count.lineCount;
+			total.executedLineCount += count.executedLineCount;
+		}
+
+		//---------------------------------------------------------------------
+		CoverageDiffCount GetCount(const Plugin::FileCoverage* file)
+		{
+			CoverageDiffCount count;
+
+			if (file)
+			{
+				count.lineCount = file->GetLineCount();
+				count.executedLineCount = file->GetExecutedLineCount();
+			}
+			return count;
+		}
+
+		//---------------------------------------------------------------------
+		bool operator!=(const CoverageDiffCount& count1, const CoverageDiffCount& count2)
+		{
+			return count1.lineCount != count2.lineCount
+				|| count1.executedLineCount != count2.executedLineCount;
+		}
+
+		//---------------------------------------------------------------------
+		void DiffLines(
+			const Plugin::FileCoverage& before,
+			const Plugin::FileCoverage& after,
+			FileCoverageDiff& fileCoverageDiff)
+		{
+			auto beforeLines = before.GetLines();
+			auto afterLines = after.GetLines();
+			auto beforeIt = beforeLines.begin();
+
+			for (const auto& afterLine : afterLines)
+			{
+				auto lineNumber = afterLine.GetLineNumber();
+
+				while (beforeIt != beforeLines.end() && beforeIt->GetLineNumber() < lineNumber)
+					++beforeIt;
+				if (beforeIt == beforeLines.end() || beforeIt->GetLineNumber() != lineNumber)
+					continue;
+				if (!beforeIt->HasBeenExecuted() && afterLine.HasBeenExecuted())
+					fileCoverageDiff.newlyCoveredLines.push_back(lineNumber);
+				else if (beforeIt->HasBeenExecuted() && !afterLine.HasBeenExecuted())
+					fileCoverageDiff.newlyUncoveredLines.push_back(lineNumber);
+			}
+		}
+
+		//---------------------------------------------------------------------
+		std::vector<const Plugin::FileCoverage*> GetSortedFiles(
+			const Plugin::ModuleCoverage* module)
+		{
+			std::vector<const Plugin::FileCoverage*> files;
+
+			if (module)
+			{
+				for (const auto& file : module->GetFiles())
+					files.push_back(file.get());
+				SortByPath(files, [](const Plugin::FileCoverage* file) -> const auto& {
+					return file->GetPath();
+				});
+			}
+			return files;
+		}
+
+		//---------------------------------------------------------------------
+		void DiffModule(
+			const Plugin::ModuleCoverage* before,
+			const Plugin::ModuleCoverage* after,
+			CoverageDiffResult& result)
+		{
+			const auto& modulePath = before ? before->GetPath() : after->GetPath();
+			auto getPath = [](const Plugin::FileCoverage* file) -> const auto& {
+				return file->GetPath();
+			};
+
+			MergeJoin(GetSortedFiles(before), GetSortedFiles(after), getPath,
+				[&](const Plugin::FileCoverage* const* beforeFile,
+					const Plugin::FileCoverage* const* afterFile)
+			{
+				FileCoverageDiff fileCoverageDiff;
+
+				fileCoverageDiff.modulePath = modulePath;
+				fileCoverageDiff.path = getPath(beforeFile ? *beforeFile : *afterFile);
+				fileCoverageDiff.before = GetCount(beforeFile ? *beforeFile : nullptr);
+				fileCoverageDiff.after = GetCount(afterFile ? *afterFile : nullptr);
+				AddCount(result.before, fileCoverageDiff.before);
+				AddCount(result.after, fileCoverageDiff.after);
+
+				if (beforeFile && afterFile)
+					DiffLines(**beforeFile, **afterFile, fileCoverageDiff);
+				if (fileCoverageDiff.before != fileCoverageDiff.after
+					|| !fileCoverageDiff.newlyCoveredLines.empty()
+					|| !fileCoverageDiff.newlyUncoveredLines.empty())
+				{
+					result.files.push_back(std::move(fileCoverageDiff));
+				}
+			});
+		}
+
+		//---------------------------------------------------------------------
+		struct ModulePosition
+		{
+			std::filesystem::path path;
+			std::streamoff position;
+		};
+
+		//---------------------------------------------------------------------
+		std::vector<ModulePosition> GetSortedModulePositions(
+			const std::filesystem::path& coverageFile)
+		{
+			std::vector<ModulePosition> modulePositions;
+
+			CoverageDataDeserializer{}.ReadModulePaths(coverageFile,
+				"Cannot extract coverage data from " + coverageFile.string(),
+				[&](const std::filesystem::path& path, std::streamoff position)
+			{
+				modulePositions.push_back({ path, position });
+			});
+			SortByPath(modulePositions, [](const ModulePosition& modulePosition) -> const auto& {
+				return modulePosition.path;
+			});
+
+			return modulePositions;
+		}
+
+		//---------------------------------------------------------------------
+		double GetRate(const CoverageDiffCount& count)
+		{
+			if (count.lineCount == 0)
+				return 0;
+			return 100.0 * count.executedLineCount / count.lineCount;
+		}
+
+		//---------------------------------------------------------------------
+		template <typename Char>
+		std::basic_string<Char> FormatRate(double rate, bool showSign)
+		{
+			std::basic_ostringstream<Char> ostr;
+
+			if (showSign)
+				ostr << std::showpos;
+			ostr << std::fixed << std::setprecision(2) << rate;
+			return ostr.str();
+		}
+
+		//---------------------------------------------------------------------
+		template <typename Char>
+		void WriteCounts(
+			std::basic_ostream<Char>& ostr,
+			const CoverageDiffCount& before,
+			const CoverageDiffCount& after)
+		{
+			ostr << before.executedLineCount << '/' << before.lineCount
+				<< " (" << FormatRate<Char>(GetRate(before), false) << "%) -> "
+				<< after.executedLineCount << '/' << after.lineCount
+				<< " (" << FormatRate<Char>(GetRate(after), false) << "%), "
+				<< FormatRate<Char>(GetRate(after) - GetRate(before), true) << '%';
+		}
+
+		//---------------------------------------------------------------------
+		void WriteTextLines(
+			std::wostream& ostr,
+			const wchar_t* title,
+			const std::vector<unsigned int>& lines)
+		{
+			if (lines.empty())
+				return;
+
+			ostr << L"    " << title << L":";
+			for (auto line : lines)
+				ostr << L' ' << line;
+			ostr << std::endl;
+		}
+
+		//---------------------------------------------------------------------
+		std::string EscapeJson(const std::filesystem::path& path)
+		{
+			std::ostringstream ostr;
+
+			for (unsigned char c : Tools::ToUtf8String(path.wstring()))
+			{
+				if (c == '"' || c == '\\')
+					ostr << '\\' << c;
+				else if (c < 0x20)
+					ostr << "\\u" << std::hex << std::setw(4) << std::setfill('0') << int{ c };
+				else
+					ostr << c;
+			}
+			return ostr.str();
+		}
+
+		//---------------------------------------------------------------------
+		void WriteJsonCount(std::ostream& ostr, const CoverageDiffCount& count)
+		{
+			ostr << "{\"lineCount\":" << count.lineCount
+				<< ",\"executedLineCount\":" << count.executedLineCount
+				<< ",\"rate\":" << FormatRate<char>(GetRate(count), false) << '}';
+		}
+
+		//---------------------------------------------------------------------
+		void WriteJsonLines(std::ostream& ostr, const std::vector<unsigned int>& lines)
+		{
+			ostr << '[';
+			for (size_t i = 0; i < lines.size(); ++i)
+				ostr << (i ? "," : "") << lines[i];
+			ostr << ']';
+		}
+
+		//---------------------------------------------------------------------
+		std::string EscapeHtml(const std::filesystem::path& path)
+		{
+			std::string escaped;
+
+			for (auto c : Tools::ToUtf8String(path.wstring()))
+			{
+				switch (c)
+				{
+					case '&': escaped += "&amp;"; break;
+					case '<': escaped += "&lt;"; break;
+					case '>': escaped += "&gt;"; break;
+					case '"': escaped += "&quot;"; break;
+					default: escaped += c;
+				}
+			}
+			return escaped;
+		}
+
+		//---------------------------------------------------------------------
+		void WriteHtmlLines(std::ostream& ostr, const std::vector<unsigned int>& lines)
+		{
+			for (size_t i = 0; i < lines.size(); ++i)
+				ostr << (i ? ", " : "") << lines[i];
+		}
+
+		//---------------------------------------------------------------------
+		void WriteHtmlRow(
+			std::ostream& ostr,
+			const std::string& name,
+			const CoverageDiffCount& before,
+			const CoverageDiffCount& after,
+			const FileCoverageDiff* fileCoverageDiff)
+		{
+			auto delta = GetRate(after) - GetRate(before);
+
+			ostr << "<tr><td>" << name << "</td><td>";
+			WriteCounts(ostr, before, after);
+			ostr << "</td><td class=\"" << (delta < 0 ? "lost" : "gained") << "\">"
+				<< FormatRate<char>(delta, true) << "%</td><td class=\"gained\">";
+			if (fileCoverageDiff)
+				WriteHtmlLines(ostr, fileCoverageDiff->newlyCoveredLines);
+			ostr << "</td><td class=\"lost\">";
+			if (fileCoverageDiff)
+				WriteHtmlLines(ostr, fileCoverageDiff->newlyUncoveredLines);
+			ostr << "</td></tr>\n";
+		}
+	}
+
+	//-------------------------------------------------------------------------
+	CoverageDiffResult CoverageDiff::Compute(
+		const std::filesystem::path& beforeCoverageFile,
+		const std::filesystem::path& afterCoverageFile) const
+	{
+		CoverageDataDeserializer coverageDataDeserializer;
+		CoverageDiffResult result;
+		auto getPath = [](const ModulePosition& modulePosition) -> const auto& {
+			return modulePosition.path;
+		};
+
+		MergeJoin(
+			GetSortedModulePositions(beforeCoverageFile),
+			GetSortedModulePositions(afterCoverageFile),
+			getPath,
+			[&](const ModulePosition* beforePosition, const ModulePosition* afterPosition)
+		{
+			std::unique_ptr<Plugin::ModuleCoverage> before;
+			std::unique_ptr<Plugin::ModuleCoverage> after;
+
+			if (beforePosition)
+			{
+				before = coverageDataDeserializer.DeserializeModule(
+					beforeCoverageFile, beforePosition->position);
+			}
+			if (afterPosition)
+			{
+				after = coverageDataDeserializer.DeserializeModule(
+					afterCoverageFile, afterPosition->position);
+			}
+			DiffModule(before.get(), after.get(), result);
+		});
+
+		return result;
+	}
+
+	//-------------------------------------------------------------------------
+	CoverageDiffResult CoverageDiff::Compute(
+		const Plugin::CoverageData& before,
+		const Plugin::CoverageData& after) const
+	{
+		auto getSortedModules = [](const Plugin::CoverageData& coverageData)
+		{
+			std::vector<const Plugin::ModuleCoverage*> modules;
+
+			for (const auto& module : coverageData.GetModules())
+				modules.push_back(module.get());
+			SortByPath(modules, [](const Plugin::ModuleCoverage* module) -> const auto& {
+				return module->GetPath();
+			});
+			return modules;
+		};
+		CoverageDiffResult result;
+
+		MergeJoin(getSortedModules(before), getSortedModules(after),
+			[](const Plugin::ModuleCoverage* module) -> const auto& { return module->GetPath(); },
+			[&](const Plugin::ModuleCoverage* const* beforeModule,
+				const Plugin::ModuleCoverage* const* afterModule)
+		{
+			DiffModule(
+				beforeModule ? *beforeModule : nullptr,
+				afterModule ? *afterModule : nullptr,
+				result);
+		});
+
+		return result;
+	}
+
+	//-------------------------------------------------------------------------
+	void CoverageDiff::WriteText(const CoverageDiffResult& result, std::wostream& ostr) const
+	{
+		const std::filesystem::path* modulePath = nullptr;
+
+		ostr << L"Total: ";
+		WriteCounts(ostr, result.before, result.after);
+		ostr << std::endl;
+
+		for (const auto& file : result.files)
+		{
+			if (!modulePath || *modulePath != file.modulePath)
+			{
+				modulePath = &file.modulePath;
+				ostr << modulePath->wstring() << std::endl;
+			}
+			ostr << L"  " << file.path.wstring() << L": ";
+			WriteCounts(ostr, file.before, file.after);
+			ostr << std::endl;
+			WriteTextLines(ostr, L"Newly covered", file.newlyCoveredLines);
+			WriteTextLines(ostr, L"Newly uncovered", file.newlyUncoveredLines);
+		}
+	}
+
+	//-------------------------------------------------------------------------
+	void CoverageDiff::WriteJson(const CoverageDiffResult& result, std::ostream& ostr) const
+	{
+		ostr << "{\"before\":";
+		WriteJsonCount(ostr, result.before);
+		ostr << ",\"after\":";
+		WriteJsonCount(ostr, result.after);
+		ostr << ",\"files\":[";
+
+		for (size_t i = 0; i < result.files.size(); ++i)
+		{
+			const auto& file = result.files[i];
+
+			ostr << (i ? ",\n" : "\n")
+				<< "{\"module\":\"" << EscapeJson(file.modulePath)
+				<< "\",\"path\":\"" << EscapeJson(file.path) << "\",\"before\":";
+			WriteJsonCount(ostr, file.before);
+			ostr << ",\"after\":";
+			WriteJsonCount(ostr, file.after);
+			ostr << ",\"newlyCoveredLines\":";
+			WriteJsonLines(ostr, file.newlyCoveredLines);
+			ostr << ",\"newlyUncoveredLines\":";
+			WriteJsonLines(ostr, file.newlyUncoveredLines);
+			ostr << '}';
+		}
+		ostr << "]}\n";
+	}
+
+	//-------------------------------------------------------------------------
+	void CoverageDiff::WriteHtml(const CoverageDiffResult& result, std::ostream& ostr) const
+	{
+		ostr << "<!DOCTYPE html>\n<html>\n<head>\n<meta charset=\"utf-8\">\n"
+			"<title>Coverage difference</title>\n<style>\n"
+			"table { border-collapse: collapse; }\n"
+			"td, th { border: 1px solid #ccc; padding: 2px 6px; text-align: left; }\n"
+			".gained { color: #080; }\n.lost { color: #c00; }\n"
+			"</style>\n</head>\n<body>\n<h1>Coverage difference</h1>\n<table>\n"
+			"<tr><th>File</th><th>Executed lines</th><th>Delta</th>"
+			"<th>Newly covered</th><th>Newly uncovered</th></tr>\n";
+
+		WriteHtmlRow(ostr, "Total", result.before, result.after, nullptr);
+		for (const auto& file : result.files)
+		{
+			WriteHtmlRow(ostr, EscapeHtml(file.modulePath) + "<br>" + EscapeHtml(file.path),
+				file.before, file.after, &file);
+		}
+		ostr << "</table>\n</body>\n</html>\n";
+	}
+}
@@ -0,0 +1,92 @@
+// OpenCppCoverage is an open source code coverage for C++.
+// Copyright (C) 2019 OpenCppCoverage
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+#include "ExporterExport.hpp"
+
+namespace Plugin
+{
+	class CoverageData;
+}
+
+namespace Exporter
+{
+	//-------------------------------------------------------------------------
+	struct EXPORTER_DLL CoverageDiffCount
+	{
+		uint64_t lineCount = 0;
+		uint64_t executedLineCount = 0;
+	};
+
+	//-------------------------------------------------------------------------
+	struct EXPORTER_DLL FileCoverageDiff
+	{
+		std::filesystem::path modulePath;
+		std::filesystem::path path;
+		CoverageDiffCount before;
+		CoverageDiffCount after;
+
+		// Sorted lines that exist in both runs and whose executed state changed.
+		std::vector<unsigned int> newlyCoveredLines;
+		std::vector<unsigned int> newlyUncoveredLines;
+	};
+
+	//-------------------------------------------------------------------------
+	struct EXPORTER_DLL CoverageDiffResult
+	{
+		CoverageDiffCount before;
+		CoverageDiffCount after;
+
+		// Files with a different line count, executed line count or executed
+		// lines, sorted by module and file path.
+		std::vector<FileCoverageDiff> files;
+	};
+
+	//-------------------------------------------------------------------------
+	// Compare two coverages by joining their modules and files sorted by path.
+	// Only one module of each coverage is loaded at a time.
+	//-------------------------------------------------------------------------
+	class EXPORTER_DLL CoverageDiff
+	{
+	public:
+		CoverageDiff() = default;
+
+		CoverageDiffResult Compute(
+			const std::filesystem::path& beforeCoverageFile,
+			const std::filesystem::path& afterCoverageFile) const;
+		CoverageDiffResult Compute(
+			const Plugin::CoverageData& before,
+			const Plugin::CoverageData& after) const;
+
+		void WriteText(const CoverageDiffResult&, std::wostream&) const;
+
+		// Written in UTF-8.
+		void WriteJson(const CoverageDiffResult&, std::ostream&) const;
+		void WriteHtml(const CoverageDiffResult&, std::ostream&) const;
+
+	private:
+		CoverageDiff(const CoverageDiff&) = delete;
+		CoverageDiff& operator=(const CoverageDiff&) = delete;
+	};
+}
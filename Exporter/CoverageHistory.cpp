@@ -0,0 +1,443 @@
+// OpenCppCoverage is an open source code coverage for C++.
+// Copyright (C) 2019 OpenCppCoverage
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "stdafx.h"
+#include "CoverageHistory.hpp"
+
+#include <fstream>
+#include <boost/algorithm/string/predicate.hpp>
+#include <boost/optional.hpp>
+
+#include "Plugin/Exporter/CoverageData.hpp"
+#include "Plugin/Exporter/ModuleCoverage.hpp"
+#include "Plugin/Exporter/FileCoverage.hpp"
+#include "Plugin/Exporter/LineCoverage.hpp"
+
+#include "Tools/BinaryStream.hpp"
+
+#include "Binary/CoverageDataDeserializer.hpp"
+#include "Binary/CoverageDataSerializer.hpp"
+#include "ExporterException.hpp"
+
+namespace Exporter
+{
+	namespace
+	{
+		// Index: Magic, Version, {revision, baseIndex}*
+		// Delta: Magic, Version, name, exitCode, layoutHash, lineCount,
+		//        flippedLineCount, {gap to the previous flipped line}*
+		// Lines are numbered in module, file and line order.
+		const uint32_t IndexMagic = 0x48434F43; // OCCH
+		const uint32_t DeltaMagic = 0x44434F43; // OCCD
+		const uint32_t Version = 2;
+		const wchar_t* IndexFilename = L"History.idx";
+
+		// A revision becomes a new base when more than 1/MaxFlippedLineRatio
+		// of its lines differ from the base.
+		const size_t MaxFlippedLineRatio = 4;
+
+		//---------------------------------------------------------------------
+		void Hash(uint64_t& hash, const void* data, size_t size)
+		{
+			// FNV-1a
+			const auto* bytes = static_cast<const unsigned char*>(data);
+			for (size_t i = 0; i < size; ++i)
+			{
+				hash ^= bytes[i];
+				hash *= 1099511628211ull;
+			}
+		}
+
+		//---------------------------------------------------------------------
+		void Hash(uint64_t& hash, const std::filesystem::path& path)
+		{
+			const auto& str = path.native();
+			Hash(hash, str.data(), (str.size() + 1) * sizeof(str[0]));
+		}
+
+		//---------------------------------------------------------------------
+		struct Layout
+		{
+			uint64_t hash = 14695981039346656037ull;
+			std::vector<bool> executedLines;
+		};
+
+		//---------------------------------------------------------------------
+		Layout ComputeLayout(const Plugin::CoverageData& coverageData)
+		{
+			Layout layout;
+
+			for (const auto& module : coverageData.GetModules())
+			{
+				Hash(layout.hash, module->GetPath());
+				for (const auto& file : module->GetFiles())
+				{
+					Hash(layout.hash, file->GetPath());
+					for (const auto& line : file->GetLineRange())
+					{
+						auto lineNumber = line.GetLineNumber();
+						Hash(layout.hash, &lineNumber, sizeof(lineNumber));
+						layout.executedLines.push_back(line.HasBeenExecuted());
+					}
+				}
+			}
+			return layout;
+		}
+
+		//---------------------------------------------------------------------
+		struct Delta
+		{
+			std::wstring name;
+			int32_t exitCode = 0;
+			uint64_t layoutHash = 0;
+			uint64_t lineCount = 0;
+			std::vector<uint64_t> flippedLines;
+		};
+
+		//---------------------------------------------------------------------
+		void WriteDelta(const std::filesystem::path& path, const Delta& delta)
+		{
+			std::ofstream ofs{ path, std::ios::binary | std::ios::trunc };
+			Tools::BinaryWriter writer{ ofs };
+
+			writer.Write(DeltaMagic);
+			writer.Write(Version);
+			writer.WriteString(delta.name);
+			writer.Write(delta.exitCode);
+			writer.Write(delta.layoutHash);
+			writer.Write(delta.lineCount);
+			writer.Write<uint64_t>(delta.flippedLines.size());
+
+			uint64_t previous = 0;
+			for (auto flippedLine : delta.flippedLines)
+			{
+				writer.WriteVarint(flippedLine - previous);
+				previous = flippedLine;
+			}
+			if (!ofs.flush())
+				THROW(L"Cannot write coverage history file " << path.wstring());
+		}
+
+		//---------------------------------------------------------------------
+		Delta ReadDelta(const std::filesystem::path& path)
+		{
+			std::ifstream ifs{ path, std::ios::binary };
+			Tools::BinaryReader reader{ ifs };
+			Delta delta;
+			uint32_t magic = 0;
+			uint32_t version = 0;
+			uint64_t flippedLineCount = 0;
+
+			// A gap takes at least one byte: flippedLineCount is bounded by the file size.
+			if (!reader.Read(magic) || magic != DeltaMagic ||
+				!reader.Read(version) || version != Version ||
+				!reader.ReadString(delta.name) ||
+				!reader.Read(delta.exitCode) ||
+				!reader.Read(delta.layoutHash) ||
+				!reader.Read(delta.lineCount) ||
+				!reader.Read(flippedLineCount) ||
+				!reader.CanRead(flippedLineCount))
+			{
+				THROW(L"Invalid coverage history file " << path.wstring());
+			}
+
+			uint64_t flippedLine = 0;
+			delta.flippedLines.reserve(static_cast<size_t>(flippedLineCount));
+			for (uint64_t i = 0; i < flippedLineCount; ++i)
+			{
+				uint64_t gap;
+				if (!reader.ReadVarint(gap))
+					THROW(L"Invalid coverage history file " << path.wstring());
+				flippedLine += gap;
+				if (flippedLine >= delta.lineCount)
+					THROW(L"Invalid coverage history file " << path.wstring());
+				delta.flippedLines.push_back(flippedLine);
+			}
+			return delta;
+		}
+	}
+
+	//-------------------------------------------------------------------------
+	struct CoverageHistory::Revision
+	{
+		std::wstring name;
+		size_t index;
+		size_t baseIndex;
+
+		bool IsBase() const { return index == baseIndex; }
+	};
+
+	//-------------------------------------------------------------------------
+	struct CoverageHistory::Base
+	{
+		size_t index;
+		uint64_t layoutHash;
+		std::vector<bool> executedLines;
+	};
+
+	//-------------------------------------------------------------------------
+	CoverageHistory::CoverageHistory(const std::filesystem::path& folder)
+		: folder_{ folder }
+	{
+		std::filesystem::create_directories(folder_);
+		LoadIndex();
+	}
+
+	//-------------------------------------------------------------------------
+	CoverageHistory::~CoverageHistory() = default;
+
+	//-------------------------------------------------------------------------
+	void CoverageHistory::LoadIndex()
+	{
+		auto path = folder_ / IndexFilename;
+		if (!std::filesystem::exists(path))
+			return;
+
+		std::ifstream ifs{ path, std::ios::binary };
+		Tools::BinaryReader reader{ ifs };
+		uint32_t magic = 0;
+		uint32_t version = 0;
+
+		if (!reader.Read(magic) || magic != IndexMagic || !reader.Read(version))
+			THROW(L"Invalid coverage history index " << path.wstring());
+		if (version != Version)
+			THROW(L"Coverage history version " << version << L" is not supported.");
+
+		// A record truncated by a killed process is ignored.
+		Revision revision;
+		uint32_t baseIndex;
+		while (reader.ReadString(revision.name) && reader.Read(baseIndex))
+		{
+			revision.index = revisions_.size();
+			revision.baseIndex = baseIndex;
+			if (revision.baseIndex > revision.index)
+				THROW(L"Invalid coverage history index " << path.wstring());
+			revisions_.push_back(revision);
+		}
+	}
+
+	//-------------------------------------------------------------------------
+	void CoverageHistory::AppendToIndex(const Revision& revision)
+	{
+		auto path = folder_ / IndexFilename;
+		bool isNewIndex = !std::filesystem::exists(path);
+		std::ofstream ofs{ path, std::ios::binary | std::ios::app };
+		Tools::BinaryWriter writer{ ofs };
+
+		if (isNewIndex)
+		{
+			writer.Write(IndexMagic);
+			writer.Write(Version);
+		}
+		writer.WriteString(revision.name);
+		writer.Write<uint32_t>(static_cast<uint32_t>(revision.baseIndex));
+		if (!ofs.flush())
+			THROW(L"Cannot write coverage history index " << path.wstring());
+	}
+
+	//-------------------------------------------------------------------------
+	void CoverageHistory::Add(
+		const std::wstring& name,
+		const Plugin::CoverageData& coverageData)
+	{
+		for (const auto& revision : revisions_)
+		{
+			if (revision.name == name)
+				THROW(L"Revision " << name << L" already exists in the coverage history.");
+		}
+
+		auto layout = ComputeLayout(coverageData);
+		Revision revision{ name, revisions_.size(), revisions_.size() };
+
+		if (!lastBase_ && !revisions_.empty())
+		{
+			auto baseIndex = revisions_.back().baseIndex;
+			auto baseLayout = ComputeLayout(LoadBaseCoverageData(baseIndex));
+			lastBase_ = std::make_unique<Base>(
+				Base{ baseIndex, baseLayout.hash, std::move(baseLayout.executedLines) });
+		}
+
+		if (lastBase_ && lastBase_->layoutHash == layout.hash &&
+			lastBase_->executedLines.size() == layout.executedLines.size())
+		{
+			Delta delta{ coverageData.GetName(), coverageData.GetExitCode(),
+				layout.hash, layout.executedLines.size() };
+
+			for (size_t i = 0; i < layout.executedLines.size(); ++i)
+			{
+				if (layout.executedLines[i] != lastBase_->executedLines[i])
+					delta.flippedLines.push_back(i);
+			}
+			if (delta.flippedLines.size() * MaxFlippedLineRatio <= layout.executedLines.size())
+			{
+				revision.baseIndex = lastBase_->index;
+				WriteDelta(GetPath(revision), delta);
+			}
+		}
+		if (revision.IsBase())
+		{
+			CoverageDataSerializer{}.Serialize(coverageData, GetPath(revision));
+			lastBase_ = std::make_unique<Base>(
+				Base{ revision.index, layout.hash, std::move(layout.executedLines) });
+		}
+
+		AppendToIndex(revision);
+		revisions_.push_back(revision);
+	}
+
+	//-------------------------------------------------------------------------
+	std::vector<std::wstring> CoverageHistory::GetRevisions() const
+	{
+		std::vector<std::wstring> revisions;
+
+		for (const auto& revision : revisions_)
+			revisions.push_back(revision.name);
+		return revisions;
+	}
+
+	//-------------------------------------------------------------------------
+	Plugin::CoverageData CoverageHistory::Get(const std::wstring& name) const
+	{
+		const auto& revision = GetRevision(name);
+		auto coverageData = LoadBaseCoverageData(revision.baseIndex);
+
+		if (revision.IsBase())
+			return coverageData;
+
+		auto path = GetPath(revision);
+		auto delta = ReadDelta(path);
+		if (ComputeLayout(coverageData).hash != delta.layoutHash)
+			THROW(L"The base of " << path.wstring() << L" does not match.");
+
+		uint64_t lineIndex = 0;
+		auto flippedLine = delta.flippedLines.begin();
+		for (const auto& module : coverageData.GetModules())
+		{
+			for (const auto& file : module->GetFiles())
+			{
+				std::vector<std::pair<unsigned int, bool>> updatedLines;
+				for (const auto& line : file->GetLineRange())
+				{
+					if (flippedLine != delta.flippedLines.end() && *flippedLine == lineIndex)
+					{
+						updatedLines.emplace_back(line.GetLineNumber(), !line.HasBeenExecuted());
+						++flippedLine;
+					}
+					++lineIndex;
+				}
+				for (const auto& updatedLine : updatedLines)
+					file->UpdateLine(updatedLine.first, updatedLine.second);
+			}
+		}
+		coverageData.SetName(delta.name);
+		coverageData.SetExitCode(delta.exitCode);
+
+		return coverageData;
+	}
+
+	//-------------------------------------------------------------------------
+	std::vector<CoverageTrendPoint> CoverageHistory::GetTrend(
+		const std::wstring& pathPrefix) const
+	{
+		std::vector<CoverageTrendPoint> trend;
+		boost::optional<size_t> loadedBaseIndex;
+		std::vector<bool> selectedLines;
+		std::vector<bool> baseExecutedLines;
+		uint64_t baseLineCount = 0;
+		uint64_t baseExecutedLineCount = 0;
+
+		for (const auto& revision : revisions_)
+		{
+			if (loadedBaseIndex != revision.baseIndex)
+			{
+				auto coverageData = LoadBaseCoverageData(revision.baseIndex);
+
+				loadedBaseIndex = revision.baseIndex;
+				selectedLines.clear();
+				baseExecutedLines.clear();
+				baseLineCount = 0;
+				baseExecutedLineCount = 0;
+				for (const auto& module : coverageData.GetModules())
+				{
+					bool isModuleSelected = boost::algorithm::istarts_with(
+						module->GetPath().wstring(), pathPrefix);
+					for (const auto& file : module->GetFiles())
+					{
+						bool isSelected = isModuleSelected || boost::algorithm::istarts_with(
+							file->GetPath().wstring(), pathPrefix);
+						for (const auto& line : file->GetLineRange())
+						{
+							selectedLines.push_back(isSelected);
+							baseExecutedLines.push_back(line.HasBeenExecuted());
+							if (isSelected)
+							{
+								++baseLineCount;
+								if (line.HasBeenExecuted())
+									++baseExecutedLineCount;
+							}
+						}
+					}
+				}
+			}
+
+			CoverageTrendPoint point{ revision.name, baseLineCount, baseExecutedLineCount };
+			if (!revision.IsBase())
+			{
+				auto delta = ReadDelta(GetPath(revision));
+				if (delta.lineCount != selectedLines.size())
+					THROW(L"The base of " << GetPath(revision).wstring() << L" does not match.");
+				for (auto flippedLine : delta.flippedLines)
+				{
+					if (!selectedLines[flippedLine])
+						continue;
+					if (baseExecutedLines[flippedLine])
+						--point.executedLineCount;
+					else
+						++point.executedLineCount;
+				}
+			}
+			trend.push_back(point);
+		}
+		return trend;
+	}
+
+	//-------------------------------------------------------------------------
+	const CoverageHistory::Revision& CoverageHistory::GetRevision(const std::wstring& name) const
+	{
+		for (const auto& revision : revisions_)
+		{
+			if (revision.name == name)
+				return revision;
+		}
+		THROW(L"Revision " << name << L" is not in the coverage history.");
+	}
+
+	//-------------------------------------------------------------------------
+	std::filesystem::path CoverageHistory::GetPath(const Revision& revision) const
+	{
+		auto extension = revision.IsBase() ? L".cov" : L".delta";
+		return folder_ / (std::to_wstring(revision.index) + extension);
+	}
+
+	//-------------------------------------------------------------------------
+	Plugin::CoverageData CoverageHistory::LoadBaseCoverageData(size_t baseIndex) const
+	{
+		auto path = GetPath(revisions_.at(baseIndex));
+
+		return CoverageDataDeserializer{}.Deserialize(
+			path, "Invalid coverage history file " + path.string());
+	}
+}
@@ -0,0 +1,81 @@
+// OpenCppCoverage is an open source code coverage for C++.
+// Copyright (C) 2019 OpenCppCoverage
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "ExporterExport.hpp"
+
+namespace Plugin
+{
+	class CoverageData;
+}
+
+namespace Exporter
+{
+	//-------------------------------------------------------------------------
+	struct EXPORTER_DLL CoverageTrendPoint
+	{
+		std::wstring revision;
+		uint64_t lineCount;
+		uint64_t executedLineCount;
+	};
+
+	//-------------------------------------------------------------------------
+	// Store the coverage of consecutive revisions in a folder. A revision with
+	// the same modules, files and lines as the previous base is stored as the
+	// list of lines whose executed state differs from the base. Otherwise, it
+	// becomes a new base written with CoverageDataSerializer.
+	//-------------------------------------------------------------------------
+	class EXPORTER_DLL CoverageHistory
+	{
+	public:
+		// Create the folder if it does not exist.
+		explicit CoverageHistory(const std::filesystem::path& folder);
+		~CoverageHistory();
+
+		// Throw if revision already exists.
+		void Add(const std::wstring& revision, const Plugin::CoverageData&);
+
+		std::vector<std::wstring> GetRevisions() const;
+		Plugin::CoverageData Get(const std::wstring& revision) const;
+
+		// Lines of the modules or files whose path starts with pathPrefix
+		// (case insensitive) for each revision. Only bases are deserialized.
+		std::vector<CoverageTrendPoint> GetTrend(const std::wstring& pathPrefix) const;
+
+	private:
+		CoverageHistory(const CoverageHistory&) = delete;
+		CoverageHistory& operator=(const CoverageHistory&) = delete;
+
+		struct Revision;
+		struct Base;
+
+		void LoadIndex();
+		const Revision& GetRevision(const std::wstring&) const;
+		std::filesystem::path GetPath(const Revision&) const;
+		Plugin::CoverageData LoadBaseCoverageData(size_t baseIndex) const;
+		void AppendToIndex(const Revision&);
+
+		const std::filesystem::path folder_;
+		std::vector<Revision> revisions_;
+		std::unique_ptr<Base> lastBase_;
+	};
+}
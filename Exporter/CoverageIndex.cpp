@@ -0,0 +1,348 @@
+// OpenCppCoverage is an open source code coverage for C++.
+// Copyright (C) 2019 OpenCppCoverage
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "stdafx.h"
+#include "CoverageIndex.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <boost/algorithm/string/case_conv.hpp>
+
+#include "Plugin/Exporter/CoverageData.hpp"
+#include "Plugin/Exporter/ModuleCoverage.hpp"
+#include "Plugin/Exporter/FileCoverage.hpp"
+#include "Plugin/Exporter/LineCoverage.hpp"
+
+#include "Tools/BinaryStream.hpp"
+#include "Tools/Log.hpp"
+
+#include "Binary/CoverageDataDeserializer.hpp"
+#include "ExporterException.hpp"
+
+namespace Exporter
+{
+	namespace
+	{
+		// Magic, Version, coverage file size and last write time, fileCount,
+		// {path, firstLine, lineCount, executedLineCount, bitOffset, bitCount}*,
+		// wordCount, line bits, executed line bits.
+		const uint32_t Magic = 0x58434F43; // OCCX
+		const uint32_t Version = 2;
+		const size_t BitsPerWord = 64;
+
+		//---------------------------------------------------------------------
+		std::wstring Normalize(const std::filesystem::path& path)
+		{
+			auto normalizedPath = std::filesystem::path{ path }.make_preferred().wstring();
+
+			boost::algorithm::to_lower(normalizedPath);
+			return normalizedPath;
+		}
+
+		//---------------------------------------------------------------------
+		void SetBit(std::vector<uint64_t>& words, uint64_t bit)
+		{
+			words[static_cast<size_t>(bit / BitsPerWord)] |= uint64_t{ 1 } << (bit % BitsPerWord);
+		}
+
+		//---------------------------------------------------------------------
+		bool GetBit(const std::vector<uint64_t>& words, uint64_t bit)
+		{
+			return (words[static_cast<size_t>(bit / BitsPerWord)] >> (bit % BitsPerWord)) & 1;
+		}
+	}
+
+	//-------------------------------------------------------------------------
+	struct CoverageIndex::File
+	{
+		std::wstring path;
+		uint32_t firstLine;
+		uint32_t lineCount;
+		uint32_t executedLineCount;
+		uint64_t bitOffset;
+		uint32_t bitCount;
+	};
+
+	//-------------------------------------------------------------------------
+	struct CoverageIndex::Stamp
+	{
+		uint64_t size;
+		int64_t lastWriteTime;
+	};
+
+	//-------------------------------------------------------------------------
+	std::filesystem::path CoverageIndex::GetIndexPath(const std::filesystem::path& coverageFile)
+	{
+		auto indexPath = coverageFile;
+		return indexPath += L".idx";
+	}
+
+	//-------------------------------------------------------------------------
+	CoverageIndex::CoverageIndex(const std::filesystem::path& coverageFile)
+		: hasBeenBuilt_{ false }
+	{
+		std::error_code error;
+		auto size = std::filesystem::file_size(coverageFile, error);
+		auto lastWriteTime = std::filesystem::last_write_time(coverageFile, error);
+
+		if (error)
+			THROW(L"Cannot open file " << coverageFile.wstring());
+
+		Stamp stamp{ size, static_cast<int64_t>(lastWriteTime.time_since_epoch().count()) };
+		auto indexPath = GetIndexPath(coverageFile);
+
+		if (!Load(indexPath, stamp))
+		{
+			Build(coverageFile);
+			Save(indexPath, stamp);
+			hasBeenBuilt_ = true;
+		}
+		ComputeCumulativeCounts();
+	}
+
+	//-------------------------------------------------------------------------
+	CoverageIndex::~CoverageIndex() = default;
+
+	//-------------------------------------------------------------------------
+	bool CoverageIndex::HasBeenBuilt() const
+	{
+		return hasBeenBuilt_;
+	}
+
+	//-------------------------------------------------------------------------
+	boost::optional<bool> CoverageIndex::IsLineExecuted(
+		const std::filesystem::path& filename,
+		unsigned int line) const
+	{
+		auto path = Normalize(filename);
+		auto it = std::lower_bound(files_.begin(), files_.end(), path,
+			[](const File& file, const std::wstring& value) { return file.path < value; });
+
+		if (it == files_.end() || it->path != path ||
+			line < it->firstLine || line - it->firstLine >= it->bitCount)
+		{
+			return boost::none;
+		}
+
+		auto bit = it->bitOffset + (line - it->firstLine);
+		if (!GetBit(lineBits_, bit))
+			return boost::none;
+		return GetBit(executedLineBits_, bit);
+	}
+
+	//-------------------------------------------------------------------------
+	CoverageIndexCount CoverageIndex::GetCount(const std::wstring& pathPrefix) const
+	{
+		return GetNormalizedCount(Normalize(pathPrefix));
+	}
+
+	//-------------------------------------------------------------------------
+	CoverageIndexCount CoverageIndex::GetDirectoryCount(const std::filesystem::path& directory) const
+	{
+		auto prefix = Normalize(directory);
+
+		if (!prefix.empty() && prefix.back() != L'\\' && prefix.back() != L'/')
+			prefix += std::filesystem::path::preferred_separator;
+		return GetNormalizedCount(prefix);
+	}
+
+	//-------------------------------------------------------------------------
+	CoverageIndexCount CoverageIndex::GetNormalizedCount(const std::wstring& prefix) const
+	{
+		// Files are sorted by path so files with the same prefix are contiguous.
+		auto first = std::lower_bound(files_.begin(), files_.end(), prefix,
+			[](const File& file, const std::wstring& value) { return file.path < value; });
+		auto last = std::partition_point(first, files_.end(), [&](const File& file)
+		{
+			return file.path.compare(0, prefix.size(), prefix) == 0;
+		});
+		auto firstIndex = first - files_.begin();
+		auto lastIndex = last - files_.begin();
+		CoverageIndexCount count;
+
+		count.fileCount = lastIndex - firstIndex;
+		count.lineCount = cumulativeLineCounts_[lastIndex] - cumulativeLineCounts_[firstIndex];
+		count.executedLineCount = cumulativeExecutedLineCounts_[lastIndex]
+			- cumulativeExecutedLineCounts_[firstIndex];
+
+		return count;
+	}
+
+	//-------------------------------------------------------------------------
+	bool CoverageIndex::Load(const std::filesystem::path& indexPath, const Stamp& stamp)
+	{
+		std::ifstream ifs{ indexPath, std::ios::binary };
+		Tools::BinaryReader reader{ ifs };
+		uint32_t magic = 0;
+		uint32_t version = 0;
+		Stamp indexStamp{};
+		uint64_t fileCount = 0;
+		uint64_t wordCount = 0;
+
+		if (!reader.Read(magic) || magic != Magic ||
+			!reader.Read(version) || version != Version ||
+			!reader.Read(indexStamp.size) || indexStamp.size != stamp.size ||
+			!reader.Read(indexStamp.lastWriteTime) || indexStamp.lastWriteTime != stamp.lastWriteTime ||
+			!reader.Read(fileCount))
+		{
+			return false;
+		}
+
+		std::vector<File> files;
+		uint64_t bitCount = 0;
+		for (uint64_t i = 0; i < fileCount; ++i)
+		{
+			File file;
+			if (!reader.ReadString(file.path) ||
+				!reader.Read(file.firstLine) ||
+				!reader.Read(file.lineCount) ||
+				!reader.Read(file.executedLineCount) ||
+				!reader.Read(file.bitOffset) || file.bitOffset != bitCount ||
+				!reader.Read(file.bitCount))
+			{
+				return false;
+			}
+			bitCount += file.bitCount;
+			files.push_back(std::move(file));
+		}
+
+		std::vector<uint64_t> lineBits;
+		std::vector<uint64_t> executedLineBits;
+		if (!reader.Read(wordCount) ||
+			wordCount != (bitCount + BitsPerWord - 1) / BitsPerWord ||
+			!reader.ReadValues(lineBits, wordCount) ||
+			!reader.ReadValues(executedLineBits, wordCount))
+		{
+			return false;
+		}
+
+		files_ = std::move(files);
+		lineBits_ = std::move(lineBits);
+		executedLineBits_ = std::move(executedLineBits);
+		return true;
+	}
+
+	//-------------------------------------------------------------------------
+	void CoverageIndex::Build(const std::filesystem::path& coverageFile)
+	{
+		std::map<std::wstring, std::unique_ptr<Plugin::FileCoverage>> filesByPath;
+
+		// Modules are deserialized one at a time but their files are kept
+		// until the end because the same file can appear in several modules.
+		CoverageDataDeserializer{}.Deserialize(coverageFile,
+			"Cannot extract coverage data from " + coverageFile.string(),
+			[&](std::unique_ptr<Plugin::ModuleCoverage> module, std::streamoff)
+		{
+			for (auto& file : module->ReleaseFiles())
+			{
+				auto& mergedFile = filesByPath[Normalize(file->GetPath())];
+				if (mergedFile)
+					mergedFile->MergeLines(*file);
+				else
+					mergedFile = std::move(file);
+			}
+		});
+
+		files_.clear();
+		lineBits_.clear();
+		executedLineBits_.clear();
+
+		uint64_t bitOffset = 0;
+		for (const auto& [path, fileCoverage] : filesByPath)
+		{
+			auto lineRange = fileCoverage->GetLineRange();
+			File file{ path, 0, 0, 0, bitOffset, 0 };
+
+			if (!lineRange.empty())
+			{
+				file.firstLine = lineRange[0].GetLineNumber();
+				file.bitCount = lineRange[lineRange.size() - 1].GetLineNumber() - file.firstLine + 1;
+			}
+			file.lineCount = static_cast<uint32_t>(fileCoverage->GetLineCount());
+			file.executedLineCount = static_cast<uint32_t>(fileCoverage->GetExecutedLineCount());
+			bitOffset += file.bitCount;
+
+			auto wordCount = static_cast<size_t>((bitOffset + BitsPerWord - 1) / BitsPerWord);
+			lineBits_.resize(wordCount);
+			executedLineBits_.resize(wordCount);
+			for (const auto& line : lineRange)
+			{
+				auto bit = file.bitOffset + (line.GetLineNumber() - file.firstLine);
+				SetBit(lineBits_, bit);
+				if (line.HasBeenExecuted())
+					SetBit(executedLineBits_, bit);
+			}
+			files_.push_back(std::move(file));
+		}
+	}
+
+	//-------------------------------------------------------------------------
+	void CoverageIndex::Save(const std::filesystem::path& indexPath, const Stamp& stamp) const
+	{
+		// Written under another name first so a concurrent reader never sees
+		// a partial index.
+		auto temporaryPath = indexPath;
+		temporaryPath += L".tmp";
+		{
+			std::ofstream ofs{ temporaryPath, std::ios::binary | std::ios::trunc };
+			Tools::BinaryWriter writer{ ofs };
+
+			writer.Write(Magic);
+			writer.Write(Version);
+			writer.Write(stamp.size);
+			writer.Write(stamp.lastWriteTime);
+			writer.Write<uint64_t>(files_.size());
+			for (const auto& file : files_)
+			{
+				writer.WriteString(file.path);
+				writer.Write(file.firstLine);
+				writer.Write(file.lineCount);
+				writer.Write(file.executedLineCount);
+				writer.Write(file.bitOffset);
+				writer.Write(file.bitCount);
+			}
+			writer.Write<uint64_t>(lineBits_.size());
+			writer.WriteValues(lineBits_);
+			writer.WriteValues(executedLineBits_);
+
+			if (!ofs.flush())
+			{
+				LOG_WARNING << L"Cannot write coverage index " << indexPath.wstring();
+				return;
+			}
+		}
+
+		std::error_code error;
+		std::filesystem::rename(temporaryPath, indexPath, error);
+		if (error)
+			LOG_WARNING << L"Cannot write coverage index " << indexPath.wstring();
+	}
+
+	//-------------------------------------------------------------------------
+	void CoverageIndex::ComputeCumulativeCounts()
+	{
+		cumulativeLineCounts_.assign(1, 0);
+		cumulativeExecutedLineCounts_.assign(1, 0);
+		for (const auto& file : files_)
+		{
+			cumulativeLineCounts_.push_back(cumulativeLineCounts_.back() + file.lineCount);
+			cumulativeExecutedLineCounts_.push_back(
+				cumulativeExecutedLineCounts_.back() + file.executedLineCount);
+		}
+	}
+}
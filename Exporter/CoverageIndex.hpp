@@ -0,0 +1,89 @@
+// OpenCppCoverage is an open source code coverage for C++.
+// Copyright (C) 2019 OpenCppCoverage
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+#include <boost/optional/optional.hpp>
+
+#include "ExporterExport.hpp"
+
+namespace Exporter
+{
+	//-------------------------------------------------------------------------
+	struct EXPORTER_DLL CoverageIndexCount
+	{
+		uint64_t fileCount = 0;
+		uint64_t lineCount = 0;
+		uint64_t executedLineCount = 0;
+	};
+
+	//-------------------------------------------------------------------------
+	// Answer point and prefix queries on a binary coverage file without
+	// deserializing it. The index is written next to the coverage file and
+	// rebuilt when the coverage file size or last write time changes.
+	// The same source file in several modules is merged. Paths are compared
+	// case insensitively.
+	//-------------------------------------------------------------------------
+	class EXPORTER_DLL CoverageIndex
+	{
+	public:
+		static std::filesystem::path GetIndexPath(const std::filesystem::path& coverageFile);
+
+		// Load the index or build it if it is missing or out of date.
+		explicit CoverageIndex(const std::filesystem::path& coverageFile);
+		~CoverageIndex();
+
+		// True if the index was built instead of loaded.
+		bool HasBeenBuilt() const;
+
+		// boost::none when the line has no coverage information.
+		boost::optional<bool> IsLineExecuted(
+			const std::filesystem::path& filename,
+			unsigned int line) const;
+
+		// Lines of the files whose path starts with pathPrefix: "C:\Dir" also
+		// matches "C:\Directory\File.cpp".
+		CoverageIndexCount GetCount(const std::wstring& pathPrefix) const;
+
+		// Lines of the files in directory and its subdirectories.
+		CoverageIndexCount GetDirectoryCount(const std::filesystem::path& directory) const;
+
+	private:
+		CoverageIndex(const CoverageIndex&) = delete;
+		CoverageIndex& operator=(const CoverageIndex&) = delete;
+
+		struct File;
+		struct Stamp;
+
+		bool Load(const std::filesystem::path& indexPath, const Stamp&);
+		void Build(const std::filesystem::path& coverageFile);
+		void Save(const std::filesystem::path& indexPath, const Stamp&) const;
+		void ComputeCumulativeCounts();
+		CoverageIndexCount GetNormalizedCount(const std::wstring& prefix) const;
+
+		std::vector<File> files_;
+		std::vector<uint64_t> lineBits_;
+		std::vector<uint64_t> executedLineBits_;
+		std::vector<uint64_t> cumulativeLineCounts_;
+		std::vector<uint64_t> cumulativeExecutedLineCounts_;
+		bool hasBeenBuilt_;
+	};
+}
@@ -18,6 +18,7 @@
 #include "HtmlExporter.hpp"
 
 #include <boost/optional/optional.hpp>
+#include <algorithm>
 #include <sstream>
 #include <iomanip>
 #include "CTemplate.hpp"
@@ -25,15 +26,19 @@
 #include "Plugin/Exporter/CoverageData.hpp"
 #include "Plugin/Exporter/ModuleCoverage.hpp"
 #include "Plugin/Exporter/FileCoverage.hpp"
+#include "Plugin/Exporter/CoverageRollup.hpp"
 #include "CppCoverage/CoverageRateComputer.hpp"
 #include "CppCoverage/CoverageRate.hpp"
 
 #include "Tools/Log.hpp"
+#include "Tools/SourceRepository.hpp"
 #include "Tools/Tool.hpp"
 
 #include "TemplateHtmlExporter.hpp"
 #include "HtmlFileCoverageExporter.hpp"
 #include "HtmlFolderStructure.hpp"
+#include "../ExporterException.hpp"
+
 namespace cov = CppCoverage;
 
 namespace Exporter
@@ -50,8 +55,59 @@ namespace Exporter
 				return HtmlExporter::WarningExitCodeMessage + std::to_wstring(exitCode);
 			return L"";
 		}
+
+		//-------------------------------------------------------------------------
+		cov::CoverageRate GetCoverageRate(const Plugin::CoverageRollupNode& directory)
+		{
+			auto executedLines = static_cast<int>(directory.GetExecutedLineCount());
+			auto unexecutedLines = static_cast<int>(directory.GetLineCount()) - executedLines;
+
+			return cov::CoverageRate{ executedLines, unexecutedLines };
+		}
+
+		//-------------------------------------------------------------------------
+		template <typename T, typename GetCoverageRate>
+		std::vector<const T*> SortByCoverageRate(
+			std::vector<const T*> objects,
+			GetCoverageRate getCoverageRate)
+		{
+			std::stable_sort(objects.begin(), objects.end(),
+				[&](const T* object1, const T* object2)
+			{
+				return getCoverageRate(*object1).GetPercentRate()
+					< getCoverageRate(*object2).GetPercentRate();
+			});
+			return objects;
+		}
 	}
 	
+	//-------------------------------------------------------------------------
+	struct HtmlExporter::ModuleExport
+	{
+		ModuleExport(
+			const std::filesystem::path& templateFolder,
+			const Plugin::CoverageData& coverageData)
+			: htmlFolderStructure{ templateFolder }
+			, name{ coverageData.GetName() }
+			, mainMessage{ GetMainMessage(coverageData) }
+		{
+		}
+
+		struct Module
+		{
+			std::filesystem::path path;
+			cov::CoverageRate coverageRate;
+			boost::optional<std::filesystem::path> link;
+		};
+
+		HtmlFolderStructure htmlFolderStructure;
+		std::filesystem::path outputFolder;
+		std::wstring name;
+		std::wstring mainMessage;
+		cov::CoverageRate coverageRate;
+		std::vector<Module> modules;
+	};
+
 	//-------------------------------------------------------------------------
 	const std::wstring HtmlExporter::WarningExitCodeMessage = L"Warning: Your program has exited with error code: ";
 
@@ -63,6 +119,9 @@ namespace Exporter
 	{
 	}
 
+	//-------------------------------------------------------------------------
+	HtmlExporter::~HtmlExporter() = default;
+
 	//-------------------------------------------------------------------------
 	std::filesystem::path HtmlExporter::GetDefaultPath(const std::wstring&) const
 	{
@@ -101,14 +160,7 @@ namespace Exporter
 
 			if (moduleCoverageRate.GetTotalLinesCount())
 			{
-				const auto& modulePath = module->GetPath();
-				auto moduleFilename = module->GetPath().filename();
-				auto moduleTemplateDictionary = exporter_.CreateTemplateDictionary(moduleFilename.wstring(), L"");
-
-				auto htmlModulePath = htmlFolderStructure.CreateCurrentModule(modulePath);
-				ExportFiles(coverageRateComputer, *module, htmlFolderStructure, *moduleTemplateDictionary);
-
-				exporter_.GenerateModuleTemplate(*moduleTemplateDictionary, htmlModulePath.GetAbsolutePath());
+				auto htmlModulePath = GenerateModule(coverageRateComputer, *module, htmlFolderStructure);
 				exporter_.AddModuleSectionToDictionary(
 				    module->GetPath(),
 				    moduleCoverageRate,
@@ -122,6 +174,103 @@ namespace Exporter
 		Tools::ShowOutputMessage(L"Coverage generated in Folder ", outputFolder);
 	}	
 
+	//-------------------------------------------------------------------------
+	void HtmlExporter::BeginExport(
+		const Plugin::CoverageData& coverageData,
+		size_t,
+		const std::filesystem::path& outputFolderPrefix)
+	{
+		moduleExport_ = std::make_unique<ModuleExport>(templateFolder_, coverageData);
+		moduleExport_->outputFolder = 
+			moduleExport_->htmlFolderStructure.CreateCurrentRoot(outputFolderPrefix);
+	}
+
+	//-------------------------------------------------------------------------
+	void HtmlExporter::ExportModule(const Plugin::CoverageData& coverageData)
+	{
+		if (!moduleExport_)
+			THROW(L"BeginExport was not called.");
+
+		cov::CoverageRateComputer coverageRateComputer{ coverageData };
+		moduleExport_->coverageRate += coverageRateComputer.GetCoverageRate();
+
+		for (const auto& module : coverageData.GetModules())
+		{
+			const auto& moduleCoverageRate = coverageRateComputer.GetCoverageRate(*module);
+			ModuleExport::Module exportedModule{ module->GetPath(), moduleCoverageRate };
+
+			if (moduleCoverageRate.GetTotalLinesCount())
+			{
+				auto htmlModulePath = GenerateModule(
+					coverageRateComputer, *module, moduleExport_->htmlFolderStructure);
+				exportedModule.link = htmlModulePath.GetRelativeLinkPath();
+			}
+			moduleExport_->modules.push_back(std::move(exportedModule));
+		}
+	}
+
+	//-------------------------------------------------------------------------
+	void HtmlExporter::EndExport()
+	{
+		if (!moduleExport_)
+			THROW(L"BeginExport was not called.");
+		auto moduleExport = std::move(moduleExport_);
+
+		auto projectDictionary = exporter_.CreateTemplateDictionary(
+			moduleExport->name, moduleExport->mainMessage);
+
+		exporter_.AddModuleSectionToDictionary(
+			moduleExport->name,
+			moduleExport->coverageRate,
+			true,
+			nullptr,
+			*projectDictionary);
+
+		// Same order as CoverageRateComputer::SortModulesByCoverageRate.
+		std::vector<const ModuleExport::Module*> sortedModules;
+		for (const auto& module : moduleExport->modules)
+			sortedModules.push_back(&module);
+		std::sort(sortedModules.begin(), sortedModules.end(), 
+			[](const auto* module1, const auto* module2)
+		{
+			return module1->coverageRate.GetPercentRate() < module2->coverageRate.GetPercentRate();
+		});
+
+		for (const auto* module : sortedModules)
+		{
+			if (module->link)
+			{
+				exporter_.AddModuleSectionToDictionary(
+					module->path,
+					module->coverageRate,
+					false,
+					module->link.get_ptr(),
+					*projectDictionary);
+			}
+		}
+
+		const auto& outputFolder = moduleExport->outputFolder;
+		exporter_.GenerateProjectTemplate(*projectDictionary, outputFolder / L"index.html");
+		Tools::ShowOutputMessage(L"Coverage generated in Folder ", outputFolder);
+	}
+
+	//---------------------------------------------------------------------
+	HtmlFile HtmlExporter::GenerateModule(
+		cov::CoverageRateComputer& coverageRateComputer,
+		const Plugin::ModuleCoverage& module,
+		HtmlFolderStructure& htmlFolderStructure)
+	{
+		const auto& modulePath = module.GetPath();
+		auto moduleFilename = modulePath.filename();
+		auto moduleTemplateDictionary = exporter_.CreateTemplateDictionary(moduleFilename.wstring(), L"");
+
+		auto htmlModulePath = htmlFolderStructure.CreateCurrentModule(modulePath);
+		ExportFiles(coverageRateComputer, module, htmlFolderStructure, *moduleTemplateDictionary);
+
+		exporter_.GenerateModuleTemplate(*moduleTemplateDictionary, htmlModulePath.GetAbsolutePath());
+		return htmlModulePath;
+	}
+
 	//---------------------------------------------------------------------
 	void HtmlExporter::ExportFiles(
 		cov::CoverageRateComputer& coverageRateComputer,
@@ -136,7 +285,49 @@ namespace Exporter
 			nullptr, 
 			moduleTemplateDictionary);
 
-		for (const auto& file : coverageRateComputer.SortFilesByCoverageRate(module))
+		// Files are grouped by directory so a module with many files does not
+		// produce a single huge page.
+		Plugin::CoverageRollup coverageRollup{ module };
+		ExportDirectory(coverageRateComputer, coverageRollup.GetRoot(),
+			htmlFolderStructure, moduleTemplateDictionary);
+	}
+
+	//---------------------------------------------------------------------
+	void HtmlExporter::ExportDirectory(
+		cov::CoverageRateComputer& coverageRateComputer,
+		const Plugin::CoverageRollupNode& directory,
+		const HtmlFolderStructure& htmlFolderStructure,
+		ctemplate::TemplateDictionary& templateDictionary)
+	{
+		std::vector<const Plugin::CoverageRollupNode*> subDirectories;
+		for (const auto& subDirectory : directory.GetChildren())
+			subDirectories.push_back(subDirectory.get());
+
+		for (const auto* subDirectory : SortByCoverageRate(subDirectories,
+			[](const Plugin::CoverageRollupNode& node) { return GetCoverageRate(node); }))
+		{
+			const auto& directoryPath = subDirectory->GetPath();
+			auto directoryCoverageRate = GetCoverageRate(*subDirectory);
+			auto htmlDirectoryPath = htmlFolderStructure.GetHtmlDirectoryPath(directoryPath);
+			auto directoryTemplateDictionary = exporter_.CreateTemplateDictionary(directoryPath.wstring(), L"");
+
+			exporter_.AddFileSectionToDictionary(
+				directoryPath, directoryCoverageRate, true, nullptr, *directoryTemplateDictionary);
+			ExportDirectory(coverageRateComputer, *subDirectory,
+				htmlFolderStructure, *directoryTemplateDictionary);
+			exporter_.GenerateModuleTemplate(
+				*directoryTemplateDictionary, htmlDirectoryPath.GetAbsolutePath());
+
+			exporter_.AddFileSectionToDictionary(
+				directoryPath,
+				directoryCoverageRate,
+				false,
+				&htmlDirectoryPath.GetRelativeLinkPath(),
+				templateDictionary);
+		}
+
+		for (const auto* file : SortByCoverageRate(directory.GetFiles(),
+			[&](const Plugin::FileCoverage& file) { return coverageRateComputer.GetCoverageRate(file); }))
 		{
 			const auto& fileCoverageRate = coverageRateComputer.GetCoverageRate(*file);
 			boost::optional<fs::path> generatedOutput = ExportFile(htmlFolderStructure, *file);
@@ -145,7 +336,7 @@ namespace Exporter
 				fileCoverageRate, 
 				false,
 				generatedOutput.get_ptr(), 
-				moduleTemplateDictionary);
+				templateDictionary);
 		}
 	}
 
@@ -157,14 +348,15 @@ namespace Exporter
 		auto htmlFilePath = htmlFolderStructure.GetHtmlFilePath(fileCoverage.GetPath());
 		std::wostringstream ostr;
 		
-		if (!Tools::FileExists(fileCoverage.GetPath()))
+		auto sourceFile = Tools::SourceRepository::GetInstance().GetSourceFile(fileCoverage.GetPath());
+		if (!sourceFile)
 			return boost::optional<fs::path>();
 
-		auto enableCodePrettify = fileCoverageExporter_.Export(fileCoverage, ostr);
+		auto enableCodePrettify = fileCoverageExporter_.Export(fileCoverage, *sourceFile, ostr);
 
 		auto title = fileCoverage.GetPath().filename().wstring();
-		exporter_.GenerateSourceTemplate(
-			title, ostr.str(), enableCodePrettify, htmlFilePath.GetAbsolutePath());
+		exporter_.GenerateSourceTemplate(title, ostr.str(), enableCodePrettify,
+			fileCoverage.GetFunctions(), htmlFilePath.GetAbsolutePath());
 
 		return htmlFilePath.GetRelativeLinkPath();
 	}	
@@ -17,15 +17,19 @@
 #pragma once
 
 #include <filesystem>
+#include <memory>
 #include "../ExporterExport.hpp"
 
 #include "TemplateHtmlExporter.hpp"
 #include "HtmlFileCoverageExporter.hpp"
+#include "HtmlFile.hpp"
 #include "../IExporter.hpp"
+#include "../IModuleExporter.hpp"
 
 namespace Plugin
 {
 	class CoverageData;
+	class CoverageRollupNode;
 	class FileCoverage;
 	class ModuleCoverage;
 }
@@ -45,21 +49,37 @@ namespace Exporter
 {
 	class HtmlFolderStructure;
 
-	class EXPORTER_DLL HtmlExporter: public IExporter
+	class EXPORTER_DLL HtmlExporter: public IExporter, public IModuleExporter
 	{
 	public:
 		static const std::wstring WarningExitCodeMessage;
 
 	public:
 		explicit HtmlExporter(const std::filesystem::path& templateFolder);
+		~HtmlExporter();
 
 		std::filesystem::path GetDefaultPath(const std::wstring& prefix) const override;
 		void Export(const Plugin::CoverageData&, const std::filesystem::path& outputFolder) override;
 
+		// Module pages are created in path order instead of coverage rate
+		// order: only the page names of modules with the same file name can
+		// differ from Export.
+		void BeginExport(
+			const Plugin::CoverageData&,
+			size_t moduleCount,
+			const std::filesystem::path& outputFolder) override;
+		void ExportModule(const Plugin::CoverageData&) override;
+		void EndExport() override;
+
 	private:
 		HtmlExporter(const HtmlExporter&) = delete;
 		HtmlExporter& operator=(const HtmlExporter&) = delete;
 
+		HtmlFile GenerateModule(
+			CppCoverage::CoverageRateComputer&,
+			const Plugin::ModuleCoverage& module,
+			HtmlFolderStructure& htmlFolderStructure);
+
 		boost::optional<std::filesystem::path> ExportFile(
 			const HtmlFolderStructure& htmlFolderStructure,
 			const Plugin::FileCoverage& fileCoverage) const;
@@ -70,10 +90,19 @@ namespace Exporter
 			const HtmlFolderStructure& htmlFolderStructure,
 			ctemplate::TemplateDictionary& moduleTemplateDictionary);
 
+		void ExportDirectory(
+			CppCoverage::CoverageRateComputer&,
+			const Plugin::CoverageRollupNode& directory,
+			const HtmlFolderStructure& htmlFolderStructure,
+			ctemplate::TemplateDictionary& templateDictionary);
+
 	private:
 		TemplateHtmlExporter exporter_;
 		HtmlFileCoverageExporter fileCoverageExporter_;
 		std::filesystem::path templateFolder_;
+
+		struct ModuleExport;
+		std::unique_ptr<ModuleExport> moduleExport_;
 	};
 }
 
@@ -17,7 +17,6 @@
 #include "stdafx.h"
 #include "HtmlFileCoverageExporter.hpp"
 
-#include <fstream>
 #include <filesystem>
 #include <boost/spirit/include/classic.hpp>
 #include <boost/spirit/include/classic_tree_to_xml.hpp>
@@ -84,6 +83,18 @@ namespace Exporter
 			return !style.empty();
 		}
 
+		//---------------------------------------------------------------------
+		std::wstring ToWString(const std::string& line)
+		{
+			// Same conversion as std::wifstream with the default locale.
+			std::wstring wline;
+
+			wline.reserve(line.size());
+			for (unsigned char c : line)
+				wline.push_back(static_cast<wchar_t>(c));
+			return wline;
+		}
+
 		const std::wstring StyleBackgroundColor = L"<span style = \"background-color:#";
 	}
 
@@ -109,21 +120,29 @@ namespace Exporter
 		const Plugin::FileCoverage& fileCoverage,
 		std::wostream& output) const
 	{
-		auto filePath = fileCoverage.GetPath();
+		const auto& filePath = fileCoverage.GetPath();
+		auto sourceFile = Tools::SourceRepository::GetInstance().GetSourceFile(filePath);
 
-		std::wifstream ifs{filePath.string()};
-		if (!ifs)
+		if (!sourceFile)
 			THROW(L"Cannot open file : " + filePath.wstring());
 
-		std::wstring line;
+		return Export(fileCoverage, *sourceFile, output);
+	}
+
+	//-------------------------------------------------------------------------
+	bool HtmlFileCoverageExporter::Export(
+		const Plugin::FileCoverage& fileCoverage,
+		const Tools::SourceRepository::SourceFile& sourceFile,
+		std::wostream& output) const
+	{
 		const Plugin::LineCoverage* previousLineCoverage = nullptr;
 		int styleChangesCount = 0;
 		int lineCount = 0;
-		for (int i = 1; std::getline(ifs, line); ++i)
+		const auto& lines = sourceFile.GetLines();
+		for (int i = 1; i <= static_cast<int>(lines.size()); ++i)
 		{			
 			auto lineCoverage = fileCoverage[i];
-			
-			line = boost::spirit::classic::xml::encode(line);				
+			auto line = boost::spirit::classic::xml::encode(ToWString(lines[i - 1]));
 			if (AddLineCoverageColor(output, line, lineCoverage, previousLineCoverage))
 				++styleChangesCount;
 			++lineCount;
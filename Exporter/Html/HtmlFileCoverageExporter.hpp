@@ -18,6 +18,8 @@
 
 #include <iosfwd> 
 
+#include "Tools/SourceRepository.hpp"
+
 #include "../ExporterExport.hpp"
 
 namespace Plugin
@@ -43,6 +45,11 @@ namespace Exporter
 		bool Export(
 			const Plugin::FileCoverage&,
 			std::wostream& output) const;
+
+		bool Export(
+			const Plugin::FileCoverage&,
+			const Tools::SourceRepository::SourceFile&,
+			std::wostream& output) const;
 		
 		bool MustEnableCodePrettify(int lineCount, int styleChangedCount) const;
 
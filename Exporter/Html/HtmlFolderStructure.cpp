@@ -124,4 +124,22 @@ namespace Exporter
 
 		return HtmlFile{fileHtmlPath, modulePath.filename() / fileHtmlPath.filename()};
 	}	
+
+	//---------------------------------------------------------------------
+	HtmlFile HtmlFolderStructure::GetHtmlDirectoryPath(const std::filesystem::path& directoryPath) const
+	{
+		if (!optionalCurrentRoot_ || !optionalCurrentModule_)
+			THROW(L"No root module selected");
+
+		auto directoryName = directoryPath.filename().wstring();
+		if (directoryName.empty())
+			directoryName = L"root";
+
+		const auto& modulePath = optionalCurrentModule_->path_;
+		auto directoryFolder = modulePath.parent_path() / (modulePath.filename().wstring() + L'-' + directoryName);
+		auto uniqueDirectoryFolder = optionalCurrentRoot_->uniqueChildrenPath_.GetUniquePath(directoryFolder);
+		fs::path directoryHtmlPath = uniqueDirectoryFolder.wstring() + L".html";
+
+		return HtmlFile{ directoryHtmlPath, directoryHtmlPath.filename() };
+	}
 }
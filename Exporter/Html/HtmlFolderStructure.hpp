@@ -38,6 +38,10 @@ namespace Exporter
 		HtmlFile CreateCurrentModule(const std::filesystem::path&);		
 		HtmlFile GetHtmlFilePath(const std::filesystem::path& filePath) const;
 
+		// Page of a directory of the current module. It is next to the module
+		// page and its link is relative to the module page.
+		HtmlFile GetHtmlDirectoryPath(const std::filesystem::path& directoryPath) const;
+
 	private:
 		HtmlFolderStructure(const HtmlFolderStructure&) = delete;
 		HtmlFolderStructure& operator=(const HtmlFolderStructure&) = delete;
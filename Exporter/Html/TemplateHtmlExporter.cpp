@@ -26,6 +26,7 @@
 #include "Tools/Tool.hpp"
 
 #include "CppCoverage/CoverageRate.hpp"
+#include "Plugin/Exporter/FunctionCoverage.hpp"
 
 #include "../ExporterException.hpp"
 
@@ -110,6 +111,9 @@ namespace Exporter
 	const std::string TemplateHtmlExporter::OCCProjectLink = "OCC_PROJECT_LINK";
 	const std::string TemplateHtmlExporter::OCCVersion = "OCC_VERSION";
 	const std::string TemplateHtmlExporter::ActualProjectLink = "https://github.com/OpenCppCoverage/OpenCppCoverage/releases";
+	const std::string TemplateHtmlExporter::FunctionTableSection = "FUNCTION_TABLE";
+	const std::string TemplateHtmlExporter::FunctionSection = "FUNCTIONS";
+	const std::string TemplateHtmlExporter::LineNumberTemplate = "LINE_NUMBER";
 
 	//-------------------------------------------------------------------------
 	TemplateHtmlExporter::TemplateHtmlExporter(
@@ -188,6 +192,7 @@ namespace Exporter
 		const std::wstring& title,
 		const std::wstring& codeContent,
 		bool enableCodePrettify,
+		const std::vector<Plugin::FunctionCoverage>& functions,
 		const fs::path& output) const
 	{
 		auto titleStr = ToString(title);
@@ -207,6 +212,22 @@ namespace Exporter
 		dictionary.SetValue(SourceWarningMessageTemplate, warning);
 		dictionary.SetValue(OCCProjectLink, ActualProjectLink);
 		dictionary.SetValue(OCCVersion, OPENCPPCOVERAGE_VERSION);
+
+		if (!functions.empty())
+			dictionary.ShowSection(FunctionTableSection);
+		for (const auto& function : functions)
+		{
+			auto executedLineCount = static_cast<int>(function.GetExecutedLineCount());
+			auto lineCount = static_cast<int>(function.GetLineCount());
+			cov::CoverageRate coverageRate{ executedLineCount, lineCount - executedLineCount };
+			auto sectionDictionary = dictionary.AddSectionDictionary(FunctionSection);
+
+			sectionDictionary->SetValue(NameTemplate, ToString(function.GetName()));
+			sectionDictionary->SetIntValue(LineNumberTemplate, function.GetFirstLineNumber());
+			sectionDictionary->SetIntValue(ExecutedLineTemplate, executedLineCount);
+			sectionDictionary->SetIntValue(TotalLineTemplate, lineCount);
+			sectionDictionary->SetIntValue(CoverRateTemplate, coverageRate.GetPercentRate());
+		}
 		WriteTemplate(dictionary, fileTemplatePath_, output);
 	}
 	//-------------------------------------------------------------------------
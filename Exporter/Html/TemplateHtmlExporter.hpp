@@ -17,6 +17,7 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include <filesystem>
 
@@ -35,6 +36,11 @@ namespace ctemplate
 	class TemplateDictionary;
 }
 
+namespace Plugin
+{
+	class FunctionCoverage;
+}
+
 namespace fs = std::filesystem;
 
 namespace Exporter
@@ -67,6 +73,9 @@ namespace Exporter
 		static const std::string OCCProjectLink;
 		static const std::string OCCVersion;
 		static const std::string ActualProjectLink;
+		static const std::string FunctionTableSection;
+		static const std::string FunctionSection;
+		static const std::string LineNumberTemplate;
 
 	public:
 		explicit TemplateHtmlExporter(
@@ -102,6 +111,7 @@ namespace Exporter
 			const std::wstring& title, 
 			const std::wstring& codeContent,
 			bool enableCodePrettify,
+			const std::vector<Plugin::FunctionCoverage>& functions,
 			const fs::path& output) const;
 
 	private:
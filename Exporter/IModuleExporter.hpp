@@ -0,0 +1,55 @@
+// OpenCppCoverage is an open source code coverage for C++.
+// Copyright (C) 2019 OpenCppCoverage
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <string>
+#include <filesystem>
+
+#include "ExporterExport.hpp"
+
+namespace Plugin
+{
+	class CoverageData;
+}
+
+namespace Exporter
+{
+	// Export coverage data one module at a time. Modules are given sorted by
+	// path and the output is the same as IExporter::Export.
+	class EXPORTER_DLL IModuleExporter
+	{
+	public:
+		IModuleExporter() = default;
+		virtual ~IModuleExporter() = default;
+
+		virtual std::filesystem::path GetDefaultPath(const std::wstring& prefix) const = 0;
+
+		// coverageData has no module.
+		virtual void BeginExport(
+			const Plugin::CoverageData& coverageData,
+			size_t moduleCount,
+			const std::filesystem::path& output) = 0;
+
+		// coverageData has exactly one module and can be released after the call.
+		virtual void ExportModule(const Plugin::CoverageData& coverageData) = 0;
+		virtual void EndExport() = 0;
+
+	private:
+		IModuleExporter(const IModuleExporter&) = delete;
+		IModuleExporter& operator=(const IModuleExporter&) = delete;
+	};
+}
@@ -0,0 +1,199 @@
+// OpenCppCoverage is an open source code coverage for C++.
+// Copyright (C) 2019 OpenCppCoverage
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "stdafx.h"
+#include "LcovExporter.hpp"
+
+#include <fstream>
+#include <vector>
+
+#include "Plugin/Exporter/CoverageData.hpp"
+#include "Plugin/Exporter/ModuleCoverage.hpp"
+#include "Plugin/Exporter/FileCoverage.hpp"
+#include "Plugin/Exporter/LineCoverage.hpp"
+#include "Plugin/Exporter/FunctionCoverage.hpp"
+#include "InvalidOutputFileException.hpp"
+#include "ExporterException.hpp"
+
+#include "Tools/Tool.hpp"
+
+namespace fs = std::filesystem;
+
+namespace Exporter
+{
+	namespace
+	{
+		// Records are small, a large buffer avoids a write by record.
+		const size_t OutputBufferSize = 1024 * 1024;
+
+		//-------------------------------------------------------------------------
+		void WriteFunctions(std::ostream& ostr, const Plugin::FileCoverage& file)
+		{
+			auto functions = file.GetFunctions();
+			size_t executedFunctionCount = 0;
+
+			for (const auto& function : functions)
+			{
+				ostr << "FN:" << function.GetFirstLineNumber() << ','
+					<< Tools::ToUtf8String(function.GetName()) << '\n';
+			}
+			for (const auto& function : functions)
+			{
+				auto hasBeenExecuted = function.GetExecutedLineCount() != 0;
+
+				ostr << "FNDA:" << (hasBeenExecuted ? 1 : 0) << ','
+					<< Tools::ToUtf8String(function.GetName()) << '\n';
+				if (hasBeenExecuted)
+					++executedFunctionCount;
+			}
+			ostr << "FNF:" << functions.size() << '\n';
+			ostr << "FNH:" << executedFunctionCount << '\n';
+		}
+
+		//-------------------------------------------------------------------------
+		void WriteFile(std::ostream& ostr, const Plugin::FileCoverage& file)
+		{
+			size_t lineCount = 0;
+			size_t executedLineCount = 0;
+
+			ostr << "SF:" << file.GetUtf8Path() << '\n';
+			if (file.GetFunctionCount())
+				WriteFunctions(ostr, file);
+			for (const auto& line : file.GetLineRange())
+			{
+				auto hasBeenExecuted = line.HasBeenExecuted();
+
+				ostr << "DA:" << line.GetLineNumber() << ',' << (hasBeenExecuted ? 1 : 0) << '\n';
+				++lineCount;
+				if (hasBeenExecuted)
+					++executedLineCount;
+			}
+			ostr << "LF:" << lineCount << '\n';
+			ostr << "LH:" << executedLineCount << '\n';
+			ostr << "end_of_record\n";
+		}
+
+		//-------------------------------------------------------------------------
+		void WriteModules(std::ostream& ostr, const Plugin::CoverageData& coverageData)
+		{
+			for (const auto& module : coverageData.GetModules())
+			{
+				for (const auto& file : module->GetFiles())
+					WriteFile(ostr, *file);
+			}
+		}
+	}
+
+	//-------------------------------------------------------------------------
+	class LcovExporter::Output
+	{
+	public:
+		explicit Output(const fs::path& path)
+			: path_{ path }
+			, buffer_(OutputBufferSize)
+		{
+			Tools::CreateParentFolderIfNeeded(path);
+
+			// The buffer must be set before opening the file.
+			stream_.rdbuf()->pubsetbuf(buffer_.data(), buffer_.size());
+			stream_.open(path.string().c_str(), std::ios::binary);
+			if (!stream_)
+				throw InvalidOutputFileException(path, "lcov");
+		}
+
+		std::ostream& GetStream()
+		{
+			return stream_;
+		}
+
+		void Close()
+		{
+			stream_.close();
+			if (!stream_)
+				throw InvalidOutputFileException(path_, "lcov");
+			Tools::ShowOutputMessage(L"Lcov report generated: ", path_);
+		}
+
+	private:
+		fs::path path_;
+
+		// Declared before stream_ as it is used until stream_ is destroyed.
+		std::vector<char> buffer_;
+		std::ofstream stream_;
+	};
+
+	//-------------------------------------------------------------------------
+	LcovExporter::LcovExporter() = default;
+
+	//-------------------------------------------------------------------------
+	LcovExporter::~LcovExporter() = default;
+
+	//-------------------------------------------------------------------------
+	fs::path LcovExporter::GetDefaultPath(const std::wstring& prefix) const
+	{
+		fs::path path{ prefix };
+
+		path += ".info";
+
+		return path;
+	}
+
+	//-------------------------------------------------------------------------
+	void LcovExporter::Export(
+		const Plugin::CoverageData& coverageData,
+		const fs::path& output)
+	{
+		Output lcovOutput{ output };
+
+		Export(coverageData, lcovOutput.GetStream());
+		lcovOutput.Close();
+	}
+
+	//-------------------------------------------------------------------------
+	void LcovExporter::Export(
+		const Plugin::CoverageData& coverageData,
+		std::ostream& ostr) const
+	{
+		WriteModules(ostr, coverageData);
+	}
+
+	//-------------------------------------------------------------------------
+	void LcovExporter::BeginExport(
+		const Plugin::CoverageData&,
+		size_t,
+		const fs::path& output)
+	{
+		moduleExport_ = std::make_unique<Output>(output);
+	}
+
+	//-------------------------------------------------------------------------
+	void LcovExporter::ExportModule(const Plugin::CoverageData& coverageData)
+	{
+		if (!moduleExport_)
+			THROW(L"BeginExport was not called.");
+		WriteModules(moduleExport_->GetStream(), coverageData);
+	}
+
+	//-------------------------------------------------------------------------
+	void LcovExporter::EndExport()
+	{
+		if (!moduleExport_)
+			THROW(L"BeginExport was not called.");
+		auto moduleExport = std::move(moduleExport_);
+
+		moduleExport->Close();
+	}
+}
@@ -0,0 +1,60 @@
+// OpenCppCoverage is an open source code coverage for C++.
+// Copyright (C) 2019 OpenCppCoverage
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <iosfwd>
+#include <memory>
+#include <filesystem>
+
+#include "ExporterExport.hpp"
+#include "IExporter.hpp"
+#include "IModuleExporter.hpp"
+
+namespace Plugin
+{
+	class CoverageData;
+}
+
+namespace Exporter
+{
+	// Write a LCOV tracefile: a SF/FN/DA/LF/LH record by source file.
+	// Records are written directly to a buffered UTF-8 stream.
+	class EXPORTER_DLL LcovExporter: public IExporter, public IModuleExporter
+	{
+	public:
+		LcovExporter();
+		~LcovExporter();
+
+		std::filesystem::path GetDefaultPath(const std::wstring& prefix) const override;
+		void Export(const Plugin::CoverageData&, const std::filesystem::path& output) override;
+		void Export(const Plugin::CoverageData&, std::ostream&) const;
+
+		void BeginExport(
+			const Plugin::CoverageData&,
+			size_t moduleCount,
+			const std::filesystem::path& output) override;
+		void ExportModule(const Plugin::CoverageData&) override;
+		void EndExport() override;
+
+	private:
+		LcovExporter(const LcovExporter&) = delete;
+		LcovExporter& operator=(const LcovExporter&) = delete;
+
+		class Output;
+		std::unique_ptr<Output> moduleExport_;
+	};
+}
@@ -0,0 +1,230 @@
+// OpenCppCoverage is an open source code coverage for C++.
+// Copyright (C) 2019 OpenCppCoverage
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "stdafx.h"
+#include "ModuleExportPipeline.hpp"
+
+#include "Plugin/Exporter/CoverageData.hpp"
+#include "Plugin/Exporter/ModuleCoverage.hpp"
+#include "Plugin/Exporter/FileCoverage.hpp"
+
+#include "CppCoverage/CoverageDataMerger.hpp"
+
+#include "Binary/CoverageDataDeserializer.hpp"
+#include "Binary/CoverageDataSerializer.hpp"
+#include "ExporterException.hpp"
+#include "IModuleExporter.hpp"
+
+#include "Tools/Log.hpp"
+#include "Tools/Tool.hpp"
+
+namespace Exporter
+{
+	//-------------------------------------------------------------------------
+	ModuleExportPipeline::ModuleExportPipeline(bool aggregateByFile)
+		: aggregateByFile_{ aggregateByFile }
+		, exitCode_{ 0 }
+	{
+	}
+
+	//-------------------------------------------------------------------------
+	ModuleExportPipeline::~ModuleExportPipeline()
+	{
+		for (const auto& path : temporaryCoverageFiles_)
+		{
+			std::error_code error;
+			std::filesystem::remove(path, error);
+			if (error)
+				LOG_WARNING << L"Cannot remove " << path.wstring();
+		}
+	}
+
+	//-------------------------------------------------------------------------
+	void ModuleExportPipeline::AddCoverageFile(
+		const std::filesystem::path& path,
+		const std::string& errorIfNotCorrectFormat)
+	{
+		CoverageDataDeserializer coverageDataDeserializer;
+		auto coverageFileIndex = coverageFiles_.size();
+
+		coverageFiles_.push_back(path);
+		auto coverageData = coverageDataDeserializer.Deserialize(
+			path,
+			errorIfNotCorrectFormat,
+			[&](std::unique_ptr<Plugin::ModuleCoverage> module, std::streamoff position) {
+				AddModule(*module, ModuleSource{ coverageFileIndex, position });
+			});
+		AddCoverageDataHeader(coverageData);
+	}
+
+	//-------------------------------------------------------------------------
+	void ModuleExportPipeline::AddCoverageData(Plugin::CoverageData&& coverageData)
+	{
+		auto path = Tools::CreateTemporaryFile();
+
+		temporaryCoverageFiles_.push_back(path);
+		{
+			auto input = std::move(coverageData);
+			CoverageDataSerializer{}.Serialize(input, path);
+		}
+		AddCoverageFile(path, "Invalid temporary coverage file " + path.string());
+	}
+
+	//-------------------------------------------------------------------------
+	void ModuleExportPipeline::Export(const ModuleExporters& moduleExporters)
+	{
+		OpenCoverageFiles();
+
+		SharedFiles sharedFiles;
+		if (aggregateByFile_)
+			sharedFiles = MergeSharedFiles();
+
+		Plugin::CoverageData coverageData{ name_, exitCode_ };
+
+		for (const auto& moduleExporter : moduleExporters)
+		{
+			moduleExporter.first->BeginExport(
+				coverageData, modules_.size(), moduleExporter.second);
+		}
+
+		for (auto& modulesByPath : modules_)
+		{
+			LOG_DEBUG << L"Export module " << modulesByPath.first.wstring();
+			auto moduleCoverageData = MergeModule(std::move(modulesByPath.second));
+
+			for (const auto& module : moduleCoverageData.GetModules())
+			{
+				for (const auto& file : module->GetFiles())
+				{
+					auto it = sharedFiles.find(file->GetPath());
+					if (it != sharedFiles.end())
+						file->MergeLines(*it->second);
+				}
+			}
+
+			for (const auto& moduleExporter : moduleExporters)
+				moduleExporter.first->ExportModule(moduleCoverageData);
+		}
+		modules_.clear();
+		coverageFileStreams_.clear();
+
+		for (const auto& moduleExporter : moduleExporters)
+			moduleExporter.first->EndExport();
+	}
+
+	//-------------------------------------------------------------------------
+	void ModuleExportPipeline::AddCoverageDataHeader(const Plugin::CoverageData& coverageData)
+	{
+		name_ = coverageData.GetName();
+
+		auto exitCode = coverageData.GetExitCode();
+		if (exitCode)
+			exitCode_ = exitCode;
+	}
+
+	//-------------------------------------------------------------------------
+	void ModuleExportPipeline::AddModule(
+		const Plugin::ModuleCoverage& module,
+		ModuleSource&& moduleSource)
+	{
+		const auto& modulePath = module.GetPath();
+		modules_[modulePath].push_back(std::move(moduleSource));
+
+		if (aggregateByFile_)
+		{
+			for (const auto& file : module.GetFiles())
+			{
+				const auto& filePath = file->GetPath();
+				auto it = firstModuleByFile_.emplace(filePath, modulePath).first;
+
+				if (it->second != modulePath)
+				{
+					sharedFiles_.insert(filePath);
+					modulesWithSharedFiles_.insert(it->second);
+					modulesWithSharedFiles_.insert(modulePath);
+				}
+			}
+		}
+	}
+
+	//-------------------------------------------------------------------------
+	void ModuleExportPipeline::OpenCoverageFiles()
+	{
+		coverageFileStreams_.clear();
+		for (const auto& path : coverageFiles_)
+		{
+			coverageFileStreams_.emplace_back(path.string(), std::ios::binary);
+			if (!coverageFileStreams_.back())
+				THROW(L"Cannot open file " + path.wstring());
+		}
+	}
+
+	//-------------------------------------------------------------------------
+	std::unique_ptr<Plugin::ModuleCoverage> 
+	ModuleExportPipeline::LoadModule(const ModuleSource& moduleSource)
+	{
+		CoverageDataDeserializer coverageDataDeserializer;
+
+		return coverageDataDeserializer.DeserializeModule(
+			coverageFileStreams_.at(moduleSource.coverageFileIndex), moduleSource.position);
+	}
+
+	//-------------------------------------------------------------------------
+	ModuleExportPipeline::SharedFiles ModuleExportPipeline::MergeSharedFiles()
+	{
+		SharedFiles sharedFiles;
+
+		// Only the lines of the files shared by several modules are kept.
+		for (const auto& modulePath : modulesWithSharedFiles_)
+		{
+			for (const auto& moduleSource : modules_.at(modulePath))
+			{
+				auto module = LoadModule(moduleSource);
+
+				for (const auto& file : module->GetFiles())
+				{
+					const auto& filePath = file->GetPath();
+
+					if (sharedFiles_.count(filePath))
+					{
+						auto& sharedFile = sharedFiles[filePath];
+						if (!sharedFile)
+							sharedFile = std::make_unique<Plugin::FileCoverage>(filePath);
+						sharedFile->MergeLines(*file);
+					}
+				}
+			}
+		}
+
+		return sharedFiles;
+	}
+
+	//-------------------------------------------------------------------------
+	Plugin::CoverageData ModuleExportPipeline::MergeModule(ModuleSources&& moduleSources)
+	{
+		std::vector<Plugin::CoverageData> coverageDatas;
+
+		for (const auto& moduleSource : moduleSources)
+		{
+			coverageDatas.emplace_back(name_, exitCode_);
+			coverageDatas.back().AddModule(LoadModule(moduleSource));
+		}
+		moduleSources.clear();
+
+		CppCoverage::CoverageDataMerger coverageDataMerger;
+		return coverageDataMerger.Merge(std::move(coverageDatas));
+	}
+}
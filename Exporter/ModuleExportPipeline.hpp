@@ -0,0 +1,101 @@
+// OpenCppCoverage is an open source code coverage for C++.
+// Copyright (C) 2019 OpenCppCoverage
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ExporterExport.hpp"
+
+namespace Plugin
+{
+	class CoverageData;
+	class ModuleCoverage;
+	class FileCoverage;
+}
+
+namespace Exporter
+{
+	class IModuleExporter;
+
+	// Merge and export coverage data one module path at a time. Coverage 
+	// files are read twice: once to index module paths and once to export.
+	// Only the modules with the same path are in memory together during the
+	// merge and the export. This does not stream the coverage of a run: the
+	// runner still builds the whole CoverageData, which is written to a
+	// temporary coverage file by AddCoverageData before being exported.
+	class EXPORTER_DLL ModuleExportPipeline
+	{
+	public:
+		using ModuleExporters = std::vector<std::pair<IModuleExporter*, std::filesystem::path>>;
+
+		// aggregateByFile has the same meaning as CoverageDataMerger::MergeFileCoverage.
+		explicit ModuleExportPipeline(bool aggregateByFile);
+		~ModuleExportPipeline();
+
+		void AddCoverageFile(
+			const std::filesystem::path&,
+			const std::string& errorIfNotCorrectFormat);
+		// coverageData is written to a temporary coverage file removed by
+		// the destructor, so its modules are released before Export.
+		void AddCoverageData(Plugin::CoverageData&&);
+
+		// Export the same coverage data as CoverageDataMerger::Merge with the
+		// coverage data in the order they were added.
+		void Export(const ModuleExporters&);
+
+	private:
+		ModuleExportPipeline(const ModuleExportPipeline&) = delete;
+		ModuleExportPipeline& operator=(const ModuleExportPipeline&) = delete;
+
+		struct ModuleSource
+		{
+			size_t coverageFileIndex;
+			std::streamoff position;
+		};
+		using ModuleSources = std::vector<ModuleSource>;
+		using SharedFiles = std::map<std::filesystem::path, std::unique_ptr<Plugin::FileCoverage>>;
+
+		void AddCoverageDataHeader(const Plugin::CoverageData&);
+		void AddModule(const Plugin::ModuleCoverage&, ModuleSource&&);
+		void OpenCoverageFiles();
+		std::unique_ptr<Plugin::ModuleCoverage> LoadModule(const ModuleSource&);
+		SharedFiles MergeSharedFiles();
+		Plugin::CoverageData MergeModule(ModuleSources&&);
+
+		const bool aggregateByFile_;
+		std::wstring name_;
+		int exitCode_;
+		std::vector<std::filesystem::path> coverageFiles_;
+		std::vector<std::filesystem::path> temporaryCoverageFiles_;
+		std::map<std::filesystem::path, ModuleSources> modules_;
+
+		// Opened during Export and indexed like coverageFiles_.
+		std::vector<std::ifstream> coverageFileStreams_;
+
+		// Used only when aggregateByFile_ is true.
+		std::map<std::filesystem::path, std::filesystem::path> firstModuleByFile_;
+		std::set<std::filesystem::path> sharedFiles_;
+		std::set<std::filesystem::path> modulesWithSharedFiles_;
+	};
+}
@@ -0,0 +1,159 @@
+// OpenCppCoverage is an open source code coverage for C++.
+// Copyright (C) 2019 OpenCppCoverage
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "stdafx.h"
+#include "ExportPluginHost.hpp"
+
+#include <atomic>
+#include <chrono>
+
+#include <Windows.h>
+
+#include "ExportPluginRequest.hpp"
+#include "SharedMemory.hpp"
+#include "../ExporterException.hpp"
+
+#include "CppCoverage/ProgramOptions.hpp"
+
+#include "Tools/Log.hpp"
+#include "Tools/ScopedAction.hpp"
+#include "Tools/Tool.hpp"
+
+namespace Exporter
+{
+	namespace
+	{
+		//---------------------------------------------------------------------
+		DWORD RunHostProcess(const std::filesystem::path& hostExecutable,
+		                     const std::wstring& sharedMemoryName,
+		                     const std::filesystem::path& pluginPath,
+		                     std::optional<std::chrono::seconds> timeout)
+		{
+			std::wstring commandLine = L'"' + hostExecutable.wstring() + L"\" " +
+			                           L"--" +
+			                           Tools::LocalToWString(CppCoverage::ProgramOptions::ExportPluginHostOption) +
+			                           L' ' + sharedMemoryName;
+			STARTUPINFO startupInfo{};
+			PROCESS_INFORMATION processInformation{};
+
+			startupInfo.cb = sizeof(startupInfo);
+			if (!CreateProcess(hostExecutable.c_str(),
+			                   &commandLine[0],
+			                   nullptr,
+			                   nullptr,
+			                   FALSE,
+			                   0,
+			                   nullptr,
+			                   nullptr,
+			                   &startupInfo,
+			                   &processInformation))
+			{
+				THROW("Cannot start the export plugin host " << hostExecutable.wstring()
+				                                             << ": " << GetLastError());
+			}
+
+			Tools::ScopedAction closeHandles{[&]() {
+				CloseHandle(processInformation.hThread);
+				CloseHandle(processInformation.hProcess);
+			}};
+
+			auto timeoutMs = timeout
+			    ? static_cast<DWORD>(std::chrono::milliseconds{*timeout}.count())
+			    : INFINITE;
+			auto waitResult = WaitForSingleObject(processInformation.hProcess, timeoutMs);
+			if (waitResult == WAIT_TIMEOUT)
+			{
+				TerminateProcess(processInformation.hProcess, ERROR_TIMEOUT);
+				WaitForSingleObject(processInformation.hProcess, INFINITE);
+				throw std::runtime_error(
+				    "The export plugin " + pluginPath.string() + " did not finish after " +
+				    std::to_string(timeout->count()) + " seconds and was stopped.");
+			}
+			if (waitResult != WAIT_OBJECT_0)
+				THROW("Cannot wait for the export plugin host: " << GetLastError());
+
+			DWORD exitCode = 0;
+			if (!GetExitCodeProcess(processInformation.hProcess, &exitCode))
+				THROW("Cannot get the exit code of the export plugin host: " << GetLastError());
+			return exitCode;
+		}
+	}
+
+	//-------------------------------------------------------------------------
+	ExportPluginHost::ExportPluginHost(std::filesystem::path&& hostExecutable,
+	                                   std::optional<std::chrono::seconds> timeout)
+	    : hostExecutable_{std::move(hostExecutable)}, timeout_{timeout}
+	{
+	}
+
+	//-------------------------------------------------------------------------
+	void ExportPluginHost::Export(const std::filesystem::path& pluginPath,
+	                              const Plugin::CoverageData& coverageData,
+	                              const std::optional<std::wstring>& argument) const
+	{
+		static std::atomic<int> requestCount;
+
+		auto startTime = std::chrono::steady_clock::now();
+		ExportPluginRequestWriter requestWriter{pluginPath, argument, coverageData};
+		auto sharedMemoryName = L"Local\\OpenCppCoverage.ExportPlugin." +
+		                        std::to_wstring(GetCurrentProcessId()) + L'.' +
+		                        std::to_wstring(++requestCount);
+		auto sharedMemory =
+		    SharedMemory::Create(sharedMemoryName, requestWriter.GetSize());
+
+		requestWriter.Write(sharedMemory.GetData(), sharedMemory.GetSize());
+		auto writeTime = std::chrono::steady_clock::now();
+
+		auto exitCode =
+		    RunHostProcess(hostExecutable_, sharedMemoryName, pluginPath, timeout_);
+		auto endTime = std::chrono::steady_clock::now();
+
+		LOG_DEBUG << L"Export plugin host: " << requestWriter.GetSize()
+		          << L" bytes written in "
+		          << std::chrono::duration_cast<std::chrono::milliseconds>(
+		                 writeTime - startTime).count()
+		          << L"ms, host process ran in "
+		          << std::chrono::duration_cast<std::chrono::milliseconds>(
+		                 endTime - writeTime).count()
+		          << L"ms.";
+
+		if (exitCode)
+		{
+			throw std::runtime_error(
+			    "The export plugin host process failed with exit code " +
+			    std::to_string(exitCode) + '.');
+		}
+	}
+
+	//-------------------------------------------------------------------------
+	int ExportPluginHost::Run(
+	    const std::wstring& sharedMemoryName,
+	    const IPluginLoader<Plugin::IExportPlugin>& pluginLoader)
+	{
+		auto sharedMemory = SharedMemory::OpenReadOnly(sharedMemoryName);
+		ExportPluginRequestView request{sharedMemory.GetData(), sharedMemory.GetSize()};
+		auto output = request.Execute(pluginLoader);
+
+		if (output)
+		{
+			Tools::ShowOutputMessage(
+			    request.GetPluginPath().stem().wstring() +
+			        L" has generated the report at ",
+			    *output);
+		}
+		return 0;
+	}
+}
@@ -0,0 +1,62 @@
+// OpenCppCoverage is an open source code coverage for C++.
+// Copyright (C) 2019 OpenCppCoverage
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <chrono>
+#include <filesystem>
+#include <optional>
+#include <string>
+
+#include "../ExporterExport.hpp"
+
+namespace Plugin
+{
+	class CoverageData;
+	class IExportPlugin;
+}
+
+namespace Exporter
+{
+	template <typename T>
+	class IPluginLoader;
+
+	//-------------------------------------------------------------------------
+	// Run export plugins in a separate process so a slow or leaking plugin
+	// does not affect OpenCppCoverage. The coverage data is written once in
+	// a shared memory segment mapped read only by the host process.
+	// Export can be called by several threads at the same time.
+	//-------------------------------------------------------------------------
+	class EXPORTER_DLL ExportPluginHost
+	{
+	  public:
+		// The host process is terminated when it runs longer than timeout.
+		ExportPluginHost(std::filesystem::path&& hostExecutable,
+		                 std::optional<std::chrono::seconds> timeout);
+
+		void Export(const std::filesystem::path& pluginPath,
+		            const Plugin::CoverageData&,
+		            const std::optional<std::wstring>& argument) const;
+
+		// Entry point of the host process.
+		static int Run(const std::wstring& sharedMemoryName,
+		               const IPluginLoader<Plugin::IExportPlugin>&);
+
+	  private:
+		const std::filesystem::path hostExecutable_;
+		const std::optional<std::chrono::seconds> timeout_;
+	};
+}
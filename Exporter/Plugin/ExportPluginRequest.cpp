@@ -0,0 +1,181 @@
+// OpenCppCoverage is an open source code coverage for C++.
+// Copyright (C) 2019 OpenCppCoverage
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "stdafx.h"
+#include "ExportPluginRequest.hpp"
+
+#include <cstdint>
+#include <cstring>
+
+#include "ExporterPluginManager.hpp"
+#include "LoadedPlugin.hpp"
+#include "Plugin/Exporter/CoverageData.hpp"
+#include "Plugin/Exporter/IExportPlugin.hpp"
+#include "../ExporterException.hpp"
+
+namespace Exporter
+{
+	namespace
+	{
+		const std::uint32_t RequestMagic = 0x51504543; // "CEPQ"
+
+		//---------------------------------------------------------------------
+		struct RequestHeader
+		{
+			std::uint32_t magic;
+			std::uint32_t charSize;
+			std::uint64_t totalSize;
+			std::uint64_t pluginPathSize;
+			std::uint64_t argumentSize;
+			std::uint64_t hasArgument;
+			std::uint64_t coverageDataOffset;
+		};
+
+		//---------------------------------------------------------------------
+		size_t AlignUp(size_t size)
+		{
+			const size_t alignment = alignof(std::uint64_t);
+			return (size + alignment - 1) & ~(alignment - 1);
+		}
+
+		//---------------------------------------------------------------------
+		size_t GetCoverageDataOffset(const std::wstring& pluginPath,
+		                             const std::optional<std::wstring>& argument)
+		{
+			auto argumentSize = argument ? argument->size() : 0;
+			return AlignUp(sizeof(RequestHeader) +
+			               (pluginPath.size() + argumentSize) * sizeof(wchar_t));
+		}
+	}
+
+	//-------------------------------------------------------------------------
+	ExportPluginRequestWriter::ExportPluginRequestWriter(
+	    const std::filesystem::path& pluginPath,
+	    const std::optional<std::wstring>& argument,
+	    const Plugin::CoverageData& coverageData)
+	    : pluginPath_{pluginPath.wstring()},
+	      argument_{argument},
+	      coverageDataWriter_{coverageData},
+	      coverageDataOffset_{GetCoverageDataOffset(pluginPath_, argument_)}
+	{
+	}
+
+	//-------------------------------------------------------------------------
+	size_t ExportPluginRequestWriter::GetSize() const
+	{
+		return coverageDataOffset_ + coverageDataWriter_.GetSize();
+	}
+
+	//-------------------------------------------------------------------------
+	void ExportPluginRequestWriter::Write(void* buffer, size_t bufferSize) const
+	{
+		if (bufferSize < GetSize())
+			THROW("Buffer is too small for the export plugin request.");
+
+		auto data = static_cast<char*>(buffer);
+		RequestHeader header{};
+
+		header.magic = RequestMagic;
+		header.charSize = sizeof(wchar_t);
+		header.totalSize = GetSize();
+		header.pluginPathSize = pluginPath_.size();
+		header.argumentSize = argument_ ? argument_->size() : 0;
+		header.hasArgument = argument_ ? 1 : 0;
+		header.coverageDataOffset = coverageDataOffset_;
+		std::memcpy(data, &header, sizeof(header));
+
+		auto chars = reinterpret_cast<wchar_t*>(data + sizeof(header));
+		std::memcpy(chars, pluginPath_.data(), pluginPath_.size() * sizeof(wchar_t));
+		if (argument_)
+		{
+			std::memcpy(chars + pluginPath_.size(),
+			            argument_->data(),
+			            argument_->size() * sizeof(wchar_t));
+		}
+
+		coverageDataWriter_.Write(data + coverageDataOffset_,
+		                          bufferSize - coverageDataOffset_);
+	}
+
+	//-------------------------------------------------------------------------
+	ExportPluginRequestView::ExportPluginRequestView(const void* buffer,
+	                                                 size_t bufferSize)
+	{
+		auto data = static_cast<const char*>(buffer);
+
+		if (bufferSize < sizeof(RequestHeader))
+			THROW("Invalid export plugin request: buffer is too small.");
+
+		const auto& header = *static_cast<const RequestHeader*>(buffer);
+		if (header.magic != RequestMagic ||
+		    header.charSize != sizeof(wchar_t))
+			THROW("Invalid export plugin request: unknown format.");
+		if (header.totalSize > bufferSize ||
+		    header.coverageDataOffset < sizeof(RequestHeader) ||
+		    header.coverageDataOffset > header.totalSize)
+			THROW("Invalid export plugin request: size mismatch.");
+
+		// The strings are between the header and the coverage data:
+		// sizeof(RequestHeader) + (pluginPathSize + argumentSize) * sizeof(wchar_t)
+		// must not exceed coverageDataOffset. Sizes are compared in characters
+		// to avoid overflows.
+		auto maxChars = (header.coverageDataOffset - sizeof(RequestHeader)) /
+		                sizeof(wchar_t);
+		if (header.pluginPathSize > maxChars ||
+		    header.argumentSize > maxChars - header.pluginPathSize)
+			THROW("Invalid export plugin request: invalid strings.");
+
+		auto chars = reinterpret_cast<const wchar_t*>(data + sizeof(RequestHeader));
+		auto pluginPathSize = static_cast<size_t>(header.pluginPathSize);
+		pluginPath_ = std::wstring{chars, pluginPathSize};
+		if (header.hasArgument)
+		{
+			argument_ = std::wstring{chars + pluginPathSize,
+			                         static_cast<size_t>(header.argumentSize)};
+		}
+
+		auto coverageDataOffset = static_cast<size_t>(header.coverageDataOffset);
+		coverageData_ = data + coverageDataOffset;
+		coverageDataSize_ =
+		    static_cast<size_t>(header.totalSize) - coverageDataOffset;
+	}
+
+	//-------------------------------------------------------------------------
+	const std::filesystem::path& ExportPluginRequestView::GetPluginPath() const
+	{
+		return pluginPath_;
+	}
+
+	//-------------------------------------------------------------------------
+	std::optional<std::filesystem::path> ExportPluginRequestView::Execute(
+	    const IPluginLoader<Plugin::IExportPlugin>& pluginLoader) const
+	{
+		auto plugin = ExporterPluginManager::LoadPlugin(pluginLoader, pluginPath_);
+		FlatCoverageDataView coverageDataView{coverageData_, coverageDataSize_};
+		auto coverageData = coverageDataView.ToCoverageDataWithExternalLines();
+
+		return plugin->Get().Export(coverageData, argument_);
+	}
+
+	//-------------------------------------------------------------------------
+	std::optional<std::filesystem::path> ExecuteExportPluginRequest(
+	    const void* buffer,
+	    size_t bufferSize,
+	    const IPluginLoader<Plugin::IExportPlugin>& pluginLoader)
+	{
+		return ExportPluginRequestView{buffer, bufferSize}.Execute(pluginLoader);
+	}
+}
@@ -0,0 +1,86 @@
+// OpenCppCoverage is an open source code coverage for C++.
+// Copyright (C) 2019 OpenCppCoverage
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <filesystem>
+#include <optional>
+#include <string>
+
+#include "../ExporterExport.hpp"
+#include "FlatCoverageData.hpp"
+
+namespace Plugin
+{
+	class CoverageData;
+	class IExportPlugin;
+}
+
+namespace Exporter
+{
+	template <typename T>
+	class IPluginLoader;
+
+	//-------------------------------------------------------------------------
+	// Serialize an export request (plugin path, argument and coverage data)
+	// in a single block that the host process reads in place.
+	//-------------------------------------------------------------------------
+	class EXPORTER_DLL ExportPluginRequestWriter
+	{
+	  public:
+		ExportPluginRequestWriter(const std::filesystem::path& pluginPath,
+		                          const std::optional<std::wstring>& argument,
+		                          const Plugin::CoverageData&);
+
+		size_t GetSize() const;
+		void Write(void* buffer, size_t bufferSize) const;
+
+	  private:
+		const std::wstring pluginPath_;
+		const std::optional<std::wstring> argument_;
+		const FlatCoverageDataWriter coverageDataWriter_;
+		const size_t coverageDataOffset_;
+	};
+
+	//-------------------------------------------------------------------------
+	// Read an export request in place. The buffer must outlive the view.
+	//-------------------------------------------------------------------------
+	class EXPORTER_DLL ExportPluginRequestView
+	{
+	  public:
+		ExportPluginRequestView(const void* buffer, size_t bufferSize);
+
+		const std::filesystem::path& GetPluginPath() const;
+
+		// Load the plugin and call Export. The files of the coverage data
+		// reference the lines of the buffer instead of copying them.
+		std::optional<std::filesystem::path>
+		Execute(const IPluginLoader<Plugin::IExportPlugin>&) const;
+
+	  private:
+		std::filesystem::path pluginPath_;
+		std::optional<std::wstring> argument_;
+		const char* coverageData_;
+		size_t coverageDataSize_;
+	};
+
+	//-------------------------------------------------------------------------
+	// Load the plugin of the request and call Export on the coverage data.
+	EXPORTER_DLL std::optional<std::filesystem::path>
+	ExecuteExportPluginRequest(const void* buffer,
+	                           size_t bufferSize,
+	                           const IPluginLoader<Plugin::IExportPlugin>&);
+}
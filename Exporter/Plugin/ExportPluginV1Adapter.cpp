@@ -0,0 +1,61 @@
+// OpenCppCoverage is an open source code coverage for C++.
+// Copyright (C) 2019 OpenCppCoverage
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "stdafx.h"
+#include "ExportPluginV1Adapter.hpp"
+
+#include "../ExporterException.hpp"
+
+namespace Exporter
+{
+	//-------------------------------------------------------------------------
+	ExportPluginV1Adapter::ExportPluginV1Adapter(
+	    std::unique_ptr<Plugin::IExportPlugin> plugin)
+	    : plugin_{std::move(plugin)}
+	{
+		if (!plugin_)
+			THROW("Null plugin");
+	}
+
+	//-------------------------------------------------------------------------
+	std::optional<std::filesystem::path>
+	ExportPluginV1Adapter::Export(const Plugin::CoverageData& coverageData,
+	                              const std::optional<std::wstring>& argument)
+	{
+		// Version 2 only adds accessors to the coverage data so version 1
+		// plugins can read the same instance.
+		return plugin_->Export(coverageData, argument);
+	}
+
+	//-------------------------------------------------------------------------
+	void ExportPluginV1Adapter::CheckArgument(
+	    const std::optional<std::wstring>& argument)
+	{
+		plugin_->CheckArgument(argument);
+	}
+
+	//-------------------------------------------------------------------------
+	std::wstring ExportPluginV1Adapter::GetArgumentHelpDescription()
+	{
+		return plugin_->GetArgumentHelpDescription();
+	}
+
+	//-------------------------------------------------------------------------
+	int ExportPluginV1Adapter::GetExportPluginVersion() const
+	{
+		return Plugin::CurrentExportPluginVersion;
+	}
+}
@@ -0,0 +1,50 @@
+// OpenCppCoverage is an open source code coverage for C++.
+// Copyright (C) 2019 OpenCppCoverage
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <memory>
+
+#include "Plugin/Exporter/IExportPlugin.hpp"
+
+namespace Exporter
+{
+	//-------------------------------------------------------------------------
+	// Wrap a plugin built for IExportPlugin version 1 so the rest of
+	// OpenCppCoverage only deals with the current version.
+	//-------------------------------------------------------------------------
+	class ExportPluginV1Adapter : public Plugin::IExportPlugin
+	{
+	  public:
+		static const int SupportedVersion = 1;
+
+		explicit ExportPluginV1Adapter(std::unique_ptr<Plugin::IExportPlugin>);
+
+		ExportPluginV1Adapter(const ExportPluginV1Adapter&) = delete;
+		ExportPluginV1Adapter& operator=(const ExportPluginV1Adapter&) = delete;
+
+		std::optional<std::filesystem::path>
+		Export(const Plugin::CoverageData&,
+		       const std::optional<std::wstring>& argument) override;
+
+		void CheckArgument(const std::optional<std::wstring>& argument) override;
+		std::wstring GetArgumentHelpDescription() override;
+		int GetExportPluginVersion() const override;
+
+	  private:
+		const std::unique_ptr<Plugin::IExportPlugin> plugin_;
+	};
+}
@@ -17,14 +17,18 @@
 #include "stdafx.h"
 #include "ExporterPluginManager.hpp"
 
+#include <chrono>
 #include <optional>
 
 #include "Plugin/OptionsParserException.hpp"
 
 #include "IPluginLoader.hpp"
 #include "LoadedPlugin.hpp"
+#include "ExportPluginV1Adapter.hpp"
+#include "ExportPluginHost.hpp"
 #include "Plugin/Exporter/IExportPlugin.hpp"
 #include "../ExporterException.hpp"
+#include "Tools/Log.hpp"
 #include "Tools/Tool.hpp"
 
 namespace Exporter
@@ -66,8 +70,8 @@ namespace Exporter
 		}
 
 		//---------------------------------------------------------------------
-		void CheckVersion(const Plugin::IExportPlugin& exportPlugin,
-		                  const std::filesystem::path& pluginPath)
+		int CheckVersion(const Plugin::IExportPlugin& exportPlugin,
+		                 const std::filesystem::path& pluginPath)
 		{
 			const auto functionName = "GetExportPluginVersion";
 			auto pluginVersion = CallPluginfunction(
@@ -75,7 +79,8 @@ namespace Exporter
 			    functionName,
 			    pluginPath);
 			auto currentVersion = Plugin::CurrentExportPluginVersion;
-			if (pluginVersion != currentVersion)
+			if (pluginVersion != currentVersion &&
+			    pluginVersion != ExportPluginV1Adapter::SupportedVersion)
 			{
 				auto error =
 				    "IExportPlugin version missmatch: "
@@ -85,14 +90,68 @@ namespace Exporter
 				throw std::runtime_error(
 				    InvalidPluginError(functionName, error, pluginPath));
 			}
+			return pluginVersion;
 		}
 	}
 
+	//-------------------------------------------------------------------------
+	class LazyExportPlugin
+	{
+	  public:
+		//---------------------------------------------------------------------
+		LazyExportPlugin(
+		    std::shared_ptr<const IPluginLoader<Plugin::IExportPlugin>> pluginLoader,
+		    const std::filesystem::path& pluginPath)
+		    : pluginLoader_{std::move(pluginLoader)},
+		      pluginPath_{pluginPath},
+		      argumentHelpDescription_{
+		          pluginLoader_->TryReadArgumentHelpDescription(pluginPath)}
+		{
+			if (!argumentHelpDescription_)
+				Get();
+		}
+
+		//---------------------------------------------------------------------
+		Plugin::IExportPlugin& Get()
+		{
+			if (!plugin_)
+			{
+				LOG_DEBUG << L"Load export plugin " << pluginPath_.wstring();
+				plugin_ = ExporterPluginManager::LoadPlugin(*pluginLoader_, pluginPath_);
+			}
+			return plugin_->Get();
+		}
+
+		//---------------------------------------------------------------------
+		std::wstring GetArgumentHelpDescription()
+		{
+			if (argumentHelpDescription_)
+				return *argumentHelpDescription_;
+			return CallPluginfunction(
+			    [&]() { return Get().GetArgumentHelpDescription(); },
+			    "GetHelpDescription",
+			    pluginPath_);
+		}
+
+		//---------------------------------------------------------------------
+		const std::filesystem::path& GetPath() const
+		{
+			return pluginPath_;
+		}
+
+	  private:
+		const std::shared_ptr<const IPluginLoader<Plugin::IExportPlugin>> pluginLoader_;
+		const std::filesystem::path pluginPath_;
+		const std::optional<std::wstring> argumentHelpDescription_;
+		std::unique_ptr<LoadedPlugin<Plugin::IExportPlugin>> plugin_;
+	};
+
 	//-------------------------------------------------------------------------
 	ExporterPluginManager::ExporterPluginManager(
-	    const IPluginLoader<Plugin::IExportPlugin>& pluginLoader,
+	    std::shared_ptr<const IPluginLoader<Plugin::IExportPlugin>> pluginLoader,
 	    std::filesystem::path&& pluginFolder)
-	    : pluginFolder_{std::move(pluginFolder)}
+	    : pluginLoader_{std::move(pluginLoader)},
+	      pluginFolder_{std::move(pluginFolder)}
 	{
 		for (auto pluginPath :
 		     std::filesystem::directory_iterator(pluginFolder_))
@@ -103,19 +162,34 @@ namespace Exporter
 				continue;
 
 			auto pluginName = path.stem().wstring();
-			const std::string pluginFactoryFctName = "CreatePlugin";
+			plugins_.emplace(
+			    pluginName, std::make_shared<LazyExportPlugin>(pluginLoader_, path));
+		}
+	}
 
-			auto plugin = Tools::Try<std::runtime_error>(
-			    [&]() {
-				    return pluginLoader.TryLoadPlugin(pluginPath,
-				                                      pluginFactoryFctName);
-			    },
-			    [&](const auto& error) {
-				    return InvalidPluginError(std::nullopt, error, path);
-			    });
-			CheckVersion(plugin->Get(), path);
-			plugins_.emplace(pluginName, std::move(plugin));
+	//-------------------------------------------------------------------------
+	std::unique_ptr<LoadedPlugin<Plugin::IExportPlugin>>
+	ExporterPluginManager::LoadPlugin(
+	    const IPluginLoader<Plugin::IExportPlugin>& pluginLoader,
+	    const std::filesystem::path& pluginPath)
+	{
+		const std::string pluginFactoryFctName = "CreatePlugin";
+
+		auto plugin = Tools::Try<std::runtime_error>(
+		    [&]() {
+			    return pluginLoader.TryLoadPlugin(pluginPath,
+			                                      pluginFactoryFctName);
+		    },
+		    [&](const auto& error) {
+			    return InvalidPluginError(std::nullopt, error, pluginPath);
+		    });
+		auto pluginVersion = CheckVersion(plugin->Get(), pluginPath);
+		if (pluginVersion == ExportPluginV1Adapter::SupportedVersion)
+		{
+			plugin->Set(std::make_unique<ExportPluginV1Adapter>(
+			    plugin->Release()));
 		}
+		return plugin;
 	}
 
 	//-------------------------------------------------------------------------
@@ -123,18 +197,19 @@ namespace Exporter
 
 	//-------------------------------------------------------------------------
 	void
-	CheckArgument(const std::weak_ptr<LoadedPlugin<Plugin::IExportPlugin>>& weakPlugin,
-	              const std::filesystem::path& pluginPath,
+	CheckArgument(const std::weak_ptr<LazyExportPlugin>& weakPlugin,
 	              const std::optional<std::wstring>& parameter)
 	{
 		auto p = weakPlugin.lock();
 		if (!p)
 			THROW("Plugin was released");
 
+		const auto& pluginPath = p->GetPath();
+		auto& exportPlugin = p->Get();
 		std::string error;
 		try
 		{
-			p->Get().CheckArgument(parameter);
+			exportPlugin.CheckArgument(parameter);
 			return;
 		}
 		catch (const Plugin::OptionsParserException&)
@@ -165,22 +240,16 @@ namespace Exporter
 		{
 			const auto& pluginName = plugin.first;
 			const auto& exportPlugin = plugin.second;
-			const auto pluginPath = pluginFolder_ / (pluginName + L".dll");
-
-			auto helpDescription = CallPluginfunction(
-			    [&]() { return exportPlugin->Get().GetArgumentHelpDescription(); },
-			    "GetHelpDescription",
-			    pluginPath);
 
-			std::weak_ptr<LoadedPlugin<Plugin::IExportPlugin>> weakPlugin{exportPlugin};
+			auto helpDescription = exportPlugin->GetArgumentHelpDescription();
+			std::weak_ptr<LazyExportPlugin> weakPlugin{exportPlugin};
 
 			exportPluginDescriptions.push_back(
 			    CppCoverage::ExportPluginDescription{
 			        std::wstring{pluginName},
 			        std::move(helpDescription),
-			        [weakPlugin, pluginPath, this](
-			            const std::optional<std::wstring>& parameter) {
-					CheckArgument(weakPlugin, pluginPath, parameter);
+			        [weakPlugin](const std::optional<std::wstring>& parameter) {
+					CheckArgument(weakPlugin, parameter);
 				}});
 		}
 
@@ -197,15 +266,55 @@ namespace Exporter
 		if (it == plugins_.end())
 			THROW("Cannot find plugin: " << pluginName);
 		auto& plugin = it->second;
+		const auto& pluginPath = plugin->GetPath();
+		auto startTime = std::chrono::steady_clock::now();
 
-		auto optionalOutput = CallPluginfunction(
-		    [&]() { return plugin->Get().Export(coverageData, argument); },
-		    "Export",
-		    pluginFolder_ / pluginName);
-		if (optionalOutput)
+		if (exportPluginHost_)
 		{
-			Tools::ShowOutputMessage(
-			    pluginName + L" has generated the report at ", *optionalOutput);
+			CallPluginfunction(
+			    [&]() {
+				    exportPluginHost_->Export(pluginPath, coverageData, argument);
+			    },
+			    "Export",
+			    pluginPath);
 		}
+		else
+		{
+			auto optionalOutput = CallPluginfunction(
+			    [&]() { return plugin->Get().Export(coverageData, argument); },
+			    "Export",
+			    pluginPath);
+			if (optionalOutput)
+			{
+				Tools::ShowOutputMessage(
+				    pluginName + L" has generated the report at ", *optionalOutput);
+			}
+		}
+
+		LOG_DEBUG << pluginName << L" export took "
+		          << std::chrono::duration_cast<std::chrono::milliseconds>(
+		                 std::chrono::steady_clock::now() - startTime).count()
+		          << (exportPluginHost_ ? L"ms (out of process)." : L"ms.");
+	}
+
+	//-------------------------------------------------------------------------
+	void ExporterPluginManager::EnableOutOfProcessExport(
+	    std::filesystem::path&& hostExecutable,
+	    std::optional<std::chrono::seconds> timeout)
+	{
+		exportPluginHost_ =
+		    std::make_unique<ExportPluginHost>(std::move(hostExecutable), timeout);
+	}
+
+	//-------------------------------------------------------------------------
+	bool ExporterPluginManager::IsOutOfProcessExportEnabled() const
+	{
+		return exportPluginHost_ != nullptr;
+	}
+
+	//-------------------------------------------------------------------------
+	void ExporterPluginManager::DisableOutOfProcessExport()
+	{
+		exportPluginHost_.reset();
 	}
 }
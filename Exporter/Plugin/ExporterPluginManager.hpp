@@ -21,6 +21,7 @@
 #include <vector>
 #include <string>
 #include <filesystem>
+#include <chrono>
 #include <unordered_map>
 #include <optional>
 
@@ -40,11 +41,17 @@ namespace Exporter
 	template <typename T>
 	class LoadedPlugin;
 
+	class ExportPluginHost;
+	class LazyExportPlugin;
+
 	class EXPORTER_DLL ExporterPluginManager
 	{
 	  public:
-		explicit ExporterPluginManager(const IPluginLoader<Plugin::IExportPlugin>&,
-		                               std::filesystem::path&& pluginFolder);
+		// A plugin is loaded only when it is used, unless pluginLoader cannot
+		// read its argument help description from the plugin metadata.
+		explicit ExporterPluginManager(
+		    std::shared_ptr<const IPluginLoader<Plugin::IExportPlugin>> pluginLoader,
+		    std::filesystem::path&& pluginFolder);
 		~ExporterPluginManager();
 
 		ExporterPluginManager(const ExporterPluginManager&) = delete;
@@ -53,17 +60,29 @@ namespace Exporter
 		ExporterPluginManager& operator=(const ExporterPluginManager&) = delete;
 		ExporterPluginManager& operator=(ExporterPluginManager&&) = delete;
 
+		// Load the plugin and check its version.
+		static std::unique_ptr<LoadedPlugin<Plugin::IExportPlugin>>
+		LoadPlugin(const IPluginLoader<Plugin::IExportPlugin>&,
+		           const std::filesystem::path& pluginPath);
+
 		std::vector<CppCoverage::ExportPluginDescription>
 		CreateExportPluginDescriptions() const;
 
+		// Run Export in hostExecutable instead of the current process. Export
+		// can then be called by several threads at the same time.
+		void EnableOutOfProcessExport(std::filesystem::path&& hostExecutable,
+		                              std::optional<std::chrono::seconds> timeout);
+		bool IsOutOfProcessExportEnabled() const;
+		void DisableOutOfProcessExport();
+
 		void Export(const std::wstring& pluginName,
 		            const Plugin::CoverageData&,
 		            const std::optional<std::wstring>& argument) const;
 
 	  private:
-		std::unordered_map<std::wstring,
-		                   std::shared_ptr<LoadedPlugin<Plugin::IExportPlugin>>>
-		    plugins_;
+		std::shared_ptr<const IPluginLoader<Plugin::IExportPlugin>> pluginLoader_;
+		std::unordered_map<std::wstring, std::shared_ptr<LazyExportPlugin>> plugins_;
 		std::filesystem::path pluginFolder_;
+		std::unique_ptr<ExportPluginHost> exportPluginHost_;
 	};
 }
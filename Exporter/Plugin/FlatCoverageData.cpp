@@ -0,0 +1,397 @@
+// OpenCppCoverage is an open source code coverage for C++.
+// Copyright (C) 2019 OpenCppCoverage
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "stdafx.h"
+#include "FlatCoverageData.hpp"
+
+#include <cstring>
+#include <type_traits>
+
+#include "Plugin/Exporter/CoverageArena.hpp"
+#include "Plugin/Exporter/CoverageData.hpp"
+#include "Plugin/Exporter/ModuleCoverage.hpp"
+#include "Plugin/Exporter/FileCoverage.hpp"
+#include "Plugin/Exporter/LineCoverage.hpp"
+
+#include "../ExporterException.hpp"
+
+namespace Exporter
+{
+	namespace
+	{
+		static_assert(std::is_trivially_copyable_v<Plugin::LineCoverage>,
+		              "Lines are copied as raw memory.");
+
+		const std::uint32_t FlatMagic = 0x56434f43; // "COCV"
+		const std::uint32_t FlatVersion = 2;
+		const size_t Alignment = alignof(std::uint64_t);
+
+		//---------------------------------------------------------------------
+		struct Layout
+		{
+			size_t modulesOffset;
+			size_t filesOffset;
+			size_t functionsOffset;
+			size_t linesOffset;
+			size_t charsOffset;
+			size_t totalSize;
+		};
+
+		//---------------------------------------------------------------------
+		size_t AlignUp(size_t size)
+		{
+			return (size + Alignment - 1) & ~(Alignment - 1);
+		}
+
+		//---------------------------------------------------------------------
+		Layout ComputeLayout(const Flat::Header& header)
+		{
+			Layout layout;
+
+			layout.modulesOffset = AlignUp(sizeof(Flat::Header));
+			layout.filesOffset = AlignUp(
+			    layout.modulesOffset + header.moduleCount * sizeof(Flat::Module));
+			layout.functionsOffset = AlignUp(
+			    layout.filesOffset + header.fileCount * sizeof(Flat::File));
+			layout.linesOffset = AlignUp(
+			    layout.functionsOffset +
+			    header.functionCount * sizeof(Flat::Function));
+			layout.charsOffset = AlignUp(
+			    layout.linesOffset +
+			    header.lineCount * sizeof(Plugin::LineCoverage));
+			layout.totalSize = AlignUp(
+			    layout.charsOffset + header.charCount * sizeof(wchar_t));
+
+			return layout;
+		}
+
+		//---------------------------------------------------------------------
+		void CheckCount(std::uint64_t count,
+		                size_t elementSize,
+		                size_t bufferSize,
+		                const char* name)
+		{
+			if (count > bufferSize / elementSize)
+				THROW("Invalid flat coverage data: too many " << name);
+		}
+
+		//---------------------------------------------------------------------
+		void CheckRange(std::uint64_t first,
+		                std::uint64_t count,
+		                std::uint64_t max,
+		                const char* name)
+		{
+			if (first > max || count > max - first)
+				THROW("Invalid flat coverage data: bad " << name << " range");
+		}
+	}
+
+	//-------------------------------------------------------------------------
+	FlatCoverageDataWriter::FlatCoverageDataWriter(
+	    const Plugin::CoverageData& coverageData)
+	    : coverageData_{coverageData}, header_{}
+	{
+		header_.magic = FlatMagic;
+		header_.version = FlatVersion;
+		header_.charSize = sizeof(wchar_t);
+		header_.exitCode = coverageData.GetExitCode();
+		header_.charCount = coverageData.GetName().size();
+
+		for (const auto& module : coverageData.GetModules())
+		{
+			++header_.moduleCount;
+			header_.charCount += module->GetPath().wstring().size();
+			for (const auto& file : module->GetFiles())
+			{
+				++header_.fileCount;
+				header_.charCount += file->GetPath().wstring().size();
+				header_.lineCount += file->GetLineCount();
+				for (const auto& function : file->GetFunctions())
+				{
+					++header_.functionCount;
+					header_.charCount += function.GetName().size();
+				}
+			}
+		}
+		header_.totalSize = ComputeLayout(header_).totalSize;
+	}
+
+	//-------------------------------------------------------------------------
+	size_t FlatCoverageDataWriter::GetSize() const
+	{
+		return static_cast<size_t>(header_.totalSize);
+	}
+
+	//-------------------------------------------------------------------------
+	void FlatCoverageDataWriter::Write(void* buffer, size_t bufferSize) const
+	{
+		if (bufferSize < GetSize())
+			THROW("Buffer is too small for flat coverage data.");
+		if (reinterpret_cast<std::uintptr_t>(buffer) % Alignment)
+			THROW("Buffer for flat coverage data is not aligned.");
+
+		auto layout = ComputeLayout(header_);
+		auto data = static_cast<char*>(buffer);
+		auto modules = reinterpret_cast<Flat::Module*>(data + layout.modulesOffset);
+		auto files = reinterpret_cast<Flat::File*>(data + layout.filesOffset);
+		auto functions = reinterpret_cast<Flat::Function*>(data + layout.functionsOffset);
+		auto lines = data + layout.linesOffset;
+		auto chars = reinterpret_cast<wchar_t*>(data + layout.charsOffset);
+		std::uint64_t charCount = 0;
+		std::uint64_t fileCount = 0;
+		std::uint64_t lineCount = 0;
+		std::uint64_t functionCount = 0;
+
+		auto writeString = [&](const std::wstring& str) {
+			std::memcpy(chars + charCount, str.data(), str.size() * sizeof(wchar_t));
+			Flat::String flatString{charCount, str.size()};
+			charCount += str.size();
+			return flatString;
+		};
+
+		auto header = header_;
+		header.name = writeString(coverageData_.GetName());
+		std::memcpy(data, &header, sizeof(header));
+
+		for (const auto& module : coverageData_.GetModules())
+		{
+			auto& flatModule = *modules++;
+
+			flatModule.path = writeString(module->GetPath().wstring());
+			flatModule.firstFile = fileCount;
+			flatModule.fileCount = module->GetFiles().size();
+
+			for (const auto& file : module->GetFiles())
+			{
+				auto& flatFile = files[fileCount++];
+				auto lineRange = file->GetLineRange();
+
+				flatFile.path = writeString(file->GetPath().wstring());
+				flatFile.firstLine = lineCount;
+				flatFile.lineCount = lineRange.size();
+				if (!lineRange.empty())
+				{
+					std::memcpy(lines + lineCount * sizeof(Plugin::LineCoverage),
+					            lineRange.begin(),
+					            lineRange.size() * sizeof(Plugin::LineCoverage));
+				}
+				lineCount += lineRange.size();
+
+				flatFile.firstFunction = functionCount;
+				flatFile.functionCount = file->GetFunctionCount();
+				for (const auto& function : file->GetFunctions())
+				{
+					auto& flatFunction = functions[functionCount++];
+
+					flatFunction.name = writeString(function.GetName());
+					flatFunction.symbolId = function.GetSymbolId();
+					flatFunction.firstLineNumber = function.GetFirstLineNumber();
+					flatFunction.lastLineNumber = function.GetLastLineNumber();
+					flatFunction.reserved = 0;
+				}
+			}
+		}
+	}
+
+	//-------------------------------------------------------------------------
+	FlatCoverageDataView::FlatCoverageDataView(const void* buffer,
+	                                           size_t bufferSize)
+	    : buffer_{static_cast<const char*>(buffer)}
+	{
+		if (bufferSize < sizeof(Flat::Header))
+			THROW("Invalid flat coverage data: buffer is too small.");
+		if (reinterpret_cast<std::uintptr_t>(buffer) % Alignment)
+			THROW("Invalid flat coverage data: buffer is not aligned.");
+
+		header_ = reinterpret_cast<const Flat::Header*>(buffer_);
+		if (header_->magic != FlatMagic || header_->version != FlatVersion)
+			THROW("Invalid flat coverage data: unknown format.");
+		if (header_->charSize != sizeof(wchar_t))
+			THROW("Invalid flat coverage data: character size mismatch.");
+
+		CheckCount(header_->moduleCount, sizeof(Flat::Module), bufferSize, "modules");
+		CheckCount(header_->fileCount, sizeof(Flat::File), bufferSize, "files");
+		CheckCount(header_->lineCount, sizeof(Plugin::LineCoverage), bufferSize, "lines");
+		CheckCount(header_->functionCount, sizeof(Flat::Function), bufferSize, "functions");
+		CheckCount(header_->charCount, sizeof(wchar_t), bufferSize, "characters");
+
+		auto layout = ComputeLayout(*header_);
+		if (layout.totalSize > bufferSize || layout.totalSize != header_->totalSize)
+			THROW("Invalid flat coverage data: size mismatch.");
+
+		modules_ = reinterpret_cast<const Flat::Module*>(buffer_ + layout.modulesOffset);
+		files_ = reinterpret_cast<const Flat::File*>(buffer_ + layout.filesOffset);
+		functions_ = reinterpret_cast<const Flat::Function*>(buffer_ + layout.functionsOffset);
+		lines_ = reinterpret_cast<const Plugin::LineCoverage*>(buffer_ + layout.linesOffset);
+		chars_ = reinterpret_cast<const wchar_t*>(buffer_ + layout.charsOffset);
+
+		CheckRange(header_->name.offset, header_->name.size, header_->charCount, "name");
+		for (size_t i = 0; i < header_->moduleCount; ++i)
+		{
+			const auto& module = modules_[i];
+			CheckRange(module.path.offset, module.path.size, header_->charCount, "module path");
+			CheckRange(module.firstFile, module.fileCount, header_->fileCount, "file");
+		}
+		for (size_t i = 0; i < header_->fileCount; ++i)
+		{
+			const auto& file = files_[i];
+			CheckRange(file.path.offset, file.path.size, header_->charCount, "file path");
+			CheckRange(file.firstLine, file.lineCount, header_->lineCount, "line");
+			CheckRange(file.firstFunction, file.functionCount, header_->functionCount, "function");
+		}
+		for (size_t i = 0; i < header_->functionCount; ++i)
+		{
+			const auto& function = functions_[i];
+			CheckRange(function.name.offset, function.name.size, header_->charCount, "function name");
+		}
+	}
+
+	//-------------------------------------------------------------------------
+	std::wstring_view FlatCoverageDataView::GetName() const
+	{
+		return GetString(header_->name);
+	}
+
+	//-------------------------------------------------------------------------
+	int FlatCoverageDataView::GetExitCode() const
+	{
+		return header_->exitCode;
+	}
+
+	//-------------------------------------------------------------------------
+	size_t FlatCoverageDataView::GetSize() const
+	{
+		return static_cast<size_t>(header_->totalSize);
+	}
+
+	//-------------------------------------------------------------------------
+	size_t FlatCoverageDataView::GetModuleCount() const
+	{
+		return static_cast<size_t>(header_->moduleCount);
+	}
+
+	//-------------------------------------------------------------------------
+	std::wstring_view FlatCoverageDataView::GetModulePath(size_t moduleIndex) const
+	{
+		return GetString(GetModule(moduleIndex).path);
+	}
+
+	//-------------------------------------------------------------------------
+	const Flat::Module& FlatCoverageDataView::GetModule(size_t moduleIndex) const
+	{
+		if (moduleIndex >= header_->moduleCount)
+			THROW("Invalid module index: " << moduleIndex);
+		return modules_[moduleIndex];
+	}
+
+	//-------------------------------------------------------------------------
+	std::wstring_view FlatCoverageDataView::GetFilePath(size_t fileIndex) const
+	{
+		return GetString(GetFile(fileIndex).path);
+	}
+
+	//-------------------------------------------------------------------------
+	const Flat::File& FlatCoverageDataView::GetFile(size_t fileIndex) const
+	{
+		if (fileIndex >= header_->fileCount)
+			THROW("Invalid file index: " << fileIndex);
+		return files_[fileIndex];
+	}
+
+	//-------------------------------------------------------------------------
+	const Plugin::LineCoverage*
+	FlatCoverageDataView::GetLines(const Flat::File& file) const
+	{
+		return lines_ + file.firstLine;
+	}
+
+	//-------------------------------------------------------------------------
+	const Flat::Function*
+	FlatCoverageDataView::GetFunctions(const Flat::File& file) const
+	{
+		return functions_ + file.firstFunction;
+	}
+
+	//-------------------------------------------------------------------------
+	std::wstring_view
+	FlatCoverageDataView::GetFunctionName(const Flat::Function& function) const
+	{
+		return GetString(function.name);
+	}
+
+	//-------------------------------------------------------------------------
+	Plugin::CoverageData FlatCoverageDataView::ToCoverageData() const
+	{
+		return ToCoverageData(false);
+	}
+
+	//-------------------------------------------------------------------------
+	Plugin::CoverageData FlatCoverageDataView::ToCoverageDataWithExternalLines() const
+	{
+		return ToCoverageData(true);
+	}
+
+	//-------------------------------------------------------------------------
+	std::wstring_view FlatCoverageDataView::GetString(const Flat::String& str) const
+	{
+		return std::wstring_view{chars_ + str.offset, static_cast<size_t>(str.size)};
+	}
+
+	//-------------------------------------------------------------------------
+	Plugin::CoverageData FlatCoverageDataView::ToCoverageData(bool useExternalLines) const
+	{
+		auto coverageData =
+		    useExternalLines
+		        ? Plugin::CoverageData{std::wstring{GetName()}, GetExitCode()}
+		        : Plugin::CoverageArena::CreateCoverageData(std::wstring{GetName()},
+		                                                    GetExitCode());
+
+		for (size_t i = 0; i < GetModuleCount(); ++i)
+		{
+			const auto& flatModule = GetModule(i);
+			auto& module = coverageData.AddModule(GetString(flatModule.path));
+
+			for (auto fileIndex = flatModule.firstFile;
+			     fileIndex < flatModule.firstFile + flatModule.fileCount;
+			     ++fileIndex)
+			{
+				const auto& flatFile = files_[fileIndex];
+				auto& file = module.AddFile(GetString(flatFile.path));
+
+				// Functions are added first as a modification copies external lines.
+				auto functions = GetFunctions(flatFile);
+				for (size_t function = 0; function < flatFile.functionCount; ++function)
+				{
+					file.AddFunction(functions[function].symbolId,
+					                 std::wstring{GetFunctionName(functions[function])},
+					                 functions[function].firstLineNumber,
+					                 functions[function].lastLineNumber);
+				}
+
+				auto lines = GetLines(flatFile);
+				if (useExternalLines)
+					file.SetExternalLines(Plugin::LineRange{lines, lines + flatFile.lineCount});
+				else
+				{
+					for (size_t line = 0; line < flatFile.lineCount; ++line)
+						file.AddLine(lines[line].GetLineNumber(), lines[line].HasBeenExecuted());
+				}
+			}
+		}
+
+		return coverageData;
+	}
+}
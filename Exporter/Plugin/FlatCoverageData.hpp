@@ -0,0 +1,151 @@
+// OpenCppCoverage is an open source code coverage for C++.
+// Copyright (C) 2019 OpenCppCoverage
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include "../ExporterExport.hpp"
+
+namespace Plugin
+{
+	class CoverageData;
+	class LineCoverage;
+}
+
+namespace Exporter
+{
+	//-------------------------------------------------------------------------
+	// Read only layout of a CoverageData in a single memory block.
+	// All references are offsets from the start of the block so it can be
+	// mapped at any address, for example in a shared memory segment.
+	//
+	// | Header | FlatModule[] | FlatFile[] | FlatFunction[] | LineCoverage[] |
+	// | wchar_t[] |
+	//-------------------------------------------------------------------------
+	namespace Flat
+	{
+		struct String
+		{
+			std::uint64_t offset; // In characters from the start of the strings.
+			std::uint64_t size;
+		};
+
+		struct Header
+		{
+			std::uint32_t magic;
+			std::uint32_t version;
+			std::uint32_t charSize;
+			std::int32_t exitCode;
+			std::uint64_t totalSize;
+			std::uint64_t moduleCount;
+			std::uint64_t fileCount;
+			std::uint64_t lineCount;
+			std::uint64_t functionCount;
+			std::uint64_t charCount;
+			String name;
+		};
+
+		struct Module
+		{
+			String path;
+			std::uint64_t firstFile;
+			std::uint64_t fileCount;
+		};
+
+		struct File
+		{
+			String path;
+			std::uint64_t firstLine;
+			std::uint64_t lineCount;
+			std::uint64_t firstFunction;
+			std::uint64_t functionCount;
+		};
+
+		struct Function
+		{
+			String name;
+			std::uint32_t symbolId;
+			std::uint32_t firstLineNumber;
+			std::uint32_t lastLineNumber;
+			std::uint32_t reserved;
+		};
+	}
+
+	//-------------------------------------------------------------------------
+	class EXPORTER_DLL FlatCoverageDataWriter
+	{
+	  public:
+		explicit FlatCoverageDataWriter(const Plugin::CoverageData&);
+
+		FlatCoverageDataWriter(const FlatCoverageDataWriter&) = delete;
+		FlatCoverageDataWriter& operator=(const FlatCoverageDataWriter&) = delete;
+
+		size_t GetSize() const;
+
+		// buffer must be aligned on 8 bytes and have at least GetSize() bytes.
+		void Write(void* buffer, size_t bufferSize) const;
+
+	  private:
+		const Plugin::CoverageData& coverageData_;
+		Flat::Header header_;
+	};
+
+	//-------------------------------------------------------------------------
+	class EXPORTER_DLL FlatCoverageDataView
+	{
+	  public:
+		// Check the layout once. Accessors do not copy.
+		FlatCoverageDataView(const void* buffer, size_t bufferSize);
+
+		std::wstring_view GetName() const;
+		int GetExitCode() const;
+		size_t GetSize() const;
+
+		size_t GetModuleCount() const;
+		std::wstring_view GetModulePath(size_t moduleIndex) const;
+		const Flat::Module& GetModule(size_t moduleIndex) const;
+
+		std::wstring_view GetFilePath(size_t fileIndex) const;
+		const Flat::File& GetFile(size_t fileIndex) const;
+
+		const Plugin::LineCoverage* GetLines(const Flat::File&) const;
+		const Flat::Function* GetFunctions(const Flat::File&) const;
+		std::wstring_view GetFunctionName(const Flat::Function&) const;
+
+		// Build the object model expected by IExportPlugin. Lines are
+		// allocated from an arena owned by the result.
+		Plugin::CoverageData ToCoverageData() const;
+
+		// Same as ToCoverageData but the files reference the lines of the
+		// buffer instead of copying them: the buffer must outlive the result.
+		Plugin::CoverageData ToCoverageDataWithExternalLines() const;
+
+	  private:
+		std::wstring_view GetString(const Flat::String&) const;
+		Plugin::CoverageData ToCoverageData(bool useExternalLines) const;
+
+		const char* buffer_;
+		const Flat::Header* header_;
+		const Flat::Module* modules_;
+		const Flat::File* files_;
+		const Flat::Function* functions_;
+		const Plugin::LineCoverage* lines_;
+		const wchar_t* chars_;
+	};
+}
@@ -18,7 +18,9 @@
 
 #include <memory>
 #include <filesystem>
+#include <optional>
 #include <stdexcept>
+#include <string>
 
 namespace Exporter
 {
@@ -34,5 +36,13 @@ namespace Exporter
 		virtual std::unique_ptr<LoadedPlugin<T>>
 		TryLoadPlugin(const std::filesystem::path& pluginPath,
 		              const std::string& pluginFactoryFctName) const = 0;
+
+		// Read the argument help description from the plugin metadata
+		// without running plugin code. Return std::nullopt if not available.
+		virtual std::optional<std::wstring>
+		TryReadArgumentHelpDescription(const std::filesystem::path&) const
+		{
+			return std::nullopt;
+		}
 	};
 }
@@ -45,6 +45,12 @@ namespace Exporter
 			plugin_ = std::move(plugin);
 		}
 
+		//---------------------------------------------------------------------
+		std::unique_ptr<T> Release()
+		{
+			return std::move(plugin_);
+		}
+
 		//---------------------------------------------------------------------
 		T& Get() const
 		{
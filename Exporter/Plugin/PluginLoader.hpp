@@ -21,6 +21,9 @@
 
 #include "Tools/Tool.hpp"
 
+#include <cwchar>
+#include <vector>
+
 #include <Windows.h>
 
 namespace Exporter
@@ -63,5 +66,59 @@ namespace Exporter
 
 			return plugin;
 		}
+
+		//-------------------------------------------------------------------------
+		std::optional<std::wstring> TryReadArgumentHelpDescription(
+		    const std::filesystem::path& pluginPath) const override
+		{
+			DWORD handle = 0;
+			auto size = GetFileVersionInfoSizeEx(
+			    FILE_VER_GET_NEUTRAL, pluginPath.c_str(), &handle);
+			if (!size)
+				return std::nullopt;
+
+			std::vector<BYTE> versionInfo(size);
+			if (!GetFileVersionInfoEx(FILE_VER_GET_NEUTRAL,
+			                          pluginPath.c_str(),
+			                          0,
+			                          size,
+			                          versionInfo.data()))
+				return std::nullopt;
+
+			struct Translation
+			{
+				WORD language;
+				WORD codePage;
+			};
+			Translation* translation = nullptr;
+			UINT translationSize = 0;
+			if (!VerQueryValue(versionInfo.data(),
+			                   L"\\VarFileInfo\\Translation",
+			                   reinterpret_cast<void**>(&translation),
+			                   &translationSize) ||
+			    translationSize < sizeof(Translation))
+				return std::nullopt;
+
+			wchar_t subBlock[128];
+			swprintf_s(subBlock,
+			           L"\\StringFileInfo\\%04x%04x\\%ls",
+			           translation->language,
+			           translation->codePage,
+			           ArgumentHelpDescriptionKey);
+			wchar_t* value = nullptr;
+			UINT valueSize = 0;
+			if (!VerQueryValue(versionInfo.data(),
+			                   subBlock,
+			                   reinterpret_cast<void**>(&value),
+			                   &valueSize) ||
+			    !valueSize)
+				return std::nullopt;
+
+			return std::wstring{value};
+		}
+
+		// Name of the string in the version resource of the plugin.
+		static constexpr const wchar_t* ArgumentHelpDescriptionKey =
+		    L"ArgumentHelpDescription";
 	};
 }
@@ -0,0 +1,126 @@
+// OpenCppCoverage is an open source code coverage for C++.
+// Copyright (C) 2019 OpenCppCoverage
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "stdafx.h"
+#include "SharedMemory.hpp"
+
+#include <Windows.h>
+
+#include "../ExporterException.hpp"
+
+namespace Exporter
+{
+	namespace
+	{
+		//---------------------------------------------------------------------
+		void* MapView(HANDLE mappingHandle, DWORD desiredAccess)
+		{
+			auto data = MapViewOfFile(mappingHandle, desiredAccess, 0, 0, 0);
+
+			if (!data)
+			{
+				auto lastError = GetLastError();
+				CloseHandle(mappingHandle);
+				THROW("MapViewOfFile failed: " << lastError);
+			}
+			return data;
+		}
+	}
+
+	//-------------------------------------------------------------------------
+	SharedMemory SharedMemory::Create(const std::wstring& name, size_t size)
+	{
+		const auto size64 = static_cast<unsigned long long>(size);
+		auto mappingHandle = CreateFileMapping(INVALID_HANDLE_VALUE,
+		                                       nullptr,
+		                                       PAGE_READWRITE,
+		                                       static_cast<DWORD>(size64 >> 32),
+		                                       static_cast<DWORD>(size64),
+		                                       name.c_str());
+		if (!mappingHandle)
+			THROW("CreateFileMapping failed for " << name << ": " << GetLastError());
+		if (GetLastError() == ERROR_ALREADY_EXISTS)
+		{
+			CloseHandle(mappingHandle);
+			THROW("Shared memory " << name << " already exists.");
+		}
+
+		auto data = MapView(mappingHandle, FILE_MAP_WRITE);
+		return SharedMemory{mappingHandle, data, size};
+	}
+
+	//-------------------------------------------------------------------------
+	SharedMemory SharedMemory::OpenReadOnly(const std::wstring& name)
+	{
+		auto mappingHandle = OpenFileMapping(FILE_MAP_READ, FALSE, name.c_str());
+
+		if (!mappingHandle)
+			THROW("OpenFileMapping failed for " << name << ": " << GetLastError());
+
+		auto data = MapView(mappingHandle, FILE_MAP_READ);
+		MEMORY_BASIC_INFORMATION memoryInformation;
+
+		if (!VirtualQuery(data, &memoryInformation, sizeof(memoryInformation)))
+		{
+			auto lastError = GetLastError();
+			UnmapViewOfFile(data);
+			CloseHandle(mappingHandle);
+			THROW("VirtualQuery failed: " << lastError);
+		}
+
+		// The region size is rounded up to the page size, the caller is
+		// responsible for storing the exact size in the data.
+		return SharedMemory{mappingHandle, data, memoryInformation.RegionSize};
+	}
+
+	//-------------------------------------------------------------------------
+	SharedMemory::SharedMemory(void* mappingHandle, void* data, size_t size)
+	    : mappingHandle_{mappingHandle}, data_{data}, size_{size}
+	{
+	}
+
+	//-------------------------------------------------------------------------
+	SharedMemory::SharedMemory(SharedMemory&& sharedMemory)
+	    : mappingHandle_{sharedMemory.mappingHandle_},
+	      data_{sharedMemory.data_},
+	      size_{sharedMemory.size_}
+	{
+		sharedMemory.mappingHandle_ = nullptr;
+		sharedMemory.data_ = nullptr;
+		sharedMemory.size_ = 0;
+	}
+
+	//-------------------------------------------------------------------------
+	SharedMemory::~SharedMemory()
+	{
+		if (data_)
+			UnmapViewOfFile(data_);
+		if (mappingHandle_)
+			CloseHandle(mappingHandle_);
+	}
+
+	//-------------------------------------------------------------------------
+	void* SharedMemory::GetData() const
+	{
+		return data_;
+	}
+
+	//-------------------------------------------------------------------------
+	size_t SharedMemory::GetSize() const
+	{
+		return size_;
+	}
+}
@@ -0,0 +1,54 @@
+// OpenCppCoverage is an open source code coverage for C++.
+// Copyright (C) 2019 OpenCppCoverage
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <string>
+
+#include "../ExporterExport.hpp"
+
+namespace Exporter
+{
+	//-------------------------------------------------------------------------
+	// Named file mapping backed by the paging file.
+	//-------------------------------------------------------------------------
+	class EXPORTER_DLL SharedMemory
+	{
+	  public:
+		// Create a new read/write segment of size bytes.
+		static SharedMemory Create(const std::wstring& name, size_t size);
+
+		// Open an existing segment in read only mode.
+		static SharedMemory OpenReadOnly(const std::wstring& name);
+
+		SharedMemory(SharedMemory&&);
+		~SharedMemory();
+
+		SharedMemory(const SharedMemory&) = delete;
+		SharedMemory& operator=(const SharedMemory&) = delete;
+		SharedMemory& operator=(SharedMemory&&) = delete;
+
+		void* GetData() const;
+		size_t GetSize() const;
+
+	  private:
+		SharedMemory(void* mappingHandle, void* data, size_t size);
+
+		void* mappingHandle_;
+		void* data_;
+		size_t size_;
+	};
+}
@@ -78,6 +78,51 @@ namespace ExporterTest
 		ASSERT_EQ(result, expectedResult);
 	}	
 
+	//-------------------------------------------------------------------------
+	TEST(CoberturaExporterTest, DirectoryPackages)
+	{
+		Plugin::CoverageData coverageData{ L"", 0 };
+		auto& module = coverageData.AddModule(L"Module");
+		auto root = fs::path{ L"Root" };
+
+		module.AddFile(root / L"File1").AddLine(0, true);
+		module.AddFile(root / L"Sub" / L"File2").AddLine(0, false);
+		module.AddFile(root / L"Sub" / L"File3").AddLine(0, true);
+
+		std::wostringstream ostr;
+		Exporter::CoberturaExporter(Exporter::CoberturaExporter::PackageType::Directory)
+			.Export(coverageData, ostr);
+		auto result = ostr.str();
+
+		auto rootPackage = L"package name=\"" + root.wstring() + L"\" line-rate=\"1\"";
+		auto subPackage = L"package name=\"" + (root / L"Sub").wstring() + L"\" line-rate=\"0.5\"";
+		ASSERT_TRUE(boost::algorithm::contains(result, rootPackage));
+		ASSERT_TRUE(boost::algorithm::contains(result, subPackage));
+		ASSERT_FALSE(boost::algorithm::contains(result, L"package name=\"Module\""));
+	}
+
+	//-------------------------------------------------------------------------
+	TEST(CoberturaExporterTest, Methods)
+	{
+		Plugin::CoverageData coverageData{ L"", 0 };
+		auto& file = coverageData.AddModule(L"Module").AddFile(L"File");
+
+		file.AddLine(1, true);
+		file.AddLine(2, false);
+		file.AddLine(10, true);
+		file.AddFunction(1, L"Function1", 1, 2);
+		file.AddFunction(2, L"Function2", 10, 10);
+
+		std::wostringstream ostr;
+		Exporter::CoberturaExporter().Export(coverageData, ostr);
+		auto result = ostr.str();
+
+		ASSERT_TRUE(boost::algorithm::contains(result, 
+			L"method name=\"Function1\" signature=\"\" line-rate=\"0.5\""));
+		ASSERT_TRUE(boost::algorithm::contains(result,
+			L"method name=\"Function2\" signature=\"\" line-rate=\"1\""));
+	}
+
 	//-------------------------------------------------------------------------
 	TEST(CoberturaExporterTest, SubFolderDoesNotExist)
 	{
@@ -0,0 +1,171 @@
+// OpenCppCoverage is an open source code coverage for C++.
+// Copyright (C) 2019 OpenCppCoverage
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "stdafx.h"
+
+#include <atomic>
+#include <sstream>
+#include <thread>
+
+#include "Plugin/Exporter/CoverageData.hpp"
+#include "Plugin/Exporter/ModuleCoverage.hpp"
+#include "Plugin/Exporter/FileCoverage.hpp"
+
+#include "CppCoverage/CoverageDataMerger.hpp"
+
+#include "Exporter/CoverageAggregationServer.hpp"
+#include "Exporter/Binary/CoverageDataSerializer.hpp"
+#include "Exporter/Binary/CoverageDataDeserializer.hpp"
+
+#include "TestHelper/CoverageDataComparer.hpp"
+#include "TestHelper/MemoryMessageChannel.hpp"
+
+#include "Tools/ScopedAction.hpp"
+
+namespace ExporterTest
+{
+	namespace
+	{
+		//---------------------------------------------------------------------
+		Plugin::CoverageData CreateCoverageData(const std::wstring& name, bool isLineExecuted)
+		{
+			Plugin::CoverageData coverageData{ name, 0 };
+			auto& file = coverageData.AddModule(L"Module").AddFile(L"File");
+
+			file.AddLine(1, isLineExecuted);
+			file.AddLine(2, false);
+			coverageData.AddModule(name).AddFile(L"File").AddLine(1, true);
+
+			return coverageData;
+		}
+
+		//---------------------------------------------------------------------
+		std::string Serialize(const Plugin::CoverageData& coverageData)
+		{
+			std::ostringstream ostr;
+
+			Exporter::CoverageDataSerializer{}.Serialize(coverageData, ostr);
+			return ostr.str();
+		}
+
+		//---------------------------------------------------------------------
+		Plugin::CoverageData Deserialize(const std::string& binaryCoverageData)
+		{
+			std::istringstream istr{ binaryCoverageData };
+
+			return Exporter::CoverageDataDeserializer{}.Deserialize(istr, "");
+		}
+	}
+
+	//-------------------------------------------------------------------------
+	TEST(CoverageAggregationServerTest, Aggregator)
+	{
+		Exporter::CoverageAggregator coverageAggregator;
+		std::vector<Plugin::CoverageData> coverageDatas;
+
+		coverageDatas.push_back(CreateCoverageData(L"Shard1", false));
+		coverageDatas.push_back(CreateCoverageData(L"Shard2", true));
+		for (const auto& coverageData : coverageDatas)
+			coverageAggregator.Add(Serialize(coverageData));
+		ASSERT_THROW(coverageAggregator.Add("Invalid"), std::exception);
+
+		auto expectedCoverageData = CppCoverage::CoverageDataMerger{}.Merge(coverageDatas);
+		TestHelper::CoverageDataComparer().AssertEquals(
+			expectedCoverageData, Deserialize(coverageAggregator.GetMergedCoverageData()));
+
+		auto summary = coverageAggregator.GetSummary();
+		ASSERT_EQ(2, summary.uploadCount);
+		ASSERT_EQ(3, summary.moduleCount);
+		ASSERT_EQ(3, summary.fileCount);
+		ASSERT_EQ(4, summary.lineCount);
+		ASSERT_EQ(3, summary.executedLineCount);
+	}
+
+	//-------------------------------------------------------------------------
+	TEST(CoverageAggregationServerTest, Serve)
+	{
+		using Server = Exporter::CoverageAggregationServer;
+		Exporter::CoverageAggregator coverageAggregator;
+		Server server{ coverageAggregator };
+		TestHelper::MemoryMessageChannelListener listener;
+		std::thread thread{ [&]() { server.Serve(listener); } };
+		Tools::ScopedAction joinServer{ [&]() {
+			listener.Close();
+			thread.join();
+		} };
+
+		Server::Upload(*listener.Connect(), Serialize(CreateCoverageData(L"Shard1", false)));
+		Server::Upload(*listener.Connect(), Serialize(CreateCoverageData(L"Shard2", true)));
+		ASSERT_THROW(Server::Upload(*listener.Connect(), "Invalid"), std::exception);
+
+		auto channel = listener.Connect();
+		auto summary = Server::GetSummary(*channel);
+		ASSERT_EQ(2, summary.uploadCount);
+		ASSERT_EQ(3, summary.executedLineCount);
+
+		auto coverageData = Deserialize(Server::DownloadMergedCoverageData(*channel));
+		ASSERT_EQ(3, coverageData.GetModules().size());
+
+		Server::SendStopRequest(*channel);
+	}
+
+	//-------------------------------------------------------------------------
+	TEST(CoverageAggregationServerTest, ConcurrentUploads)
+	{
+		using Server = Exporter::CoverageAggregationServer;
+		Exporter::CoverageAggregator coverageAggregator;
+		Server server{ coverageAggregator };
+		TestHelper::MemoryMessageChannelListener listener;
+		std::thread thread{ [&]() { server.Serve(listener); } };
+		Tools::ScopedAction joinServer{ [&]() {
+			listener.Close();
+			thread.join();
+		} };
+
+		// An idle client must not block the other ones.
+		auto idleChannel = listener.Connect();
+
+		const int shardCount = 8;
+		std::atomic<int> errorCount{ 0 };
+		std::vector<std::thread> clients;
+		for (int i = 0; i < shardCount; ++i)
+		{
+			clients.emplace_back([&, i]() {
+				try
+				{
+					auto coverageData = CreateCoverageData(L"Shard" + std::to_wstring(i), i == 0);
+					Server::Upload(*listener.Connect(), Serialize(coverageData));
+				}
+				catch (const std::exception&)
+				{
+					++errorCount;
+				}
+			});
+		}
+		for (auto& client : clients)
+			client.join();
+		ASSERT_EQ(0, errorCount);
+
+		auto channel = listener.Connect();
+		auto summary = Server::GetSummary(*channel);
+		ASSERT_EQ(shardCount, summary.uploadCount);
+		ASSERT_EQ(shardCount + 1, summary.moduleCount);
+		ASSERT_EQ(shardCount + 1, summary.executedLineCount);
+
+		Server::SendStopRequest(*channel);
+		idleChannel.reset();
+	}
+}
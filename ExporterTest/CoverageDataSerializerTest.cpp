@@ -50,6 +50,8 @@ namespace ExporterTest
 
 					for (int line = 0; line < 100; ++line)
 						file.AddLine(line, distribution(generator) != 0);
+					file.AddFunction(fileIndex, L"Function" + std::to_wstring(fileIndex), 10, 20);
+					file.AddFunction(fileIndex + 1, L"Functioné", 30, 30);
 				}
 			}
 		}
@@ -91,6 +93,18 @@ namespace ExporterTest
 		TestHelper::CoverageDataComparer().AssertEquals(randomCoverageData, coverageDataRestored);
 	}
 
+	//-------------------------------------------------------------------------
+	TEST(CoverageDataSerializerTest, SerializeAndDeserializeStream)
+	{
+		std::stringstream stream;
+		auto randomCoverageData = CreateRandomCoverageData();
+
+		Exporter::CoverageDataSerializer{}.Serialize(randomCoverageData, stream);
+		auto coverageDataRestored = Exporter::CoverageDataDeserializer{}.Deserialize(stream, "");
+
+		TestHelper::CoverageDataComparer().AssertEquals(randomCoverageData, coverageDataRestored);
+	}
+
 	//-------------------------------------------------------------------------
 	TEST(CoverageDataSerializerTest, InvalidFile)
 	{
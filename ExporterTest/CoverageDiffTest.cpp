@@ -0,0 +1,138 @@
+// OpenCppCoverage is an open source code coverage for C++.
+// Copyright (C) 2019 OpenCppCoverage
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "stdafx.h"
+
+#include "Plugin/Exporter/CoverageData.hpp"
+#include "Plugin/Exporter/ModuleCoverage.hpp"
+#include "Plugin/Exporter/FileCoverage.hpp"
+
+#include "Exporter/CoverageDiff.hpp"
+#include "Exporter/Binary/CoverageDataSerializer.hpp"
+
+#include "TestHelper/TemporaryPath.hpp"
+
+namespace ExporterTest
+{
+	namespace
+	{
+		//---------------------------------------------------------------------
+		void AddLines(Plugin::FileCoverage& file, const std::vector<bool>& executedLines)
+		{
+			for (size_t i = 0; i < executedLines.size(); ++i)
+				file.AddLine(static_cast<unsigned int>(i + 1), executedLines[i]);
+		}
+
+		//---------------------------------------------------------------------
+		Plugin::CoverageData CreateBefore()
+		{
+			Plugin::CoverageData coverageData{ L"Before", 0 };
+			auto& module2 = coverageData.AddModule(L"C:\\Module2.exe");
+			AddLines(module2.AddFile(L"C:\\File.cpp"), { true, true });
+
+			auto& module1 = coverageData.AddModule(L"C:\\Module1.exe");
+			AddLines(module1.AddFile(L"C:\\Removed.cpp"), { true });
+			AddLines(module1.AddFile(L"C:\\Changed.cpp"), { true, false, true, false });
+			AddLines(module1.AddFile(L"C:\\Same.cpp"), { true, false });
+
+			return coverageData;
+		}
+
+		//---------------------------------------------------------------------
+		Plugin::CoverageData CreateAfter()
+		{
+			Plugin::CoverageData coverageData{ L"After", 0 };
+			auto& module1 = coverageData.AddModule(L"C:\\Module1.exe");
+			AddLines(module1.AddFile(L"C:\\Same.cpp"), { true, false });
+			AddLines(module1.AddFile(L"C:\\Changed.cpp"), { false, true, true, false, true });
+			AddLines(module1.AddFile(L"C:\\Added.cpp"), { false });
+
+			auto& module2 = coverageData.AddModule(L"C:\\Module2.exe");
+			AddLines(module2.AddFile(L"C:\\File.cpp"), { true, true });
+
+			return coverageData;
+		}
+
+		//---------------------------------------------------------------------
+		void CheckResult(const Exporter::CoverageDiffResult& result)
+		{
+			ASSERT_EQ(9, result.before.lineCount);
+			ASSERT_EQ(6, result.before.executedLineCount);
+			ASSERT_EQ(10, result.after.lineCount);
+			ASSERT_EQ(6, result.after.executedLineCount);
+
+			ASSERT_EQ(3, result.files.size());
+			ASSERT_EQ(L"C:\\Added.cpp", result.files[0].path.wstring());
+			ASSERT_EQ(0, result.files[0].before.lineCount);
+			ASSERT_EQ(1, result.files[0].after.lineCount);
+
+			const auto& changed = result.files[1];
+			ASSERT_EQ(L"C:\\Module1.exe", changed.modulePath.wstring());
+			ASSERT_EQ(L"C:\\Changed.cpp", changed.path.wstring());
+			ASSERT_EQ(2, changed.before.executedLineCount);
+			ASSERT_EQ(3, changed.after.executedLineCount);
+			ASSERT_EQ(std::vector<unsigned int>{ 2 }, changed.newlyCoveredLines);
+			ASSERT_EQ(std::vector<unsigned int>{ 1 }, changed.newlyUncoveredLines);
+
+			ASSERT_EQ(L"C:\\Removed.cpp", result.files[2].path.wstring());
+			ASSERT_EQ(1, result.files[2].before.executedLineCount);
+			ASSERT_EQ(0, result.files[2].after.lineCount);
+		}
+	}
+
+	//-------------------------------------------------------------------------
+	TEST(CoverageDiffTest, Compute)
+	{
+		Exporter::CoverageDiff coverageDiff;
+
+		CheckResult(coverageDiff.Compute(CreateBefore(), CreateAfter()));
+	}
+
+	//-------------------------------------------------------------------------
+	TEST(CoverageDiffTest, ComputeFromFiles)
+	{
+		TestHelper::TemporaryPath beforePath;
+		TestHelper::TemporaryPath afterPath;
+		Exporter::CoverageDataSerializer coverageDataSerializer;
+		Exporter::CoverageDiff coverageDiff;
+
+		coverageDataSerializer.Serialize(CreateBefore(), beforePath);
+		coverageDataSerializer.Serialize(CreateAfter(), afterPath);
+		CheckResult(coverageDiff.Compute(beforePath.GetPath(), afterPath.GetPath()));
+	}
+
+	//-------------------------------------------------------------------------
+	TEST(CoverageDiffTest, Write)
+	{
+		Exporter::CoverageDiff coverageDiff;
+		auto result = coverageDiff.Compute(CreateBefore(), CreateAfter());
+		std::wostringstream text;
+		std::ostringstream json;
+		std::ostringstream html;
+
+		coverageDiff.WriteText(result, text);
+		coverageDiff.WriteJson(result, json);
+		coverageDiff.WriteHtml(result, html);
+
+		ASSERT_NE(std::wstring::npos, text.str().find(L"Total: 6/9 (66.67%) -> 6/10 (60.00%), -6.67%"));
+		ASSERT_NE(std::wstring::npos, text.str().find(L"Newly uncovered: 1"));
+		ASSERT_NE(std::string::npos, json.str().find(
+			"\"path\":\"C:\\\\Changed.cpp\",\"before\":{\"lineCount\":4,\"executedLineCount\":2,\"rate\":50.00}"));
+		ASSERT_NE(std::string::npos, json.str().find("\"newlyCoveredLines\":[2]"));
+		ASSERT_NE(std::string::npos, html.str().find("C:\\Module1.exe<br>C:\\Changed.cpp"));
+	}
+}
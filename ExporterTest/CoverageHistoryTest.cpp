@@ -0,0 +1,106 @@
+// OpenCppCoverage is an open source code coverage for C++.
+// Copyright (C) 2019 OpenCppCoverage
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "stdafx.h"
+
+#include "Plugin/Exporter/CoverageData.hpp"
+#include "Plugin/Exporter/ModuleCoverage.hpp"
+#include "Plugin/Exporter/FileCoverage.hpp"
+
+#include "Exporter/CoverageHistory.hpp"
+
+#include "TestHelper/CoverageDataComparer.hpp"
+#include "TestHelper/TemporaryPath.hpp"
+
+namespace ExporterTest
+{
+	namespace
+	{
+		//---------------------------------------------------------------------
+		Plugin::CoverageData CreateCoverageData(
+			const std::wstring& name,
+			const std::vector<bool>& executedLines,
+			bool addFile = false)
+		{
+			Plugin::CoverageData coverageData{ name, 0 };
+			auto& module = coverageData.AddModule(L"C:\\Module.exe");
+			auto& file = module.AddFile(L"C:\\Dir\\File.cpp");
+
+			for (size_t i = 0; i < executedLines.size(); ++i)
+				file.AddLine(static_cast<unsigned int>(i + 1), executedLines[i]);
+			module.AddFile(L"C:\\Other\\File.cpp").AddLine(1, true);
+			if (addFile)
+				module.AddFile(L"C:\\Dir\\NewFile.cpp").AddLine(1, false);
+
+			return coverageData;
+		}
+	}
+
+	//-------------------------------------------------------------------------
+	TEST(CoverageHistoryTest, AddAndGet)
+	{
+		TestHelper::TemporaryPath folder;
+		std::vector<Plugin::CoverageData> coverageDatas;
+
+		coverageDatas.push_back(CreateCoverageData(L"1", { true, false, false, false, false }));
+		coverageDatas.push_back(CreateCoverageData(L"2", { true, true, false, false, false }));
+		coverageDatas.push_back(CreateCoverageData(L"3", { true, true, false, false, false }, true));
+		{
+			Exporter::CoverageHistory coverageHistory{ folder };
+			coverageHistory.Add(L"r1", coverageDatas[0]);
+			coverageHistory.Add(L"r2", coverageDatas[1]);
+			ASSERT_THROW(coverageHistory.Add(L"r2", coverageDatas[1]), std::exception);
+			coverageHistory.Add(L"r3", coverageDatas[2]);
+		}
+		ASSERT_TRUE(std::filesystem::exists(folder.GetPath() / "1.delta"));
+		ASSERT_TRUE(std::filesystem::exists(folder.GetPath() / "2.cov"));
+
+		Exporter::CoverageHistory coverageHistory{ folder };
+		std::vector<std::wstring> expectedRevisions = { L"r1", L"r2", L"r3" };
+		ASSERT_EQ(expectedRevisions, coverageHistory.GetRevisions());
+		for (size_t i = 0; i < expectedRevisions.size(); ++i)
+		{
+			TestHelper::CoverageDataComparer().AssertEquals(
+				coverageDatas[i], coverageHistory.Get(expectedRevisions[i]));
+		}
+		ASSERT_THROW(coverageHistory.Get(L"r4"), std::exception);
+	}
+
+	//-------------------------------------------------------------------------
+	TEST(CoverageHistoryTest, Trend)
+	{
+		TestHelper::TemporaryPath folder;
+		Exporter::CoverageHistory coverageHistory{ folder };
+
+		coverageHistory.Add(L"r1", CreateCoverageData(L"1", { true, false, false, false }));
+		coverageHistory.Add(L"r2", CreateCoverageData(L"2", { false, true, true, false }, true));
+		coverageHistory.Add(L"r3", CreateCoverageData(L"3", { false, true, true, true }, true));
+
+		auto trend = coverageHistory.GetTrend(L"c:\\dir\\");
+		ASSERT_EQ(3, trend.size());
+		ASSERT_EQ(L"r1", trend[0].revision);
+		ASSERT_EQ(4, trend[0].lineCount);
+		ASSERT_EQ(1, trend[0].executedLineCount);
+		ASSERT_EQ(5, trend[1].lineCount);
+		ASSERT_EQ(2, trend[1].executedLineCount);
+		ASSERT_EQ(5, trend[2].lineCount);
+		ASSERT_EQ(3, trend[2].executedLineCount);
+
+		auto moduleTrend = coverageHistory.GetTrend(L"C:\\Module.exe");
+		ASSERT_EQ(5, moduleTrend[0].lineCount);
+		ASSERT_EQ(2, moduleTrend[0].executedLineCount);
+	}
+}
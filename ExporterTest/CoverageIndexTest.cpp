@@ -0,0 +1,152 @@
+// OpenCppCoverage is an open source code coverage for C++.
+// Copyright (C) 2019 OpenCppCoverage
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "stdafx.h"
+
+#include <fstream>
+
+#include "Plugin/Exporter/CoverageData.hpp"
+#include "Plugin/Exporter/ModuleCoverage.hpp"
+#include "Plugin/Exporter/FileCoverage.hpp"
+
+#include "Exporter/CoverageIndex.hpp"
+#include "Exporter/Binary/CoverageDataSerializer.hpp"
+
+#include "TestHelper/TemporaryPath.hpp"
+
+namespace ExporterTest
+{
+	namespace
+	{
+		//---------------------------------------------------------------------
+		void CreateCoverageFile(const std::filesystem::path& path, bool isLine3Executed)
+		{
+			Plugin::CoverageData coverageData{ L"Test", 0 };
+			auto& module1 = coverageData.AddModule(L"C:\\Module1.exe");
+			auto& file1 = module1.AddFile(L"C:\\Dir\\File1.cpp");
+			file1.AddLine(1, true);
+			file1.AddLine(3, isLine3Executed);
+			file1.AddLine(100, false);
+			module1.AddFile(L"C:\\Other\\File.cpp").AddLine(1, true);
+
+			auto& module2 = coverageData.AddModule(L"C:\\Module2.exe");
+			auto& file2 = module2.AddFile(L"C:\\Dir\\File1.cpp");
+			file2.AddLine(100, true);
+			file2.AddLine(101, false);
+			module2.AddFile(L"C:\\Dir\\Sub\\File2.cpp").AddLine(5, false);
+
+			Exporter::CoverageDataSerializer{}.Serialize(coverageData, path);
+		}
+	}
+
+	//-------------------------------------------------------------------------
+	TEST(CoverageIndexTest, Query)
+	{
+		TestHelper::TemporaryPath folder{ TestHelper::TemporaryPathOption::CreateAsFolder };
+		auto coverageFile = folder.GetPath() / "Coverage.cov";
+		CreateCoverageFile(coverageFile, false);
+
+		Exporter::CoverageIndex coverageIndex{ coverageFile };
+		ASSERT_TRUE(coverageIndex.HasBeenBuilt());
+		ASSERT_TRUE(std::filesystem::exists(
+			Exporter::CoverageIndex::GetIndexPath(coverageFile)));
+
+		ASSERT_EQ(true, coverageIndex.IsLineExecuted(L"C:\\Dir\\File1.cpp", 1));
+		ASSERT_EQ(false, coverageIndex.IsLineExecuted(L"c:\\dir\\file1.cpp", 3));
+		ASSERT_EQ(true, coverageIndex.IsLineExecuted(L"C:\\Dir\\File1.cpp", 100));
+		ASSERT_EQ(boost::none, coverageIndex.IsLineExecuted(L"C:\\Dir\\File1.cpp", 2));
+		ASSERT_EQ(boost::none, coverageIndex.IsLineExecuted(L"C:\\Dir\\File1.cpp", 102));
+		ASSERT_EQ(boost::none, coverageIndex.IsLineExecuted(L"C:\\Dir\\Unknown.cpp", 1));
+
+		auto count = coverageIndex.GetCount(L"C:\\Dir\\");
+		ASSERT_EQ(2, count.fileCount);
+		ASSERT_EQ(5, count.lineCount);
+		ASSERT_EQ(2, count.executedLineCount);
+
+		count = coverageIndex.GetCount(L"");
+		ASSERT_EQ(3, count.fileCount);
+		ASSERT_EQ(6, count.lineCount);
+		ASSERT_EQ(3, count.executedLineCount);
+
+		ASSERT_EQ(0, coverageIndex.GetCount(L"D:\\").fileCount);
+	}
+
+	//-------------------------------------------------------------------------
+	TEST(CoverageIndexTest, Invalidation)
+	{
+		TestHelper::TemporaryPath folder{ TestHelper::TemporaryPathOption::CreateAsFolder };
+		auto coverageFile = folder.GetPath() / "Coverage.cov";
+		CreateCoverageFile(coverageFile, false);
+		{
+			Exporter::CoverageIndex coverageIndex{ coverageFile };
+			ASSERT_TRUE(coverageIndex.HasBeenBuilt());
+		}
+		{
+			Exporter::CoverageIndex coverageIndex{ coverageFile };
+			ASSERT_FALSE(coverageIndex.HasBeenBuilt());
+			ASSERT_EQ(false, coverageIndex.IsLineExecuted(L"C:\\Dir\\File1.cpp", 3));
+		}
+
+		CreateCoverageFile(coverageFile, true);
+		std::filesystem::last_write_time(coverageFile,
+			std::filesystem::last_write_time(coverageFile) + std::chrono::seconds{ 1 });
+
+		Exporter::CoverageIndex coverageIndex{ coverageFile };
+		ASSERT_TRUE(coverageIndex.HasBeenBuilt());
+		ASSERT_EQ(true, coverageIndex.IsLineExecuted(L"C:\\Dir\\File1.cpp", 3));
+	}
+
+	//-------------------------------------------------------------------------
+	TEST(CoverageIndexTest, DirectoryCount)
+	{
+		TestHelper::TemporaryPath folder{ TestHelper::TemporaryPathOption::CreateAsFolder };
+		auto coverageFile = folder.GetPath() / "Coverage.cov";
+		Plugin::CoverageData coverageData{ L"Test", 0 };
+		auto& module = coverageData.AddModule(L"C:\\Module.exe");
+		module.AddFile(L"C:\\Dir\\File.cpp").AddLine(1, true);
+		module.AddFile(L"C:\\Directory\\File.cpp").AddLine(1, false);
+		Exporter::CoverageDataSerializer{}.Serialize(coverageData, coverageFile);
+
+		Exporter::CoverageIndex coverageIndex{ coverageFile };
+		ASSERT_EQ(2, coverageIndex.GetCount(L"C:\\Dir").fileCount);
+		ASSERT_EQ(1, coverageIndex.GetDirectoryCount(L"C:\\Dir").fileCount);
+		ASSERT_EQ(1, coverageIndex.GetDirectoryCount(L"C:\\Dir\\").executedLineCount);
+		ASSERT_EQ(2, coverageIndex.GetDirectoryCount(L"").fileCount);
+	}
+
+	//-------------------------------------------------------------------------
+	TEST(CoverageIndexTest, CorruptedIndex)
+	{
+		TestHelper::TemporaryPath folder{ TestHelper::TemporaryPathOption::CreateAsFolder };
+		auto coverageFile = folder.GetPath() / "Coverage.cov";
+		auto indexPath = Exporter::CoverageIndex::GetIndexPath(coverageFile);
+		CreateCoverageFile(coverageFile, false);
+		Exporter::CoverageIndex{ coverageFile };
+
+		{
+			// Size of the first path after magic, version, stamp and file count.
+			std::fstream fs{ indexPath, std::ios::binary | std::ios::in | std::ios::out };
+			const uint32_t invalidSize = 0xFFFFFFFF;
+			fs.seekp(32);
+			fs.write(reinterpret_cast<const char*>(&invalidSize), sizeof(invalidSize));
+		}
+
+		Exporter::CoverageIndex coverageIndex{ coverageFile };
+		ASSERT_TRUE(coverageIndex.HasBeenBuilt());
+		ASSERT_EQ(true, coverageIndex.IsLineExecuted(L"C:\\Dir\\File1.cpp", 1));
+	}
+}
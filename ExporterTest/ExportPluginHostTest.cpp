@@ -0,0 +1,227 @@
+// OpenCppCoverage is an open source code coverage for C++.
+// Copyright (C) 2019 OpenCppCoverage
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "stdafx.h"
+
+#include <limits>
+
+#include "Plugin/Exporter/CoverageData.hpp"
+#include "Plugin/Exporter/ModuleCoverage.hpp"
+#include "Plugin/Exporter/FileCoverage.hpp"
+#include "Plugin/Exporter/IExportPlugin.hpp"
+
+#include "Exporter/ExporterException.hpp"
+#include "Exporter/Plugin/ExportPluginRequest.hpp"
+#include "Exporter/Plugin/FlatCoverageData.hpp"
+#include "Exporter/Plugin/IPluginLoader.hpp"
+#include "Exporter/Plugin/LoadedPlugin.hpp"
+
+#include "TestHelper/CoverageDataComparer.hpp"
+
+namespace ExporterTest
+{
+	namespace
+	{
+		//---------------------------------------------------------------------
+		Plugin::CoverageData CreateCoverageData()
+		{
+			Plugin::CoverageData coverageData{L"Name", 42};
+			auto& module1 = coverageData.AddModule(L"Module1");
+			auto& file1 = module1.AddFile(L"File1");
+
+			file1.AddLine(1, true);
+			file1.AddLine(2, false);
+			file1.AddLine(10, true);
+			file1.AddFunction(7, L"Function", 1, 2);
+			module1.AddFile(L"EmptyFile");
+			coverageData.AddModule(L"EmptyModule");
+			coverageData.AddModule(L"Module2").AddFile(L"File2").AddLine(5, false);
+
+			return coverageData;
+		}
+
+		//---------------------------------------------------------------------
+		template <typename Writer>
+		std::vector<std::uint64_t> Write(const Writer& writer)
+		{
+			std::vector<std::uint64_t> buffer(
+			    (writer.GetSize() + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t));
+
+			writer.Write(buffer.data(), buffer.size() * sizeof(std::uint64_t));
+			return buffer;
+		}
+
+		//---------------------------------------------------------------------
+		// Stand-in for a plugin loaded by the host process.
+		class StandInExportPlugin : public Plugin::IExportPlugin
+		{
+		  public:
+			//-----------------------------------------------------------------
+			explicit StandInExportPlugin(const Plugin::CoverageData& expectedCoverageData)
+			    : expectedCoverageData_{expectedCoverageData}
+			{
+			}
+
+			//-----------------------------------------------------------------
+			std::optional<std::filesystem::path>
+			Export(const Plugin::CoverageData& coverageData,
+			       const std::optional<std::wstring>& argument) override
+			{
+				TestHelper::CoverageDataComparer().AssertEquals(
+				    expectedCoverageData_, coverageData);
+				return std::filesystem::path{argument.value_or(L"NoArgument")};
+			}
+
+			void CheckArgument(const std::optional<std::wstring>&) override {}
+			std::wstring GetArgumentHelpDescription() override { return L""; }
+			int GetExportPluginVersion() const override
+			{
+				return Plugin::CurrentExportPluginVersion;
+			}
+
+		  private:
+			const Plugin::CoverageData& expectedCoverageData_;
+		};
+
+		//---------------------------------------------------------------------
+		class StandInPluginLoader
+		    : public Exporter::IPluginLoader<Plugin::IExportPlugin>
+		{
+		  public:
+			//-----------------------------------------------------------------
+			explicit StandInPluginLoader(const Plugin::CoverageData& expectedCoverageData)
+			    : expectedCoverageData_{expectedCoverageData}
+			{
+			}
+
+			//-----------------------------------------------------------------
+			std::unique_ptr<Exporter::LoadedPlugin<Plugin::IExportPlugin>>
+			TryLoadPlugin(const std::filesystem::path& pluginPath,
+			              const std::string&) const override
+			{
+				loadedPluginPath_ = pluginPath;
+				auto plugin =
+				    std::make_unique<Exporter::LoadedPlugin<Plugin::IExportPlugin>>(nullptr);
+				plugin->Set(std::make_unique<StandInExportPlugin>(expectedCoverageData_));
+				return plugin;
+			}
+
+			mutable std::filesystem::path loadedPluginPath_;
+
+		  private:
+			const Plugin::CoverageData& expectedCoverageData_;
+		};
+	}
+
+	//-------------------------------------------------------------------------
+	TEST(ExportPluginHostTest, FlatCoverageData)
+	{
+		auto coverageData = CreateCoverageData();
+		Exporter::FlatCoverageDataWriter writer{coverageData};
+		auto buffer = Write(writer);
+		Exporter::FlatCoverageDataView view{buffer.data(), writer.GetSize()};
+
+		ASSERT_EQ(L"Name", view.GetName());
+		ASSERT_EQ(42, view.GetExitCode());
+		ASSERT_EQ(3, view.GetModuleCount());
+		ASSERT_EQ(L"EmptyModule", view.GetModulePath(1));
+
+		const auto& file = view.GetFile(view.GetModule(0).firstFile);
+		ASSERT_EQ(3, file.lineCount);
+		ASSERT_EQ(10, view.GetLines(file)[2].GetLineNumber());
+		ASSERT_TRUE(view.GetLines(file)[2].HasBeenExecuted());
+		ASSERT_EQ(1, file.functionCount);
+		ASSERT_EQ(L"Function", view.GetFunctionName(view.GetFunctions(file)[0]));
+
+		TestHelper::CoverageDataComparer().AssertEquals(coverageData,
+		                                                view.ToCoverageData());
+
+		auto coverageDataWithExternalLines = view.ToCoverageDataWithExternalLines();
+		TestHelper::CoverageDataComparer().AssertEquals(coverageData,
+		                                                coverageDataWithExternalLines);
+		const auto& externalFile = coverageDataWithExternalLines.GetModules()[0]->GetFiles()[0];
+		ASSERT_EQ(view.GetLines(file), externalFile->GetLineRange().begin());
+	}
+
+	//-------------------------------------------------------------------------
+	TEST(ExportPluginHostTest, InvalidFlatCoverageData)
+	{
+		auto coverageData = CreateCoverageData();
+		Exporter::FlatCoverageDataWriter writer{coverageData};
+		auto buffer = Write(writer);
+
+		ASSERT_THROW(Exporter::FlatCoverageDataView(buffer.data(), writer.GetSize() - 8),
+		             Exporter::ExporterException);
+		ASSERT_THROW(writer.Write(buffer.data(), writer.GetSize() - 8),
+		             Exporter::ExporterException);
+
+		buffer[0] = 0;
+		ASSERT_THROW(Exporter::FlatCoverageDataView(buffer.data(), writer.GetSize()),
+		             Exporter::ExporterException);
+	}
+
+	//-------------------------------------------------------------------------
+	TEST(ExportPluginHostTest, ExecuteRequest)
+	{
+		auto coverageData = CreateCoverageData();
+		const std::filesystem::path pluginPath = L"Plugin.dll";
+		StandInPluginLoader pluginLoader{coverageData};
+
+		for (const auto& argument : {std::optional<std::wstring>{L"Argument"},
+		                             std::optional<std::wstring>{}})
+		{
+			Exporter::ExportPluginRequestWriter writer{pluginPath, argument, coverageData};
+			auto buffer = Write(writer);
+			auto output = Exporter::ExecuteExportPluginRequest(
+			    buffer.data(), writer.GetSize(), pluginLoader);
+
+			ASSERT_EQ(pluginPath, pluginLoader.loadedPluginPath_);
+			ASSERT_EQ(std::filesystem::path{argument.value_or(L"NoArgument")}, *output);
+		}
+	}
+
+	//-------------------------------------------------------------------------
+	TEST(ExportPluginHostTest, InvalidRequestHeader)
+	{
+		auto coverageData = CreateCoverageData();
+		Exporter::ExportPluginRequestWriter writer{L"Plugin.dll", L"Argument", coverageData};
+		const auto validBuffer = Write(writer);
+
+		// Words of the header: magic and char size, total size, plugin path
+		// size, argument size, has argument and coverage data offset.
+		const size_t pluginPathSizeIndex = 2;
+		const size_t argumentSizeIndex = 3;
+		const size_t coverageDataOffsetIndex = 5;
+		const auto maxChars = (validBuffer[coverageDataOffsetIndex] -
+		                       (coverageDataOffsetIndex + 1) * sizeof(std::uint64_t)) /
+		                      sizeof(wchar_t);
+
+		auto checkInvalid = [&](size_t index, std::uint64_t value) {
+			auto buffer = validBuffer;
+			buffer[index] = value;
+			ASSERT_THROW(Exporter::ExportPluginRequestView(buffer.data(), writer.GetSize()),
+			             Exporter::ExporterException);
+		};
+
+		Exporter::ExportPluginRequestView(validBuffer.data(), writer.GetSize());
+		checkInvalid(coverageDataOffsetIndex, 0);
+		checkInvalid(coverageDataOffsetIndex, sizeof(std::uint64_t));
+		checkInvalid(pluginPathSizeIndex, maxChars + 1);
+		checkInvalid(pluginPathSizeIndex, std::numeric_limits<std::uint64_t>::max());
+		checkInvalid(argumentSizeIndex, maxChars - validBuffer[pluginPathSizeIndex] + 1);
+		checkInvalid(argumentSizeIndex, std::numeric_limits<std::uint64_t>::max());
+	}
+}
@@ -45,6 +45,9 @@ namespace ExporterTest
 			    std::unique_ptr<Exporter::LoadedPlugin<Plugin::IExportPlugin>>(
 			        const std::filesystem::path& pluginPath,
 			        const std::string& pluginFactoryFctName));
+			MOCK_CONST_METHOD1(TryReadArgumentHelpDescription,
+			                   std::optional<std::wstring>(
+			                       const std::filesystem::path& pluginPath));
 		};
 
 		//---------------------------------------------------------------------
@@ -61,6 +64,66 @@ namespace ExporterTest
 			MOCK_METHOD0(GetArgumentHelpDescription, std::wstring());
 			MOCK_CONST_METHOD0(GetExportPluginVersion, int());
 		};
+
+		//---------------------------------------------------------------------
+		class FakeExportPlugin : public Plugin::IExportPlugin
+		{
+		  public:
+			//-----------------------------------------------------------------
+			std::optional<std::filesystem::path>
+			Export(const Plugin::CoverageData&,
+			       const std::optional<std::wstring>&) override
+			{
+				return std::nullopt;
+			}
+
+			//-----------------------------------------------------------------
+			void CheckArgument(const std::optional<std::wstring>&) override
+			{
+			}
+
+			//-----------------------------------------------------------------
+			std::wstring GetArgumentHelpDescription() override
+			{
+				throw std::runtime_error("Must be read from the metadata.");
+			}
+
+			//-----------------------------------------------------------------
+			int GetExportPluginVersion() const override
+			{
+				return Plugin::CurrentExportPluginVersion;
+			}
+		};
+
+		//---------------------------------------------------------------------
+		// Read the argument help description from the metadata and record
+		// the loaded plugins.
+		class FakePluginLoader
+		    : public Exporter::IPluginLoader<Plugin::IExportPlugin>
+		{
+		  public:
+			//-----------------------------------------------------------------
+			std::unique_ptr<Exporter::LoadedPlugin<Plugin::IExportPlugin>>
+			TryLoadPlugin(const std::filesystem::path& pluginPath,
+			              const std::string&) const override
+			{
+				loadedPluginPaths_.push_back(pluginPath);
+
+				auto plugin = std::make_unique<
+				    Exporter::LoadedPlugin<Plugin::IExportPlugin>>(nullptr);
+				plugin->Set(std::make_unique<FakeExportPlugin>());
+				return plugin;
+			}
+
+			//-----------------------------------------------------------------
+			std::optional<std::wstring> TryReadArgumentHelpDescription(
+			    const std::filesystem::path& pluginPath) const override
+			{
+				return pluginPath.stem().wstring() + L" description";
+			}
+
+			mutable std::vector<std::filesystem::path> loadedPluginPaths_;
+		};
 	}
 
 	//-------------------------------------------------------------------------
@@ -78,29 +141,41 @@ namespace ExporterTest
 		}
 
 		//---------------------------------------------------------------------
-		std::unique_ptr<Exporter::ExporterPluginManager>
-		CreateManager(std::unique_ptr<ExportPluginMock> exportPlugin)
+		void ExpectLoadPlugin(PluginLoaderMock& pluginLoader,
+		                      std::unique_ptr<ExportPluginMock> exportPlugin)
 		{
-			PluginLoaderMock pluginLoader;
+			auto sharedExportPlugin =
+			    std::make_shared<std::unique_ptr<ExportPluginMock>>(
+			        std::move(exportPlugin));
 
 			EXPECT_CALL(pluginLoader, TryLoadPlugin(pluginPath_, _))
-			    .WillOnce(testing::Invoke([&](const auto& p, const auto&) {
+			    .WillOnce(testing::Invoke([=](const auto& p, const auto&) {
 				    EXPECT_EQ(pluginPath_, p);
 				    auto plugin = std::make_unique<
 				        Exporter::LoadedPlugin<Plugin::IExportPlugin>>(nullptr);
-				    plugin->Set(std::move(exportPlugin));
+				    plugin->Set(std::move(*sharedExportPlugin));
 
 				    return plugin;
 			    }));
+		}
+
+		//---------------------------------------------------------------------
+		std::unique_ptr<Exporter::ExporterPluginManager>
+		CreateManager(std::unique_ptr<ExportPluginMock> exportPlugin)
+		{
+			auto pluginLoader = std::make_shared<PluginLoaderMock>();
+
+			ExpectLoadPlugin(*pluginLoader, std::move(exportPlugin));
 			return CreateManager(pluginLoader);
 		}
 
 		//---------------------------------------------------------------------
 		std::unique_ptr<Exporter::ExporterPluginManager>
-		CreateManager(PluginLoaderMock& pluginLoader)
+		CreateManager(std::shared_ptr<PluginLoaderMock> pluginLoader)
 		{
 			return std::make_unique<Exporter::ExporterPluginManager>(
-			    pluginLoader, std::filesystem::path{pluginFolder_.GetPath()});
+			    std::move(pluginLoader),
+			    std::filesystem::path{pluginFolder_.GetPath()});
 		}
 
 		//---------------------------------------------------------------------
@@ -161,15 +236,33 @@ namespace ExporterTest
 		    CreateExportPluginMock(Plugin::CurrentExportPluginVersion + 1);
 		ASSERT_THROW(CreateManager(std::move(exportPlugin)),
 		             std::runtime_error);
+
+		exportPlugin = CreateExportPluginMock(0);
+		ASSERT_THROW(CreateManager(std::move(exportPlugin)),
+		             std::runtime_error);
+	}
+
+	//-------------------------------------------------------------------------
+	TEST_F(ExporterPluginManagerTest, Version1)
+	{
+		auto exportPlugin = CreateExportPluginMock(1);
+		const std::optional<std::wstring> argument = L"argument";
+
+		EXPECT_CALL(*exportPlugin, Export(_, argument));
+
+		auto pluginManager = CreateManager(std::move(exportPlugin));
+		Plugin::CoverageData coverageData{L"", 0};
+
+		pluginManager->Export(pluginName_, coverageData, argument);
 	}
 
 	//-------------------------------------------------------------------------
 	TEST_F(ExporterPluginManagerTest, TryLoadPluginFailure)
 	{
-		PluginLoaderMock pluginLoader;
+		auto pluginLoader = std::make_shared<PluginLoaderMock>();
 		const auto errorMessage = "errorMessage";
 
-		EXPECT_CALL(pluginLoader, TryLoadPlugin(pluginPath_, _))
+		EXPECT_CALL(*pluginLoader, TryLoadPlugin(pluginPath_, _))
 		    .WillOnce(testing::Invoke([&](const auto&, const auto&) {
 			    throw 42;
 			    return nullptr;
@@ -202,6 +295,62 @@ namespace ExporterTest
 		pluginManager->Export(pluginName_, coverageData, argument);
 	}
 
+	//-------------------------------------------------------------------------
+	TEST_F(ExporterPluginManagerTest, LazyLoading)
+	{
+		auto pluginLoader = std::make_shared<PluginLoaderMock>();
+		const std::wstring description = L"description";
+		const std::optional<std::wstring> argument = L"argument";
+
+		EXPECT_CALL(*pluginLoader, TryReadArgumentHelpDescription(pluginPath_))
+		    .WillOnce(testing::Return(description));
+		EXPECT_CALL(*pluginLoader, TryLoadPlugin(_, _)).Times(0);
+
+		auto pluginManager = CreateManager(pluginLoader);
+		auto pluginDescriptions =
+		    pluginManager->CreateExportPluginDescriptions();
+
+		ASSERT_EQ(1, pluginDescriptions.size());
+		ASSERT_EQ(description, pluginDescriptions[0].GetParameterDescription());
+		ASSERT_TRUE(testing::Mock::VerifyAndClearExpectations(pluginLoader.get()));
+
+		auto exportPlugin = CreateExportPluginMock();
+		EXPECT_CALL(*exportPlugin, CheckArgument(argument));
+		EXPECT_CALL(*exportPlugin, Export(_, argument));
+		ExpectLoadPlugin(*pluginLoader, std::move(exportPlugin));
+
+		pluginDescriptions[0].CheckArgument(argument);
+		Plugin::CoverageData coverageData{L"", 0};
+		pluginManager->Export(pluginName_, coverageData, argument);
+	}
+
+	//-------------------------------------------------------------------------
+	TEST_F(ExporterPluginManagerTest, LoadOnlyUsedPlugin)
+	{
+		auto otherPluginPath = pluginPath_.parent_path() / "OtherPlugin.dll";
+		TestHelper::CreateEmptyFile(otherPluginPath);
+
+		auto pluginLoader = std::make_shared<FakePluginLoader>();
+		Exporter::ExporterPluginManager pluginManager{
+		    pluginLoader, pluginPath_.parent_path()};
+		auto pluginDescriptions = pluginManager.CreateExportPluginDescriptions();
+
+		ASSERT_EQ(2, pluginDescriptions.size());
+		for (const auto& pluginDescription : pluginDescriptions)
+		{
+			ASSERT_EQ(pluginDescription.GetPluginName() + L" description",
+			          pluginDescription.GetParameterDescription());
+		}
+		ASSERT_TRUE(pluginLoader->loadedPluginPaths_.empty());
+
+		Plugin::CoverageData coverageData{L"", 0};
+		pluginManager.Export(pluginName_, coverageData, std::nullopt);
+		pluginManager.Export(pluginName_, coverageData, std::nullopt);
+
+		ASSERT_EQ(std::vector<std::filesystem::path>{pluginPath_},
+		          pluginLoader->loadedPluginPaths_);
+	}
+
 	//-------------------------------------------------------------------------
 	TEST_F(ExporterPluginManagerTest, InvalidExport)
 	{
@@ -101,6 +101,30 @@ namespace ExporterTest
 		ASSERT_TRUE(Tools::FileExists(modulesPath / "module1" / (filename2 + L".html")));
 	}
 
+	//-------------------------------------------------------------------------
+	TEST_F(HtmlExporterTest, DirectoryPages)
+	{
+		fs::path testFolder = fs::path(PROJECT_DIR) / "Data";
+		Plugin::CoverageData data{ L"Test", 0 };
+		auto& module = data.AddModule(L"Module.exe");
+
+		module.AddFile(testFolder / L"TestFile1.cpp").AddLine(0, true);
+		module.AddFile(testFolder / L"Sub1" / L"File.cpp").AddLine(0, false);
+		module.AddFile(testFolder / L"Sub2" / L"Sub" / L"File.cpp").AddLine(0, true);
+
+		htmlExporter_.Export(data, output_);
+
+		auto modulesPath = output_.GetPath() / Exporter::HtmlFolderStructure::FolderModules;
+		ASSERT_TRUE(Tools::FileExists(modulesPath / "module.html"));
+		ASSERT_TRUE(Tools::FileExists(modulesPath / "module-Sub1.html"));
+		ASSERT_TRUE(Tools::FileExists(modulesPath / "module-Sub.html"));
+		ASSERT_FALSE(Tools::FileExists(modulesPath / "module-Sub2.html"));
+		ASSERT_TRUE(Tools::FileExists(modulesPath / "module" / L"TestFile1.cpp.html"));
+
+		std::wifstream ifs{ (modulesPath / "module.html").string() };
+		ASSERT_TRUE(Contains(ifs, L"href=\"module-Sub1.html\""));
+	}
+
 	//-------------------------------------------------------------------------
 	TEST_F(HtmlExporterTest, NoWarning)
 	{
@@ -0,0 +1,125 @@
+// OpenCppCoverage is an open source code coverage for C++.
+// Copyright (C) 2019 OpenCppCoverage
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "stdafx.h"
+
+#include <filesystem>
+#include <sstream>
+
+#include <boost/algorithm/string.hpp>
+
+#include "Plugin/Exporter/CoverageData.hpp"
+#include "Plugin/Exporter/ModuleCoverage.hpp"
+#include "Plugin/Exporter/FileCoverage.hpp"
+
+#include "Exporter/InvalidOutputFileException.hpp"
+#include "Exporter/LcovExporter.hpp"
+#include "tools/Tool.hpp"
+
+#include "TestHelper/TemporaryPath.hpp"
+
+namespace fs = std::filesystem;
+
+namespace ExporterTest
+{
+	namespace
+	{
+		//-------------------------------------------------------------------------
+		std::string Export(const Plugin::CoverageData& coverageData)
+		{
+			std::ostringstream ostr;
+
+			Exporter::LcovExporter().Export(coverageData, ostr);
+			return ostr.str();
+		}
+	}
+
+	//-------------------------------------------------------------------------
+	TEST(LcovExporterTest, Export)
+	{
+		Plugin::CoverageData coverageData{ L"", 0 };
+
+		coverageData.AddModule(L"EmptyModule");
+		auto& module = coverageData.AddModule(L"Module");
+
+		module.AddFile("EmptyFile");
+		auto& file = module.AddFile("File");
+
+		file.AddLine(1, true);
+		file.AddLine(2, false);
+		file.AddLine(3, true);
+
+		coverageData.AddModule(L"Module2").AddFile("File2").AddLine(10, false);
+
+		ASSERT_EQ(
+			"SF:EmptyFile\nLF:0\nLH:0\nend_of_record\n"
+			"SF:File\nDA:1,1\nDA:2,0\nDA:3,1\nLF:3\nLH:2\nend_of_record\n"
+			"SF:File2\nDA:10,0\nLF:1\nLH:0\nend_of_record\n",
+			Export(coverageData));
+	}
+
+	//-------------------------------------------------------------------------
+	TEST(LcovExporterTest, Functions)
+	{
+		Plugin::CoverageData coverageData{ L"", 0 };
+		auto& file = coverageData.AddModule(L"Module").AddFile(L"File");
+
+		file.AddLine(1, true);
+		file.AddLine(2, false);
+		file.AddLine(10, false);
+		file.AddFunction(1, L"Function1", 1, 2);
+		file.AddFunction(2, L"Function2", 10, 10);
+
+		auto result = Export(coverageData);
+
+		ASSERT_TRUE(boost::algorithm::contains(result, "FN:1,Function1\nFN:10,Function2\n"));
+		ASSERT_TRUE(boost::algorithm::contains(result, "FNDA:1,Function1\nFNDA:0,Function2\n"));
+		ASSERT_TRUE(boost::algorithm::contains(result, "FNF:2\nFNH:1\n"));
+	}
+
+	//-------------------------------------------------------------------------
+	TEST(LcovExporterTest, SpecialChars)
+	{
+		Plugin::CoverageData coverageData{ L"", 0 };
+		coverageData.AddModule(L"Module").AddFile(L"\u00e9\u00e0").AddLine(1, true);
+
+		ASSERT_TRUE(boost::algorithm::contains(Export(coverageData), "SF:\xc3\xa9\xc3\xa0\n"));
+	}
+
+	//-------------------------------------------------------------------------
+	TEST(LcovExporterTest, SubFolderDoesNotExist)
+	{
+		Plugin::CoverageData coverageData{ L"", 0 };
+		TestHelper::TemporaryPath output;
+		auto outputPath = output.GetPath() / "SubFolder" / "output.info";
+
+		ASSERT_FALSE(Tools::FileExists(outputPath));
+		Exporter::LcovExporter().Export(coverageData, outputPath);
+		ASSERT_TRUE(Tools::FileExists(outputPath));
+	}
+
+	//-------------------------------------------------------------------------
+	TEST(LcovExporterTest, InvalidFile)
+	{
+		Plugin::CoverageData coverageData{ L"", 0 };
+		TestHelper::TemporaryPath outputPath{
+			TestHelper::TemporaryPathOption::CreateAsFolder };
+
+		ASSERT_THROW(Exporter::LcovExporter().Export(
+			coverageData, outputPath.GetPath() / "InvalidFile/"),
+			Exporter::InvalidOutputFileException);
+	}
+}
@@ -0,0 +1,178 @@
+// OpenCppCoverage is an open source code coverage for C++.
+// Copyright (C) 2019 OpenCppCoverage
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "stdafx.h"
+
+#include <random>
+#include <regex>
+#include <fstream>
+
+#include "Plugin/Exporter/CoverageData.hpp"
+#include "Plugin/Exporter/ModuleCoverage.hpp"
+#include "Plugin/Exporter/FileCoverage.hpp"
+
+#include "CppCoverage/CoverageDataMerger.hpp"
+
+#include "Exporter/ModuleExportPipeline.hpp"
+#include "Exporter/CoberturaExporter.hpp"
+#include "Exporter/LcovExporter.hpp"
+#include "Exporter/Binary/BinaryExporter.hpp"
+#include "Exporter/Binary/CoverageDataSerializer.hpp"
+#include "Exporter/Binary/CoverageDataDeserializer.hpp"
+
+#include "TestHelper/TemporaryPath.hpp"
+#include "TestHelper/CoverageDataComparer.hpp"
+
+namespace ExporterTest
+{
+	namespace
+	{
+		//---------------------------------------------------------------------
+		// Modules and files have overlapping paths between seeds.
+		Plugin::CoverageData CreateCoverageData(unsigned int seed)
+		{
+			Plugin::CoverageData coverageData{ L"Name" + std::to_wstring(seed), seed % 2 ? 0 : 42 };
+			std::default_random_engine generator{ seed };
+			std::uniform_int_distribution<int> distribution(0, 1);
+
+			for (int moduleIndex = 0; moduleIndex < 10; ++moduleIndex)
+			{
+				if (!distribution(generator))
+					continue;
+				auto& module = coverageData.AddModule(L"Module" + std::to_wstring(moduleIndex));
+				for (int fileIndex = 0; fileIndex < 5; ++fileIndex)
+				{
+					if (!distribution(generator))
+						continue;
+					auto& file = module.AddFile(L"File" + std::to_wstring(fileIndex));
+					for (unsigned int line = 0; line < 20; ++line)
+					{
+						if (distribution(generator))
+							file.AddLine(line, distribution(generator) != 0);
+					}
+				}
+			}
+			return coverageData;
+		}
+
+		//---------------------------------------------------------------------
+		const unsigned int CoverageFileCount = 3;
+
+		//---------------------------------------------------------------------
+		Plugin::CoverageData MergeInMemory(bool aggregateByFile)
+		{
+			std::vector<Plugin::CoverageData> coverageDatas;
+			CppCoverage::CoverageDataMerger coverageDataMerger;
+
+			for (unsigned int seed = 0; seed <= CoverageFileCount; ++seed)
+				coverageDatas.push_back(CreateCoverageData(seed));
+
+			auto coverageData = coverageDataMerger.Merge(std::move(coverageDatas));
+			if (aggregateByFile)
+				coverageDataMerger.MergeFileCoverage(coverageData);
+			return coverageData;
+		}
+
+		//---------------------------------------------------------------------
+		class ModuleExportPipelineTest : public ::testing::TestWithParam<bool>
+		{
+		  public:
+			//-----------------------------------------------------------------
+			void SetUp() override
+			{
+				Exporter::CoverageDataSerializer serializer;
+
+				for (unsigned int seed = 0; seed < CoverageFileCount; ++seed)
+				{
+					coverageFiles_.push_back(std::make_unique<TestHelper::TemporaryPath>());
+					serializer.Serialize(CreateCoverageData(seed), *coverageFiles_.back());
+				}
+			}
+
+			//-----------------------------------------------------------------
+			std::unique_ptr<Exporter::ModuleExportPipeline> CreatePipeline() const
+			{
+				auto pipeline = std::make_unique<Exporter::ModuleExportPipeline>(GetParam());
+
+				for (const auto& coverageFile : coverageFiles_)
+					pipeline->AddCoverageFile(*coverageFile, "error");
+				pipeline->AddCoverageData(CreateCoverageData(CoverageFileCount));
+				return pipeline;
+			}
+
+		  private:
+			std::vector<std::unique_ptr<TestHelper::TemporaryPath>> coverageFiles_;
+		};
+
+		//---------------------------------------------------------------------
+		std::wstring ReadCobertura(const std::filesystem::path& path)
+		{
+			std::wifstream ifs{ path.string().c_str() };
+			std::wostringstream ostr;
+
+			ostr << ifs.rdbuf();
+			std::wregex regex(LR"(timestamp="\d*")");
+			return std::regex_replace(ostr.str(), regex, L"timestamp=\"TIMESTAMP\"");
+		}
+	}
+
+	//-------------------------------------------------------------------------
+	TEST_P(ModuleExportPipelineTest, Binary)
+	{
+		TestHelper::TemporaryPath output;
+		Exporter::BinaryExporter exporter;
+
+		CreatePipeline()->Export({ { &exporter, output.GetPath() } });
+
+		auto coverageData = Exporter::CoverageDataDeserializer{}.Deserialize(output, "error");
+		TestHelper::CoverageDataComparer().AssertEquals(MergeInMemory(GetParam()), coverageData);
+	}
+
+	//-------------------------------------------------------------------------
+	TEST_P(ModuleExportPipelineTest, Cobertura)
+	{
+		TestHelper::TemporaryPath output;
+		TestHelper::TemporaryPath expectedOutput;
+		Exporter::CoberturaExporter exporter;
+
+		CreatePipeline()->Export({ { &exporter, output.GetPath() } });
+		exporter.Export(MergeInMemory(GetParam()), expectedOutput);
+
+		ASSERT_EQ(ReadCobertura(expectedOutput), ReadCobertura(output));
+	}
+
+	//-------------------------------------------------------------------------
+	TEST_P(ModuleExportPipelineTest, Lcov)
+	{
+		TestHelper::TemporaryPath output;
+		Exporter::LcovExporter exporter;
+
+		CreatePipeline()->Export({ { &exporter, output.GetPath() } });
+
+		std::ifstream ifs{ output.GetPath().string().c_str(), std::ios::binary };
+		std::ostringstream result;
+		std::ostringstream expectedResult;
+
+		result << ifs.rdbuf();
+		exporter.Export(MergeInMemory(GetParam()), expectedResult);
+		ASSERT_EQ(expectedResult.str(), result.str());
+	}
+
+	//-------------------------------------------------------------------------
+	INSTANTIATE_TEST_CASE_P(ModuleExportPipelineTest,
+	                        ModuleExportPipelineTest,
+	                        ::testing::Values(false, true));
+}
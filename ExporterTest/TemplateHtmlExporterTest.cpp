@@ -21,6 +21,7 @@
 #include "Exporter/Html/TemplateHtmlExporter.hpp"
 #include "Exporter/Html/CTemplate.hpp"
 #include "CppCoverage/CoverageRate.hpp"
+#include "Plugin/Exporter/FunctionCoverage.hpp"
 #include "Tools/Tool.hpp"
 
 using namespace Exporter;
@@ -102,6 +103,16 @@ namespace ExporterTest
 				AddTag(ofs, tag);
 			}
 
+			AddSection(ofs, TemplateHtmlExporter::FunctionTableSection, [&]()
+			{
+				AddSection(ofs, TemplateHtmlExporter::FunctionSection, [&]()
+				{
+					AddTag(ofs, TemplateHtmlExporter::NameTemplate);
+					AddTag(ofs, TemplateHtmlExporter::LineNumberTemplate);
+					AddTag(ofs, TemplateHtmlExporter::CoverRateTemplate);
+				});
+			});
+
 			return templatePath;
 		}
 
@@ -190,7 +201,7 @@ namespace ExporterTest
 		auto outputFile = output_folder.GetPath() / "file";
 		std::wstring sourceTitle = L"SourceTitle";
 		std::wstring sourceContent = L"SourceContent";
-		exporter.GenerateSourceTemplate(sourceTitle, sourceContent, true, outputFile);
+		exporter.GenerateSourceTemplate(sourceTitle, sourceContent, true, {}, outputFile);
 		auto templateValues = ReadTemplate(outputFile);
 
 		ASSERT_EQ(sourceTitle, templateValues.at(TemplateHtmlExporter::TitleTemplate));
@@ -198,10 +209,31 @@ namespace ExporterTest
 		ASSERT_NE(L"", templateValues.at(TemplateHtmlExporter::BodyOnLoadTemplate));
 		ASSERT_EQ(L"", templateValues.at(TemplateHtmlExporter::SourceWarningMessageTemplate));
 
-		exporter.GenerateSourceTemplate(sourceTitle, sourceContent, false, outputFile);
+		exporter.GenerateSourceTemplate(sourceTitle, sourceContent, false, {}, outputFile);
 		templateValues = ReadTemplate(outputFile);
 
 		ASSERT_EQ(L"", templateValues.at(TemplateHtmlExporter::BodyOnLoadTemplate));
 		ASSERT_NE(L"", templateValues.at(TemplateHtmlExporter::SourceWarningMessageTemplate));
 	}
-}
\ No newline at end of file
+
+	//-------------------------------------------------------------------------
+	TEST_F(TemplateHtmlExporterTest, FileTemplateFunctions)
+	{
+		auto sourceTemplate = CreateSourceTemplate();
+		TemplateHtmlExporter exporter{ sourceTemplate, sourceTemplate };
+		auto outputFile = output_folder.GetPath() / "file";
+
+		exporter.GenerateSourceTemplate(L"SourceTitle", L"SourceContent", true, {}, outputFile);
+		auto templateValues = ReadTemplate(outputFile);
+		ASSERT_EQ(0, templateValues.count(TemplateHtmlExporter::LineNumberTemplate));
+
+		std::vector<Plugin::FunctionCoverage> functions;
+		functions.emplace_back(1, L"Function", 42, 44, 2, 1);
+		exporter.GenerateSourceTemplate(L"SourceTitle", L"SourceContent", true, functions, outputFile);
+		templateValues = ReadTemplate(outputFile);
+
+		ASSERT_EQ(L"Function", templateValues.at(TemplateHtmlExporter::NameTemplate));
+		ASSERT_EQ(L"42", templateValues.at(TemplateHtmlExporter::LineNumberTemplate));
+		ASSERT_EQ(L"50", templateValues.at(TemplateHtmlExporter::CoverRateTemplate));
+	}
+}
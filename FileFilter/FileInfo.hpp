@@ -18,6 +18,7 @@
 
 #include <windows.h>
 #include <vector>
+#include <memory_resource>
 #include <filesystem>
 
 #include "LineInfo.hpp"
@@ -31,10 +32,17 @@ namespace FileFilter
 			const std::filesystem::path& filePath,
 			std::vector<LineInfo>&& lineInfoColllection)
 			: filePath_{ filePath }
+			, lineInfoColllection_{ lineInfoColllection.begin(), lineInfoColllection.end() }
+		{}
+
+		FileInfo(
+			const std::filesystem::path& filePath,
+			std::pmr::vector<LineInfo>&& lineInfoColllection)
+			: filePath_{ filePath }
 			, lineInfoColllection_{ std::move(lineInfoColllection) }
 		{}
 
 		const std::filesystem::path filePath_;
-		const std::vector<LineInfo> lineInfoColllection_;
+		const std::pmr::vector<LineInfo> lineInfoColllection_;
 	};	
 }
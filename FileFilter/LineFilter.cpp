@@ -21,7 +21,6 @@
 #include "FileFilter/LineInfo.hpp"
 #include "Tools/Log.hpp"
 #include "Tools/Tool.hpp"
-#include "Tools/MappedFile.hpp"
 
 namespace FileFilter
 {
@@ -86,13 +85,17 @@ namespace FileFilter
 	{
 		if (path != filePath_)
 		{
-			mappedFileForFilePath_ = Tools::MappedFile::TryCreate(path);
-			if (mappedFileForFilePath_)
+			sourceFileForFilePath_ = Tools::SourceRepository::GetInstance().GetSourceFile(path);
+
+			// Empty files are handled as missing files: all lines are selected.
+			if (sourceFileForFilePath_ && sourceFileForFilePath_->GetLines().empty())
+				sourceFileForFilePath_ = nullptr;
+			if (sourceFileForFilePath_)
 				++fileReadCount_;
 			filePath_ = path;
 		}
 
-		return mappedFileForFilePath_ ? &mappedFileForFilePath_->GetLines() : nullptr;
+		return sourceFileForFilePath_ ? &sourceFileForFilePath_->GetLines() : nullptr;
 	}
 
 	//-------------------------------------------------------------------------
@@ -18,14 +18,12 @@
 
 #include "FileFilterExport.hpp"
 #include <filesystem>
+#include <memory>
 #include <vector>
 #include <string>
 #include <regex>
 
-namespace Tools
-{
-	class MappedFile;
-}
+#include "Tools/SourceRepository.hpp"
 
 namespace FileFilter
 {	
@@ -55,7 +53,7 @@ namespace FileFilter
 
 		std::vector<std::regex> excludedLineRegexes_;
 		std::filesystem::path filePath_;
-		std::unique_ptr<Tools::MappedFile> mappedFileForFilePath_;
+		std::shared_ptr<const Tools::SourceRepository::SourceFile> sourceFileForFilePath_;
 		int fileReadCount_;
 		const bool enableLog_;
 	};
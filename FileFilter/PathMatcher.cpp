@@ -23,7 +23,9 @@
 #include <boost/algorithm/string.hpp>
 
 #include <unordered_map>
-#include <map>
+#include <algorithm>
+
+#include "Tools/PathInterner.hpp"
 
 #include "AmbiguousPathException.hpp"
 #include "File.hpp"
@@ -45,12 +47,23 @@ namespace FileFilter
 	}
 
 	//-------------------------------------------------------------------------
+	// Each engine interns the paths it sees in its own PathInterner so they
+	// are released with the matcher instead of growing the process-wide one.
 	class PathMatcher::IPathMatcherEngine
 	{
 	public:
 		virtual ~IPathMatcherEngine() = default;
 		virtual File* Match(const fs::path&) = 0;
 		virtual PathCollection GetUnmatchedPaths() const = 0;
+
+	protected:
+		//---------------------------------------------------------------------
+		Tools::PathId GetCanonicalId(const fs::path& path)
+		{
+			return pathInterner_.GetCanonicalId(pathInterner_.Intern(path));
+		}
+
+		Tools::PathInterner pathInterner_;
 	};
 
 	//---------------------------------------------------------------------
@@ -64,15 +77,16 @@ namespace FileFilter
 			{
 				auto path = NormalizePath(file.GetPath());
 				auto filename = path.filename().wstring();
-				postFixPathByFilename_[filename].emplace_back(std::move(file));
+				postFixPathByFilename_[filename].emplace_back(std::move(file), path.wstring());
 			}			
 		}
 
 		//-----------------------------------------------------------------
 		File* Match(const fs::path& path) override
 		{		
-			const auto normalizedPath = NormalizePath(path);
-			const auto filenameStr = normalizedPath.filename().wstring();
+			const auto canonicalId = GetCanonicalId(path);
+			const auto& normalizedPath = pathInterner_.GetNormalizedPath(canonicalId);
+			const auto filenameStr = fs::path{ normalizedPath }.filename().wstring();
 			auto it = postFixPathByFilename_.find(filenameStr);
 
 			if (it == postFixPathByFilename_.end())
@@ -80,17 +94,17 @@ namespace FileFilter
 						
 			for (auto& pathData : it->second)
 			{
-				auto postFixPath = NormalizePath(pathData.postFixPath_.GetPath());
+				const auto& postFixPath = pathData.normalizedPostFixPath_;
 
-				if (boost::algorithm::ends_with(normalizedPath.wstring(), postFixPath.wstring()))
+				if (boost::algorithm::ends_with(normalizedPath, postFixPath))
 				{
-					if (pathData.matchedPath_ && 
-						!boost::algorithm::equals(pathData.matchedPath_->wstring(), normalizedPath.wstring()))
+					if (pathData.matchedPathId_ && *pathData.matchedPathId_ != canonicalId)
 					{
 						throw AmbiguousPathException(postFixPath,
-							*pathData.matchedPath_, normalizedPath);
+							pathInterner_.GetNormalizedPath(*pathData.matchedPathId_), 
+							normalizedPath);
 					}
-					pathData.matchedPath_ = normalizedPath;
+					pathData.matchedPathId_ = canonicalId;
 					return &pathData.postFixPath_;
 				}
 			}
@@ -108,7 +122,7 @@ namespace FileFilter
 				const auto& postFixPathCollection = pair.second;
 				for (const auto& pathData : postFixPathCollection)
 				{
-					if (!pathData.matchedPath_)
+					if (!pathData.matchedPathId_)
 						paths.push_back(pathData.postFixPath_.GetPath());
 				}
 			}
@@ -119,11 +133,15 @@ namespace FileFilter
 	private:
 		struct PathData
 		{
-			explicit PathData(File&& postFixPath) : postFixPath_{ std::move(postFixPath) } {}
+			explicit PathData(File&& postFixPath, std::wstring&& normalizedPostFixPath)
+				: postFixPath_{ std::move(postFixPath) }
+				, normalizedPostFixPath_{ std::move(normalizedPostFixPath) }
+			{}
 			PathData(PathData&& pathData) = default;
 			
 			File postFixPath_;
-			boost::optional<fs::path> matchedPath_;
+			std::wstring normalizedPostFixPath_;
+			boost::optional<Tools::PathId> matchedPathId_;
 		};
 		
 		std::unordered_map<std::wstring, std::vector<PathData>> postFixPathByFilename_;
@@ -139,16 +157,14 @@ namespace FileFilter
 			for (auto& file : files)
 			{
 				auto fullPath = parentPath / file.GetPath();				
-				auto normalizedFullPathStr = NormalizePath(fullPath).wstring();
-				pathDataByPath_.emplace(normalizedFullPathStr, PathData{ std::move(file) });
+				pathDataByPath_.emplace(GetCanonicalId(fullPath), PathData{ std::move(file) });
 			}
 		}
 
 		//-----------------------------------------------------------------
 		File* Match(const fs::path& path) override
 		{
-			auto normalizedPath = NormalizePath(path);
-			auto it = pathDataByPath_.find(normalizedPath.wstring());
+			auto it = pathDataByPath_.find(GetCanonicalId(path));
 
 			if (it == pathDataByPath_.end())
 				return nullptr;
@@ -168,8 +184,9 @@ namespace FileFilter
 			{
 				const auto& pathData = pair.second;
 				if (!pathData.haveBeenMarched_)
-					paths.push_back(pair.first);
+					paths.push_back(pathInterner_.GetNormalizedPath(pair.first));
 			}
+			std::sort(paths.begin(), paths.end());
 
 			return paths;
 		}
@@ -189,7 +206,7 @@ namespace FileFilter
 			bool haveBeenMarched_;
 		};
 		
-		std::map<fs::path, PathData> pathDataByPath_;
+		std::unordered_map<Tools::PathId, PathData> pathDataByPath_;
 	};
 
 	//-------------------------------------------------------------------------
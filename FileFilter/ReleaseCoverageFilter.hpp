@@ -20,6 +20,7 @@
 #include <unordered_set>
 #include <unordered_map>
 #include <memory>
+#include <memory_resource>
 #include <filesystem>
 
 namespace FileFilter
@@ -48,7 +49,7 @@ namespace FileFilter
 		struct FileData;
 		std::unique_ptr<FileData>
 		UpdateLineDataCaches(const std::filesystem::path& filePath,
-		                     const std::vector<LineInfo>&);
+		                     const std::pmr::vector<LineInfo>&);
 
 		const std::unique_ptr<IRelocationsExtractor> relocationsExtractor_;
 
@@ -0,0 +1,90 @@
+// OpenCppCoverage is an open source code coverage for C++.
+// Copyright (C) 2019 OpenCppCoverage
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "stdafx.h"
+#include "Subcommands.hpp"
+
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+#include "OpenCppCoverage.hpp"
+
+#include "CppCoverage/MessageChannel.hpp"
+
+#include "Exporter/CoverageAggregationServer.hpp"
+
+#include "Tools/Log.hpp"
+
+namespace cov = CppCoverage;
+
+namespace OpenCppCoverage
+{
+	//-----------------------------------------------------------------------------
+	int RunAggregationServer(const std::wstring& pipeName)
+	{
+		Exporter::CoverageAggregator coverageAggregator;
+		Exporter::CoverageAggregationServer coverageAggregationServer{ coverageAggregator };
+		cov::NamedPipeListener listener{ pipeName };
+
+		Tools::InitConsoleAndFileLog(LogFilename);
+		LOG_INFO << L"Coverage aggregation server is listening on " << pipeName;
+		coverageAggregationServer.Serve(listener);
+		LOG_INFO << L"Coverage aggregation server stopped.";
+
+		return 0;
+	}
+
+	//-----------------------------------------------------------------------------
+	int RunAggregationClient(
+		const std::wstring& pipeName,
+		const std::wstring& command,
+		const std::vector<std::filesystem::path>& paths)
+	{
+		using Server = Exporter::CoverageAggregationServer;
+		auto channel = cov::NamedPipeChannel::Connect(pipeName);
+
+		if (command == L"upload")
+		{
+			for (const auto& path : paths)
+			{
+				std::ifstream ifs{ path, std::ios::binary };
+				if (!ifs)
+					throw std::runtime_error("Cannot open " + path.string());
+				Server::Upload(*channel, { std::istreambuf_iterator<char>{ ifs }, {} });
+			}
+		}
+		else if (command == L"download")
+		{
+			auto binaryCoverageData = Server::DownloadMergedCoverageData(*channel);
+			std::ofstream ofs{ paths.front(), std::ios::binary };
+			if (!ofs.write(binaryCoverageData.data(), binaryCoverageData.size()))
+				throw std::runtime_error("Cannot write " + paths.front().string());
+		}
+		else if (command == L"summary")
+		{
+			auto summary = Server::GetSummary(*channel);
+			std::wcout << L"Uploads: " << summary.uploadCount << std::endl;
+			std::wcout << L"Modules: " << summary.moduleCount << std::endl;
+			std::wcout << L"Files: " << summary.fileCount << std::endl;
+			std::wcout << L"Executed lines: " << summary.executedLineCount
+				<< L"/" << summary.lineCount << std::endl;
+		}
+		else
+			Server::SendStopRequest(*channel);
+		return 0;
+	}
+}
@@ -0,0 +1,81 @@
+// OpenCppCoverage is an open source code coverage for C++.
+// Copyright (C) 2019 OpenCppCoverage
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "stdafx.h"
+#include "Subcommands.hpp"
+
+#include <sstream>
+#include <boost/make_shared.hpp>
+
+#include "OpenCppCoverage.hpp"
+
+#include "CppCoverage/CoverageDaemon.hpp"
+#include "CppCoverage/MessageChannel.hpp"
+
+#include "Tools/Tool.hpp"
+#include "Tools/Log.hpp"
+#include "Tools/WarningManager.hpp"
+#include "Tools/ScopedAction.hpp"
+
+namespace cov = CppCoverage;
+
+namespace OpenCppCoverage
+{
+	//-----------------------------------------------------------------------------
+	// The objects used by requestHandler are reused by all requests so the
+	// loaded plugins, the line tables and the filter decisions stay warm.
+	int RunDaemon(
+		const std::wstring& pipeName,
+		std::shared_ptr<Tools::WarningManager> warningManager,
+		const DaemonRequestHandler& requestHandler)
+	{
+		const auto daemonWorkingDirectory = std::filesystem::current_path();
+
+		Tools::InitConsoleAndFileLog(LogFilename);
+		cov::CoverageDaemon coverageDaemon{ [&](const cov::DaemonRequest& request) {
+			// Requests are handled one at a time so the log and the current
+			// directory can be switched to the client ones.
+			auto output = boost::make_shared<std::ostringstream>();
+			std::wostringstream emptyOptionsExplanation;
+			std::vector<const char*> argv = { "OpenCppCoverage.exe" };
+			for (const auto& argument : request.arguments)
+				argv.push_back(argument.c_str());
+
+			LOG_INFO << L"Run request from " << request.workingDirectory;
+			Tools::InitLoggerOstream(output);
+			Tools::ScopedAction restoreDaemonState{ [&]() {
+				std::error_code error;
+				warningManager->Clear();
+				std::filesystem::current_path(daemonWorkingDirectory, error);
+				Tools::InitConsoleAndFileLog(LogFilename);
+			} };
+			std::filesystem::current_path(request.workingDirectory);
+
+			auto exitCode = requestHandler(
+				static_cast<int>(argv.size()), argv.data(), &emptyOptionsExplanation, request);
+
+			return cov::DaemonResponse{ exitCode,
+				Tools::ToLocalString(emptyOptionsExplanation.str()) + output->str() };
+		} };
+
+		cov::NamedPipeListener listener{ pipeName };
+		LOG_INFO << L"Coverage daemon is listening on " << pipeName;
+		coverageDaemon.Serve(listener);
+		LOG_INFO << L"Coverage daemon stopped.";
+
+		return 0;
+	}
+}
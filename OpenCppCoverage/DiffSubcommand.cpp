@@ -0,0 +1,64 @@
+// OpenCppCoverage is an open source code coverage for C++.
+// Copyright (C) 2019 OpenCppCoverage
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "stdafx.h"
+#include "Subcommands.hpp"
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#include "Exporter/CoverageDiff.hpp"
+
+#include "Tools/Tool.hpp"
+
+namespace OpenCppCoverage
+{
+	//-----------------------------------------------------------------------------
+	int RunDiff(
+		const std::filesystem::path& beforeCoverageFile,
+		const std::filesystem::path& afterCoverageFile,
+		const std::wstring& format,
+		const boost::optional<std::filesystem::path>& output)
+	{
+		Exporter::CoverageDiff coverageDiff;
+		std::ostringstream ostr;
+
+		auto result = coverageDiff.Compute(beforeCoverageFile, afterCoverageFile);
+		if (format == L"text")
+		{
+			std::wostringstream text;
+			coverageDiff.WriteText(result, text);
+			ostr << Tools::ToUtf8String(text.str());
+		}
+		else if (format == L"json")
+			coverageDiff.WriteJson(result, ostr);
+		else
+			coverageDiff.WriteHtml(result, ostr);
+
+		// The console is written with std::wcout like the other subcommands.
+		if (!output)
+			std::wcout << Tools::Utf8ToWString(ostr.str());
+		else
+		{
+			Tools::CreateParentFolderIfNeeded(*output);
+			std::ofstream ofs{ *output, std::ios::binary };
+			if (!(ofs << ostr.str()))
+				throw std::runtime_error("Cannot write " + output->string());
+		}
+		return 0;
+	}
+}
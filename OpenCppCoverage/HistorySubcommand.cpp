@@ -0,0 +1,76 @@
+// OpenCppCoverage is an open source code coverage for C++.
+// Copyright (C) 2019 OpenCppCoverage
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "stdafx.h"
+#include "Subcommands.hpp"
+
+#include <iostream>
+
+#include "CppCoverage/CoverageDataMerger.hpp"
+
+#include "Exporter/Binary/CoverageDataDeserializer.hpp"
+#include "Exporter/Binary/CoverageDataSerializer.hpp"
+#include "Exporter/CoverageHistory.hpp"
+
+#include "Plugin/Exporter/CoverageData.hpp"
+
+namespace cov = CppCoverage;
+
+namespace OpenCppCoverage
+{
+	//-----------------------------------------------------------------------------
+	int RunHistory(
+		const std::filesystem::path& folder,
+		const std::wstring& command,
+		const std::vector<std::wstring>& arguments)
+	{
+		Exporter::CoverageHistory coverageHistory{ folder };
+
+		if (command == L"add")
+		{
+			// Several coverage files of the same revision are merged.
+			std::vector<Plugin::CoverageData> coverageDatas;
+			for (auto it = arguments.begin() + 1; it != arguments.end(); ++it)
+			{
+				std::filesystem::path path{ *it };
+				coverageDatas.push_back(Exporter::CoverageDataDeserializer{}.Deserialize(
+					path, "Cannot extract coverage data from " + path.string()));
+			}
+			coverageHistory.Add(arguments[0],
+				cov::CoverageDataMerger{}.Merge(std::move(coverageDatas)));
+		}
+		else if (command == L"get")
+		{
+			Exporter::CoverageDataSerializer{}.Serialize(
+				coverageHistory.Get(arguments[0]), arguments[1]);
+		}
+		else if (command == L"list")
+		{
+			for (const auto& revision : coverageHistory.GetRevisions())
+				std::wcout << revision << std::endl;
+		}
+		else
+		{
+			auto pathPrefix = arguments.empty() ? L"" : arguments[0];
+			for (const auto& point : coverageHistory.GetTrend(pathPrefix))
+			{
+				std::wcout << point.revision << L'\t' << point.executedLineCount
+					<< L'/' << point.lineCount << std::endl;
+			}
+		}
+		return 0;
+	}
+}
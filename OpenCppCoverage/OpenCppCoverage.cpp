@@ -16,8 +16,18 @@
 
 #include "stdafx.h"
 #include "OpenCppCoverage.hpp"
-
+#include "Subcommands.hpp"
+
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <future>
+#include <iomanip>
 #include <iostream>
+#include <sstream>
+#include <thread>
+#include <boost/optional.hpp>
 
 #include "CppCoverage/CodeCoverageRunner.hpp"
 #include "CppCoverage/CoverageFilterSettings.hpp"
@@ -25,15 +35,24 @@
 #include "CppCoverage/Options.hpp"
 #include "CppCoverage/ProgramOptions.hpp"
 #include "CppCoverage/CoverageDataMerger.hpp"
+#include "CppCoverage/CoverageDataAccumulator.hpp"
+#include "CppCoverage/CoverageSummary.hpp"
 #include "CppCoverage/OptionsExport.hpp"
 #include "CppCoverage/RunCoverageSettings.hpp"
 #include "CppCoverage/ExportOptionParser.hpp"
+#include "CppCoverage/CoverageJournal.hpp"
+#include "CppCoverage/CoverageDaemon.hpp"
+#include "CppCoverage/MessageChannel.hpp"
 
 #include "Exporter/Html/HtmlExporter.hpp"
 #include "Exporter/CoberturaExporter.hpp"
+#include "Exporter/LcovExporter.hpp"
 #include "Exporter/Binary/BinaryExporter.hpp"
 #include "Exporter/Binary/CoverageDataDeserializer.hpp"
+#include "Exporter/Binary/CoverageDataSerializer.hpp"
+#include "Exporter/ModuleExportPipeline.hpp"
 #include "Exporter/Plugin/ExporterPluginManager.hpp"
+#include "Exporter/Plugin/ExportPluginHost.hpp"
 #include "Exporter/Plugin/PluginLoader.hpp"
 
 #include "Plugin/Exporter/IExportPlugin.hpp"
@@ -41,6 +60,7 @@
 #include "Tools/Tool.hpp"
 #include "Tools/Log.hpp"
 #include "Tools/WarningManager.hpp"
+#include "Tools/ScopedAction.hpp"
 
 namespace cov = CppCoverage;
 namespace logging = boost::log;
@@ -90,19 +110,38 @@ namespace OpenCppCoverage
 				std::unique_ptr<Exporter::IExporter>(std::make_unique<Exporter::HtmlExporter>(GetTemplateFolder())));
 			exporters.emplace(cov::OptionsExportType::Cobertura,
 				std::unique_ptr<Exporter::IExporter>(std::make_unique<Exporter::CoberturaExporter>()));
+			exporters.emplace(cov::OptionsExportType::CoberturaDirectory,
+				std::unique_ptr<Exporter::IExporter>(std::make_unique<Exporter::CoberturaExporter>(
+					Exporter::CoberturaExporter::PackageType::Directory)));
 			exporters.emplace(cov::OptionsExportType::Binary,
 				std::unique_ptr<Exporter::IExporter>(std::make_unique<Exporter::BinaryExporter>()));
+			exporters.emplace(cov::OptionsExportType::Lcov,
+				std::unique_ptr<Exporter::IExporter>(std::make_unique<Exporter::LcovExporter>()));
 
 			auto defaultPathPrefix = GetDefaultPathPrefix(options);
 
+			// Plugins running in their own process export at the same time as
+			// the other exporters. Futures wait for their export when destroyed.
+			std::vector<std::future<void>> pluginExports;
 			for (const auto& singleExport : exports)
 			{
 				auto exportType = singleExport.GetType();
 				auto parameter = singleExport.GetParameter();
 
 				if (exportType == cov::OptionsExportType::Plugin)
-					exporterPluginManager.Export(
-						singleExport.GetName(), coverage, parameter);
+				{
+					if (exporterPluginManager.IsOutOfProcessExportEnabled())
+					{
+						pluginExports.push_back(std::async(std::launch::async,
+							[&exporterPluginManager, &coverage, &singleExport, parameter]() {
+								exporterPluginManager.Export(
+									singleExport.GetName(), coverage, parameter);
+							}));
+					}
+					else
+						exporterPluginManager.Export(
+							singleExport.GetName(), coverage, parameter);
+				}
 				else
 				{
 					const auto& exporter = exporters.at(exportType);
@@ -114,6 +153,76 @@ namespace OpenCppCoverage
 					exporter->Export(coverage, output);
 				}
 			}
+			for (auto& pluginExport : pluginExports)
+				pluginExport.get();
+		}
+
+		//-----------------------------------------------------------------------------
+		std::unique_ptr<Exporter::IModuleExporter> CreateModuleExporter(cov::OptionsExportType exportType)
+		{
+			switch (exportType)
+			{
+			case cov::OptionsExportType::Html: 
+				return std::make_unique<Exporter::HtmlExporter>(GetTemplateFolder());
+			case cov::OptionsExportType::Cobertura: 
+				return std::make_unique<Exporter::CoberturaExporter>();
+			case cov::OptionsExportType::CoberturaDirectory:
+				return std::make_unique<Exporter::CoberturaExporter>(
+					Exporter::CoberturaExporter::PackageType::Directory);
+			case cov::OptionsExportType::Binary: 
+				return std::make_unique<Exporter::BinaryExporter>();
+			case cov::OptionsExportType::Lcov:
+				return std::make_unique<Exporter::LcovExporter>();
+			}
+			throw std::runtime_error("Export type is not supported module by module.");
+		}
+
+		//-----------------------------------------------------------------------------
+		void ExportModuleByModule(
+			const cov::Options& options,
+			Exporter::ModuleExportPipeline& moduleExportPipeline)
+		{
+			std::vector<std::unique_ptr<Exporter::IModuleExporter>> exporters;
+			Exporter::ModuleExportPipeline::ModuleExporters moduleExporters;
+			auto defaultPathPrefix = GetDefaultPathPrefix(options);
+
+			// Each export has its own exporter as an export lasts for all modules.
+			for (const auto& singleExport : options.GetExports())
+			{
+				auto parameter = singleExport.GetParameter();
+
+				exporters.push_back(CreateModuleExporter(singleExport.GetType()));
+				auto& exporter = *exporters.back();
+				auto output =
+					(parameter)
+					? fs::path{ *parameter }
+				: exporter.GetDefaultPath(defaultPathPrefix);
+
+				moduleExporters.emplace_back(&exporter, output);
+			}
+
+			moduleExportPipeline.Export(moduleExporters);
+		}
+
+		//-----------------------------------------------------------------------------
+		std::unique_ptr<Exporter::ModuleExportPipeline> CreateModuleExportPipeline(const cov::Options& options)
+		{
+			auto moduleExportPipeline = std::make_unique<Exporter::ModuleExportPipeline>(
+				options.IsAggregateByFileModeEnabled());
+
+			for (const auto& path : options.GetInputCoveragePaths())
+			{
+				auto errorMsg = "Cannot extract coverage data from " + path.string();
+
+				LOG_INFO << L"Index coverage file: " << path.wstring();
+				moduleExportPipeline->AddCoverageFile(path, errorMsg);
+			}
+			for (const auto& path : options.GetInputCoverageJournalPaths())
+			{
+				LOG_INFO << L"Recover coverage journal: " << path.wstring();
+				moduleExportPipeline->AddCoverageData(cov::CoverageJournal::Recover(path));
+			}
+			return moduleExportPipeline;
 		}
 
 		//-----------------------------------------------------------------------------
@@ -129,73 +238,233 @@ namespace OpenCppCoverage
 				LOG_INFO << L"Load coverage file: " << path.wstring();
 				coverageDatas.push_back(coverageDataDeserializer.Deserialize(path, errorMsg));
 			}
+			for (const auto& path : options.GetInputCoverageJournalPaths())
+			{
+				LOG_INFO << L"Recover coverage journal: " << path.wstring();
+				coverageDatas.push_back(cov::CoverageJournal::Recover(path));
+			}
 			return coverageDatas;
 		}
 
 		//-----------------------------------------------------------------------------
-		void InitLogger(const cov::Options& options)
+		cov::SnapshotHandler CreateSnapshotHandler(const cov::SnapshotSettings& snapshotSettings)
+		{
+			const auto& directory = snapshotSettings.GetDirectory();
+			std::filesystem::create_directories(directory);
+			LOG_INFO << L"Coverage snapshots will be written to " << directory.wstring();
+
+			// Several runs can share the same directory.
+			auto now = std::time(nullptr);
+			std::wostringstream prefix;
+			prefix << L"Snapshot-" << std::put_time(std::localtime(&now), L"%Y-%m-%d-%Hh%Mm%Ss")
+				<< L'-' << GetCurrentProcessId() << L'-';
+
+			// Snapshots are handled one at a time.
+			int index = 0;
+			return [directory, prefix = prefix.str(), index](Plugin::CoverageData&& coverageData) mutable {
+				std::wostringstream filename;
+				filename << prefix << std::setw(5) << std::setfill(L'0') << index++ << L".cov";
+
+				auto path = directory / filename.str();
+				Exporter::CoverageDataSerializer{}.Serialize(coverageData, path);
+				LOG_INFO << L"Coverage snapshot written to " << path.wstring();
+			};
+		}
+
+		//-----------------------------------------------------------------------------
+		std::vector<cov::StartInfo> GetStartInfos(const cov::Options& options)
+		{
+			std::vector<cov::StartInfo> startInfos;
+			if (const auto* startInfo = options.GetStartInfo())
+				startInfos.push_back(*startInfo);
+			const auto& batchStartInfos = options.GetBatchStartInfos();
+			startInfos.insert(startInfos.end(), batchStartInfos.begin(), batchStartInfos.end());
+
+			return startInfos;
+		}
+
+		//-----------------------------------------------------------------------------
+		size_t GetJobCount(const cov::Options& options)
 		{
-			auto logLevel = logging::trivial::info;
+			return options.GetBatchJobCount().get_value_or(
+				std::max<size_t>(std::thread::hardware_concurrency(), 1));
+		}
 
+		//-----------------------------------------------------------------------------
+		int RunBatchCoverage(
+			const cov::Options& options,
+			cov::CodeCoverageRunner& codeCoverageRunner,
+			const cov::RunCoverageSettings& runCoverageSettings,
+			Exporter::ModuleExportPipeline* moduleExportPipeline,
+			std::vector<Plugin::CoverageData>& coverageDatas)
+		{
+			auto startInfos = GetStartInfos(options);
+			auto jobCount = GetJobCount(options);
+			LOG_INFO << L"Run " << startInfos.size() << L" commands, " << jobCount << L" at the same time.";
+
+			// Merge each result into the same accumulator as soon as it is
+			// available to keep a single coverage in memory.
+			int exitCode = 0;
+			bool hasCoverageData = false;
+			cov::CoverageDataAccumulator coverageDataAccumulator;
+			codeCoverageRunner.RunCoverage(runCoverageSettings, startInfos, jobCount,
+				[&](Plugin::CoverageData&& coverageData) {
+					LOG_INFO << L"Coverage of " << coverageData.GetName() << L" completed.";
+					if (coverageData.GetExitCode())
+						exitCode = coverageData.GetExitCode();
+					if (moduleExportPipeline)
+					{
+						moduleExportPipeline->AddCoverageData(std::move(coverageData));
+						return;
+					}
+					coverageDataAccumulator.Add(std::move(coverageData));
+					hasCoverageData = true;
+				});
+			if (hasCoverageData)
+				coverageDatas.push_back(coverageDataAccumulator.Release());
+			return exitCode;
+		}
+
+		//-----------------------------------------------------------------------------
+		int RunCoverageSummary(
+			const cov::Options& options,
+			cov::CodeCoverageRunner& codeCoverageRunner,
+			const cov::RunCoverageSettings& runCoverageSettings)
+		{
+			auto coverageSummary = codeCoverageRunner.RunCoverageSummary(
+				runCoverageSettings, GetStartInfos(options), GetJobCount(options));
+			if (options.IsAggregateByFileModeEnabled())
+				coverageSummary.MergeFileCoverage();
+
+			std::wostringstream ostr;
+			coverageSummary.WriteText(ostr);
+			LOG_INFO << L"Coverage summary:" << std::endl << ostr.str();
+
+			if (const auto& outputPath = options.GetSummaryOutputPath())
+			{
+				Tools::CreateParentFolderIfNeeded(*outputPath);
+				std::ofstream ofs{ *outputPath };
+				if (!ofs)
+					throw std::runtime_error("Cannot write the summary to " + outputPath->string());
+				coverageSummary.WriteJson(ofs);
+				LOG_INFO << L"Coverage summary written to " << outputPath->wstring();
+			}
+
+			auto exitCode = coverageSummary.GetExitCode();
+			if (exitCode)
+				LOG_ERROR << L"Your program stop with error code: " << exitCode;
+
+			const auto& threshold = options.GetSummaryThreshold();
+			if (threshold && coverageSummary.GetCoverageRate().GetRate() * 100 < *threshold)
+			{
+				LOG_ERROR << L"The coverage is lower than " << *threshold << L"%.";
+				if (!exitCode)
+					exitCode = CoverageThresholdExitCode;
+			}
+			return exitCode;
+		}
+
+		//-----------------------------------------------------------------------------
+		logging::trivial::severity_level GetLogLevel(const cov::Options& options)
+		{
 			switch (options.GetLogLevel())
 			{
-			case cov::LogLevel::Verbose: logLevel = logging::trivial::debug; break;
-			case cov::LogLevel::Quiet: logLevel = logging::trivial::error; break;
+			case cov::LogLevel::Verbose: return logging::trivial::debug;
+			case cov::LogLevel::Quiet: return logging::trivial::error;
 			}
+			return logging::trivial::info;
+		}
 
-			Tools::InitConsoleAndFileLog(L"LastCoverageResults.log");
-			Tools::SetLoggerMinSeverity(logLevel);
+		//-----------------------------------------------------------------------------
+		void InitLogger(const cov::Options& options)
+		{
+			Tools::InitConsoleAndFileLog(LogFilename);
+			Tools::SetLoggerMinSeverity(GetLogLevel(options));
 		}
 
 		//-----------------------------------------------------------------------------
 		int Run(const cov::Options& options,
 			const Exporter::ExporterPluginManager& exporterPluginManager,
-			std::shared_ptr<Tools::WarningManager> warningManager)
+			cov::CodeCoverageRunner& codeCoverageRunner)
 		{
-			InitLogger(options);
+			std::unique_ptr<Exporter::ModuleExportPipeline> moduleExportPipeline;
+			std::vector<Plugin::CoverageData> coveraDatas;
 
-			auto coveraDatas = LoadInputCoverageDatas(options);
+			if (options.IsExportModuleByModuleEnabled())
+				moduleExportPipeline = CreateModuleExportPipeline(options);
+			else
+				coveraDatas = LoadInputCoverageDatas(options);
 			const auto* startInfo = options.GetStartInfo();
+			const auto& batchStartInfos = options.GetBatchStartInfos();
 
 			std::wostringstream ostr;
 			ostr << std::endl << options;
 			LOG_INFO << L"Start Program:" << ostr.str();
 
-			cov::CodeCoverageRunner codeCoverageRunner{ warningManager };
 			cov::CoverageFilterSettings coverageFilterSettings{ options.GetModulePatterns(), options.GetSourcePatterns() };
 			auto exitCode = 0;
 
-			if (startInfo)
+			if (startInfo || !batchStartInfos.empty())
 			{
 				size_t maxUnmatchPathsForWarning = (options.GetLogLevel() == cov::LogLevel::Verbose)
 					? std::numeric_limits<size_t>::max() : 30;
 
 				cov::RunCoverageSettings runCoverageSettings(
-					*startInfo,
+					startInfo ? *startInfo : batchStartInfos.front(),
 					coverageFilterSettings,
 					options.GetUnifiedDiffSettingsCollection(),
 					options.GetExcludedLineRegexes(),
 					options.GetSubstitutePdbSourcePaths());
 
 				runCoverageSettings.SetCoverChildren(options.IsCoverChildrenModeEnabled());
+				runCoverageSettings.SetCoverChildrenInParallel(options.IsCoverChildrenInParallelModeEnabled());
 				runCoverageSettings.SetContinueAfterCppException(options.IsContinueAfterCppExceptionModeEnabled());
 				runCoverageSettings.SetStopOnAssert(options.IsStopOnAssertModeEnabled());
 				runCoverageSettings.SetDumpOnCrash(options.IsDumpOnCrashEnabled());
 				runCoverageSettings.SetDumpDirectory(options.GetDumpDirectory());
 				runCoverageSettings.SetMaxUnmatchPathsForWarning(maxUnmatchPathsForWarning);
 				runCoverageSettings.SetOptimizedBuildSupport(options.IsOptimizedBuildSupportEnabled());
-				auto coverageData = codeCoverageRunner.RunCoverage(runCoverageSettings);
-				exitCode = coverageData.GetExitCode();
-				coveraDatas.push_back(std::move(coverageData));
+				runCoverageSettings.SetBasicBlockBreakPoints(options.IsBasicBlockBreakPointsEnabled());
+				if (auto coverageMemoryBudget = options.GetCoverageMemoryBudget())
+					runCoverageSettings.SetCoverageMemoryBudget(*coverageMemoryBudget * 1024 * 1024);
+				if (const auto& snapshotSettings = options.GetSnapshotSettings())
+				{
+					runCoverageSettings.SetSnapshotSettings(
+						*snapshotSettings, CreateSnapshotHandler(*snapshotSettings));
+				}
+				runCoverageSettings.SetCoverageJournalPath(options.GetCoverageJournalPath());
+				if (options.IsSummaryOnlyEnabled())
+					return RunCoverageSummary(options, codeCoverageRunner, runCoverageSettings);
+				if (batchStartInfos.empty())
+				{
+					auto coverageData = codeCoverageRunner.RunCoverage(runCoverageSettings);
+					exitCode = coverageData.GetExitCode();
+					if (moduleExportPipeline)
+						moduleExportPipeline->AddCoverageData(std::move(coverageData));
+					else
+						coveraDatas.push_back(std::move(coverageData));
+				}
+				else
+				{
+					exitCode = RunBatchCoverage(
+						options, codeCoverageRunner, runCoverageSettings,
+						moduleExportPipeline.get(), coveraDatas);
+				}
 			}
-			cov::CoverageDataMerger	coverageDataMerger;
 
-			auto coverageData = coverageDataMerger.Merge(coveraDatas);
+			if (moduleExportPipeline)
+				ExportModuleByModule(options, *moduleExportPipeline);
+			else
+			{
+				cov::CoverageDataMerger	coverageDataMerger;
 
-			if (options.IsAggregateByFileModeEnabled())
-				coverageDataMerger.MergeFileCoverage(coverageData);
+				auto coverageData = coverageDataMerger.Merge(std::move(coveraDatas));
+
+				if (options.IsAggregateByFileModeEnabled())
+					coverageDataMerger.MergeFileCoverage(coverageData);
 
-			Export(options, exporterPluginManager, coverageData);
+				Export(options, exporterPluginManager, coverageData);
+			}
 			LOG_INFO << L"The code coverage report is not what you expect? See the FAQ "
 				L"https://github.com/OpenCppCoverage/OpenCppCoverage/wiki/FAQ.";
 
@@ -203,52 +472,185 @@ namespace OpenCppCoverage
 				LOG_ERROR << L"Your program stop with error code: " << exitCode;
 			return exitCode;
 		}
-	}
 
-	//-----------------------------------------------------------------------------
-	int OpenCppCoverage::Run(int argc,
-		const char** argv,
-		std::wostream* emptyOptionsExplanation) const
-	{
-		auto warningManager = std::make_shared<Tools::WarningManager>();
-		std::vector<std::unique_ptr<cov::IOptionParser>> optionParsers;
-
-		Exporter::ExporterPluginManager exporterPluginManager{
-			Exporter::PluginLoader<Plugin::IExportPlugin>{},
-			GetPluginsExportFolder() };
+		//-----------------------------------------------------------------------------
+		int RunDaemonClient(const std::wstring& pipeName, int argc, const char** argv)
+		{
+			auto channel = cov::NamedPipeChannel::Connect(pipeName);
+			auto request = cov::CoverageDaemon::CreateRequest({ argv, argv + argc });
+			auto response = cov::CoverageDaemon::SendRequest(*channel, request);
+			std::clog << response.output;
 
-		auto exportPluginDescriptions =
-			exporterPluginManager.CreateExportPluginDescriptions();
-		optionParsers.push_back(std::make_unique<cov::ExportOptionParser>(
-			std::move(exportPluginDescriptions)));
-		cov::OptionsParser optionsParser{ warningManager, std::move(optionParsers) };
+			return response.exitCode;
+		}
 
-		auto options = optionsParser.Parse(argc, argv, emptyOptionsExplanation);
-		auto status = FailureExitCode;
+		//-----------------------------------------------------------------------------
+		int RunSubcommand(
+			const cov::Subcommand&,
+			Exporter::ExporterPluginManager&,
+			cov::CodeCoverageRunner&,
+			std::shared_ptr<Tools::WarningManager>);
 
-		if (options)
+		//-----------------------------------------------------------------------------
+		int ParseAndRun(
+			int argc,
+			const char** argv,
+			std::wostream* emptyOptionsExplanation,
+			Exporter::ExporterPluginManager& exporterPluginManager,
+			cov::CodeCoverageRunner& codeCoverageRunner,
+			std::shared_ptr<Tools::WarningManager> warningManager,
+			const std::function<void(const cov::Options&)>& initLogger,
+			const cov::DaemonRequest* daemonRequest)
 		{
-			try
+			std::vector<std::unique_ptr<cov::IOptionParser>> optionParsers;
+			auto exportPluginDescriptions =
+				exporterPluginManager.CreateExportPluginDescriptions();
+			optionParsers.push_back(std::make_unique<cov::ExportOptionParser>(
+				std::move(exportPluginDescriptions)));
+			cov::OptionsParser optionsParser{ warningManager, std::move(optionParsers) };
+
+			auto options = optionsParser.Parse(argc, argv, emptyOptionsExplanation);
+			auto status = FailureExitCode;
+
+			if (options)
 			{
-				status = ::OpenCppCoverage::Run(*options, exporterPluginManager, warningManager);
+				if (const auto& subcommand = options->GetSubcommand())
+				{
+					if (daemonRequest)
+					{
+						LOG_ERROR << L"Subcommands cannot be run by the daemon.";
+						return FailureExitCode;
+					}
+					return RunSubcommand(*subcommand,
+						exporterPluginManager, codeCoverageRunner, warningManager);
+				}
+				// The daemon ignores the pipe name sent with the other arguments.
+				const auto& daemonClientPipeName = options->GetDaemonClientPipeName();
+				if (daemonClientPipeName && !daemonRequest)
+					return RunDaemonClient(*daemonClientPipeName, argc - 1, argv + 1);
+
+				// In daemon mode, the plugin manager is reused by the next requests.
+				if (options->IsExportPluginOutOfProcessEnabled())
+				{
+					std::optional<std::chrono::seconds> timeout;
+					if (auto exportPluginTimeout = options->GetExportPluginTimeout())
+						timeout = std::chrono::seconds{ *exportPluginTimeout };
+					exporterPluginManager.EnableOutOfProcessExport(
+						Tools::GetExecutableFolder() / "OpenCppCoverage.exe", timeout);
+				}
+				Tools::ScopedAction disableOutOfProcessExport{ [&]() {
+					exporterPluginManager.DisableOutOfProcessExport();
+				} };
+
+				try
+				{
+					if (daemonRequest)
+					{
+						options->SetDefaultWorkingDirectory(daemonRequest->workingDirectory);
+						options->SetEnvironment(daemonRequest->environment);
+					}
+					initLogger(*options);
+					status = Run(*options, exporterPluginManager, codeCoverageRunner);
+				}
+				catch (const std::exception& e)
+				{
+					LOG_ERROR << "Error: " << e.what();
+				}
+				catch (...)
+				{
+					LOG_ERROR << "Unkown Error";
+				}
+
+				warningManager->DisplayWarnings();
+				if (options->IsPlugingModeEnabled() && !daemonRequest)
+				{
+					std::cout << "Press any key to continue... ";
+					std::cin.get();
+				}
 			}
-			catch (const std::exception& e)
+
+			return status;
+		}
+
+		//-----------------------------------------------------------------------------
+		std::unique_ptr<Exporter::ExporterPluginManager> CreateExporterPluginManager()
+		{
+			return std::make_unique<Exporter::ExporterPluginManager>(
+				std::make_shared<Exporter::PluginLoader<Plugin::IExportPlugin>>(),
+				GetPluginsExportFolder());
+		}
+
+		//-----------------------------------------------------------------------------
+		int RunSubcommand(
+			const cov::Subcommand& subcommand,
+			Exporter::ExporterPluginManager& exporterPluginManager,
+			cov::CodeCoverageRunner& codeCoverageRunner,
+			std::shared_ptr<Tools::WarningManager> warningManager)
+		{
+			const auto& arguments = subcommand.GetArguments();
+
+			switch (subcommand.GetType())
 			{
-				LOG_ERROR << "Error: " << e.what();
+			case cov::SubcommandType::Daemon:
+			{
+				// exporterPluginManager, codeCoverageRunner and warningManager
+				// are reused by all requests.
+				return RunDaemon(arguments[0], warningManager,
+					[&](int argc, const char** argv, std::wostream* emptyOptionsExplanation,
+						const cov::DaemonRequest& request) {
+					return ParseAndRun(argc, argv, emptyOptionsExplanation,
+						exporterPluginManager, codeCoverageRunner, warningManager,
+						[](const cov::Options& options) {
+							Tools::SetLoggerMinSeverity(GetLogLevel(options));
+						},
+						&request);
+				});
 			}
-			catch (...)
+			case cov::SubcommandType::DaemonStop:
 			{
-				LOG_ERROR << "Unkown Error";
+				auto channel = cov::NamedPipeChannel::Connect(arguments[0]);
+				cov::CoverageDaemon::SendStopRequest(*channel);
+				return 0;
 			}
-
-			warningManager->DisplayWarnings();
-			if (options->IsPlugingModeEnabled())
+			case cov::SubcommandType::AggregationServer:
+				return RunAggregationServer(arguments[0]);
+			case cov::SubcommandType::AggregationClient:
+				return RunAggregationClient(arguments[0], arguments[1],
+					{ arguments.begin() + 2, arguments.end() });
+			case cov::SubcommandType::History:
+				return RunHistory(arguments[0], arguments[1],
+					{ arguments.begin() + 2, arguments.end() });
+			case cov::SubcommandType::Diff:
 			{
-				std::cout << "Press any key to continue... ";
-				std::cin.get();
+				boost::optional<std::filesystem::path> output;
+				if (arguments.size() == 4)
+					output = arguments[3];
+				return RunDiff(arguments[0], arguments[1],
+					arguments.size() >= 3 ? arguments[2] : L"text", output);
 			}
+			case cov::SubcommandType::Query:
+				return RunQuery(arguments[0], arguments[1],
+					{ arguments.begin() + 2, arguments.end() });
+			case cov::SubcommandType::ExportPluginHost:
+				return Exporter::ExportPluginHost::Run(
+					arguments[0], Exporter::PluginLoader<Plugin::IExportPlugin>{});
+			}
+			throw std::runtime_error("Invalid subcommand.");
 		}
+	}
 
-		return status;
+	//-----------------------------------------------------------------------------
+	int OpenCppCoverage::Run(int argc,
+		const char** argv,
+		std::wostream* emptyOptionsExplanation) const
+	{
+		auto warningManager = std::make_shared<Tools::WarningManager>();
+		auto exporterPluginManager = CreateExporterPluginManager();
+		cov::CodeCoverageRunner codeCoverageRunner{ warningManager };
+
+		return ParseAndRun(argc, argv, emptyOptionsExplanation,
+			*exporterPluginManager, codeCoverageRunner, warningManager,
+			InitLogger, nullptr);
 	}
-}
\ No newline at end of file
+}
+
@@ -21,6 +21,10 @@
 namespace OpenCppCoverage
 {
 	const int FailureExitCode = 0x9F8C8E5C;
+	// Returned by --summary_only when the program succeeds but the coverage
+	// is lower than --summary_threshold.
+	const int CoverageThresholdExitCode = 0x9F8C8E5D;
+	const wchar_t* const LogFilename = L"LastCoverageResults.log";
 
 	class OpenCppCoverage
 	{
@@ -0,0 +1,61 @@
+// OpenCppCoverage is an open source code coverage for C++.
+// Copyright (C) 2019 OpenCppCoverage
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "stdafx.h"
+#include "Subcommands.hpp"
+
+#include <iostream>
+
+#include "Exporter/CoverageIndex.hpp"
+
+namespace OpenCppCoverage
+{
+	namespace
+	{
+		//-----------------------------------------------------------------------------
+		void PrintCount(const Exporter::CoverageIndexCount& count)
+		{
+			std::wcout << L"Files: " << count.fileCount << std::endl;
+			std::wcout << L"Executed lines: " << count.executedLineCount
+				<< L"/" << count.lineCount << std::endl;
+		}
+	}
+
+	//-----------------------------------------------------------------------------
+	int RunQuery(
+		const std::filesystem::path& coverageFile,
+		const std::wstring& command,
+		const std::vector<std::wstring>& arguments)
+	{
+		Exporter::CoverageIndex coverageIndex{ coverageFile };
+
+		if (command == L"line")
+		{
+			auto isLineExecuted = coverageIndex.IsLineExecuted(
+				arguments[0], std::stoul(arguments[1]));
+
+			if (!isLineExecuted)
+				std::wcout << L"No coverage information" << std::endl;
+			else
+				std::wcout << (*isLineExecuted ? L"Covered" : L"Not covered") << std::endl;
+		}
+		else if (command == L"prefix")
+			PrintCount(coverageIndex.GetCount(arguments.empty() ? L"" : arguments[0]));
+		else
+			PrintCount(coverageIndex.GetDirectoryCount(arguments[0]));
+		return 0;
+	}
+}
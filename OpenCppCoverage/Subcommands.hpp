@@ -0,0 +1,73 @@
+// OpenCppCoverage is an open source code coverage for C++.
+// Copyright (C) 2019 OpenCppCoverage
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <filesystem>
+#include <functional>
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <vector>
+#include <boost/optional/optional.hpp>
+
+namespace CppCoverage
+{
+	struct DaemonRequest;
+}
+
+namespace Tools
+{
+	class WarningManager;
+}
+
+namespace OpenCppCoverage
+{
+	// Run the command line of a daemon request and return its exit code.
+	using DaemonRequestHandler = std::function<int(
+		int argc,
+		const char** argv,
+		std::wostream* emptyOptionsExplanation,
+		const CppCoverage::DaemonRequest&)>;
+
+	// The arguments are checked by OptionsParser.
+	int RunDaemon(
+		const std::wstring& pipeName,
+		std::shared_ptr<Tools::WarningManager>,
+		const DaemonRequestHandler&);
+
+	int RunAggregationServer(const std::wstring& pipeName);
+	int RunAggregationClient(
+		const std::wstring& pipeName,
+		const std::wstring& command,
+		const std::vector<std::filesystem::path>& paths);
+
+	int RunHistory(
+		const std::filesystem::path& folder,
+		const std::wstring& command,
+		const std::vector<std::wstring>& arguments);
+
+	int RunDiff(
+		const std::filesystem::path& beforeCoverageFile,
+		const std::filesystem::path& afterCoverageFile,
+		const std::wstring& format,
+		const boost::optional<std::filesystem::path>& output);
+
+	int RunQuery(
+		const std::filesystem::path& coverageFile,
+		const std::wstring& command,
+		const std::vector<std::wstring>& arguments);
+}
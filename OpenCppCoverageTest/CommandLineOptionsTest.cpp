@@ -173,4 +173,22 @@ namespace OpenCppCoverageTest
 		ASSERT_EQ(OpenCppCoverage::FailureExitCode,
 		          RunCoverageOnProgramWithExitCode(coverageArguments));
 	}
+
+	//-------------------------------------------------------------------------
+	TEST_F(CommandLineOptionsTest, SummaryOnly)
+	{
+		auto summaryPath = GetTempPath() / "Summary.json";
+		std::vector<std::pair<std::string, std::string>> coverageArguments = {
+			{ cov::ProgramOptions::SummaryOnlyOption, "" },
+			{ cov::ProgramOptions::SummaryOutputOption, summaryPath.string() },
+			{ cov::ProgramOptions::SummaryThresholdOption, "0" } };
+
+		ASSERT_EQ(0, RunCoverageOnProgramWithExitCode(coverageArguments));
+		ASSERT_TRUE(fs::exists(summaryPath));
+		CheckFilenameExistsInOutput(testCoverageConsole, false);
+
+		coverageArguments.back().second = "100";
+		ASSERT_EQ(OpenCppCoverage::CoverageThresholdExitCode,
+		          RunCoverageOnProgramWithExitCode(coverageArguments));
+	}
 }
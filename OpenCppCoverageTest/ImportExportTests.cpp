@@ -89,6 +89,12 @@ namespace OpenCppCoverageTest
 		RunCoverage(cov::ExportOptionParser::ExportTypeCoberturaValue);
 	}
 
+	//-------------------------------------------------------------------------
+	TEST(ImportExportTest, ExportLcov)
+	{
+		RunCoverage(cov::ExportOptionParser::ExportTypeLcovValue);
+	}
+
 	//-------------------------------------------------------------------------
 	TEST(ImportExportTest, ExportImportBinary)
 	{
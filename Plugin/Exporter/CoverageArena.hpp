@@ -0,0 +1,51 @@
+// OpenCppCoverage is an open source code coverage for C++.
+// Copyright (C) 2019 OpenCppCoverage
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#pragma once
+
+#include <memory_resource>
+#include <string>
+
+#include "../PluginExport.hpp"
+
+namespace Plugin
+{
+	class CoverageData;
+
+	// Monotonic arena shared by the lines and functions of a coverage data.
+	// It is not part of the export plugin interface: plugin headers only
+	// forward declare it.
+	class PLUGIN_DLL CoverageArena
+	{
+	public:
+		// The lines and functions of the files allocate from an arena released
+		// in one shot with the last user. Modules and files stay on the heap.
+		// A growing table leaves its old buffer in the arena: use it only for
+		// data built once.
+		static CoverageData CreateCoverageData(const std::wstring& name, int exitCode);
+
+		CoverageArena() = default;
+
+		std::pmr::memory_resource& GetMemoryResource();
+
+	private:
+		CoverageArena(const CoverageArena&) = delete;
+		CoverageArena& operator=(const CoverageArena&) = delete;
+
+		std::pmr::monotonic_buffer_resource memoryResource_;
+	};
+}
@@ -17,13 +17,25 @@
 #include "stdafx.h"
 #include "CoverageData.hpp"
 
+#include <stdexcept>
+
 #include "ModuleCoverage.hpp"
 
 namespace Plugin
 {
 	//-------------------------------------------------------------------------
 	CoverageData::CoverageData(const std::wstring& name, int exitCode)
-		: name_(name)
+		: CoverageData(name, exitCode, nullptr)
+	{
+	}
+
+	//-------------------------------------------------------------------------
+	CoverageData::CoverageData(
+		const std::wstring& name,
+		int exitCode,
+		std::shared_ptr<CoverageArena> arena)
+		: arena_(std::move(arena))
+		, name_(name)
 		, exitCode_(exitCode)
 	{
 	}
@@ -44,6 +56,7 @@ namespace Plugin
 	{
 		if (this != &coverageData)
 		{
+			std::swap(arena_, coverageData.arena_);
 			std::swap(modules_, coverageData.modules_);
 			name_ = coverageData.name_;
 			exitCode_ = coverageData.exitCode_;
@@ -54,11 +67,30 @@ namespace Plugin
 	//-------------------------------------------------------------------------
 	ModuleCoverage& CoverageData::AddModule(const std::filesystem::path& path)
 	{
-		modules_.push_back(std::unique_ptr<ModuleCoverage>(new ModuleCoverage(path)));
+		modules_.push_back(std::unique_ptr<ModuleCoverage>(new ModuleCoverage(path, arena_)));
+
+		return *modules_.back();
+	}
+
+	//-------------------------------------------------------------------------
+	ModuleCoverage& CoverageData::AddModule(std::unique_ptr<ModuleCoverage> module)
+	{
+		if (!module)
+			throw std::runtime_error("Cannot add null module.");
+		modules_.push_back(std::move(module));
 
 		return *modules_.back();
 	}
 
+	//-------------------------------------------------------------------------
+	CoverageData::T_ModuleCoverageCollection CoverageData::ReleaseModules()
+	{
+		T_ModuleCoverageCollection modules;
+
+		std::swap(modules, modules_);
+		return modules;
+	}
+
 	//-------------------------------------------------------------------------	
 	void CoverageData::SetName(const std::wstring& name)
 	{
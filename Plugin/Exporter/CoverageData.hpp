@@ -26,6 +26,7 @@
 namespace Plugin
 {
 	class ModuleCoverage;
+	class CoverageArena;
 
 	class PLUGIN_DLL CoverageData
 	{
@@ -39,6 +40,8 @@ namespace Plugin
 		CoverageData(CoverageData&&);			
 		CoverageData& operator=(CoverageData&&);
 		ModuleCoverage& AddModule(const std::filesystem::path& name);
+		ModuleCoverage& AddModule(std::unique_ptr<ModuleCoverage>);
+		T_ModuleCoverageCollection ReleaseModules();
 		
 		void SetName(const std::wstring&);
 		void SetExitCode(int);
@@ -51,7 +54,12 @@ namespace Plugin
 		CoverageData(const CoverageData&) = delete;
 		CoverageData& operator=(const CoverageData&) = delete;
 
+		friend class CoverageArena;
+
+		CoverageData(const std::wstring& name, int exitCode, std::shared_ptr<CoverageArena>);
+
 	private:
+		std::shared_ptr<CoverageArena> arena_;
 		T_ModuleCoverageCollection modules_;
 		std::wstring name_;
 		int exitCode_;
@@ -0,0 +1,154 @@
+// OpenCppCoverage is an open source code coverage for C++.
+// Copyright (C) 2019 OpenCppCoverage
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "stdafx.h"
+#include "CoverageRollup.hpp"
+
+#include <algorithm>
+
+#include "CoverageData.hpp"
+#include "ModuleCoverage.hpp"
+#include "FileCoverage.hpp"
+
+namespace Plugin
+{
+	//-------------------------------------------------------------------------
+	CoverageRollupNode::CoverageRollupNode(const std::filesystem::path& path)
+		: path_{ path }
+		, fileCount_{ 0 }
+		, lineCount_{ 0 }
+		, executedLineCount_{ 0 }
+	{
+	}
+
+	//-------------------------------------------------------------------------
+	CoverageRollupNode::~CoverageRollupNode() = default;
+
+	//-------------------------------------------------------------------------
+	const std::filesystem::path& CoverageRollupNode::GetPath() const
+	{
+		return path_;
+	}
+
+	//-------------------------------------------------------------------------
+	const CoverageRollupNode::T_NodeCollection& CoverageRollupNode::GetChildren() const
+	{
+		return children_;
+	}
+
+	//-------------------------------------------------------------------------
+	const std::vector<const FileCoverage*>& CoverageRollupNode::GetFiles() const
+	{
+		return files_;
+	}
+
+	//-------------------------------------------------------------------------
+	size_t CoverageRollupNode::GetFileCount() const
+	{
+		return fileCount_;
+	}
+
+	//-------------------------------------------------------------------------
+	size_t CoverageRollupNode::GetLineCount() const
+	{
+		return lineCount_;
+	}
+
+	//-------------------------------------------------------------------------
+	size_t CoverageRollupNode::GetExecutedLineCount() const
+	{
+		return executedLineCount_;
+	}
+
+	//-------------------------------------------------------------------------
+	CoverageRollupNode& CoverageRollupNode::GetOrAddChild(const std::filesystem::path& name)
+	{
+		auto path = path_ / name;
+		auto it = std::lower_bound(children_.begin(), children_.end(), path,
+			[](const auto& child, const std::filesystem::path& value)
+		{
+			return child->GetPath() < value;
+		});
+
+		if (it == children_.end() || (*it)->GetPath() != path)
+			it = children_.insert(it, std::make_unique<CoverageRollupNode>(path));
+		return **it;
+	}
+
+	//-------------------------------------------------------------------------
+	void CoverageRollupNode::Add(const FileCoverage& file)
+	{
+		++fileCount_;
+		lineCount_ += file.GetLineCount();
+		executedLineCount_ += file.GetExecutedLineCount();
+	}
+
+	//-------------------------------------------------------------------------
+	CoverageRollup::CoverageRollup(const ModuleCoverage& module)
+		: root_{ std::make_unique<CoverageRollupNode>(std::filesystem::path{}) }
+	{
+		Add(module);
+		MergeSingleChildren(root_);
+	}
+
+	//-------------------------------------------------------------------------
+	CoverageRollup::CoverageRollup(const CoverageData& coverageData)
+		: root_{ std::make_unique<CoverageRollupNode>(std::filesystem::path{}) }
+	{
+		for (const auto& module : coverageData.GetModules())
+			Add(*module);
+		MergeSingleChildren(root_);
+	}
+
+	//-------------------------------------------------------------------------
+	CoverageRollup::~CoverageRollup() = default;
+
+	//-------------------------------------------------------------------------
+	const CoverageRollupNode& CoverageRollup::GetRoot() const
+	{
+		return *root_;
+	}
+
+	//-------------------------------------------------------------------------
+	void CoverageRollup::Add(const ModuleCoverage& module)
+	{
+		for (const auto& file : module.GetFiles())
+		{
+			auto* node = root_.get();
+
+			node->Add(*file);
+			for (const auto& name : file->GetPath().parent_path())
+			{
+				node = &node->GetOrAddChild(name);
+				node->Add(*file);
+			}
+			node->files_.push_back(file.get());
+		}
+	}
+
+	//-------------------------------------------------------------------------
+	void CoverageRollup::MergeSingleChildren(std::unique_ptr<CoverageRollupNode>& node)
+	{
+		while (node->files_.empty() && node->children_.size() == 1)
+		{
+			auto child = std::move(node->children_.front());
+			node = std::move(child);
+		}
+		for (auto& child : node->children_)
+			MergeSingleChildren(child);
+	}
+}
@@ -0,0 +1,98 @@
+// OpenCppCoverage is an open source code coverage for C++.
+// Copyright (C) 2019 OpenCppCoverage
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#pragma once
+
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+#include "../PluginExport.hpp"
+
+namespace Plugin
+{
+	class CoverageData;
+	class ModuleCoverage;
+	class FileCoverage;
+
+	//-------------------------------------------------------------------------
+	// A directory of a CoverageRollup.
+	//-------------------------------------------------------------------------
+	class PLUGIN_DLL CoverageRollupNode
+	{
+	public:
+		using T_NodeCollection = std::vector<std::unique_ptr<CoverageRollupNode>>;
+
+		explicit CoverageRollupNode(const std::filesystem::path& path);
+		~CoverageRollupNode();
+
+		const std::filesystem::path& GetPath() const;
+
+		// Sub directories sorted by path.
+		const T_NodeCollection& GetChildren() const;
+
+		// Files directly in this directory.
+		const std::vector<const FileCoverage*>& GetFiles() const;
+
+		// Counts for the files of this directory and its sub directories.
+		size_t GetFileCount() const;
+		size_t GetLineCount() const;
+		size_t GetExecutedLineCount() const;
+
+	private:
+		CoverageRollupNode(const CoverageRollupNode&) = delete;
+		CoverageRollupNode& operator=(const CoverageRollupNode&) = delete;
+
+		friend class CoverageRollup;
+
+		CoverageRollupNode& GetOrAddChild(const std::filesystem::path& name);
+		void Add(const FileCoverage&);
+
+		std::filesystem::path path_;
+		T_NodeCollection children_;
+		std::vector<const FileCoverage*> files_;
+		size_t fileCount_;
+		size_t lineCount_;
+		size_t executedLineCount_;
+	};
+
+	//-------------------------------------------------------------------------
+	// Directory tree of the files with the line counts aggregated at every
+	// directory, computed in a single pass over the files. Directories with
+	// only one sub directory and no file are merged with their sub directory
+	// so the root is the deepest folder containing all the files.
+	// The files are referenced so the coverage must outlive the rollup.
+	//-------------------------------------------------------------------------
+	class PLUGIN_DLL CoverageRollup
+	{
+	public:
+		explicit CoverageRollup(const ModuleCoverage&);
+		explicit CoverageRollup(const CoverageData&);
+		~CoverageRollup();
+
+		const CoverageRollupNode& GetRoot() const;
+
+	private:
+		CoverageRollup(const CoverageRollup&) = delete;
+		CoverageRollup& operator=(const CoverageRollup&) = delete;
+
+		void Add(const ModuleCoverage&);
+		static void MergeSingleChildren(std::unique_ptr<CoverageRollupNode>&);
+
+		std::unique_ptr<CoverageRollupNode> root_;
+	};
+}
@@ -16,39 +16,428 @@
 
 #include "stdafx.h"
 #include <string>
+#include <algorithm>
+#include <cstdint>
+#include <cwchar>
+#include <memory_resource>
+#include <optional>
+#include <type_traits>
 #include "FileCoverage.hpp"
+#include "ModuleCoverage.hpp"
+#include "CoverageArena.hpp"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#include <emmintrin.h>
+#define PLUGIN_USE_SSE2
+#endif
 
 namespace Plugin
 {
+	namespace
+	{
+		using LineCollection = std::pmr::vector<LineCoverage>;
+
+		//---------------------------------------------------------------------
+		template <typename Lines>
+		auto FindLine(const Lines& lines, unsigned int lineNumber)
+		{
+			return std::lower_bound(lines.begin(), lines.end(), lineNumber,
+				[](const LineCoverage& line, unsigned int value)
+			{
+				return line.GetLineNumber() < value;
+			});
+		}
+
+		// Two LineCoverage are loaded as a 128 bits value: 32 bits line number,
+		// the executed flag byte and padding for each. Only the line number and
+		// the executed flag bytes are used, see the layout checks in
+		// LineCoverage.cpp.
+		static_assert(std::is_trivially_copyable<LineCoverage>::value, 
+			"LineCoverage must be trivially copyable.");
+		static_assert(sizeof(LineCoverage) == sizeof(std::uint64_t),
+			"LineCoverage must have the size of a 64 bits word.");
+
+		//---------------------------------------------------------------------
+		bool HaveSameLineNumbers(LineRange lines1, LineRange lines2)
+		{
+			auto size = lines1.size();
+
+			if (size != lines2.size())
+				return false;
+
+			size_t i = 0;
+#ifdef PLUGIN_USE_SSE2
+			// Keep only the line numbers of two LineCoverage.
+			const auto lineNumberMask = _mm_set_epi32(0, -1, 0, -1);
+			for (; i + 2 <= size; i += 2)
+			{
+				auto value1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&lines1[i]));
+				auto value2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&lines2[i]));
+				auto difference = _mm_and_si128(_mm_xor_si128(value1, value2), lineNumberMask);
+
+				if (_mm_movemask_epi8(_mm_cmpeq_epi32(difference, _mm_setzero_si128())) != 0xFFFF)
+					return false;
+			}
+#endif
+			for (; i < size; ++i)
+			{
+				if (lines1[i].GetLineNumber() != lines2[i].GetLineNumber())
+					return false;
+			}
+			return true;
+		}
+
+		//---------------------------------------------------------------------
+		// Lines of both collections must have the same line numbers.
+		void OrExecutedLines(LineCollection& destination, LineRange source)
+		{
+			auto size = destination.size();
+			size_t i = 0;
+
+#ifdef PLUGIN_USE_SSE2
+			// Keep only the executed flags of two LineCoverage so the padding
+			// of source is never copied. Flags are 0 or 1 so ORing them gives
+			// a valid bool.
+			const auto executedFlagMask = _mm_set_epi32(0xFF, 0, 0xFF, 0);
+			for (; i + 2 <= size; i += 2)
+			{
+				auto destinationPtr = reinterpret_cast<__m128i*>(&destination[i]);
+				auto value1 = _mm_loadu_si128(destinationPtr);
+				auto value2 = _mm_and_si128(executedFlagMask,
+					_mm_loadu_si128(reinterpret_cast<const __m128i*>(&source[i])));
+
+				_mm_storeu_si128(destinationPtr, _mm_or_si128(value1, value2));
+			}
+#endif
+			for (; i < size; ++i)
+			{
+				if (source[i].HasBeenExecuted())
+					destination[i] = source[i];
+			}
+		}
+
+		//---------------------------------------------------------------------
+		size_t CountMissingLines(
+			const LineCollection& destination, 
+			LineRange source)
+		{
+			size_t missingLineCount = 0;
+			auto it = destination.begin();
+
+			for (const auto& line : source)
+			{
+				auto lineNumber = line.GetLineNumber();
+				while (it != destination.end() && it->GetLineNumber() < lineNumber)
+					++it;
+				if (it == destination.end() || it->GetLineNumber() != lineNumber)
+					++missingLineCount;
+			}
+			return missingLineCount;
+		}
+
+		//---------------------------------------------------------------------
+		// Merge two sorted runs in place starting from the end so no 
+		// temporary buffer is needed.
+		void MergeSortedLines(LineCollection& destination, LineRange source)
+		{
+			auto missingLineCount = CountMissingLines(destination, source);
+			auto destinationSize = destination.size();
+
+			destination.resize(destinationSize + missingLineCount, LineCoverage{ 0, false });
+
+			auto destinationIndex = destinationSize;
+			auto sourceIndex = source.size();
+			auto outputIndex = destination.size();
+
+			while (sourceIndex > 0)
+			{
+				const auto& sourceLine = source[sourceIndex - 1];
+				auto sourceLineNumber = sourceLine.GetLineNumber();
+
+				if (destinationIndex > 0 && 
+					destination[destinationIndex - 1].GetLineNumber() > sourceLineNumber)
+				{
+					destination[--outputIndex] = destination[--destinationIndex];
+				}
+				else if (destinationIndex > 0 &&
+					destination[destinationIndex - 1].GetLineNumber() == sourceLineNumber)
+				{
+					auto hasBeenExecuted = destination[--destinationIndex].HasBeenExecuted() 
+						|| sourceLine.HasBeenExecuted();
+					destination[--outputIndex] = LineCoverage{ sourceLineNumber, hasBeenExecuted };
+					--sourceIndex;
+				}
+				else
+				{
+					destination[--outputIndex] = sourceLine;
+					--sourceIndex;
+				}
+			}
+		}
+	}
+
+	//-------------------------------------------------------------------------
+	struct FileCoverage::Lines
+	{
+		struct Function
+		{
+			unsigned int symbolId_;
+			unsigned int nameOffset_;
+			unsigned int firstLineNumber_;
+			unsigned int lastLineNumber_;
+		};
+
+		//---------------------------------------------------------------------
+		explicit Lines(std::shared_ptr<CoverageArena> arena)
+			: arena_{ std::move(arena) }
+			, lines_{ GetMemoryResource() }
+			, functions_{ GetMemoryResource() }
+			, functionNames_{ GetMemoryResource() }
+		{
+		}
+
+		//---------------------------------------------------------------------
+		Lines(const Lines& lines, std::shared_ptr<CoverageArena> arena)
+			: Lines{ std::move(arena) }
+		{
+			auto lineRange = lines.GetLineRange();
+
+			lines_.assign(lineRange.begin(), lineRange.end());
+			executedLineCount_ = lines.executedLineCount_;
+			functions_.assign(lines.functions_.begin(), lines.functions_.end());
+			functionNames_ = lines.functionNames_;
+		}
+
+		//---------------------------------------------------------------------
+		std::pmr::memory_resource* GetMemoryResource() const
+		{
+			return arena_ ? &arena_->GetMemoryResource() : std::pmr::get_default_resource();
+		}
+
+		//---------------------------------------------------------------------
+		LineRange GetLineRange() const
+		{
+			if (externalLines_)
+				return *externalLines_;
+			return LineRange{ lines_.data(), lines_.data() + lines_.size() };
+		}
+
+		//---------------------------------------------------------------------
+		const wchar_t* GetFunctionName(const Function& function) const
+		{
+			return functionNames_.c_str() + function.nameOffset_;
+		}
+
+		//---------------------------------------------------------------------
+		void AddFunction(
+			unsigned int symbolId,
+			const wchar_t* name,
+			unsigned int firstLineNumber,
+			unsigned int lastLineNumber)
+		{
+			auto it = std::upper_bound(functions_.begin(), functions_.end(), firstLineNumber,
+				[](unsigned int value, const Function& function)
+			{
+				return value < function.firstLineNumber_;
+			});
+			auto nameOffset = static_cast<unsigned int>(functionNames_.size());
+
+			// Names are separated by a null character.
+			functionNames_.append(name);
+			functionNames_.push_back(L'\0');
+			functions_.insert(it, Function{ symbolId, nameOffset, firstLineNumber, lastLineNumber });
+		}
+
+		//---------------------------------------------------------------------
+		// Functions are identified by their name and their first line as
+		// symbol ids are specific to a module.
+		void MergeFunctions(const Lines& source)
+		{
+			for (const auto& function : source.functions_)
+			{
+				const auto* name = source.GetFunctionName(function);
+				auto range = std::equal_range(functions_.begin(), functions_.end(), 
+					Function{ 0, 0, function.firstLineNumber_, 0 },
+					[](const Function& function1, const Function& function2)
+				{
+					return function1.firstLineNumber_ < function2.firstLineNumber_;
+				});
+
+				if (std::none_of(range.first, range.second, [&](const Function& existingFunction)
+					{ return std::wcscmp(GetFunctionName(existingFunction), name) == 0; }))
+				{
+					AddFunction(function.symbolId_, name,
+						function.firstLineNumber_, function.lastLineNumber_);
+				}
+			}
+		}
+
+		//---------------------------------------------------------------------
+		void UpdateExecutedLineCount()
+		{
+			executedLineCount_ = static_cast<size_t>(std::count_if(
+				lines_.begin(), lines_.end(), [](const auto& line) { return line.HasBeenExecuted(); }));
+		}
+
+		// Keep the arena alive as long as the lines are shared.
+		const std::shared_ptr<CoverageArena> arena_;
+		LineCollection lines_;
+		size_t executedLineCount_ = 0;
+
+		// Used instead of lines_ until the first modification.
+		std::optional<LineRange> externalLines_;
+
+		// Sorted by first line number.
+		std::pmr::vector<Function> functions_;
+		std::pmr::wstring functionNames_;
+	};
+
 	//-------------------------------------------------------------------------
 	FileCoverage::FileCoverage(const std::filesystem::path& path)
-		: path_(path)
+		: FileCoverage(path, nullptr)
 	{
 	}
 
+	//-------------------------------------------------------------------------
+	FileCoverage::FileCoverage(
+		const std::filesystem::path& path,
+		std::shared_ptr<CoverageArena> arena)
+		: arena_(std::move(arena))
+		, path_(path)
+		, lines_(std::make_shared<Lines>(arena_))
+	{
+	}
+
+	//-------------------------------------------------------------------------
+	FileCoverage::~FileCoverage() = default;
+
+	//-------------------------------------------------------------------------
+	FileCoverage& FileCoverage::operator=(const FileCoverage& fileCoverage)
+	{
+		auto previousLineCount = GetLineCount();
+		auto previousExecutedLineCount = GetExecutedLineCount();
+
+		arena_ = fileCoverage.arena_;
+		path_ = fileCoverage.path_;
+		lines_ = fileCoverage.lines_;
+		UpdateModuleLineCounts(previousLineCount, previousExecutedLineCount);
+
+		return *this;
+	}
+
 	//-------------------------------------------------------------------------
 	void FileCoverage::AddLine(unsigned int lineNumber, bool hasBeenExecuted)
 	{
+		auto& mutableLines = GetMutableLines();
+		auto& lines = mutableLines.lines_;
 		LineCoverage line{ lineNumber, hasBeenExecuted };
 
-		if (!lines_.emplace(lineNumber, line).second)
+		// Lines are almost always added in order.
+		if (lines.empty() || lines.back().GetLineNumber() < lineNumber)
+			lines.push_back(line);
+		else
 		{
-			throw std::runtime_error("Line " + std::to_string(lineNumber) +
-				" already exists for " + path_.string());
+			auto it = FindLine(lines, lineNumber);
+			if (it != lines.end() && it->GetLineNumber() == lineNumber)
+			{
+				throw std::runtime_error("Line " + std::to_string(lineNumber) +
+					" already exists for " + path_.string());
+			}
+			lines.insert(it, line);
 		}
+
+		if (hasBeenExecuted)
+			++mutableLines.executedLineCount_;
+		UpdateModuleLineCounts(lines.size() - 1, 
+			mutableLines.executedLineCount_ - (hasBeenExecuted ? 1 : 0));
 	}
 
 	//-------------------------------------------------------------------------
 	void FileCoverage::UpdateLine(unsigned int lineNumber, bool hasBeenExecuted)
 	{
-		if (!lines_.erase(lineNumber))
+		auto& mutableLines = GetMutableLines();
+		auto& lines = mutableLines.lines_;
+		auto it = FindLine(lines, lineNumber);
+
+		if (it == lines.end() || it->GetLineNumber() != lineNumber)
 		{
 			throw std::runtime_error(
 			    "Line " + std::to_string(lineNumber) +
 			    " does not exists and cannot be updated for " + path_.string());
 		}
 
-		AddLine(lineNumber, hasBeenExecuted);
+		if (it->HasBeenExecuted() != hasBeenExecuted)
+		{
+			auto previousExecutedLineCount = mutableLines.executedLineCount_;
+
+			if (hasBeenExecuted)
+				++mutableLines.executedLineCount_;
+			else
+				--mutableLines.executedLineCount_;
+			UpdateModuleLineCounts(lines.size(), previousExecutedLineCount);
+		}
+		lines[it - lines.begin()] = LineCoverage{ lineNumber, hasBeenExecuted };
+	}
+
+	//-------------------------------------------------------------------------
+	void FileCoverage::MergeLines(const FileCoverage& fileCoverage)
+	{
+		if (lines_ == fileCoverage.lines_)
+			return;
+
+		auto previousLineCount = GetLineCount();
+		auto previousExecutedLineCount = GetExecutedLineCount();
+
+		// Lines from another arena or from an external buffer are copied
+		// instead of shared: they must not keep the arena of fileCoverage
+		// alive nor outlive their buffer.
+		if (lines_->GetLineRange().empty() && lines_->functions_.empty() &&
+			fileCoverage.lines_->arena_ == arena_ &&
+			!fileCoverage.lines_->externalLines_)
+		{
+			lines_ = fileCoverage.lines_;
+			UpdateModuleLineCounts(previousLineCount, previousExecutedLineCount);
+			return;
+		}
+
+		auto sourceLines = fileCoverage.lines_->GetLineRange();
+
+		// Files from the same binary almost always have the same lines.
+		auto sameLineNumbers = HaveSameLineNumbers(lines_->GetLineRange(), sourceLines);
+		auto& mutableLines = GetMutableLines();
+
+		if (sameLineNumbers)
+			OrExecutedLines(mutableLines.lines_, sourceLines);
+		else
+			MergeSortedLines(mutableLines.lines_, sourceLines);
+		mutableLines.UpdateExecutedLineCount();
+		mutableLines.MergeFunctions(*fileCoverage.lines_);
+		UpdateModuleLineCounts(previousLineCount, previousExecutedLineCount);
+	}
+
+	//-------------------------------------------------------------------------
+	void FileCoverage::SetExternalLines(LineRange lines)
+	{
+		auto previousLineCount = GetLineCount();
+		auto previousExecutedLineCount = GetExecutedLineCount();
+		size_t executedLineCount = 0;
+
+		for (size_t i = 0; i < lines.size(); ++i)
+		{
+			if (i > 0 && lines[i - 1].GetLineNumber() >= lines[i].GetLineNumber())
+			{
+				throw std::runtime_error("Lines are not sorted by line number for " +
+					path_.string());
+			}
+			if (lines[i].HasBeenExecuted())
+				++executedLineCount;
+		}
+
+		auto& mutableLines = GetMutableLines();
+		mutableLines.lines_.clear();
+		mutableLines.executedLineCount_ = executedLineCount;
+		mutableLines.externalLines_ = lines;
+		UpdateModuleLineCounts(previousLineCount, previousExecutedLineCount);
 	}
 
 	//-------------------------------------------------------------------------
@@ -60,22 +449,129 @@ namespace Plugin
 	//-------------------------------------------------------------------------
 	const LineCoverage* FileCoverage::operator[](unsigned int line) const
 	{
-		auto it = lines_.find(line);
+		auto lines = lines_->GetLineRange();
+		auto it = FindLine(lines, line);
 
-		if (it == lines_.end())
+		if (it == lines.end() || it->GetLineNumber() != line)
 			return 0;
 
-		return &it->second;
+		return &*it;
 	}
 		
 	//-------------------------------------------------------------------------
 	std::vector<LineCoverage> FileCoverage::GetLines() const
 	{
-		std::vector<LineCoverage> lines;
-		
-		for (const auto& pair : lines_)
-			lines.push_back(pair.second);
-		
-		return lines;
-	}	
+		auto lines = lines_->GetLineRange();
+
+		return std::vector<LineCoverage>(lines.begin(), lines.end());
+	}
+
+	//-------------------------------------------------------------------------
+	std::string FileCoverage::GetUtf8Path() const
+	{
+		return path_.u8string();
+	}
+
+	//-------------------------------------------------------------------------
+	LineRange FileCoverage::GetLineRange() const
+	{
+		return lines_->GetLineRange();
+	}
+
+	//-------------------------------------------------------------------------
+	size_t FileCoverage::GetLineCount() const
+	{
+		return lines_->GetLineRange().size();
+	}
+
+	//-------------------------------------------------------------------------
+	size_t FileCoverage::GetExecutedLineCount() const
+	{
+		return lines_->executedLineCount_;
+	}
+
+	//-------------------------------------------------------------------------
+	void FileCoverage::AddFunction(
+		unsigned int symbolId,
+		const std::wstring& name,
+		unsigned int firstLineNumber,
+		unsigned int lastLineNumber)
+	{
+		if (firstLineNumber > lastLineNumber)
+		{
+			throw std::runtime_error("Invalid line range " + std::to_string(firstLineNumber) +
+				"-" + std::to_string(lastLineNumber) + " for a function of " + path_.string());
+		}
+		GetMutableLines().AddFunction(symbolId, name.c_str(), firstLineNumber, lastLineNumber);
+	}
+
+	//-------------------------------------------------------------------------
+	std::vector<FunctionCoverage> FileCoverage::GetFunctions() const
+	{
+		auto lines = lines_->GetLineRange();
+		std::vector<FunctionCoverage> functions;
+
+		functions.reserve(lines_->functions_.size());
+
+		// Functions and lines are both sorted so the first line of a 
+		// function is found by moving forward in lines.
+		auto itFirstLine = lines.begin();
+		for (const auto& function : lines_->functions_)
+		{
+			while (itFirstLine != lines.end() && 
+				itFirstLine->GetLineNumber() < function.firstLineNumber_)
+			{
+				++itFirstLine;
+			}
+
+			size_t lineCount = 0;
+			size_t executedLineCount = 0;
+			for (auto it = itFirstLine; 
+				it != lines.end() && it->GetLineNumber() <= function.lastLineNumber_; ++it)
+			{
+				++lineCount;
+				if (it->HasBeenExecuted())
+					++executedLineCount;
+			}
+
+			functions.emplace_back(
+				function.symbolId_,
+				lines_->GetFunctionName(function),
+				function.firstLineNumber_,
+				function.lastLineNumber_,
+				lineCount,
+				executedLineCount);
+		}
+		return functions;
+	}
+
+	//-------------------------------------------------------------------------
+	size_t FileCoverage::GetFunctionCount() const
+	{
+		return lines_->functions_.size();
+	}
+
+	//-------------------------------------------------------------------------
+	FileCoverage::Lines& FileCoverage::GetMutableLines()
+	{
+		// Copy on write: lines can be shared after an assignment or be
+		// external.
+		if (lines_.use_count() > 1 || lines_->externalLines_)
+			lines_ = std::make_shared<Lines>(*lines_, arena_);
+
+		return *lines_;
+	}
+
+	//-------------------------------------------------------------------------
+	void FileCoverage::UpdateModuleLineCounts(
+		size_t previousLineCount, 
+		size_t previousExecutedLineCount)
+	{
+		if (module_)
+		{
+			module_->UpdateLineCounts(
+				previousLineCount, previousExecutedLineCount,
+				GetLineCount(), GetExecutedLineCount());
+		}
+	}
 }
@@ -17,34 +17,81 @@
 #pragma once
 
 #include <filesystem>
-#include <map>
+#include <string>
+#include <vector>
+#include <memory>
 
 #include "LineCoverage.hpp"
+#include "LineRange.hpp"
+#include "FunctionCoverage.hpp"
 #include "../PluginExport.hpp"
 
 namespace Plugin
 {
+	class ModuleCoverage;
+	class CoverageArena;
+
 	class PLUGIN_DLL FileCoverage
 	{
 	public:
 		explicit FileCoverage(const std::filesystem::path& path);
+		~FileCoverage();
 
 		void AddLine(unsigned int lineNumber, bool hasBeenExecuted);
 		void UpdateLine(unsigned int lineNumber, bool hasBeenExecuted);
 
+		// Add the lines of fileCoverage that do not exist yet and mark 
+		// the lines executed in fileCoverage as executed. New lines allocate
+		// from the arena of this file if any.
+		void MergeLines(const FileCoverage& fileCoverage);
+
+		// Use lines sorted by line number from a buffer owned by the caller
+		// instead of copying them. The buffer must outlive this file: the
+		// lines are copied on the first modification.
+		void SetExternalLines(LineRange lines);
+
 		const std::filesystem::path& GetPath() const;
 		const LineCoverage* operator[](unsigned int line) const;
 		std::vector<LineCoverage> GetLines() const;
 
-		FileCoverage& operator=(const FileCoverage&) = default;
+		// Since CurrentExportPluginVersion 2.
+		std::string GetUtf8Path() const;
+		LineRange GetLineRange() const;
+		size_t GetLineCount() const;
+		size_t GetExecutedLineCount() const;
+
+		// The function table is stored with the lines: line counts of the
+		// functions are computed from the lines when calling GetFunctions.
+		void AddFunction(
+			unsigned int symbolId,
+			const std::wstring& name,
+			unsigned int firstLineNumber,
+			unsigned int lastLineNumber);
+		std::vector<FunctionCoverage> GetFunctions() const;
+		size_t GetFunctionCount() const;
+
+		// Lines are shared with fileCoverage until one of them is modified.
+		// New lines then allocate from the arena of fileCoverage if any.
+		FileCoverage& operator=(const FileCoverage& fileCoverage);
 
 	private:
 		FileCoverage(const FileCoverage&) = delete;
+
+		friend class ModuleCoverage;
+
+		FileCoverage(const std::filesystem::path& path, std::shared_ptr<CoverageArena>);
+
+		struct Lines;
+		Lines& GetMutableLines();
+		void UpdateModuleLineCounts(size_t previousLineCount, size_t previousExecutedLineCount);
 			
 	private:
+		std::shared_ptr<CoverageArena> arena_;
 		std::filesystem::path path_;
-		std::map<unsigned int, LineCoverage> lines_;	
+		std::shared_ptr<Lines> lines_;
+
+		// Set while the file belongs to a module so the line counts of the
+		// module stay up to date.
+		ModuleCoverage* module_ = nullptr;
 	};
 }
-
-
@@ -0,0 +1,75 @@
+// OpenCppCoverage is an open source code coverage for C++.
+// Copyright (C) 2019 OpenCppCoverage
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "stdafx.h"
+#include "FunctionCoverage.hpp"
+
+namespace Plugin
+{
+	//-------------------------------------------------------------------------
+	FunctionCoverage::FunctionCoverage(
+		unsigned int symbolId,
+		const std::wstring& name,
+		unsigned int firstLineNumber,
+		unsigned int lastLineNumber,
+		size_t lineCount,
+		size_t executedLineCount)
+		: symbolId_{ symbolId }
+		, name_{ name }
+		, firstLineNumber_{ firstLineNumber }
+		, lastLineNumber_{ lastLineNumber }
+		, lineCount_{ lineCount }
+		, executedLineCount_{ executedLineCount }
+	{
+	}
+
+	//-------------------------------------------------------------------------
+	unsigned int FunctionCoverage::GetSymbolId() const
+	{
+		return symbolId_;
+	}
+
+	//-------------------------------------------------------------------------
+	const std::wstring& FunctionCoverage::GetName() const
+	{
+		return name_;
+	}
+
+	//-------------------------------------------------------------------------
+	unsigned int FunctionCoverage::GetFirstLineNumber() const
+	{
+		return firstLineNumber_;
+	}
+
+	//-------------------------------------------------------------------------
+	unsigned int FunctionCoverage::GetLastLineNumber() const
+	{
+		return lastLineNumber_;
+	}
+
+	//-------------------------------------------------------------------------
+	size_t FunctionCoverage::GetLineCount() const
+	{
+		return lineCount_;
+	}
+
+	//-------------------------------------------------------------------------
+	size_t FunctionCoverage::GetExecutedLineCount() const
+	{
+		return executedLineCount_;
+	}
+}
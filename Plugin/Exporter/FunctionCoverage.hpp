@@ -0,0 +1,55 @@
+// OpenCppCoverage is an open source code coverage for C++.
+// Copyright (C) 2019 OpenCppCoverage
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#pragma once
+
+#include <string>
+
+#include "../PluginExport.hpp"
+
+namespace Plugin
+{
+	class PLUGIN_DLL FunctionCoverage
+	{
+	public:
+		FunctionCoverage(
+			unsigned int symbolId,
+			const std::wstring& name,
+			unsigned int firstLineNumber,
+			unsigned int lastLineNumber,
+			size_t lineCount,
+			size_t executedLineCount);
+
+		// Symbol index of the function in the PDB of its module.
+		unsigned int GetSymbolId() const;
+		const std::wstring& GetName() const;
+
+		// Lines of the file between first and last line numbers (included).
+		unsigned int GetFirstLineNumber() const;
+		unsigned int GetLastLineNumber() const;
+		size_t GetLineCount() const;
+		size_t GetExecutedLineCount() const;
+
+	private:
+		unsigned int symbolId_;
+		std::wstring name_;
+		unsigned int firstLineNumber_;
+		unsigned int lastLineNumber_;
+		size_t lineCount_;
+		size_t executedLineCount_;
+	};
+}
@@ -56,6 +56,9 @@ namespace Plugin
 		//---------------------------------------------------------------------
 		// Get the text to describe the command line argument.
 		// For example, it can be "output file (optional)".
+		// If the version resource of the plugin defines the string
+		// ArgumentHelpDescription with the same text, OpenCppCoverage loads
+		// the plugin only when its export type is selected.
 		//---------------------------------------------------------------------
 		virtual std::wstring GetArgumentHelpDescription() = 0;
 
@@ -67,5 +70,9 @@ namespace Plugin
 	};
 
 	// The current version of IExportPlugin.
-	const int CurrentExportPluginVersion = 1;
+	// Version 2: FileCoverage::GetLineRange iterates the lines without copy.
+	// FileCoverage and ModuleCoverage provide GetLineCount,
+	// GetExecutedLineCount and GetUtf8Path.
+	// Plugins of version 1 are still supported.
+	const int CurrentExportPluginVersion = 2;
 }
@@ -17,6 +17,8 @@
 #include "stdafx.h"
 #include "LineCoverage.hpp"
 
+#include <cstddef>
+
 namespace Plugin
 {
 	//-------------------------------------------------------------------------
@@ -24,6 +26,11 @@ namespace Plugin
 		: lineNumber_(lineNumber)
 		, hasBeenExecuted_(hasBeenExecuted)
 	{
+		// FileCoverage compares and merges two lines at a time with SSE2.
+		static_assert(offsetof(LineCoverage, lineNumber_) == 0,
+			"The line number must be the first 32 bits of LineCoverage.");
+		static_assert(offsetof(LineCoverage, hasBeenExecuted_) == sizeof(unsigned int) &&
+			sizeof(bool) == 1, "The executed flag must be the byte after the line number.");
 	}
 		
 	//-------------------------------------------------------------------------
@@ -25,6 +25,7 @@ namespace Plugin
 	public:
 		LineCoverage(unsigned int lineNumber, bool hasBeenExecuted);
 		LineCoverage(const LineCoverage&) = default;
+		LineCoverage& operator=(const LineCoverage&) = default;
 		
 		unsigned int GetLineNumber() const;
 		bool HasBeenExecuted() const;
@@ -0,0 +1,73 @@
+// OpenCppCoverage is an open source code coverage for C++.
+// Copyright (C) 2014 OpenCppCoverage
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <cstddef>
+
+#include "LineCoverage.hpp"
+
+namespace Plugin
+{
+	//-------------------------------------------------------------------------
+	// Non owning view over the lines of a FileCoverage sorted by line number.
+	// The view is invalidated when the file is modified.
+	//-------------------------------------------------------------------------
+	class LineRange
+	{
+	public:
+		//---------------------------------------------------------------------
+		LineRange(const LineCoverage* begin, const LineCoverage* end)
+			: begin_{ begin }
+			, end_{ end }
+		{
+		}
+
+		//---------------------------------------------------------------------
+		const LineCoverage* begin() const
+		{
+			return begin_;
+		}
+
+		//---------------------------------------------------------------------
+		const LineCoverage* end() const
+		{
+			return end_;
+		}
+
+		//---------------------------------------------------------------------
+		size_t size() const
+		{
+			return static_cast<size_t>(end_ - begin_);
+		}
+
+		//---------------------------------------------------------------------
+		bool empty() const
+		{
+			return begin_ == end_;
+		}
+
+		//---------------------------------------------------------------------
+		const LineCoverage& operator[](size_t index) const
+		{
+			return begin_[index];
+		}
+
+	private:
+		const LineCoverage* begin_;
+		const LineCoverage* end_;
+	};
+}
@@ -17,13 +17,24 @@
 #include "stdafx.h"
 #include "ModuleCoverage.hpp"
 
+#include <stdexcept>
+
 #include "FileCoverage.hpp"
 
 namespace Plugin
 {
 	//-------------------------------------------------------------------------
 	ModuleCoverage::ModuleCoverage(const std::filesystem::path& path)
-		: path_(path)
+		: ModuleCoverage(path, nullptr)
+	{
+	}
+
+	//-------------------------------------------------------------------------
+	ModuleCoverage::ModuleCoverage(
+		const std::filesystem::path& path,
+		std::shared_ptr<CoverageArena> arena)
+		: arena_(std::move(arena))
+		, path_(path)
 	{
 	}
 
@@ -35,11 +46,39 @@ namespace Plugin
 	//-------------------------------------------------------------------------
 	FileCoverage& ModuleCoverage::AddFile(const std::filesystem::path& filePath)
 	{
-		files_.push_back(std::unique_ptr<FileCoverage>(new FileCoverage(filePath)));
+		files_.push_back(std::unique_ptr<FileCoverage>(new FileCoverage(filePath, arena_)));
+		files_.back()->module_ = this;
 
 		return *files_.back();
 	}
 
+	//-------------------------------------------------------------------------
+	FileCoverage& ModuleCoverage::AddFile(std::unique_ptr<FileCoverage> file)
+	{
+		if (!file)
+			throw std::runtime_error("Cannot add null file.");
+		files_.push_back(std::move(file));
+
+		auto& fileCoverage = *files_.back();
+		fileCoverage.module_ = this;
+		UpdateLineCounts(0, 0, fileCoverage.GetLineCount(), fileCoverage.GetExecutedLineCount());
+
+		return fileCoverage;
+	}
+
+	//-------------------------------------------------------------------------
+	ModuleCoverage::T_FileCoverageCollection ModuleCoverage::ReleaseFiles()
+	{
+		T_FileCoverageCollection files;
+
+		std::swap(files, files_);
+		for (auto& file : files)
+			file->module_ = nullptr;
+		lineCount_ = 0;
+		executedLineCount_ = 0;
+		return files;
+	}
+
 	//-------------------------------------------------------------------------
 	const std::filesystem::path& ModuleCoverage::GetPath() const
 	{
@@ -51,4 +90,33 @@ namespace Plugin
 	{
 		return files_;
 	}
+
+	//-------------------------------------------------------------------------
+	std::string ModuleCoverage::GetUtf8Path() const
+	{
+		return path_.u8string();
+	}
+
+	//-------------------------------------------------------------------------
+	size_t ModuleCoverage::GetLineCount() const
+	{
+		return lineCount_;
+	}
+
+	//-------------------------------------------------------------------------
+	size_t ModuleCoverage::GetExecutedLineCount() const
+	{
+		return executedLineCount_;
+	}
+
+	//-------------------------------------------------------------------------
+	void ModuleCoverage::UpdateLineCounts(
+		size_t previousLineCount,
+		size_t previousExecutedLineCount,
+		size_t lineCount,
+		size_t executedLineCount)
+	{
+		lineCount_ = lineCount_ - previousLineCount + lineCount;
+		executedLineCount_ = executedLineCount_ - previousExecutedLineCount + executedLineCount;
+	}
 }
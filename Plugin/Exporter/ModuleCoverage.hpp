@@ -20,12 +20,14 @@
 #include <memory>
 
 #include <filesystem>
+#include <string>
 
 #include "../PluginExport.hpp"
 
 namespace Plugin
 {
 	class FileCoverage;
+	class CoverageArena;
 
 	class PLUGIN_DLL ModuleCoverage
 	{
@@ -37,17 +39,40 @@ namespace Plugin
 		~ModuleCoverage();
 
 		FileCoverage& AddFile(const std::filesystem::path& filename);
+		FileCoverage& AddFile(std::unique_ptr<FileCoverage>);
+		T_FileCoverageCollection ReleaseFiles();
 		
 		const std::filesystem::path& GetPath() const;
 		const T_FileCoverageCollection& GetFiles() const;
 
+		// Since CurrentExportPluginVersion 2.
+		std::string GetUtf8Path() const;
+
+		// Kept up to date when files are added, released or modified.
+		size_t GetLineCount() const;
+		size_t GetExecutedLineCount() const;
+
 	private:
 		ModuleCoverage(const ModuleCoverage&) = delete;
 		ModuleCoverage& operator=(const ModuleCoverage&) = delete;
+
+		friend class CoverageData;
+		friend class FileCoverage;
+
+		ModuleCoverage(const std::filesystem::path& path, std::shared_ptr<CoverageArena>);
+
+		void UpdateLineCounts(
+			size_t previousLineCount,
+			size_t previousExecutedLineCount,
+			size_t lineCount,
+			size_t executedLineCount);
 		
 	private:
+		std::shared_ptr<CoverageArena> arena_;
 		T_FileCoverageCollection files_;
 		std::filesystem::path path_;		
+		size_t lineCount_ = 0;
+		size_t executedLineCount_ = 0;
 	};
 }
 
@@ -16,6 +16,7 @@
 
 #include "pch.h"
 
+#include "Plugin/Exporter/CoverageArena.hpp"
 #include "Plugin/Exporter/CoverageData.hpp"
 #include "Plugin/Exporter/ModuleCoverage.hpp"
 #include "Plugin/Exporter/FileCoverage.hpp"
@@ -82,4 +83,31 @@ namespace PluginTest
 		Plugin::CoverageData movedCoverageData = { std::move(data) };
 		CheckCoverageData(movedCoverageData);
 	}			
+
+	//---------------------------------------------------------------------
+	TEST(CoverageDataTest, Arena)
+	{
+		auto data = Plugin::CoverageArena::CreateCoverageData(L"", 0);
+
+		FillCoverageData(data);
+
+		Plugin::CoverageData movedCoverageData = { std::move(data) };
+		CheckCoverageData(movedCoverageData);
+	}
+
+	//---------------------------------------------------------------------
+	TEST(CoverageDataTest, CopyFileFromArena)
+	{
+		auto data = Plugin::CoverageArena::CreateCoverageData(L"", 0);
+		FillCoverageData(data);
+
+		Plugin::CoverageData otherData{L"", 0};
+		auto& file = otherData.AddModule(moduleName).AddFile(L"other");
+		file = *data.GetModules().front()->GetFiles().front();
+		data = Plugin::CoverageData{L"", 0};
+
+		ASSERT_EQ(filename, file.GetPath());
+		ASSERT_EQ(2, file.GetLines().size());
+		ASSERT_TRUE(file[1]->HasBeenExecuted());
+	}
 }
\ No newline at end of file
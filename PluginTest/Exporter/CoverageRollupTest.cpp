@@ -0,0 +1,103 @@
+// OpenCppCoverage is an open source code coverage for C++.
+// Copyright (C) 2019 OpenCppCoverage
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "pch.h"
+
+#include "Plugin/Exporter/CoverageData.hpp"
+#include "Plugin/Exporter/ModuleCoverage.hpp"
+#include "Plugin/Exporter/FileCoverage.hpp"
+#include "Plugin/Exporter/CoverageRollup.hpp"
+
+namespace fs = std::filesystem;
+
+namespace PluginTest
+{
+	namespace
+	{
+		const fs::path root = L"Root";
+
+		//---------------------------------------------------------------------
+		void AddFile(
+			Plugin::ModuleCoverage& module,
+			const fs::path& path,
+			const std::vector<bool>& executedLines)
+		{
+			auto& file = module.AddFile(path);
+
+			for (size_t i = 0; i < executedLines.size(); ++i)
+				file.AddLine(static_cast<unsigned int>(i + 1), executedLines[i]);
+		}
+
+		//---------------------------------------------------------------------
+		void CheckNode(
+			const Plugin::CoverageRollupNode& node,
+			const fs::path& path,
+			size_t fileCount,
+			size_t lineCount,
+			size_t executedLineCount)
+		{
+			ASSERT_EQ(path, node.GetPath());
+			ASSERT_EQ(fileCount, node.GetFileCount());
+			ASSERT_EQ(lineCount, node.GetLineCount());
+			ASSERT_EQ(executedLineCount, node.GetExecutedLineCount());
+		}
+	}
+
+	//-------------------------------------------------------------------------
+	TEST(CoverageRollupTest, Module)
+	{
+		Plugin::ModuleCoverage module{ L"Module.exe" };
+
+		AddFile(module, root / L"B" / L"Deep" / L"Deeper" / L"File3.cpp", { false, false });
+		AddFile(module, root / L"A" / L"File1.cpp", { true, false });
+		AddFile(module, root / L"A" / L"Sub" / L"File2.cpp", { true });
+
+		Plugin::CoverageRollup coverageRollup{ module };
+		const auto& rootNode = coverageRollup.GetRoot();
+		CheckNode(rootNode, root, 3, 5, 2);
+		ASSERT_TRUE(rootNode.GetFiles().empty());
+		ASSERT_EQ(2, rootNode.GetChildren().size());
+
+		const auto& a = *rootNode.GetChildren()[0];
+		CheckNode(a, root / L"A", 2, 3, 2);
+		ASSERT_EQ(1, a.GetFiles().size());
+		ASSERT_EQ(root / L"A" / L"File1.cpp", a.GetFiles()[0]->GetPath());
+		ASSERT_EQ(1, a.GetChildren().size());
+		CheckNode(*a.GetChildren()[0], root / L"A" / L"Sub", 1, 1, 1);
+
+		const auto& b = *rootNode.GetChildren()[1];
+		CheckNode(b, root / L"B" / L"Deep" / L"Deeper", 1, 2, 0);
+		ASSERT_EQ(1, b.GetFiles().size());
+		ASSERT_TRUE(b.GetChildren().empty());
+	}
+
+	//-------------------------------------------------------------------------
+	TEST(CoverageRollupTest, CoverageData)
+	{
+		Plugin::CoverageData coverageData{ L"Test", 0 };
+
+		AddFile(coverageData.AddModule(L"Module1.exe"), root / L"File.cpp", { true });
+		AddFile(coverageData.AddModule(L"Module2.exe"), root / L"File.cpp", { false, true });
+		coverageData.AddModule(L"Empty.exe");
+
+		Plugin::CoverageRollup coverageRollup{ coverageData };
+		const auto& rootNode = coverageRollup.GetRoot();
+		CheckNode(rootNode, root, 2, 3, 2);
+		ASSERT_EQ(2, rootNode.GetFiles().size());
+		ASSERT_TRUE(rootNode.GetChildren().empty());
+	}
+}
@@ -16,6 +16,9 @@
 
 #include "pch.h"
 
+#include <cstring>
+#include <new>
+
 #include "Plugin/Exporter/FileCoverage.hpp"
 #include "CppCoverage/CppCoverageException.hpp"
 
@@ -60,4 +63,217 @@ namespace PluginTest
 		
 		ASSERT_THROW(file.UpdateLine(0, false), std::runtime_error);
 	}
-}
\ No newline at end of file
+
+	//-------------------------------------------------------------------------
+	TEST(FileCoverageTest, AddLineNotSorted)
+	{
+		Plugin::FileCoverage file{ L"" };
+
+		file.AddLine(10, true);
+		file.AddLine(5, false);
+		ASSERT_THROW(file.AddLine(5, true), std::runtime_error);
+
+		const auto lines = file.GetLines();
+		ASSERT_EQ(2, lines.size());
+		ASSERT_EQ(5, lines.at(0).GetLineNumber());
+		ASSERT_EQ(10, lines.at(1).GetLineNumber());
+	}
+
+	//-------------------------------------------------------------------------
+	TEST(FileCoverageTest, MergeLines)
+	{
+		Plugin::FileCoverage file1{ L"" };
+		Plugin::FileCoverage file2{ L"" };
+
+		file1.AddLine(1, false);
+		file1.AddLine(3, true);
+		file1.AddLine(5, false);
+		file2.AddLine(0, true);
+		file2.AddLine(3, false);
+		file2.AddLine(5, true);
+		file2.AddLine(6, false);
+		file1.MergeLines(file2);
+
+		const auto lines = file1.GetLines();
+		std::vector<std::pair<unsigned int, bool>> expectedLines{
+			{ 0, true }, { 1, false }, { 3, true }, { 5, true }, { 6, false } };
+		ASSERT_EQ(expectedLines.size(), lines.size());
+		for (size_t i = 0; i < lines.size(); ++i)
+		{
+			ASSERT_EQ(expectedLines[i].first, lines[i].GetLineNumber());
+			ASSERT_EQ(expectedLines[i].second, lines[i].HasBeenExecuted());
+		}
+		ASSERT_EQ(4, file2.GetLines().size());
+	}
+
+	//-------------------------------------------------------------------------
+	TEST(FileCoverageTest, AssignmentCopyOnWrite)
+	{
+		Plugin::FileCoverage file1{ L"file1" };
+		Plugin::FileCoverage file2{ L"file2" };
+
+		file1.AddLine(1, false);
+		file2 = file1;
+		file2.UpdateLine(1, true);
+		file2.AddLine(2, true);
+
+		ASSERT_EQ(L"file1", file2.GetPath());
+		ASSERT_FALSE(file1[1]->HasBeenExecuted());
+		ASSERT_EQ(nullptr, file1[2]);
+		ASSERT_TRUE(file2[1]->HasBeenExecuted());
+	}
+
+	//-------------------------------------------------------------------------
+	TEST(FileCoverageTest, MergeLinesSameLineNumbers)
+	{
+		Plugin::FileCoverage file1{ L"" };
+		Plugin::FileCoverage file2{ L"" };
+		const unsigned int lineCount = 7;
+
+		for (unsigned int i = 0; i < lineCount; ++i)
+		{
+			file1.AddLine(i, i % 2 == 0);
+			file2.AddLine(i, i % 3 == 0);
+		}
+		file1.MergeLines(file2);
+
+		const auto lines = file1.GetLines();
+		ASSERT_EQ(lineCount, lines.size());
+		for (unsigned int i = 0; i < lineCount; ++i)
+		{
+			ASSERT_EQ(i, lines[i].GetLineNumber());
+			ASSERT_EQ(i % 2 == 0 || i % 3 == 0, lines[i].HasBeenExecuted());
+		}
+	}
+
+	//-------------------------------------------------------------------------
+	TEST(FileCoverageTest, LineRangeAndCounts)
+	{
+		Plugin::FileCoverage file1{ L"file" };
+		Plugin::FileCoverage file2{ L"file" };
+
+		file1.AddLine(2, true);
+		file1.AddLine(1, false);
+		file1.AddLine(3, false);
+		file1.UpdateLine(3, true);
+		file2.AddLine(1, true);
+		file2.AddLine(4, false);
+
+		ASSERT_EQ(3, file1.GetLineCount());
+		ASSERT_EQ(2, file1.GetExecutedLineCount());
+		ASSERT_EQ("file", file1.GetUtf8Path());
+
+		file1.MergeLines(file2);
+		ASSERT_EQ(4, file1.GetLineCount());
+		ASSERT_EQ(3, file1.GetExecutedLineCount());
+
+		auto lineRange = file1.GetLineRange();
+		ASSERT_EQ(4, lineRange.size());
+		unsigned int expectedLineNumber = 1;
+		for (const auto& line : lineRange)
+			ASSERT_EQ(expectedLineNumber++, line.GetLineNumber());
+	}
+
+	//-------------------------------------------------------------------------
+	TEST(FileCoverageTest, Functions)
+	{
+		Plugin::FileCoverage file{ L"file" };
+
+		file.AddFunction(2, L"Function2", 10, 12);
+		file.AddFunction(1, L"Function1", 1, 5);
+		ASSERT_THROW(file.AddFunction(3, L"Function3", 8, 7), std::runtime_error);
+
+		file.AddLine(1, true);
+		file.AddLine(4, false);
+		file.AddLine(10, true);
+		file.AddLine(11, true);
+		file.AddLine(20, false);
+
+		const auto functions = file.GetFunctions();
+		ASSERT_EQ(2, functions.size());
+		ASSERT_EQ(1, functions[0].GetSymbolId());
+		ASSERT_EQ(L"Function1", functions[0].GetName());
+		ASSERT_EQ(1, functions[0].GetFirstLineNumber());
+		ASSERT_EQ(5, functions[0].GetLastLineNumber());
+		ASSERT_EQ(2, functions[0].GetLineCount());
+		ASSERT_EQ(1, functions[0].GetExecutedLineCount());
+		ASSERT_EQ(L"Function2", functions[1].GetName());
+		ASSERT_EQ(2, functions[1].GetLineCount());
+		ASSERT_EQ(2, functions[1].GetExecutedLineCount());
+	}
+
+	//-------------------------------------------------------------------------
+	TEST(FileCoverageTest, MergeFunctions)
+	{
+		Plugin::FileCoverage file1{ L"file" };
+		Plugin::FileCoverage file2{ L"file" };
+
+		file1.AddLine(1, false);
+		file1.AddFunction(1, L"Function1", 1, 1);
+		file2.AddLine(1, true);
+		file2.AddLine(3, true);
+		file2.AddFunction(10, L"Function1", 1, 1);
+		file2.AddFunction(11, L"Function3", 3, 3);
+
+		file1.MergeLines(file2);
+
+		const auto functions = file1.GetFunctions();
+		ASSERT_EQ(2, functions.size());
+		ASSERT_EQ(1, functions[0].GetSymbolId());
+		ASSERT_EQ(1, functions[0].GetExecutedLineCount());
+		ASSERT_EQ(L"Function3", functions[1].GetName());
+		ASSERT_EQ(1, functions[1].GetExecutedLineCount());
+	}
+
+	//-------------------------------------------------------------------------
+	TEST(FileCoverageTest, ExternalLines)
+	{
+		const Plugin::LineCoverage lines[] = { { 1, true }, { 2, false }, { 5, true } };
+		Plugin::FileCoverage file{ L"file" };
+
+		file.SetExternalLines(Plugin::LineRange{ std::begin(lines), std::end(lines) });
+		ASSERT_EQ(std::begin(lines), file.GetLineRange().begin());
+		ASSERT_EQ(3, file.GetLineCount());
+		ASSERT_EQ(2, file.GetExecutedLineCount());
+		ASSERT_FALSE(file[2]->HasBeenExecuted());
+
+		file.UpdateLine(2, true);
+		ASSERT_NE(std::begin(lines), file.GetLineRange().begin());
+		ASSERT_TRUE(file[2]->HasBeenExecuted());
+		ASSERT_FALSE(lines[1].HasBeenExecuted());
+		ASSERT_EQ(3, file.GetExecutedLineCount());
+
+		const Plugin::LineCoverage unsortedLines[] = { { 2, true }, { 1, true } };
+		ASSERT_THROW(file.SetExternalLines(
+			Plugin::LineRange{ std::begin(unsortedLines), std::end(unsortedLines) }),
+			std::runtime_error);
+	}
+
+	//-------------------------------------------------------------------------
+	TEST(FileCoverageTest, MergeLinesIgnoresPadding)
+	{
+		const unsigned int lineCount = 4;
+		alignas(Plugin::LineCoverage) unsigned char buffer[lineCount * sizeof(Plugin::LineCoverage)];
+		auto* lines = reinterpret_cast<Plugin::LineCoverage*>(buffer);
+
+		// Construct the source lines over bytes set to 0xFF so their padding
+		// is not zero.
+		std::memset(buffer, 0xFF, sizeof(buffer));
+		for (unsigned int i = 0; i < lineCount; ++i)
+			new (&lines[i]) Plugin::LineCoverage{ i, i == 1 };
+
+		Plugin::FileCoverage source{ L"file" };
+		source.SetExternalLines(Plugin::LineRange{ lines, lines + lineCount });
+		Plugin::FileCoverage file{ L"file" };
+		for (unsigned int i = 0; i < lineCount; ++i)
+			file.AddLine(i, i == 2);
+
+		file.MergeLines(source);
+		ASSERT_EQ(2, file.GetExecutedLineCount());
+		for (unsigned int i = 0; i < lineCount; ++i)
+		{
+			ASSERT_EQ(i, file[i]->GetLineNumber());
+			ASSERT_EQ(i == 1 || i == 2, file[i]->HasBeenExecuted());
+		}
+	}
+}
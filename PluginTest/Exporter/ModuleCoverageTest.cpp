@@ -0,0 +1,123 @@
+// OpenCppCoverage is an open source code coverage for C++.
+// Copyright (C) 2019 OpenCppCoverage
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "pch.h"
+
+#include "Plugin/Exporter/ModuleCoverage.hpp"
+#include "Plugin/Exporter/FileCoverage.hpp"
+
+namespace PluginTest
+{
+	namespace
+	{
+		//---------------------------------------------------------------------
+		std::unique_ptr<Plugin::FileCoverage> CreateFile(
+			const std::wstring& path,
+			const std::vector<std::pair<unsigned int, bool>>& lines)
+		{
+			auto file = std::make_unique<Plugin::FileCoverage>(path);
+
+			for (const auto& line : lines)
+				file->AddLine(line.first, line.second);
+			return file;
+		}
+
+		//---------------------------------------------------------------------
+		void CheckLineCounts(const Plugin::ModuleCoverage& module)
+		{
+			size_t lineCount = 0;
+			size_t executedLineCount = 0;
+
+			for (const auto& file : module.GetFiles())
+			{
+				lineCount += file->GetLineCount();
+				executedLineCount += file->GetExecutedLineCount();
+			}
+			ASSERT_EQ(lineCount, module.GetLineCount());
+			ASSERT_EQ(executedLineCount, module.GetExecutedLineCount());
+		}
+	}
+
+	//-------------------------------------------------------------------------
+	TEST(ModuleCoverageTest, LineCounts)
+	{
+		Plugin::ModuleCoverage module{ L"module" };
+
+		auto& file1 = module.AddFile(L"file1");
+		file1.AddLine(1, true);
+		file1.AddLine(2, false);
+		module.AddFile(CreateFile(L"file2", { { 1, true }, { 3, true } }));
+
+		ASSERT_EQ(4, module.GetLineCount());
+		ASSERT_EQ(3, module.GetExecutedLineCount());
+
+		file1.UpdateLine(1, false);
+		ASSERT_EQ(4, module.GetLineCount());
+		ASSERT_EQ(2, module.GetExecutedLineCount());
+		CheckLineCounts(module);
+	}
+
+	//-------------------------------------------------------------------------
+	TEST(ModuleCoverageTest, LineCountsAfterMergeLines)
+	{
+		Plugin::ModuleCoverage module{ L"module" };
+		auto& file1 = module.AddFile(L"file1");
+		auto& file2 = module.AddFile(L"file2");
+
+		// Shared lines.
+		auto source1 = CreateFile(L"file1", { { 1, false }, { 2, true } });
+		file1.MergeLines(*source1);
+		ASSERT_EQ(2, module.GetLineCount());
+		ASSERT_EQ(1, module.GetExecutedLineCount());
+
+		// Same line numbers.
+		auto source2 = CreateFile(L"file1", { { 1, true }, { 2, false } });
+		file1.MergeLines(*source2);
+		ASSERT_EQ(2, module.GetLineCount());
+		ASSERT_EQ(2, module.GetExecutedLineCount());
+
+		// Different line numbers.
+		file2.AddLine(5, false);
+		auto source3 = CreateFile(L"file2", { { 4, true }, { 5, true }, { 6, false } });
+		file2.MergeLines(*source3);
+		ASSERT_EQ(5, module.GetLineCount());
+		ASSERT_EQ(4, module.GetExecutedLineCount());
+		CheckLineCounts(module);
+
+		// Modifying the source does not change the module.
+		source1->UpdateLine(1, true);
+		ASSERT_EQ(4, module.GetExecutedLineCount());
+		CheckLineCounts(module);
+	}
+
+	//-------------------------------------------------------------------------
+	TEST(ModuleCoverageTest, LineCountsAfterReleaseFiles)
+	{
+		Plugin::ModuleCoverage module{ L"module" };
+		module.AddFile(CreateFile(L"file", { { 1, true }, { 2, false } }));
+
+		auto files = module.ReleaseFiles();
+		ASSERT_EQ(0, module.GetLineCount());
+		ASSERT_EQ(0, module.GetExecutedLineCount());
+
+		files.front()->AddLine(3, true);
+		ASSERT_EQ(0, module.GetLineCount());
+
+		module.AddFile(std::move(files.front()));
+		ASSERT_EQ(3, module.GetLineCount());
+		ASSERT_EQ(2, module.GetExecutedLineCount());
+	}
+}
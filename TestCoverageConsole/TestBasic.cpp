@@ -49,9 +49,15 @@ namespace TestCoverageConsole
 
 		for (int i = 2; i < argc; ++i)
 		{
-			auto argument = Tools::ToLocalString(argv[i]);
-			std::cout << "Start: " << outputBinaryPath << " with " << argument << std::endl;
-			auto handle = Poco::Process::launch(outputBinaryPath.string(), std::vector<std::string>{argument});
+			std::vector<std::string> arguments{ Tools::ToLocalString(argv[i]) };
+
+			if (argv[i] == TestCoverageConsole::TestGrandChildProcess && i + 1 < argc)
+			{
+				arguments = { Tools::ToLocalString(TestCoverageConsole::TestChildProcess),
+					Tools::ToLocalString(argv[++i]) };
+			}
+			std::cout << "Start: " << outputBinaryPath << " with " << arguments.back() << std::endl;
+			auto handle = Poco::Process::launch(outputBinaryPath.string(), arguments);
 			handle.wait();
 		}
 	}
@@ -59,6 +59,8 @@ namespace TestCoverageConsole
 	const std::wstring TestThrowUnHandledSEHException = L"TestThrowUnHandledSEHException";
 	const std::wstring TestBreakPoint = L"TestBreakPoint";
 	const std::wstring TestChildProcess = L"ChildProcess";
+	// Argument of TestChildProcess: the next argument runs in a grandchild.
+	const std::wstring TestGrandChildProcess = L"GrandChildProcess";
 	const std::wstring TestFileInSeveralModules = L"FileInSeveralModules";
 	const std::wstring TestSpecialLineInfo = L"TestSpecialLineInfo";
 	const std::wstring TestUnloadReloadDll = L"TestUnloadReloadDll";
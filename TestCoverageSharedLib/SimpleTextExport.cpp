@@ -31,14 +31,9 @@ class SimpleTextExport : public Plugin::IExportPlugin
 			ofs << mod->GetPath().filename().wstring() << std::endl;
 			for (const auto& file : mod->GetFiles())
 			{
-				const auto& lines = file->GetLines();
-				auto coveredCount = std::count_if(
-				    lines.begin(), lines.end(), [](const auto& line) {
-					    return line.HasBeenExecuted();
-				    });
 				ofs << '\t' << file->GetPath().filename().wstring() << "  ";
-				ofs << "Lines covered: " << coveredCount
-				    << " Total: " << lines.size() << std::endl;
+				ofs << "Lines covered: " << file->GetExecutedLineCount()
+				    << " Total: " << file->GetLineCount() << std::endl;
 			}
 		}
 		return output;
@@ -54,6 +49,8 @@ class SimpleTextExport : public Plugin::IExportPlugin
 	}
 
 	//-------------------------------------------------------------------------
+	// Also in the version resource of TestCoverageSharedLib.rc so the plugin
+	// is not loaded to show the help.
 	std::wstring GetArgumentHelpDescription()
 	{
 		return L"output file (optional)";
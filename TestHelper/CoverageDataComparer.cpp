@@ -46,6 +46,17 @@ namespace TestHelper
 			AssertEqual(line1.HasBeenExecuted(), line2.HasBeenExecuted());
 		}
 
+		//---------------------------------------------------------------------
+		void AssertFunctionsEquals(
+			const Plugin::FunctionCoverage& function1,
+			const Plugin::FunctionCoverage& function2)
+		{
+			AssertEqual(function1.GetSymbolId(), function2.GetSymbolId());
+			AssertEqual(function1.GetName(), function2.GetName());
+			AssertEqual(function1.GetFirstLineNumber(), function2.GetFirstLineNumber());
+			AssertEqual(function1.GetLastLineNumber(), function2.GetLastLineNumber());
+		}
+
 		//---------------------------------------------------------------------
 		void AssertFilesEquals(
 			const Plugin::FileCoverage& file1,
@@ -53,6 +64,7 @@ namespace TestHelper
 		{
 			AssertEqual(file1.GetPath(), file2.GetPath());
 			AssertContainerEqual(file1.GetLines(), file2.GetLines(), AssertLinesEquals);
+			AssertContainerEqual(file1.GetFunctions(), file2.GetFunctions(), AssertFunctionsEquals);
 		}
 
 		//---------------------------------------------------------------------
@@ -0,0 +1,118 @@
+// OpenCppCoverage is an open source code coverage for C++.
+// Copyright (C) 2019 OpenCppCoverage
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "stdafx.h"
+#include "MemoryMessageChannel.hpp"
+
+namespace TestHelper
+{
+	//-------------------------------------------------------------------------
+	struct MemoryMessageChannel::Queue
+	{
+		std::mutex mutex_;
+		std::condition_variable condition_;
+		std::deque<std::string> messages_;
+		bool isClosed_ = false;
+	};
+
+	//-------------------------------------------------------------------------
+	MemoryMessageChannel::Pair MemoryMessageChannel::CreatePair()
+	{
+		auto clientToServer = std::make_shared<Queue>();
+		auto serverToClient = std::make_shared<Queue>();
+
+		return {
+			std::unique_ptr<MemoryMessageChannel>{
+				new MemoryMessageChannel{ serverToClient, clientToServer } },
+			std::unique_ptr<MemoryMessageChannel>{
+				new MemoryMessageChannel{ clientToServer, serverToClient } } };
+	}
+
+	//-------------------------------------------------------------------------
+	MemoryMessageChannel::MemoryMessageChannel(
+		std::shared_ptr<Queue> input,
+		std::shared_ptr<Queue> output)
+		: input_{ std::move(input) }
+		, output_{ std::move(output) }
+	{
+	}
+
+	//-------------------------------------------------------------------------
+	MemoryMessageChannel::~MemoryMessageChannel()
+	{
+		std::lock_guard<std::mutex> lock{ output_->mutex_ };
+		output_->isClosed_ = true;
+		output_->condition_.notify_all();
+	}
+
+	//-------------------------------------------------------------------------
+	void MemoryMessageChannel::Write(const std::string& message)
+	{
+		std::lock_guard<std::mutex> lock{ output_->mutex_ };
+		output_->messages_.push_back(message);
+		output_->condition_.notify_all();
+	}
+
+	//-------------------------------------------------------------------------
+	boost::optional<std::string> MemoryMessageChannel::Read()
+	{
+		std::unique_lock<std::mutex> lock{ input_->mutex_ };
+
+		input_->condition_.wait(lock, [&]() {
+			return !input_->messages_.empty() || input_->isClosed_;
+		});
+		if (input_->messages_.empty())
+			return boost::none;
+
+		auto message = std::move(input_->messages_.front());
+		input_->messages_.pop_front();
+		return message;
+	}
+
+	//-------------------------------------------------------------------------
+	std::unique_ptr<CppCoverage::IMessageChannel> MemoryMessageChannelListener::Connect()
+	{
+		auto channels = MemoryMessageChannel::CreatePair();
+		std::lock_guard<std::mutex> lock{ mutex_ };
+
+		pendingChannels_.push_back(std::move(channels.second));
+		condition_.notify_all();
+		return std::move(channels.first);
+	}
+
+	//-------------------------------------------------------------------------
+	void MemoryMessageChannelListener::Close()
+	{
+		std::lock_guard<std::mutex> lock{ mutex_ };
+
+		isClosed_ = true;
+		condition_.notify_all();
+	}
+
+	//-------------------------------------------------------------------------
+	std::unique_ptr<CppCoverage::IMessageChannel> MemoryMessageChannelListener::Accept()
+	{
+		std::unique_lock<std::mutex> lock{ mutex_ };
+
+		condition_.wait(lock, [&]() { return !pendingChannels_.empty() || isClosed_; });
+		if (pendingChannels_.empty())
+			return nullptr;
+
+		auto channel = std::move(pendingChannels_.front());
+		pendingChannels_.pop_front();
+		return channel;
+	}
+}
@@ -0,0 +1,76 @@
+// OpenCppCoverage is an open source code coverage for C++.
+// Copyright (C) 2019 OpenCppCoverage
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+#include "CppCoverage/MessageChannel.hpp"
+
+#include "TestHelperExport.hpp"
+
+namespace TestHelper
+{
+	//-------------------------------------------------------------------------
+	// In memory stand-in for a named pipe connection.
+	//-------------------------------------------------------------------------
+	class TEST_HELPER_DLL MemoryMessageChannel : public CppCoverage::IMessageChannel
+	{
+	public:
+		using Pair = std::pair<
+			std::unique_ptr<MemoryMessageChannel>,
+			std::unique_ptr<MemoryMessageChannel>>;
+
+		static Pair CreatePair();
+
+		~MemoryMessageChannel();
+
+		void Write(const std::string& message) override;
+		boost::optional<std::string> Read() override;
+
+	private:
+		struct Queue;
+
+		MemoryMessageChannel(std::shared_ptr<Queue> input, std::shared_ptr<Queue> output);
+
+		std::shared_ptr<Queue> input_;
+		std::shared_ptr<Queue> output_;
+	};
+
+	//-------------------------------------------------------------------------
+	class TEST_HELPER_DLL MemoryMessageChannelListener : public CppCoverage::IMessageChannelListener
+	{
+	public:
+		// Return the client side of a new connection.
+		std::unique_ptr<CppCoverage::IMessageChannel> Connect();
+
+		// Accept returns nullptr once the pending connections are accepted.
+		void Close() override;
+
+		std::unique_ptr<CppCoverage::IMessageChannel> Accept() override;
+
+	private:
+		std::mutex mutex_;
+		std::condition_variable condition_;
+		std::deque<std::unique_ptr<CppCoverage::IMessageChannel>> pendingChannels_;
+		bool isClosed_ = false;
+	};
+}
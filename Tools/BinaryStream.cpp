@@ -0,0 +1,145 @@
+// OpenCppCoverage is an open source code coverage for C++.
+// Copyright (C) 2019 OpenCppCoverage
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "stdafx.h"
+#include "BinaryStream.hpp"
+
+#include <istream>
+#include <ostream>
+
+#include "Tool.hpp"
+
+namespace Tools
+{
+	//-------------------------------------------------------------------------
+	BinaryWriter::BinaryWriter(std::ostream& ostr)
+		: ostr_{ ostr }
+	{
+	}
+
+	//-------------------------------------------------------------------------
+	void BinaryWriter::WriteVarint(uint64_t value)
+	{
+		while (value >= 0x80)
+		{
+			ostr_.put(static_cast<char>((value & 0x7F) | 0x80));
+			value >>= 7;
+		}
+		ostr_.put(static_cast<char>(value));
+	}
+
+	//-------------------------------------------------------------------------
+	void BinaryWriter::WriteString(const std::string& str)
+	{
+		Write<uint32_t>(static_cast<uint32_t>(str.size()));
+		WriteBytes(str.data(), str.size());
+	}
+
+	//-------------------------------------------------------------------------
+	void BinaryWriter::WriteString(const std::wstring& str)
+	{
+		WriteString(ToUtf8String(str));
+	}
+
+	//-------------------------------------------------------------------------
+	void BinaryWriter::WriteBytes(const void* data, size_t size)
+	{
+		ostr_.write(static_cast<const char*>(data), size);
+	}
+
+	//-------------------------------------------------------------------------
+	const uint64_t BinaryReader::DefaultMaxSize = 256 * 1024 * 1024;
+
+	//-------------------------------------------------------------------------
+	BinaryReader::BinaryReader(std::istream& istr, uint64_t maxSize)
+		: istr_{ istr }
+		, remainingSize_{ maxSize }
+	{
+		auto position = istr_.tellg();
+
+		if (position != std::istream::pos_type(-1) && istr_.seekg(0, std::ios::end))
+		{
+			auto end = istr_.tellg();
+
+			istr_.seekg(position);
+			if (end != std::istream::pos_type(-1) && end >= position)
+				remainingSize_ = static_cast<uint64_t>(end - position);
+		}
+		istr_.clear(istr_.rdstate() & ~std::ios::failbit);
+	}
+
+	//-------------------------------------------------------------------------
+	bool BinaryReader::ReadVarint(uint64_t& value)
+	{
+		value = 0;
+		for (int shift = 0; shift < 64; shift += 7)
+		{
+			unsigned char byte;
+
+			if (!ReadBytes(&byte, 1))
+				return false;
+			value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+			if (!(byte & 0x80))
+				return true;
+		}
+		return false;
+	}
+
+	//-------------------------------------------------------------------------
+	bool BinaryReader::ReadString(std::string& str)
+	{
+		uint32_t size;
+
+		if (!Read(size) || !CanRead(size))
+			return false;
+		str.resize(size);
+		return ReadBytes(&str[0], str.size());
+	}
+
+	//-------------------------------------------------------------------------
+	bool BinaryReader::ReadString(std::wstring& str)
+	{
+		std::string utf8Str;
+
+		if (!ReadString(utf8Str))
+			return false;
+		str = Utf8ToWString(utf8Str);
+		return true;
+	}
+
+	//-------------------------------------------------------------------------
+	bool BinaryReader::ReadBytes(void* data, size_t size)
+	{
+		if (!CanRead(size))
+			return false;
+		if (size && !istr_.read(static_cast<char*>(data), size))
+			return false;
+		remainingSize_ -= size;
+		return true;
+	}
+
+	//-------------------------------------------------------------------------
+	bool BinaryReader::CanRead(uint64_t count, uint64_t elementSize) const
+	{
+		return elementSize == 0 || count <= remainingSize_ / elementSize;
+	}
+
+	//-------------------------------------------------------------------------
+	uint64_t BinaryReader::GetRemainingSize() const
+	{
+		return remainingSize_;
+	}
+}
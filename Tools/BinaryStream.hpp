@@ -0,0 +1,145 @@
+// OpenCppCoverage is an open source code coverage for C++.
+// Copyright (C) 2019 OpenCppCoverage
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "ToolsExport.hpp"
+
+namespace Tools
+{
+	namespace Detail
+	{
+		//---------------------------------------------------------------------
+		template <typename T>
+		auto ToUnsigned(T value)
+		{
+			if constexpr (std::is_same_v<T, bool>)
+				return static_cast<uint8_t>(value);
+			else if constexpr (std::is_enum_v<T>)
+				return static_cast<std::make_unsigned_t<std::underlying_type_t<T>>>(value);
+			else
+			{
+				static_assert(std::is_integral_v<T>, "Only integral and enum types are supported.");
+				return static_cast<std::make_unsigned_t<T>>(value);
+			}
+		}
+	}
+
+	// Write integers in little endian and strings as UTF-8 with their size
+	// so binary files do not depend on the platform.
+	class TOOLS_DLL BinaryWriter
+	{
+	public:
+		explicit BinaryWriter(std::ostream&);
+
+		//---------------------------------------------------------------------
+		template <typename T>
+		void Write(T value)
+		{
+			auto integer = Detail::ToUnsigned(value);
+			unsigned char bytes[sizeof(T)];
+
+			for (size_t i = 0; i < sizeof(T); ++i)
+				bytes[i] = static_cast<unsigned char>(integer >> (8 * i));
+			WriteBytes(bytes, sizeof(T));
+		}
+
+		//---------------------------------------------------------------------
+		template <typename T>
+		void WriteValues(const std::vector<T>& values)
+		{
+			for (const auto& value : values)
+				Write(value);
+		}
+
+		void WriteVarint(uint64_t);
+		void WriteString(const std::string&);
+		void WriteString(const std::wstring&);
+		void WriteBytes(const void*, size_t);
+
+	private:
+		BinaryWriter(const BinaryWriter&) = delete;
+		BinaryWriter& operator=(const BinaryWriter&) = delete;
+
+		std::ostream& ostr_;
+	};
+
+	// Read the format of BinaryWriter. All methods return false when the
+	// stream ends before the value. Sizes read from the stream are checked
+	// against the remaining bytes before anything is allocated so a corrupt
+	// file is reported as truncated.
+	class TOOLS_DLL BinaryReader
+	{
+	public:
+		// Limit used when the size of the stream cannot be computed.
+		static const uint64_t DefaultMaxSize;
+
+		explicit BinaryReader(std::istream&, uint64_t maxSize = DefaultMaxSize);
+
+		//---------------------------------------------------------------------
+		template <typename T>
+		bool Read(T& value)
+		{
+			using Unsigned = decltype(Detail::ToUnsigned(value));
+			unsigned char bytes[sizeof(T)];
+			Unsigned integer = 0;
+
+			if (!ReadBytes(bytes, sizeof(T)))
+				return false;
+			for (size_t i = 0; i < sizeof(T); ++i)
+				integer |= static_cast<Unsigned>(static_cast<Unsigned>(bytes[i]) << (8 * i));
+			value = static_cast<T>(integer);
+			return true;
+		}
+
+		//---------------------------------------------------------------------
+		template <typename T>
+		bool ReadValues(std::vector<T>& values, uint64_t count)
+		{
+			if (!CanRead(count, sizeof(T)))
+				return false;
+			values.resize(static_cast<size_t>(count));
+			for (auto& value : values)
+			{
+				if (!Read(value))
+					return false;
+			}
+			return true;
+		}
+
+		bool ReadVarint(uint64_t&);
+		bool ReadString(std::string&);
+		bool ReadString(std::wstring&);
+		bool ReadBytes(void*, size_t);
+
+		// Return true if count elements of elementSize bytes can be read.
+		bool CanRead(uint64_t count, uint64_t elementSize = 1) const;
+		uint64_t GetRemainingSize() const;
+
+	private:
+		BinaryReader(const BinaryReader&) = delete;
+		BinaryReader& operator=(const BinaryReader&) = delete;
+
+		std::istream& istr_;
+		uint64_t remainingSize_;
+	};
+}
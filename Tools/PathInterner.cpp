@@ -0,0 +1,146 @@
+// OpenCppCoverage is an open source code coverage for C++.
+// Copyright (C) 2014 OpenCppCoverage
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "stdafx.h"
+#include "PathInterner.hpp"
+
+#include <boost/algorithm/string.hpp>
+
+#include "ToolsException.hpp"
+
+namespace fs = std::filesystem;
+
+namespace Tools
+{
+	namespace
+	{
+		//---------------------------------------------------------------------
+		std::wstring NormalizePath(const fs::path& path)
+		{
+			fs::path lowerPath = boost::algorithm::to_lower_copy(path.wstring());
+			lowerPath.make_preferred();
+
+			return lowerPath.wstring();
+		}
+
+		//---------------------------------------------------------------------
+		std::pair<size_t, size_t> GetChunkPosition(size_t index, size_t firstChunkSize)
+		{
+			size_t chunkIndex = 0;
+			size_t chunkSize = firstChunkSize;
+
+			while (index >= chunkSize)
+			{
+				index -= chunkSize;
+				chunkSize *= 2;
+				++chunkIndex;
+			}
+			return { chunkIndex, index };
+		}
+	}
+
+	//-------------------------------------------------------------------------
+	PathInterner& PathInterner::GetInstance()
+	{
+		static PathInterner pathInterner;
+
+		return pathInterner;
+	}
+
+	//-------------------------------------------------------------------------
+	PathInterner::PathInterner()
+		: count_{ 0 }
+	{
+	}
+
+	//-------------------------------------------------------------------------
+	PathInterner::~PathInterner() = default;
+
+	//-------------------------------------------------------------------------
+	PathId PathInterner::Intern(const fs::path& path)
+	{
+		std::lock_guard<std::mutex> lock{mutex_};
+
+		return InternNoLock(path);
+	}
+
+	//-------------------------------------------------------------------------
+	PathId PathInterner::InternNoLock(const fs::path& path)
+	{
+		auto it = idByPath_.find(path.native());
+
+		if (it != idByPath_.end())
+			return it->second;
+
+		auto normalizedPath = NormalizePath(path);
+		auto isCanonical = normalizedPath == path.native();
+		auto canonicalId = isCanonical ? 0 : InternNoLock(normalizedPath);
+		auto count = count_.load(std::memory_order_relaxed);
+		auto id = static_cast<PathId>(count);
+		auto chunkPosition = GetChunkPosition(count, FirstChunkSize);
+
+		if (isCanonical)
+			canonicalId = id;
+
+		auto& chunk = chunks_.at(chunkPosition.first);
+		if (!chunk)
+			chunk = std::make_unique<Entry[]>(FirstChunkSize << chunkPosition.first);
+
+		// Entries never move so the key can point to the stored path.
+		auto& entry = chunk[chunkPosition.second];
+		entry = Entry{path, std::move(normalizedPath), canonicalId};
+		idByPath_.emplace(entry.path_.native(), id);
+
+		// Readers see the entry once the count includes it.
+		count_.store(count + 1, std::memory_order_release);
+
+		return id;
+	}
+
+	//-------------------------------------------------------------------------
+	const fs::path& PathInterner::GetPath(PathId id) const
+	{
+		return GetEntry(id).path_;
+	}
+
+	//-------------------------------------------------------------------------
+	const std::wstring& PathInterner::GetNormalizedPath(PathId id) const
+	{
+		return GetEntry(id).normalizedPath_;
+	}
+
+	//-------------------------------------------------------------------------
+	PathId PathInterner::GetCanonicalId(PathId id) const
+	{
+		return GetEntry(id).canonicalId_;
+	}
+
+	//-------------------------------------------------------------------------
+	size_t PathInterner::GetCount() const
+	{
+		return count_.load(std::memory_order_acquire);
+	}
+
+	//-------------------------------------------------------------------------
+	const PathInterner::Entry& PathInterner::GetEntry(PathId id) const
+	{
+		if (id >= count_.load(std::memory_order_acquire))
+			THROW(L"Invalid path id: " << id);
+
+		auto chunkPosition = GetChunkPosition(id, FirstChunkSize);
+		return chunks_[chunkPosition.first][chunkPosition.second];
+	}
+}
@@ -0,0 +1,84 @@
+// OpenCppCoverage is an open source code coverage for C++.
+// Copyright (C) 2014 OpenCppCoverage
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <filesystem>
+
+#include "ToolsExport.hpp"
+
+namespace Tools
+{
+	using PathId = unsigned int;
+
+	// Intern takes a lock. Readers do not: entries are stored in chunks that
+	// never move and are published by the entry count.
+	class TOOLS_DLL PathInterner
+	{
+	public:
+		// Process-wide instance shared by all modules.
+		static PathInterner& GetInstance();
+
+		PathInterner();
+		~PathInterner();
+
+		PathInterner(const PathInterner&) = delete;
+		PathInterner& operator=(const PathInterner&) = delete;
+		PathInterner(PathInterner&&) = delete;
+		PathInterner& operator=(PathInterner&&) = delete;
+
+		// Return the same id for the same path. The path is stored and
+		// normalized (lower case, preferred separators) only the first time.
+		PathId Intern(const std::filesystem::path&);
+
+		const std::filesystem::path& GetPath(PathId) const;
+		const std::wstring& GetNormalizedPath(PathId) const;
+
+		// Paths that differ only by case or by separators share the same
+		// canonical id.
+		PathId GetCanonicalId(PathId) const;
+
+		size_t GetCount() const;
+
+	private:
+		struct Entry
+		{
+			std::filesystem::path path_;
+			std::wstring normalizedPath_;
+			PathId canonicalId_;
+		};
+
+		// The first chunk has FirstChunkSize entries and each next chunk is
+		// twice as large, so ChunkCount chunks cover all the PathId values.
+		static constexpr size_t FirstChunkSize = 1024;
+		static constexpr size_t ChunkCount = 23;
+
+		PathId InternNoLock(const std::filesystem::path&);
+		const Entry& GetEntry(PathId) const;
+
+		std::mutex mutex_;
+		std::array<std::unique_ptr<Entry[]>, ChunkCount> chunks_;
+		std::atomic<size_t> count_;
+		std::unordered_map<std::wstring_view, PathId> idByPath_;
+	};
+}
@@ -0,0 +1,192 @@
+// OpenCppCoverage is an open source code coverage for C++.
+// Copyright (C) 2019 OpenCppCoverage
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "stdafx.h"
+#include "SourceRepository.hpp"
+
+#include "MappedFile.hpp"
+
+namespace fs = std::filesystem;
+
+namespace Tools
+{
+	const size_t SourceRepository::DefaultMemoryLimit = 256 * 1024 * 1024;
+
+	//-------------------------------------------------------------------------
+	SourceRepository::SourceFile::SourceFile(
+		std::uintmax_t size,
+		fs::file_time_type lastWriteTime,
+		std::unique_ptr<MappedFile> mappedFile)
+		: size_{ size }
+		, lastWriteTime_{ lastWriteTime }
+		, mappedFile_{ std::move(mappedFile) }
+	{
+	}
+
+	//-------------------------------------------------------------------------
+	SourceRepository::SourceFile::~SourceFile() = default;
+
+	//-------------------------------------------------------------------------
+	const std::vector<std::string>& SourceRepository::SourceFile::GetLines() const
+	{
+		static const std::vector<std::string> noLines;
+
+		return mappedFile_ ? mappedFile_->GetLines() : noLines;
+	}
+
+	//-------------------------------------------------------------------------
+	std::uintmax_t SourceRepository::SourceFile::GetSize() const
+	{
+		return size_;
+	}
+
+	//-------------------------------------------------------------------------
+	fs::file_time_type SourceRepository::SourceFile::GetLastWriteTime() const
+	{
+		return lastWriteTime_;
+	}
+
+	//-------------------------------------------------------------------------
+	size_t SourceRepository::SourceFile::GetMemorySize() const
+	{
+		return sizeof(SourceFile) + static_cast<size_t>(size_)
+			+ GetLines().size() * sizeof(std::string);
+	}
+
+	//-------------------------------------------------------------------------
+	SourceRepository& SourceRepository::GetInstance()
+	{
+		static SourceRepository sourceRepository;
+
+		return sourceRepository;
+	}
+
+	//-------------------------------------------------------------------------
+	SourceRepository::SourceRepository(size_t memoryLimit)
+		: memoryLimit_{ memoryLimit }
+		, memorySize_{ 0 }
+		, readCount_{ 0 }
+	{
+	}
+
+	//-------------------------------------------------------------------------
+	SourceRepository::~SourceRepository() = default;
+
+	//-------------------------------------------------------------------------
+	std::shared_ptr<const SourceRepository::SourceFile>
+	SourceRepository::GetSourceFile(const fs::path& path)
+	{
+		std::error_code error;
+		fs::directory_entry directoryEntry{ path, error };
+
+		if (error || !directoryEntry.is_regular_file(error))
+			return nullptr;
+
+		auto size = directoryEntry.file_size(error);
+		if (error)
+			return nullptr;
+
+		auto lastWriteTime = directoryEntry.last_write_time(error);
+		if (error)
+			return nullptr;
+
+		auto& pathInterner = PathInterner::GetInstance();
+		auto id = pathInterner.GetCanonicalId(pathInterner.Intern(path));
+		{
+			std::lock_guard<std::mutex> lock{ mutex_ };
+			auto it = entryById_.find(id);
+
+			if (it != entryById_.end())
+			{
+				auto entryIt = it->second;
+				const auto& sourceFile = entryIt->second;
+
+				if (sourceFile->GetSize() == size && sourceFile->GetLastWriteTime() == lastWriteTime)
+				{
+					entries_.splice(entries_.begin(), entries_, entryIt);
+					return sourceFile;
+				}
+			}
+		}
+
+		// Read the file without the lock so other files can be served meanwhile.
+		auto mappedFile = size ? MappedFile::TryCreate(path) : nullptr;
+		auto sourceFile = std::make_shared<const SourceFile>(size, lastWriteTime, std::move(mappedFile));
+
+		std::lock_guard<std::mutex> lock{ mutex_ };
+		++readCount_;
+		AddNoLock(id, sourceFile);
+
+		return sourceFile;
+	}
+
+	//-------------------------------------------------------------------------
+	void SourceRepository::SetMemoryLimit(size_t memoryLimit)
+	{
+		std::lock_guard<std::mutex> lock{ mutex_ };
+
+		memoryLimit_ = memoryLimit;
+		EvictNoLock();
+	}
+
+	//-------------------------------------------------------------------------
+	size_t SourceRepository::GetMemorySize() const
+	{
+		std::lock_guard<std::mutex> lock{ mutex_ };
+
+		return memorySize_;
+	}
+
+	//-------------------------------------------------------------------------
+	int SourceRepository::GetReadCount() const
+	{
+		std::lock_guard<std::mutex> lock{ mutex_ };
+
+		return readCount_;
+	}
+
+	//-------------------------------------------------------------------------
+	void SourceRepository::AddNoLock(PathId id, SourceFilePtr sourceFile)
+	{
+		auto it = entryById_.find(id);
+
+		if (it != entryById_.end())
+		{
+			memorySize_ -= it->second->second->GetMemorySize();
+			entries_.erase(it->second);
+			entryById_.erase(it);
+		}
+
+		memorySize_ += sourceFile->GetMemorySize();
+		entries_.emplace_front(id, std::move(sourceFile));
+		entryById_.emplace(id, entries_.begin());
+		EvictNoLock();
+	}
+
+	//-------------------------------------------------------------------------
+	void SourceRepository::EvictNoLock()
+	{
+		// The most recently used file is always kept.
+		while (memorySize_ > memoryLimit_ && entries_.size() > 1)
+		{
+			const auto& entry = entries_.back();
+
+			memorySize_ -= entry.second->GetMemorySize();
+			entryById_.erase(entry.first);
+			entries_.pop_back();
+		}
+	}
+}
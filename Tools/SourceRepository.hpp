@@ -0,0 +1,108 @@
+// OpenCppCoverage is an open source code coverage for C++.
+// Copyright (C) 2019 OpenCppCoverage
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <filesystem>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "PathInterner.hpp"
+#include "ToolsExport.hpp"
+
+namespace Tools
+{
+	class MappedFile;
+
+	// Source files shared by the line filter and the exporters so each
+	// file is read only once per run.
+	// A file is read again when its size or its last write time changes.
+	// The least recently used files are released when the memory limit
+	// is exceeded.
+	class TOOLS_DLL SourceRepository
+	{
+	public:
+		static const size_t DefaultMemoryLimit;
+
+		class TOOLS_DLL SourceFile
+		{
+		public:
+			SourceFile(
+				std::uintmax_t size,
+				std::filesystem::file_time_type lastWriteTime,
+				std::unique_ptr<MappedFile>);
+			~SourceFile();
+
+			// Empty when the file is empty.
+			const std::vector<std::string>& GetLines() const;
+
+			std::uintmax_t GetSize() const;
+			std::filesystem::file_time_type GetLastWriteTime() const;
+
+			// Estimation of the memory used by the lines.
+			size_t GetMemorySize() const;
+
+		private:
+			SourceFile(const SourceFile&) = delete;
+			SourceFile& operator=(const SourceFile&) = delete;
+
+			std::uintmax_t size_;
+			std::filesystem::file_time_type lastWriteTime_;
+			std::unique_ptr<MappedFile> mappedFile_;
+		};
+
+		// Process-wide instance shared by all modules.
+		static SourceRepository& GetInstance();
+
+		explicit SourceRepository(size_t memoryLimit = DefaultMemoryLimit);
+		~SourceRepository();
+
+		// Return nullptr if path is not a regular file.
+		// The returned file stays valid after it is evicted.
+		std::shared_ptr<const SourceFile> GetSourceFile(const std::filesystem::path&);
+
+		void SetMemoryLimit(size_t);
+
+		// Memory used by the cached files.
+		size_t GetMemorySize() const;
+
+		// Number of files read from the disk.
+		int GetReadCount() const;
+
+	private:
+		SourceRepository(const SourceRepository&) = delete;
+		SourceRepository& operator=(const SourceRepository&) = delete;
+
+		using SourceFilePtr = std::shared_ptr<const SourceFile>;
+		using Entry = std::pair<PathId, SourceFilePtr>;
+
+		void AddNoLock(PathId, SourceFilePtr);
+		void EvictNoLock();
+
+		mutable std::mutex mutex_;
+
+		// Most recently used first.
+		std::list<Entry> entries_;
+		std::unordered_map<PathId, std::list<Entry>::iterator> entryById_;
+		size_t memoryLimit_;
+		size_t memorySize_;
+		int readCount_;
+	};
+}
@@ -175,4 +175,18 @@ namespace Tools
 		// Error can happen when the drive is not ready (DVD for example).
 		return std::filesystem::exists(path, ignoredErrorCode);
 	}
-}
\ No newline at end of file
+
+	//---------------------------------------------------------------------
+	std::filesystem::path CreateTemporaryFile()
+	{
+		std::vector<wchar_t> folder(MAX_PATH + 1);
+		std::vector<wchar_t> filename(MAX_PATH);
+
+		if (!GetTempPath(static_cast<int>(folder.size()), &folder[0]))
+			THROW("Cannot get the temporary folder.");
+		if (!GetTempFileName(&folder[0], L"OCC", 0, &filename[0]))
+			THROW(L"Cannot create a temporary file in " << &folder[0]);
+
+		return fs::path{ &filename[0] };
+	}
+}
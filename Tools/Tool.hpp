@@ -62,6 +62,9 @@ namespace Tools
 
 	TOOLS_DLL void CreateParentFolderIfNeeded(const std::filesystem::path& path);
 	TOOLS_DLL bool FileExists(const std::filesystem::path& path);
+
+	// Create an empty file with a unique name in the temporary folder.
+	TOOLS_DLL std::filesystem::path CreateTemporaryFile();
 }
 
 
@@ -32,4 +32,10 @@ namespace Tools
 		for (const auto& warning : warnings_)
 			LOG_WARNING << warning;
 	}
+
+	//-------------------------------------------------------------------------
+	void WarningManager::Clear()
+	{
+		warnings_.clear();
+	}
 }
@@ -29,6 +29,7 @@ namespace Tools
 
 		void AddWarning(const std::wstring&);
 		void DisplayWarnings() const;
+		void Clear();
 		
 	private:
 		std::vector<std::wstring> warnings_;
@@ -0,0 +1,90 @@
+// OpenCppCoverage is an open source code coverage for C++.
+// Copyright (C) 2019 OpenCppCoverage
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "stdafx.h"
+#include "WorkQueue.hpp"
+
+#include <boost/optional/optional.hpp>
+
+#include "Tool.hpp"
+#include "Log.hpp"
+
+namespace Tools
+{
+	//-------------------------------------------------------------------------
+	WorkQueue::WorkQueue()
+		: isRunningTask_{ false }
+		, stop_{ false }
+		, thread_{ [this]() { Run(); } }
+	{
+	}
+
+	//-------------------------------------------------------------------------
+	WorkQueue::~WorkQueue()
+	{
+		{
+			std::lock_guard<std::mutex> lock{ mutex_ };
+			stop_ = true;
+		}
+		condition_.notify_one();
+		thread_.join();
+	}
+
+	//-------------------------------------------------------------------------
+	void WorkQueue::Push(std::function<void()> task)
+	{
+		{
+			std::lock_guard<std::mutex> lock{ mutex_ };
+			tasks_.push_back(std::move(task));
+		}
+		condition_.notify_one();
+	}
+
+	//-------------------------------------------------------------------------
+	void WorkQueue::Flush()
+	{
+		std::unique_lock<std::mutex> lock{ mutex_ };
+		emptyCondition_.wait(lock, [this]() { return tasks_.empty() && !isRunningTask_; });
+	}
+
+	//-------------------------------------------------------------------------
+	void WorkQueue::Run()
+	{
+		std::unique_lock<std::mutex> lock{ mutex_ };
+
+		while (true)
+		{
+			condition_.wait(lock, [this]() { return stop_ || !tasks_.empty(); });
+			if (tasks_.empty())
+				return;
+
+			auto task = std::move(tasks_.front());
+			tasks_.pop_front();
+			isRunningTask_ = true;
+			lock.unlock();
+
+			auto error = Try(task);
+			if (error)
+				LOG_ERROR << *error;
+
+			lock.lock();
+			isRunningTask_ = false;
+			if (tasks_.empty())
+				emptyCondition_.notify_all();
+		}
+	}
+}
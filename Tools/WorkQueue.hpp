@@ -0,0 +1,59 @@
+// OpenCppCoverage is an open source code coverage for C++.
+// Copyright (C) 2019 OpenCppCoverage
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include "ToolsExport.hpp"
+
+namespace Tools
+{
+	// Run tasks in order on a single background thread.
+	class TOOLS_DLL WorkQueue
+	{
+	public:
+		WorkQueue();
+
+		// Wait for all pushed tasks.
+		~WorkQueue();
+
+		// Errors thrown by a task are logged.
+		void Push(std::function<void()>);
+
+		// Block until all pushed tasks have run.
+		void Flush();
+
+	private:
+		WorkQueue(const WorkQueue&) = delete;
+		WorkQueue& operator=(const WorkQueue&) = delete;
+
+		void Run();
+
+		std::mutex mutex_;
+		std::condition_variable condition_;
+		std::condition_variable emptyCondition_;
+		std::deque<std::function<void()>> tasks_;
+		bool isRunningTask_;
+		bool stop_;
+		std::thread thread_;
+	};
+}
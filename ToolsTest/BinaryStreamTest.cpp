@@ -0,0 +1,117 @@
+// OpenCppCoverage is an open source code coverage for C++.
+// Copyright (C) 2019 OpenCppCoverage
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "stdafx.h"
+#include "Tools/BinaryStream.hpp"
+
+#include <sstream>
+
+namespace ToolsTests
+{
+	namespace
+	{
+		enum class Type : uint8_t
+		{
+			Value = 42
+		};
+	}
+
+	//---------------------------------------------------------------------
+	TEST(BinaryStreamTest, WriteRead)
+	{
+		std::stringstream stream;
+		Tools::BinaryWriter writer{ stream };
+
+		writer.Write<uint32_t>(0x01020304);
+		writer.Write<int64_t>(-2);
+		writer.Write(Type::Value);
+		writer.Write(true);
+		writer.WriteVarint(300);
+		writer.WriteString(std::string{ "abc" });
+		writer.WriteString(std::wstring{ L"\u00e9\u00e0" });
+		writer.WriteValues(std::vector<uint16_t>{ 1, 2 });
+
+		Tools::BinaryReader reader{ stream };
+		uint32_t u32;
+		int64_t i64;
+		Type type;
+		bool b;
+		uint64_t varint;
+		std::string str;
+		std::wstring wstr;
+		std::vector<uint16_t> values;
+
+		ASSERT_TRUE(reader.Read(u32));
+		ASSERT_EQ(0x01020304u, u32);
+		ASSERT_TRUE(reader.Read(i64));
+		ASSERT_EQ(-2, i64);
+		ASSERT_TRUE(reader.Read(type));
+		ASSERT_EQ(Type::Value, type);
+		ASSERT_TRUE(reader.Read(b));
+		ASSERT_TRUE(b);
+		ASSERT_TRUE(reader.ReadVarint(varint));
+		ASSERT_EQ(300u, varint);
+		ASSERT_TRUE(reader.ReadString(str));
+		ASSERT_EQ("abc", str);
+		ASSERT_TRUE(reader.ReadString(wstr));
+		ASSERT_EQ(L"\u00e9\u00e0", wstr);
+		ASSERT_TRUE(reader.ReadValues(values, 2));
+		ASSERT_EQ(std::vector<uint16_t>({ 1, 2 }), values);
+		ASSERT_EQ(0u, reader.GetRemainingSize());
+		ASSERT_FALSE(reader.Read(u32));
+	}
+
+	//---------------------------------------------------------------------
+	TEST(BinaryStreamTest, LittleEndian)
+	{
+		std::ostringstream ostr;
+		Tools::BinaryWriter writer{ ostr };
+
+		writer.Write<uint32_t>(0x01020304);
+		ASSERT_EQ(std::string("\x04\x03\x02\x01", 4), ostr.str());
+	}
+
+	//---------------------------------------------------------------------
+	TEST(BinaryStreamTest, InvalidSize)
+	{
+		std::stringstream stream;
+		Tools::BinaryWriter writer{ stream };
+
+		writer.Write<uint32_t>(0xFFFFFFFF);
+		writer.WriteString(std::string{ "abc" });
+
+		Tools::BinaryReader reader{ stream };
+		std::string str;
+		std::vector<uint64_t> values;
+
+		ASSERT_FALSE(reader.ReadString(str));
+		ASSERT_TRUE(str.empty());
+		ASSERT_FALSE(reader.ReadValues(values, 0xFFFFFFFFFFFFFFFF));
+		ASSERT_TRUE(values.empty());
+	}
+
+	//---------------------------------------------------------------------
+	TEST(BinaryStreamTest, CanRead)
+	{
+		std::stringstream stream{ std::string(10, ' ') };
+		Tools::BinaryReader reader{ stream };
+
+		ASSERT_TRUE(reader.CanRead(10));
+		ASSERT_TRUE(reader.CanRead(2, 5));
+		ASSERT_FALSE(reader.CanRead(3, 4));
+		ASSERT_FALSE(reader.CanRead(0xFFFFFFFFFFFFFFFF, 2));
+	}
+}
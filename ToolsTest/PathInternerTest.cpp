@@ -0,0 +1,72 @@
+// OpenCppCoverage is an open source code coverage for C++.
+// Copyright (C) 2017 OpenCppCoverage
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "stdafx.h"
+#include "Tools/PathInterner.hpp"
+#include "Tools/ToolsException.hpp"
+
+namespace fs = std::filesystem;
+
+namespace ToolsTests
+{
+	//---------------------------------------------------------------------
+	TEST(PathInternerTest, SamePathSameId)
+	{
+		Tools::PathInterner pathInterner;
+
+		auto id = pathInterner.Intern(L"C:\\Dev\\File.cpp");
+		ASSERT_EQ(id, pathInterner.Intern(L"C:\\Dev\\File.cpp"));
+		ASSERT_EQ(fs::path{L"C:\\Dev\\File.cpp"}, pathInterner.GetPath(id));
+	}
+
+	//---------------------------------------------------------------------
+	TEST(PathInternerTest, CanonicalId)
+	{
+		Tools::PathInterner pathInterner;
+
+		auto id1 = pathInterner.Intern(L"C:\\Dev\\File.cpp");
+		auto id2 = pathInterner.Intern(L"c:\\dev\\FILE.cpp");
+		auto id3 = pathInterner.Intern(L"c:\\dev\\file.cpp");
+
+		ASSERT_NE(id1, id2);
+		ASSERT_EQ(pathInterner.GetCanonicalId(id1), pathInterner.GetCanonicalId(id2));
+		ASSERT_EQ(id3, pathInterner.GetCanonicalId(id1));
+		ASSERT_EQ(id3, pathInterner.GetCanonicalId(id3));
+		ASSERT_EQ(L"c:\\dev\\file.cpp", pathInterner.GetNormalizedPath(id2));
+		ASSERT_EQ(3u, pathInterner.GetCount());
+	}
+
+	//---------------------------------------------------------------------
+	TEST(PathInternerTest, InvalidId)
+	{
+		Tools::PathInterner pathInterner;
+
+		ASSERT_THROW(pathInterner.GetPath(0), Tools::ToolsException);
+	}
+
+	//---------------------------------------------------------------------
+	TEST(PathInternerTest, ManyPaths)
+	{
+		Tools::PathInterner pathInterner;
+		const size_t count = 5000;
+
+		for (size_t i = 0; i < count; ++i)
+			ASSERT_EQ(i, pathInterner.Intern(std::to_wstring(i)));
+		ASSERT_EQ(count, pathInterner.GetCount());
+		for (size_t i = 0; i < count; ++i)
+			ASSERT_EQ(fs::path{std::to_wstring(i)}, pathInterner.GetPath(static_cast<Tools::PathId>(i)));
+	}
+}
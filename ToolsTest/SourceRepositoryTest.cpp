@@ -0,0 +1,112 @@
+// OpenCppCoverage is an open source code coverage for C++.
+// Copyright (C) 2019 OpenCppCoverage
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "stdafx.h"
+#include "Tools/SourceRepository.hpp"
+#include <fstream>
+
+#include "TestHelper/TemporaryPath.hpp"
+
+namespace ToolsTests
+{
+	namespace
+	{
+		//---------------------------------------------------------------------
+		void WriteFile(const std::filesystem::path& path, const std::string& content)
+		{
+			std::ofstream ofs(path.string(), std::ios::binary);
+
+			ofs.write(content.c_str(), content.size());
+		}
+	}
+
+	//---------------------------------------------------------------------
+	TEST(SourceRepositoryTest, GetSourceFile)
+	{
+		TestHelper::TemporaryPath path;
+		WriteFile(path, "abc\r\n123\n");
+
+		Tools::SourceRepository sourceRepository;
+		auto sourceFile = sourceRepository.GetSourceFile(path);
+
+		ASSERT_TRUE(sourceFile);
+		ASSERT_EQ(std::vector<std::string>({ "abc", "123" }), sourceFile->GetLines());
+		ASSERT_EQ(sourceFile, sourceRepository.GetSourceFile(path));
+		ASSERT_EQ(1, sourceRepository.GetReadCount());
+	}
+
+	//---------------------------------------------------------------------
+	TEST(SourceRepositoryTest, ModifiedFile)
+	{
+		TestHelper::TemporaryPath path;
+		WriteFile(path, "abc\n");
+
+		Tools::SourceRepository sourceRepository;
+		auto sourceFile = sourceRepository.GetSourceFile(path);
+
+		WriteFile(path, "abc\n123\n");
+		auto modifiedSourceFile = sourceRepository.GetSourceFile(path);
+
+		ASSERT_EQ(std::vector<std::string>({ "abc" }), sourceFile->GetLines());
+		ASSERT_EQ(std::vector<std::string>({ "abc", "123" }), modifiedSourceFile->GetLines());
+		ASSERT_EQ(2, sourceRepository.GetReadCount());
+	}
+
+	//---------------------------------------------------------------------
+	TEST(SourceRepositoryTest, MemoryLimit)
+	{
+		TestHelper::TemporaryPath path1;
+		TestHelper::TemporaryPath path2;
+		WriteFile(path1, "abc\n");
+		WriteFile(path2, "123\n");
+
+		Tools::SourceRepository sourceRepository{ 0 };
+		auto sourceFile = sourceRepository.GetSourceFile(path1);
+		ASSERT_EQ(sourceFile->GetMemorySize(), sourceRepository.GetMemorySize());
+
+		sourceRepository.GetSourceFile(path2);
+		ASSERT_EQ(std::vector<std::string>({ "abc" }), sourceFile->GetLines());
+
+		sourceRepository.GetSourceFile(path1);
+		ASSERT_EQ(3, sourceRepository.GetReadCount());
+
+		sourceRepository.SetMemoryLimit(Tools::SourceRepository::DefaultMemoryLimit);
+		sourceRepository.GetSourceFile(path2);
+		sourceRepository.GetSourceFile(path1);
+		sourceRepository.GetSourceFile(path2);
+		ASSERT_EQ(4, sourceRepository.GetReadCount());
+	}
+
+	//---------------------------------------------------------------------
+	TEST(SourceRepositoryTest, EmptyFile)
+	{
+		TestHelper::TemporaryPath path{ TestHelper::TemporaryPathOption::CreateAsFile };
+		Tools::SourceRepository sourceRepository;
+		auto sourceFile = sourceRepository.GetSourceFile(path);
+
+		ASSERT_TRUE(sourceFile);
+		ASSERT_TRUE(sourceFile->GetLines().empty());
+	}
+
+	//---------------------------------------------------------------------
+	TEST(SourceRepositoryTest, MissingFile)
+	{
+		Tools::SourceRepository sourceRepository;
+
+		ASSERT_EQ(nullptr, sourceRepository.GetSourceFile("MissingFile"));
+		ASSERT_EQ(nullptr, sourceRepository.GetSourceFile(std::filesystem::temp_directory_path()));
+	}
+}
@@ -0,0 +1,58 @@
+// OpenCppCoverage is an open source code coverage for C++.
+// Copyright (C) 2019 OpenCppCoverage
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "stdafx.h"
+#include "Tools/WorkQueue.hpp"
+
+namespace ToolsTests
+{
+	//---------------------------------------------------------------------
+	TEST(WorkQueueTest, RunInOrder)
+	{
+		std::vector<int> values;
+		{
+			Tools::WorkQueue workQueue;
+
+			for (int i = 0; i < 10; ++i)
+				workQueue.Push([&values, i]() { values.push_back(i); });
+		}
+		ASSERT_EQ((std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9}), values);
+	}
+
+	//---------------------------------------------------------------------
+	TEST(WorkQueueTest, Flush)
+	{
+		Tools::WorkQueue workQueue;
+		int value = 0;
+
+		workQueue.Push([&]() { value = 1; });
+		workQueue.Flush();
+		ASSERT_EQ(1, value);
+	}
+
+	//---------------------------------------------------------------------
+	TEST(WorkQueueTest, Error)
+	{
+		Tools::WorkQueue workQueue;
+		bool hasRun = false;
+
+		workQueue.Push([]() { throw std::runtime_error("Error"); });
+		workQueue.Push([&]() { hasRun = true; });
+		workQueue.Flush();
+		ASSERT_TRUE(hasRun);
+	}
+}